@@ -23,12 +23,75 @@ Revision History:
 
 #include "chess.h"
 
+static UINT64
+_BenchEvalTree(IN SEARCHER_THREAD_CONTEXT *ctx,
+               IN ULONG uDepth)
+/**
+
+Routine description:
+
+    Statically evaluate every node in a full width tree uDepth ply
+    deep below the position in ctx.  Moves are made and unmade the
+    same way the search does it so incremental eval state (e.g. the
+    NNUE accumulators) sees a realistic access pattern.
+
+Parameters:
+
+    SEARCHER_THREAD_CONTEXT *ctx,
+    ULONG uDepth
+
+Return value:
+
+    static UINT64 : the number of evals done
+
+**/
+{
+    UINT64 u64Evals = 1;
+    MOVE mv;
+    ULONG u;
+    ULONG uPly;
+
+    (void)Eval(ctx, -INFINITY, +INFINITY);
+    if (uDepth == 0)
+    {
+        return(u64Evals);
+    }
+
+    mv.uMove = 0;
+    GenerateMoves(ctx, mv, GENERATE_DONT_SCORE);
+    uPly = ctx->uPly;
+    for (u = ctx->sMoveStack.uBegin[uPly];
+         u < ctx->sMoveStack.uEnd[uPly];
+         u++)
+    {
+        mv = ctx->sMoveStack.mv[u];
+        if (MakeMove(ctx, mv))
+        {
+            u64Evals += _BenchEvalTree(ctx, uDepth - 1);
+            UnmakeMove(ctx, mv);
+        }
+    }
+    return(u64Evals);
+}
+
+
 COMMAND(BenchCommand)
 /**
 
 Routine description:
 
-    Run a benchmark
+    Run a benchmark.
+
+    Usage:
+
+        bench
+        bench eval [depth]
+
+    With no arguments, search the benchmark positions to a fixed
+    depth and report nodes per second.  With "eval", statically
+    evaluate every node of a full width tree (default 3 ply) below
+    each benchmark position with the current eval (see the EvalType
+    variable) and report evals per second.
 
 Parameters:
 
@@ -69,13 +132,48 @@ Return value:
         }
     };
     ULONG u;
+    ULONG uDepth;
     double dStart;
     double dEnd;
     UINT64 u64Nodes = 0;
+    SEARCHER_THREAD_CONTEXT *ctx;
 
 #ifdef DEBUG
     Trace("You know this is a DEBUG build, right?\n");
 #endif
+    if ((argc > 1) && (!STRCMPI(argv[1], "eval")))
+    {
+        uDepth = 3;
+        if (argc > 2)
+        {
+            uDepth = (ULONG)atoi(argv[2]);
+            if ((uDepth == 0) || (uDepth >= MAX_PLY_PER_SEARCH))
+            {
+                Trace("Error (invalid depth): %s\n", argv[2]);
+                return;
+            }
+        }
+        ctx = SystemAllocateMemory(sizeof(SEARCHER_THREAD_CONTEXT));
+        dStart = SystemTimeStamp();
+        for (u = 0;
+             u < ARRAY_LENGTH(x) && (FALSE == g_fExitProgram);
+             u++)
+        {
+            VERIFY(SetRootPosition(x[u].szFen));
+            InitializeSearcherContext(GetRootPosition(), ctx);
+            u64Nodes += _BenchEvalTree(ctx, uDepth);
+        }
+        dEnd = SystemTimeStamp();
+        SystemFreeMemory(ctx);
+        Trace("Evaluated %"COMPILER_LONGLONG_UNSIGNED_FORMAT
+              " positions (%s eval) in %4.1f sec.\n", u64Nodes,
+              g_Options.szEvalType, (dEnd - dStart));
+        Trace("BENCHMARK>> %8.1f evals/sec\n",
+              (double)u64Nodes / MAX(dEnd - dStart, 0.001));
+        VERIFY(PreGameReset(TRUE));
+        return;
+    }
+
     dStart = SystemTimeStamp();
     for (u = 0;
          u < ARRAY_LENGTH(x) && (FALSE == g_fExitProgram);
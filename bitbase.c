@@ -0,0 +1,408 @@
+/**
+
+Copyright (c) Scott Gasch
+
+Module Name:
+
+    bitbase.c
+
+Abstract:
+
+    Small win/draw endgame bitbases built in memory at startup by
+    retrograde analysis so that the interior node recognizers (see
+    recogn.c) can classify some endgames exactly without any disk
+    I/O or on-disk EGTB files.
+
+    Right now this is only KPK.  Positions are normalized so that the
+    side with the pawn is white and the pawn is on files a..d; the
+    table then holds one bit per (side to move, black king, white
+    king, pawn square) that is set iff white wins.  That is 24 pawn
+    squares * 64 * 64 * 2 = 196,608 positions in 24Kb of bits.
+
+    The generator marks obviously won, drawn and illegal positions
+    and then iterates over the unknown ones until nothing changes:
+    with white to move a position is won if any move reaches a won
+    position; with black to move it is drawn if any move reaches a
+    drawn position.  Whatever is still unknown at the end is a draw.
+
+Revision History:
+
+**/
+
+#include "chess.h"
+
+#define KPK_NUM_POSITIONS         (24 * 64 * 64 * 2)
+
+#define KPK_INVALID               (0)
+#define KPK_UNKNOWN               (1)
+#define KPK_DRAW                  (2)
+#define KPK_WIN                   (4)
+
+static BITV g_bvKPKWins[KPK_NUM_POSITIONS / 32];
+
+static const int g_iKingDeltas[8] =
+{
+    -17, -16, -15, -1, +1, +15, +16, +17
+};
+
+static INLINE ULONG
+_KPKIndex(IN COOR cWhiteKing,
+          IN COOR cBlackKing,
+          IN COOR cPawn,
+          IN ULONG uToMove)
+/**
+
+Routine description:
+
+    Compute the bitbase index of a normalized KPK position: white has
+    the pawn and the pawn is on files a..d, ranks 2..7.
+
+Parameters:
+
+    COOR cWhiteKing,
+    COOR cBlackKing,
+    COOR cPawn,
+    ULONG uToMove
+
+Return value:
+
+    static INLINE ULONG
+
+**/
+{
+    ASSERT(IS_ON_BOARD(cWhiteKing));
+    ASSERT(IS_ON_BOARD(cBlackKing));
+    ASSERT(IS_ON_BOARD(cPawn));
+    ASSERT(FILE(cPawn) <= D);
+    ASSERT((RANK(cPawn) >= 2) && (RANK(cPawn) <= 7));
+    ASSERT(IS_VALID_COLOR(uToMove));
+
+    return(uToMove |
+           (COOR_TO_BIT_NUMBER(cBlackKing) << 1) |
+           (COOR_TO_BIT_NUMBER(cWhiteKing) << 7) |
+           (((RANK(cPawn) - 2) * 4 + FILE(cPawn)) << 13));
+}
+
+static FLAG
+_PawnAttacks(IN COOR cPawn,
+             IN COOR c)
+{
+    return((c == cPawn - 15) || (c == cPawn - 17));
+}
+
+static ULONG
+_KPKInitialClassification(IN COOR cWhiteKing,
+                          IN COOR cBlackKing,
+                          IN COOR cPawn,
+                          IN ULONG uToMove)
+/**
+
+Routine description:
+
+    Classify a KPK position without looking at its successors.
+    Positions with overlapping pieces, touching kings or the side not
+    on move in check are invalid.  With white to move a pawn on the
+    7th that can promote safely wins.  With black to move stalemate
+    or capturing an undefended pawn is a draw.  Everything else is
+    unknown for now.
+
+Parameters:
+
+    COOR cWhiteKing,
+    COOR cBlackKing,
+    COOR cPawn,
+    ULONG uToMove
+
+Return value:
+
+    static ULONG : KPK_INVALID, KPK_UNKNOWN, KPK_DRAW or KPK_WIN
+
+**/
+{
+    COOR cQueen;
+    COOR c;
+    ULONG u;
+
+    if ((cWhiteKing == cBlackKing) ||
+        (cWhiteKing == cPawn) ||
+        (cBlackKing == cPawn) ||
+        (DISTANCE(cWhiteKing, cBlackKing) <= 1))
+    {
+        return(KPK_INVALID);
+    }
+
+    if (uToMove == WHITE)
+    {
+        if (_PawnAttacks(cPawn, cBlackKing))
+        {
+            return(KPK_INVALID);
+        }
+
+        if (RANK(cPawn) == 7)
+        {
+            cQueen = cPawn - 16;
+            if ((cQueen != cWhiteKing) &&
+                (cQueen != cBlackKing) &&
+                ((DISTANCE(cBlackKing, cQueen) > 1) ||
+                 (DISTANCE(cWhiteKing, cQueen) == 1)))
+            {
+                return(KPK_WIN);
+            }
+        }
+        return(KPK_UNKNOWN);
+    }
+
+    ASSERT(uToMove == BLACK);
+    if ((DISTANCE(cBlackKing, cPawn) == 1) &&
+        (DISTANCE(cWhiteKing, cPawn) > 1))
+    {
+        return(KPK_DRAW);
+    }
+
+    if (!_PawnAttacks(cPawn, cBlackKing))
+    {
+        for (u = 0; u < ARRAY_LENGTH(g_iKingDeltas); u++)
+        {
+            c = cBlackKing + g_iKingDeltas[u];
+            if (IS_ON_BOARD(c) &&
+                (c != cPawn) &&
+                (DISTANCE(c, cWhiteKing) > 1) &&
+                !_PawnAttacks(cPawn, c))
+            {
+                return(KPK_UNKNOWN);
+            }
+        }
+        return(KPK_DRAW);
+    }
+    return(KPK_UNKNOWN);
+}
+
+static ULONG
+_KPKClassify(IN UCHAR *pResults,
+             IN COOR cWhiteKing,
+             IN COOR cBlackKing,
+             IN COOR cPawn,
+             IN ULONG uToMove)
+/**
+
+Routine description:
+
+    Classify an unknown KPK position based on the current state of
+    its successors.
+
+Parameters:
+
+    UCHAR *pResults : the work table, one entry per index
+    COOR cWhiteKing,
+    COOR cBlackKing,
+    COOR cPawn,
+    ULONG uToMove
+
+Return value:
+
+    static ULONG : KPK_UNKNOWN, KPK_DRAW or KPK_WIN
+
+**/
+{
+    ULONG uSeen = 0;
+    ULONG u;
+    COOR c;
+
+    if (uToMove == WHITE)
+    {
+        for (u = 0; u < ARRAY_LENGTH(g_iKingDeltas); u++)
+        {
+            c = cWhiteKing + g_iKingDeltas[u];
+            if (IS_ON_BOARD(c) &&
+                (c != cPawn) &&
+                (DISTANCE(c, cBlackKing) > 1))
+            {
+                uSeen |= pResults[_KPKIndex(c, cBlackKing, cPawn, BLACK)];
+            }
+        }
+
+        //
+        // Promotions were handled in the initial classification.
+        //
+        if (RANK(cPawn) < 7)
+        {
+            c = cPawn - 16;
+            if ((c != cWhiteKing) && (c != cBlackKing))
+            {
+                uSeen |= pResults[_KPKIndex(cWhiteKing, cBlackKing, c,
+                                            BLACK)];
+                if (RANK(cPawn) == 2)
+                {
+                    c -= 16;
+                    if ((c != cWhiteKing) && (c != cBlackKing))
+                    {
+                        uSeen |= pResults[_KPKIndex(cWhiteKing, cBlackKing,
+                                                    c, BLACK)];
+                    }
+                }
+            }
+        }
+        ASSERT(!(uSeen & ~(KPK_UNKNOWN | KPK_DRAW | KPK_WIN)));
+
+        if (uSeen & KPK_WIN) return(KPK_WIN);
+        if (uSeen & KPK_UNKNOWN) return(KPK_UNKNOWN);
+        return(KPK_DRAW);
+    }
+
+    ASSERT(uToMove == BLACK);
+    for (u = 0; u < ARRAY_LENGTH(g_iKingDeltas); u++)
+    {
+        //
+        // Capturing the pawn is either illegal (defended) or was
+        // already scored as a draw (undefended).
+        //
+        c = cBlackKing + g_iKingDeltas[u];
+        if (IS_ON_BOARD(c) &&
+            (c != cPawn) &&
+            (DISTANCE(c, cWhiteKing) > 1) &&
+            !_PawnAttacks(cPawn, c))
+        {
+            uSeen |= pResults[_KPKIndex(cWhiteKing, c, cPawn, WHITE)];
+        }
+    }
+    ASSERT(!(uSeen & ~(KPK_UNKNOWN | KPK_DRAW | KPK_WIN)));
+
+    if (uSeen & KPK_DRAW) return(KPK_DRAW);
+    if (uSeen & KPK_UNKNOWN) return(KPK_UNKNOWN);
+    return(KPK_WIN);
+}
+
+static void
+_KPKDecodeIndex(IN ULONG uIndex,
+                OUT COOR *pcWhiteKing,
+                OUT COOR *pcBlackKing,
+                OUT COOR *pcPawn,
+                OUT ULONG *puToMove)
+{
+    ULONG uPawn = uIndex >> 13;
+
+    *puToMove = uIndex & 1;
+    *pcBlackKing = BIT_NUMBER_TO_COOR((uIndex >> 1) & 63);
+    *pcWhiteKing = BIT_NUMBER_TO_COOR((uIndex >> 7) & 63);
+    *pcPawn = FILE_RANK_TO_COOR(uPawn & 3, (uPawn >> 2) + 2);
+    ASSERT(_KPKIndex(*pcWhiteKing, *pcBlackKing, *pcPawn, *puToMove) ==
+           uIndex);
+}
+
+void
+InitializeBitbases(void)
+/**
+
+Routine description:
+
+    Build the KPK bitbase.  This takes a few milliseconds and must be
+    called after the distance table is initialized.
+
+Parameters:
+
+    void
+
+Return value:
+
+    void
+
+**/
+{
+    UCHAR *pResults;
+    COOR cWhiteKing, cBlackKing, cPawn;
+    ULONG uToMove;
+    ULONG u, x;
+    FLAG fChanged;
+
+    pResults = SystemAllocateMemory(KPK_NUM_POSITIONS);
+    for (u = 0; u < KPK_NUM_POSITIONS; u++)
+    {
+        _KPKDecodeIndex(u, &cWhiteKing, &cBlackKing, &cPawn, &uToMove);
+        pResults[u] = (UCHAR)_KPKInitialClassification(cWhiteKing,
+                                                       cBlackKing,
+                                                       cPawn,
+                                                       uToMove);
+    }
+
+    do
+    {
+        fChanged = FALSE;
+        for (u = 0; u < KPK_NUM_POSITIONS; u++)
+        {
+            if (pResults[u] == KPK_UNKNOWN)
+            {
+                _KPKDecodeIndex(u, &cWhiteKing, &cBlackKing, &cPawn,
+                                &uToMove);
+                x = _KPKClassify(pResults, cWhiteKing, cBlackKing, cPawn,
+                                 uToMove);
+                if (x != KPK_UNKNOWN)
+                {
+                    pResults[u] = (UCHAR)x;
+                    fChanged = TRUE;
+                }
+            }
+        }
+    }
+    while (fChanged);
+
+    memset(g_bvKPKWins, 0, sizeof(g_bvKPKWins));
+    for (u = 0; u < KPK_NUM_POSITIONS; u++)
+    {
+        if (pResults[u] == KPK_WIN)
+        {
+            g_bvKPKWins[u >> 5] |= (1U << (u & 31));
+        }
+    }
+    SystemFreeMemory(pResults);
+}
+
+FLAG
+ProbeKPKBitbase(IN ULONG uStrong,
+                IN COOR cStrongKing,
+                IN COOR cWeakKing,
+                IN COOR cPawn,
+                IN ULONG uToMove)
+/**
+
+Routine description:
+
+    Look up a KPK position in the bitbase.
+
+Parameters:
+
+    ULONG uStrong : the color with the pawn
+    COOR cStrongKing : the king of the side with the pawn
+    COOR cWeakKing : the lone king
+    COOR cPawn : the pawn
+    ULONG uToMove : side on move
+
+Return value:
+
+    FLAG : TRUE if the side with the pawn wins, FALSE if it's a draw
+
+**/
+{
+    ULONG u;
+
+    ASSERT(IS_VALID_COLOR(uStrong));
+    ASSERT(IS_VALID_COLOR(uToMove));
+
+    //
+    // Normalize: the pawn is white's and on the queenside.
+    //
+    if (uStrong == BLACK)
+    {
+        cStrongKing ^= 0x70;
+        cWeakKing ^= 0x70;
+        cPawn ^= 0x70;
+        uToMove = FLIP(uToMove);
+    }
+    if (FILE(cPawn) > D)
+    {
+        cStrongKing ^= 0x07;
+        cWeakKing ^= 0x07;
+        cPawn ^= 0x07;
+    }
+    u = _KPKIndex(cStrongKing, cWeakKing, cPawn, uToMove);
+    return((g_bvKPKWins[u >> 5] >> (u & 31)) & 1);
+}
@@ -28,6 +28,13 @@ Abstract:
     your time to research what your instruction set has in the way of
     bit twiddling opcodes.
 
+    These days FirstBit, LastBit and CountBits are compiler
+    intrinsics (see chess.h) rather than hand written asm.  The only
+    one that needs help at runtime is CountBits: popcnt is not in the
+    x86-64 baseline instruction set so, unless the build was told it
+    can assume popcnt, InitializeBitboards looks at the cpu and picks
+    a version for g_pfnCountBits.
+
 Author:
 
     Scott Gasch (scott.gasch@gmail.com) 19 Jun 2004
@@ -214,6 +221,99 @@ Return value:
 }
 
 
+//
+// The CountBits implementation chosen by InitializeBitboards.  Start
+// out with the C version so that it's safe to call before init.
+//
+ULONG (CDECL *g_pfnCountBits)(BITBOARD bb) = SlowCountBits;
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+__attribute__((target("popcnt")))
+static ULONG CDECL
+_PopcntCountBits(BITBOARD bb)
+{
+    return((ULONG)__builtin_popcountll(bb));
+}
+#elif defined(_MSC_VER) && defined(_M_X64)
+static ULONG CDECL
+_PopcntCountBits(BITBOARD bb)
+{
+    return((ULONG)__popcnt64(bb));
+}
+#endif
+
+
+static FLAG
+_CpuSupportsPopcnt(void)
+/**
+
+Routine description:
+
+    Does the processor we are running on have a popcnt instruction?
+    This is cpuid leaf 1, ecx bit 23 on x86; other architectures
+    either always have one or we don't know how to ask.
+
+Parameters:
+
+    void
+
+Return value:
+
+    FLAG
+
+**/
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    return(0 != __builtin_cpu_supports("popcnt"));
+#elif defined(_MSC_VER) && defined(_M_X64)
+    int rgRegs[4];
+    __cpuid(rgRegs, 1);
+    return(0 != (rgRegs[2] & (1 << 23)));
+#else
+    return(FALSE);
+#endif
+}
+
+
+void
+InitializeBitboards(void)
+/**
+
+Routine description:
+
+    Pick the fastest CountBits implementation this cpu can run.  When
+    the compiler already assumed popcnt (CPU_HAS_POPCNT) CountBits is
+    inlined and g_pfnCountBits is only used by the test code.
+
+Parameters:
+
+    void
+
+Return value:
+
+    void
+
+**/
+{
+    g_pfnCountBits = SlowCountBits;
+#if (defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))) || \
+    (defined(_MSC_VER) && defined(_M_X64))
+    if (TRUE == _CpuSupportsPopcnt())
+    {
+        g_pfnCountBits = _PopcntCountBits;
+    }
+#endif
+#ifndef CPU_HAS_POPCNT
+    if (SlowCountBits == g_pfnCountBits)
+    {
+        Trace("InitializeBitboards: no popcnt opcode, using C bit "
+              "counting.\n");
+    }
+#endif
+}
+
+
 static const int foldedTable[] = {
     63,30, 3,32,59,14,11,33,
     60,24,50, 9,55,19,21,34,
@@ -168,6 +168,8 @@ Return value:
         "More pieces on board than accounted for in piece material",
         "Extra pieces on board that are not accounted for",
         "Fifty move counter is too high",
+        "Material signature mismatch",
+        "Piece square accumulator mismatch",
     };
     ULONG u, v;
     COOR c;
@@ -178,6 +180,7 @@ Return value:
     ULONG uSigmaNonPawnCount[2] = {0, 0};
     ULONG uWhiteSqBishopCount[2] = {0, 0};
     UINT64 u64Computed;
+    SCORE iPsqt[2][2];
     PIECE p;
     FLAG fRet = FALSE;
     ULONG uReason = (ULONG)-1;
@@ -197,6 +200,23 @@ Return value:
         goto end;
     }
 
+    u64Computed = ComputeMaterialSig(pos);
+    if (pos->u64MaterialSig != u64Computed)
+    {
+        uReason = 21;
+        goto end;
+    }
+
+    memcpy(iPsqt, pos->iPsqt, sizeof(iPsqt));
+    ComputePsqt(pos);
+    u = memcmp(iPsqt, pos->iPsqt, sizeof(iPsqt));
+    memcpy(pos->iPsqt, iPsqt, sizeof(iPsqt));
+    if (u != 0)
+    {
+        uReason = 22;
+        goto end;
+    }
+
     if (!VALID_EP_SQUARE(pos->cEpSquare))
     {
         uReason = 2;
@@ -604,6 +624,10 @@ Return value:
     }
 #endif
     p = PositionToFen(pos);
+    if (g_Options.fRunningUnderUci)
+    {
+        goto end;
+    }
     if (g_Options.fRunningUnderXboard)
     {
         Trace("; PositionToFen(pos): %s\n", p);
@@ -1149,7 +1149,7 @@ Return value:
 
 */
 {
-    LIGHTWEIGHT_SEARCHER_CONTEXT *ctx = NULL;
+    SEARCHER_THREAD_CONTEXT *ctx = NULL;
     UINT64 u64Sig;
     ULONG uTotalWeight = 0;
     static ULONG uMoveWeights[32];
@@ -1172,12 +1172,13 @@ Return value:
 #ifdef DEBUG
     memset(uMoveWeights, 0, sizeof(uMoveWeights));
 #endif
-    ctx = SystemAllocateMemory(sizeof(LIGHTWEIGHT_SEARCHER_CONTEXT));
+    ctx = SystemAllocateMemory(sizeof(SEARCHER_THREAD_CONTEXT));
     if (NULL == ctx) 
     {
         Trace("Out of memory.\n");
         goto end;
     }
+    InitializeSearcherContext(pos, ctx);
 
     //
     // We cannot probe the opening book if membook is non-NULL (which
@@ -1238,24 +1239,24 @@ Return value:
         // Make sure it's legal and doesn't draw... also get the name
         // of this opening.
         //
-        InitializeLightweightSearcherContext(pos, ctx);
-        if (FALSE == MakeMove((SEARCHER_THREAD_CONTEXT *)ctx, entry.mvNext))
+        ReInitializeSearcherContext(pos, ctx);
+        if (FALSE == MakeMove(ctx, entry.mvNext))
         {
             ASSERT(FALSE);
             continue;
         }
         else
         {
-            if (TRUE == IsDraw((SEARCHER_THREAD_CONTEXT *)ctx))
+            if (TRUE == IsDraw(ctx))
             {
-                UnmakeMove((SEARCHER_THREAD_CONTEXT *)ctx, entry.mvNext);
+                UnmakeMove(ctx, entry.mvNext);
                 continue;
             }
             
             u64Sig = (ctx->sPosition.u64PawnSig ^
                       ctx->sPosition.u64NonPawnSig);
             szNames[uMoveNum] = _BookLineToString(u64Sig);
-            UnmakeMove((SEARCHER_THREAD_CONTEXT *)ctx, entry.mvNext);
+            UnmakeMove(ctx, entry.mvNext);
         }
         
         //
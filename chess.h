@@ -158,11 +158,11 @@ typedef struct _DLIST_ENTRY
 //
 #ifndef OFFSET_OF
 #define OFFSET_OF(field, type) \
-    (ULONG)(&((type *)0)->field)
+    ((ULONG)offsetof(type, field))
 #endif
 #ifndef CONTAINING_STRUCT
 #define CONTAINING_STRUCT(address, type, field) \
-    ((type *)((BYTE *)(address) - (BYTE *)(OFFSET_OF(field, type))))
+    ((type *)((BYTE *)(address) - OFFSET_OF(field, type)))
 #endif
 
 #define WHITE                      (1)
@@ -177,6 +177,7 @@ typedef struct _DLIST_ENTRY
 #define MAX_MOVES_PER_PLY          (218)
 #define MAX_PLY_PER_SEARCH         (64)
 #define MAX_MOVES_PER_GAME         (1024)
+#define MAX_SEARCHER_THREADS       (64)
 #define SMALL_STRING_LEN_CHAR      (256)
 #define MEDIUM_STRING_LEN_CHAR     (8192)
 #define BIG_STRING_LEN_CHAR        (16384)
@@ -642,6 +643,9 @@ typedef struct _POSITION
 
     ULONG uWhiteSqBishopCount[2];          // num bishops on white squares
     SCORE iMaterialBalance[2];             // material balance
+    UINT64 u64MaterialSig;                 // piece counts (see sig.c)
+    SCORE iPsqt[2][2];                     // piece square terms, by
+                                           // PSQT_MG/PSQT_EG and color
 
     // temporary storage space for use in eval
     COOR cTrapped[2];
@@ -658,6 +662,30 @@ typedef struct _POSITION
 }
 POSITION;
 
+//
+// The static piece square part of the eval is kept up to date in
+// POSITION.iPsqt by the routines in move.c as pieces move.  There is
+// a middlegame and an endgame accumulator per side; they are blended
+// by game phase (MATERIAL_MAX_PHASE with all the pieces on the board,
+// 0 with only kings and pawns).
+//
+#define PSQT_MG                           (0)
+#define PSQT_EG                           (1)
+#define GAME_PHASE(pos) \
+    (MINU(MATERIAL_MAX_PHASE, \
+          (pos)->uNonPawnCount[BLACK][KNIGHT] + \
+          (pos)->uNonPawnCount[WHITE][KNIGHT] + \
+          (pos)->uNonPawnCount[BLACK][BISHOP] + \
+          (pos)->uNonPawnCount[WHITE][BISHOP] + \
+          ((pos)->uNonPawnCount[BLACK][ROOK] + \
+           (pos)->uNonPawnCount[WHITE][ROOK]) * 2 + \
+          ((pos)->uNonPawnCount[BLACK][QUEEN] + \
+           (pos)->uNonPawnCount[WHITE][QUEEN]) * 4))
+#define TAPERED_PSQT(pos, color, phase) \
+    (((pos)->iPsqt[PSQT_MG][(color)] * (SCORE)(phase) + \
+      (pos)->iPsqt[PSQT_EG][(color)] * \
+      (SCORE)(MATERIAL_MAX_PHASE - (phase))) / MATERIAL_MAX_PHASE)
+
 //
 // Castling permission bitvector flags.
 //
@@ -732,9 +760,14 @@ typedef struct _MOVE_STACK
 
     //
     // The main move list, a long series of moves, their values and some
-    // flag bits to tell search what the values are based upon.
+    // flag bits to tell search what the values are based upon.  These
+    // are kept in parallel arrays rather than as an array of structs
+    // so that the move picker scans a dense array of SCOREs (see
+    // SelectBestNoHistory).
     //
-    MOVE_STACK_MOVE_VALUE_FLAGS mvf[MAX_MOVE_STACK];
+    SCORE iValue[MAX_MOVE_STACK];
+    MOVE mv[MAX_MOVE_STACK];
+    BITV bvFlags[MAX_MOVE_STACK];
 
     //
     // uBegin[ply] and uEnd[ply] specify the start and end of moves gen-
@@ -754,6 +787,28 @@ MOVE_STACK;
     ctx->sMoveStack.uBegin[ctx->uPly + 1] =            \
         ctx->sMoveStack.uEnd[ctx->uPly]
 
+#define COPY_MOVE_STACK_ENTRY(pStack, uTo, uFrom)              \
+    do                                                          \
+    {                                                           \
+        (pStack)->iValue[(uTo)] = (pStack)->iValue[(uFrom)];    \
+        (pStack)->mv[(uTo)] = (pStack)->mv[(uFrom)];            \
+        (pStack)->bvFlags[(uTo)] = (pStack)->bvFlags[(uFrom)];  \
+    }                                                           \
+    while(0)
+
+#define SWAP_MOVE_STACK_ENTRIES(pStack, uA, uB)                 \
+    do                                                          \
+    {                                                           \
+        SCORE iSwap = (pStack)->iValue[(uA)];                   \
+        MOVE mvSwap = (pStack)->mv[(uA)];                       \
+        BITV bvSwap = (pStack)->bvFlags[(uA)];                  \
+        COPY_MOVE_STACK_ENTRY((pStack), (uA), (uB));            \
+        (pStack)->iValue[(uB)] = iSwap;                         \
+        (pStack)->mv[(uB)] = mvSwap;                            \
+        (pStack)->bvFlags[(uB)] = bvSwap;                       \
+    }                                                           \
+    while(0)
+
 #define GENERATE_ALL_MOVES             (1)
 #define GENERATE_ESCAPES               (2)
 #define GENERATE_CAPTURES_PROMS_CHECKS (3)
@@ -777,6 +832,11 @@ MOVE_STACK;
 //
 // Accumulators
 //
+#define LAZY_STAGE_PAWNS           (0)        // see Eval
+#define LAZY_STAGE_MINORS          (1)
+#define LAZY_STAGE_KINGS           (2)
+#define LAZY_EVAL_STAGES           (3)
+
 typedef struct _COUNTERS
 {
     struct
@@ -797,6 +857,30 @@ typedef struct _COUNTERS
     }
     pawnhash;
 
+    struct
+    {
+        UINT64 u64Probes;
+        UINT64 u64Hits;
+        UINT64 u64Stores;
+    }
+    poshash;
+
+    struct
+    {
+        UINT64 u64Hits;
+        UINT64 u64Updates;
+        UINT64 u64Refreshes;
+    }
+    nnue;
+
+    struct
+    {
+        UINT64 u64Exits[LAZY_EVAL_STAGES];
+        UINT64 u64Verified[LAZY_EVAL_STAGES];
+        UINT64 u64Wrong[LAZY_EVAL_STAGES];
+    }
+    lazy;
+
     struct
     {
         UINT64 u64TotalNodeCount;
@@ -818,6 +902,7 @@ typedef struct _COUNTERS
         UINT64 u64LazyEvals;
         UINT64 u64FullEvals;
         UINT64 u64CyclesInEval;
+        ULONG uMaxPly;                        // seldepth
     }
     tree;
 
@@ -828,6 +913,17 @@ typedef struct _COUNTERS
     }
     parallel;
 
+    struct
+    {
+        UINT64 u64Generates;
+        UINT64 u64HistoryPicks;
+        UINT64 u64PlainPicks;
+        UINT64 u64RootPicks;
+        UINT64 u64Scanned;
+        UINT64 u64Sorts;
+    }
+    movepick;
+
     struct
     {
         ULONG uPawnPush;
@@ -850,6 +946,7 @@ typedef struct _COUNTERS
     {
         ULONG uProbes;
         ULONG uHits;
+        double dProbeSeconds;
     }
     egtb;
 }
@@ -945,92 +1042,141 @@ PLY_INFO;
 
 #define EVAL_HASH
 #ifdef EVAL_HASH
-#define EVAL_HASH_TABLE_SIZE (2097152) // 32Mb (per thread)
+#define DEFAULT_EVAL_HASH_ENTRIES (2097152) // 48Mb (per thread or shared)
 typedef struct _EVAL_HASH_ENTRY
 {
-    UINT64 u64Key;
-    SCORE iEval;
-    ULONG uPositional;
-    COOR cTrapped[2];
-
+    UINT64 u64Key;                   // sig ^ u64Data[0] ^ u64Data[1]
+    union
+    {
+        struct
+        {
+            SCORE iEval;
+            ULONG uPositional;
+            COOR cTrapped[2];
+        } s;
+        UINT64 u64Data[2];
+    } u;
 } EVAL_HASH_ENTRY;
 #endif
 
-#define PAWN_HASH_TABLE_SIZE (131072) // 5.5Mb (per thread)
+#define DEFAULT_PAWN_HASH_ENTRIES (262144) // 36Mb (shared or per thread)
+#define PAWN_HASH_WAYS            (2)
 typedef struct _PAWN_HASH_ENTRY
 {
     UINT64 u64Key;
     BITBOARD bbPawnLocations[2];
     BITBOARD bbPasserLocations[2];
     BITBOARD bbStationaryPawns[2];
+    BITBOARD bbPawnAttacks[2];       // squares attacked by color's pawns
+    BITBOARD bbOutposts[2];          // squares color's minors can't be
+                                     // chased from by enemy pawns
     SHORT iScore[2];
     UCHAR uCountPerFile[2][10];
     UCHAR uNumRammedPawns;
     UCHAR uNumUnmovedPawns[2];
+    UCHAR uKingFileDefects[8];       // open files near a king, by king file
+    UCHAR cStormer[2][8];            // most advanced enemy pawn on a file
+                                     // from color's king's perspective
 }
 PAWN_HASH_ENTRY;
 
+//
+// Per-thread dynamic move ordering data (see dynamic.c): a history
+// table for ranking quiet moves and a "how often does this move fail
+// high" table for pruning decisions.  HISTORY_MAX is 8x the largest
+// history bonus ((depth+1)^2 at MAX_PLY_PER_SEARCH) so the gravity term
+// in _IncrementMoveHistoryCounter actually ages busy entries.
+//
+#define FH_STATS_TABLE_SIZE (0x20000)
+#define HISTORY_MAX         (8 * (MAX_PLY_PER_SEARCH + 1) * \
+                             (MAX_PLY_PER_SEARCH + 1))
+
+typedef struct _FH_STATS
+{
+    union
+    {
+        ULONG uWholeThing;
+        struct
+        {
+            USHORT u16FailHighs;
+            USHORT u16Attempts;
+        };
+    };
+} FH_STATS;
+
+typedef struct _HISTORY_TABLE
+{
+    ULONG uCounters[14][128];
+    FH_STATS sFailHighs[FH_STATS_TABLE_SIZE];
+}
+HISTORY_TABLE;
+
 #define NUM_SPLIT_PTRS_IN_CONTEXT (8)
 
+//
+// The first layer outputs of the NNUE evaluator (see nnue.c) for
+// both perspectives at one ply.  Each half is tagged with the
+// signature of the position (and the network) it was computed for.
+//
+#define NNUE_HIDDEN               (256)
+
+typedef struct _NNUE_ACCUMULATOR
+{
+    UINT64 u64Sig[2];                // position sig ^ net salt per half
+    SHORT iValue[2][NNUE_HIDDEN];    // by perspective color
+}
+NNUE_ACCUMULATOR;
+
+//
+// A searcher thread's context.  Fields are ordered by temperature:
+// the scalars and pointers that every node touches come first so
+// they share a cacheline or two (SystemAllocateMemory hands back
+// cacheline aligned buffers), then the board, ply info, killers and
+// counters, then the (big) move stack and finally things only looked
+// at once per search.  The pawn and eval hash tables live outside
+// the context (see pawnhash.c and evalhash.c) so that a context is
+// cheap enough to put on the stack or initialize on the fly for
+// things like SAN parsing or book legality checks.  The NNUE
+// accumulator stack does live here: it is private to the line being
+// searched and needs no teardown.
+//
 typedef struct _SEARCHER_THREAD_CONTEXT
 {
     ULONG uPly;                               // its distance from root
     ULONG uPositional;                        // positional component of score
-    POSITION sPosition;                       // the board
-    MOVE_STACK sMoveStack;                    // the move stack
+    ULONG uThreadNumber;
     CUMULATIVE_SEARCH_FLAGS sSearchFlags;
+    PAWN_HASH_ENTRY *pPawnHash;               // this thread's (or shared)
+#ifdef EVAL_HASH
+    EVAL_HASH_ENTRY *pEvalHash;               // this thread's (or shared)
+#endif
+    HISTORY_TABLE *pHistory;                  // this thread's
+    SPLIT_INFO *pSplitInfo[NUM_SPLIT_PTRS_IN_CONTEXT];
+    POSITION sPosition;                       // the board
     PLY_INFO sPlyInfo[MAX_PLY_PER_SEARCH+1];
     MOVE mvKiller[MAX_PLY_PER_SEARCH][2];
     MOVE mvKillerEscapes[MAX_PLY_PER_SEARCH][2];
     MOVE mvNullmoveRefutations[MAX_PLY_PER_SEARCH];
     COUNTERS sCounters;
-    ULONG uThreadNumber;
-    SPLIT_INFO *pSplitInfo[NUM_SPLIT_PTRS_IN_CONTEXT];
+    MOVE_STACK sMoveStack;                    // the move stack
+    NNUE_ACCUMULATOR sNnue[MAX_PLY_PER_SEARCH+1]; // nnue.c, by ply
     MOVE mvRootMove;
     SCORE iRootScore;
     ULONG uRootDepth;
-    PAWN_HASH_ENTRY rgPawnHash[PAWN_HASH_TABLE_SIZE];
-#ifdef EVAL_HASH
-    EVAL_HASH_ENTRY rgEvalHash[EVAL_HASH_TABLE_SIZE];
-#endif
+    UINT64 u64RootMoveNodes;                  // nodes under mvRootMove
+    PAWN_HASH_ENTRY sPawnHashScratch;         // private copy when shared
     CHAR szLastPV[SMALL_STRING_LEN_CHAR];
 }
 SEARCHER_THREAD_CONTEXT;
 
-//
-// When I added the pawn hash table and eval hash tables to searcher
-// thread contexts they became too heavy to just allocate on the fly
-// for things like checking the legality of SAN moves or seeing if an
-// opening book line leads to a draw.  This
-// LIGHTWEIGHT_SEARCHER_CONTEXT structure can be cast into a full
-// SEARCHER_THREAD_CONTEXT and passed safely into the Generate,
-// MakeMove and UnMakeMove functions because they presently only
-// need:
-//
-//     1. uPly
-//     2. sPosition
-//     3. sPlyInfo
-//     4. sMoveStack
-//
-typedef struct _LIGHTWEIGHT_SEARCHER_CONTEXT
-{
-    ULONG uPly;
-    ULONG uPositional;
-    POSITION sPosition;
-    MOVE_STACK sMoveStack;
-    CUMULATIVE_SEARCH_FLAGS sSearchFlags;
-    PLY_INFO sPlyInfo[MAX_PLY_PER_SEARCH+1];
-}
-LIGHTWEIGHT_SEARCHER_CONTEXT;
-
 // ----------------------------------------------------------------------
 //
 // Global game options
 //
 typedef struct _GAME_OPTIONS
 {
-    ULONG uMyClock;
-    ULONG uOpponentsClock;
+    ULONG uMyClockMs;
+    ULONG uOpponentsClockMs;
     FLAG fGameIsRated;
     FLAG fOpponentIsComputer;
     ULONG uSecPerMove;
@@ -1043,8 +1189,11 @@ typedef struct _GAME_OPTIONS
     MOVE mvPonder;
     FLAG fShouldPost;
     FLAG fForceDrawWorthZero;
-    ULONG uMyIncrement;
+    ULONG uMyIncrementMs;                     // or time per move if fixed
     ULONG uMovesPerTimePeriod;
+    ULONG uMovesToGo;                         // if the GUI says, else 0
+    ULONG uMoveOverhead;                      // ms lost per move to GUI/net
+    ULONG uMultiPv;                           // root lines to search/report
     CHAR szAnalyzeProgressReport[SMALL_STRING_LEN_CHAR];
     FLAG fShouldAnnounceOpening;
     SCORE iLastEvalScore;
@@ -1054,9 +1203,21 @@ typedef struct _GAME_OPTIONS
     CHAR szBookName[SMALL_STRING_LEN_CHAR];
     ULONG uNumProcessors;
     ULONG uNumHashTableEntries;
+    ULONG uNumPawnHashEntries;
+    ULONG uNumEvalHashEntries;
+    ULONG uNumPositionHashEntries;
+    ULONG uEGTBCacheSize;
+    ULONG uEGTBProbeDepth;
+    FLAG fSharedPawnHash;
+    FLAG fSharedEvalHash;
+    FLAG fUseNnue;
+    CHAR szEvalType[SMALL_STRING_LEN_CHAR];
+    CHAR szNnueFile[SMALL_STRING_LEN_CHAR];
+    CHAR szTelemetryFile[SMALL_STRING_LEN_CHAR];
     FLAG fNoInputThread;
     FLAG fVerbosePosting;
     FLAG fRunningUnderXboard;
+    FLAG fRunningUnderUci;
     FLAG fStatusLine;
     FLAG fFastScript;
     INT iResignThreshold;
@@ -1109,6 +1270,8 @@ extern GAME_OPTIONS g_Options;
 #define TIMER_MANY_ROOT_FLS              (0x200)
 #define TIMER_STOPPING                   (0x400)
 #define TIMER_SPLIT_FAILED               (0x800)
+#define TIMER_INPUT_PENDING              (0x1000)
+#define TIMER_MANAGED                    (0x2000)
 
 typedef struct _MOVE_TIMER
 {
@@ -1116,6 +1279,7 @@ typedef struct _MOVE_TIMER
     double dEndTime;
     double dSoftTimeLimit;
     double dHardTimeLimit;
+    double dOptimalTime;                      // soft budget before timer.c
     ULONG uNodeCheckMask;
     volatile BITV bvFlags;
 }
@@ -1214,7 +1378,7 @@ _assert(CHAR *szFile, ULONG uLine);
 #ifdef DEBUG
 #define DISTANCE(a, b)             DistanceBetweenSquares((a), (b))
 #else
-#define DISTANCE(a, b)             g_pDistance[(a) - (b)]
+#define DISTANCE(a, b)             g_pDistance[(int)(a) - (int)(b)]
 #endif // DEBUG
 
 #define    IS_EMPTY( square )      (!(square))
@@ -1438,7 +1602,8 @@ UtilPrintPV(SEARCHER_THREAD_CONTEXT *ctx,
             SCORE iAlpha,
             SCORE iBeta,
             SCORE iScore,
-            MOVE mv);
+            MOVE mv,
+            ULONG uLine);
 
 #define CANNOT_INITIALIZE_SPLIT           (1)
 #define INCONSISTENT_POSITION             (2)
@@ -1571,6 +1736,30 @@ SystemReleaseSemaphoreResource(ULONG u);
 void
 SystemObtainSemaphoreResource(ULONG u);
 
+ULONG
+SystemCreateEvent(void);
+
+FLAG
+SystemDeleteEvent(ULONG u);
+
+void
+SystemSignalEvent(ULONG u);
+
+FLAG
+SystemWaitForEvent(ULONG u, ULONG uTimeoutMs);
+
+ULONG
+SystemCreateServerSocket(CHAR *szPath);
+
+FLAG
+SystemAcceptServerConnection(ULONG uSocket,
+                             ULONG uTimeoutMs,
+                             FILE **ppIn,
+                             FILE **ppOut);
+
+void
+SystemDeleteServerSocket(ULONG uSocket, CHAR *szPath);
+
 
 //
 // fen.c
@@ -1747,6 +1936,9 @@ SelectBestNoHistory(SEARCHER_THREAD_CONTEXT *ctx, ULONG u);
 void FASTCALL
 SelectMoveAtRoot(SEARCHER_THREAD_CONTEXT *ctx, ULONG u);
 
+void
+SortMovesWithHistory(SEARCHER_THREAD_CONTEXT *ctx, ULONG u);
+
 #define NOT_MOVE 0
 #define MOVE_ICS 1
 #define MOVE_SAN 2
@@ -1831,6 +2023,23 @@ ComputePawnSig(POSITION *pos);
 UINT64
 ComputeSig(POSITION *pos);
 
+//
+// The material signature packs each side's piece counts into 4 bit
+// fields: pawns..queens and then white square bishops (in the slot
+// the king would use).  Black's counts are in bits 0..23, white's in
+// 24..47.  It is exact (no collisions), cheap to keep up to date in
+// LiftPiece / PlacePiece and never zero thanks to the valid bit.
+//
+#define MATERIAL_SIG_VALID         (0x8000000000000000ULL)
+#define MATERIAL_SIG_SHIFT(t, col) (4 * ((t) - PAWN) + 24 * (col))
+#define MATERIAL_SIG_DELTA(p, c)                                 \
+    ((1ULL << MATERIAL_SIG_SHIFT(PIECE_TYPE(p), GET_COLOR(p))) + \
+     ((UINT64)(IS_BISHOP(p) & IS_SQUARE_WHITE(c)) <<            \
+      MATERIAL_SIG_SHIFT(KING, GET_COLOR(p))))
+
+UINT64
+ComputeMaterialSig(POSITION *pos);
+
 //
 // mersenne.c
 //
@@ -2108,6 +2317,9 @@ GetRootPosition(void);
 FLAG
 SetRootPosition(CHAR *szFen);
 
+void
+RecomputeRootPositionPsqt(void);
+
 void
 ResetGameList(void);
 
@@ -2199,6 +2411,27 @@ extern ULONG g_uHardExtendLimit;
 extern volatile MOVE_TIMER g_MoveTimer;
 extern ULONG g_uExtensionReduction[MAX_PLY_PER_SEARCH];
 
+//
+// How Iterate sizes and widens its aspiration window.  The initial
+// half window is iMinDelta plus dVolatilityWeight times the average
+// recent change in score between depths (capped at iMaxDelta).  On
+// a root fail high / fail low the half window on that side grows by
+// dFailHighGrowth / dFailLowGrowth and once it passes iMaxDelta, or
+// the score is more than iScoreJump off the last one, that side of
+// the window is opened all the way.
+//
+typedef struct _ASPIRATION_POLICY
+{
+    SCORE iMinDelta;
+    SCORE iMaxDelta;
+    SCORE iScoreJump;
+    double dVolatilityWeight;
+    double dFailHighGrowth;
+    double dFailLowGrowth;
+} ASPIRATION_POLICY;
+
+extern ASPIRATION_POLICY g_AspirationPolicy;
+
 #ifdef PERF_COUNTERS
 #define KEEP_TRACK_OF_FIRST_MOVE_FHs(x)                \
     ctx->sCounters.tree.u64BetaCutoffs++;              \
@@ -2224,9 +2457,17 @@ Think(POSITION *pos);
 GAME_RESULT
 Ponder(POSITION *pos);
 
+void
+PonderHit(void);
+
+void
+PonderMiss(ULONG uColor);
+
 GAME_RESULT
 Iterate(SEARCHER_THREAD_CONTEXT *ctx);
 
+#define MAX_MULTI_PV (16)
+
 void
 SetMoveTimerForSearch(FLAG fSwitchOver, ULONG uColor);
 
@@ -2236,6 +2477,121 @@ SetMoveTimerToThinkForever(void);
 void
 ClearRootNodecountHash(void);
 
+UINT64
+GetRootRivalNodecount(SEARCHER_THREAD_CONTEXT *ctx);
+
+FLAG
+GetMultiPvLine(ULONG u, MOVE *pmv, SCORE *piScore);
+
+//
+// timer.c
+//
+#define TIMER_MIN_SEARCH_TIME       (0.02)
+#define DEFAULT_MOVE_OVERHEAD_MS    (50)
+
+void
+SetMoveTimerFlag(BITV bvFlag);
+
+void
+ClearMoveTimerFlag(BITV bvFlag);
+
+void
+ComputeMoveTimeBudget(double dClock,
+                      double dIncrement,
+                      ULONG uMovesToGo,
+                      ULONG uMoveNumber,
+                      double *pdSoft,
+                      double *pdHard);
+
+void
+UpdateMoveTimerAfterIteration(SEARCHER_THREAD_CONTEXT *ctx,
+                              ULONG uDepth,
+                              SCORE iScore);
+
+void
+ArmMoveTimer(SEARCHER_THREAD_CONTEXT *ctx);
+
+void
+DisarmMoveTimer(void);
+
+void
+InitializeMoveTimer(void);
+
+void
+CleanupMoveTimer(void);
+
+//
+// uci.c
+//
+COMMAND(UciCommand);
+
+COMMAND(IsReadyCommand);
+
+COMMAND(UciNewGameCommand);
+
+COMMAND(PositionCommand);
+
+COMMAND(SetOptionCommand);
+
+COMMAND(StopCommand);
+
+COMMAND(PonderHitCommand);
+
+void
+UciGo(ULONG argc, CHAR *argv[], POSITION *pos);
+
+void
+UciPostPV(SEARCHER_THREAD_CONTEXT *ctx,
+          SCORE iAlpha,
+          SCORE iBeta,
+          SCORE iScore,
+          ULONG uLine,
+          double dElapsed);
+
+void
+UciPostBestMove(SEARCHER_THREAD_CONTEXT *ctx);
+
+CHAR *
+MoveToUci(MOVE mv);
+
+//
+// server.c
+//
+COMMAND(ServeCommand);
+
+FLAG
+AnalysisServerIsRunning(void);
+
+void
+ScoreToJson(OUT CHAR *szDest,
+            IN ULONG uLen,
+            IN SCORE iScore);
+
+//
+// telemetry.c
+//
+COMMAND(TelemetryCommand);
+
+FLAG
+StartTelemetry(IN CHAR *szFilename);
+
+void
+StopTelemetry(void);
+
+void
+InitializeTelemetry(void);
+
+void
+TelemetryIteration(IN SEARCHER_THREAD_CONTEXT *ctx,
+                   IN ULONG uDepth,
+                   IN SCORE iScore);
+
+void
+TelemetryMove(IN SEARCHER_THREAD_CONTEXT *ctx,
+              IN ULONG uFailHighs,
+              IN ULONG uFailLows,
+              IN UINT64 u64ResearchNodes);
+
 //
 // draw.c
 //
@@ -2370,14 +2726,40 @@ SanityCheckMoves(IN SEARCHER_THREAD_CONTEXT *ctx,
 FLAG
 TestSearch(void);
 
+FLAG
+TestMultiPvSearch(void);
+
 //
 // see.c
 //
 #define SEE_HEAPS
 
+void
+InitializeSeeRayTable(void);
+
 SCORE
-SEE(POSITION *pos,
-    MOVE mv);
+ListSEE(POSITION *pos,
+        MOVE mv);
+
+SCORE
+BitboardSEE(POSITION *pos,
+            MOVE mv);
+
+//
+// ListSEE stays the default: BitboardSEE rebuilds occupancy from the
+// piece lists on every call and measures slower (see TestSEE).
+//
+#ifdef SEE_BITBOARDS
+#define SEE BitboardSEE
+#else
+#define SEE ListSEE
+#endif
+
+#ifdef SEE_PARITY
+extern ULONG g_uSeeParityCalls;
+extern ULONG g_uSeeParityListMismatches;
+extern ULONG g_uSeeParityDebugMismatches;
+#endif
 
 typedef struct _SEE_THREESOME
 {
@@ -2409,6 +2791,9 @@ DebugSEE(POSITION *pos,
 void
 TestGetAttacks(void);
 
+void
+TestSEE(void);
+
 //
 // hash.c
 //
@@ -2495,12 +2880,13 @@ AnalyzeFullHashTable(void);
 // IDEA: store "mate threat" flag in here?
 // IDEA: store "king safety" numbers in here?
 //
-typedef struct _POSITION_HASH_ENTRY {
-    UINT64 u64Sig;
-    UCHAR cEnprise[2];
-    UCHAR uEnpriseCount[2];
-    UCHAR cTrapped[2];
-} POSITION_HASH_ENTRY;
+// An entry is a single UINT64 so that it can be read and written
+// atomically without a lock (see poshash.c for the layout).
+//
+typedef UINT64 POSITION_HASH_ENTRY;
+#define DEFAULT_POSITION_HASH_ENTRIES (1048576) // 8Mb
+
+extern ULONG g_uPositionHashTableSizeEntries;
 
 void
 InitializePositionHashSystem(void);
@@ -2509,28 +2895,30 @@ void
 CleanupPositionHashSystem(void);
 
 void
-StoreEnprisePiece(POSITION *pos, COOR cSquare);
+ClearPositionHashTable(void);
 
 void
-StoreTrappedPiece(POSITION *pos, COOR cSquare);
+StoreEnprisePiece(SEARCHER_THREAD_CONTEXT *ctx, COOR cSquare);
 
-COOR
-GetEnprisePiece(POSITION *pos, ULONG uSide);
+void
+StoreTrappedPiece(SEARCHER_THREAD_CONTEXT *ctx, COOR cSquare);
 
-ULONG
-GetEnpriseCount(POSITION *pos, ULONG uSide);
+COOR
+GetEnprisePiece(SEARCHER_THREAD_CONTEXT *ctx, ULONG uSide);
 
 COOR
-GetTrappedPiece(POSITION *pos, ULONG uSide);
+GetTrappedPiece(SEARCHER_THREAD_CONTEXT *ctx, ULONG uSide);
 
 FLAG
-SideCanStandPat(POSITION *pos, ULONG uSide);
+SideCanStandPat(SEARCHER_THREAD_CONTEXT *ctx, ULONG uSide);
 
 ULONG
-ValueOfMaterialInTroubleDespiteMove(POSITION *pos, ULONG uSide);
+ValueOfMaterialInTroubleDespiteMove(SEARCHER_THREAD_CONTEXT *ctx, 
+                                    ULONG uSide);
 
 ULONG
-ValueOfMaterialInTroubleAfterNull(POSITION *pos, ULONG uSide);
+ValueOfMaterialInTroubleAfterNull(SEARCHER_THREAD_CONTEXT *ctx, 
+                                  ULONG uSide);
 
 //
 // pawnhash.c
@@ -2543,9 +2931,112 @@ ClearPawnHashStats(void);
 void
 ReportPawnHashStats(void);
 
+extern ULONG g_uPawnHashTableSizeEntries;
+
+FLAG
+InitializePawnHashSystem(void);
+
+void
+CleanupPawnHashSystem(void);
+
+void
+ClearPawnHashTables(void);
+
+PAWN_HASH_ENTRY *
+GetPawnHashTable(ULONG uThreadNumber);
+
 PAWN_HASH_ENTRY *
 PawnHashLookup(SEARCHER_THREAD_CONTEXT *ctx);
 
+void
+PawnHashStore(SEARCHER_THREAD_CONTEXT *ctx, PAWN_HASH_ENTRY *pHash);
+
+//
+// materialhash.c
+//
+// Everything that depends only on the material on the board, looked
+// up by POSITION.u64MaterialSig.  Entries are stored with their key
+// XORed with their data words so that the (single, shared) table can
+// be read and written by every searcher thread without a lock.
+//
+#define MATERIAL_HASH_ENTRIES     (8192)  // 256Kb
+#define MATERIAL_MAX_PHASE        (24)
+#define MATERIAL_SCALE_NORMAL     (8)
+
+typedef ULONG RECOGNIZER(SEARCHER_THREAD_CONTEXT *ctx,   // see recogn.c
+                        SCORE *piScore);
+
+typedef struct _MATERIAL_HASH_ENTRY
+{
+    UINT64 u64Key;                   // sig ^ u64Data[0..2]
+    union
+    {
+        struct
+        {
+            RECOGNIZER *pRecognizer; // interior node recognizer or NULL
+            SCORE iImbalance[2];     // bad trades, bishop pairs
+            UCHAR uArmyScaler[2];    // non-pawn material in pawns, <= 31
+            UCHAR uPhase;            // 0 = bare kings .. MATERIAL_MAX_PHASE
+            UCHAR uScale;            // eval scale, MATERIAL_SCALE_NORMAL = 1
+        } s;
+        UINT64 u64Data[3];
+    } u;
+}
+MATERIAL_HASH_ENTRY;
+
+void
+InitializeMaterialHashSystem(void);
+
+void
+CleanupMaterialHashSystem(void);
+
+void
+ClearMaterialHashTable(void);
+
+void
+MaterialHashLookup(POSITION *pos,
+                   MATERIAL_HASH_ENTRY *pEntry);
+
+//
+// nnue.c
+//
+#define NNUE_INPUTS               (64 * 10 * 64)
+#define NNUE_CLIP                 (127)
+#define NNUE_MAX_SCORE            (NMATE / 2)
+
+void
+InitializeNnue(void);
+
+void
+CleanupNnue(void);
+
+void
+SelectEvalType(void);
+
+void
+ApplyPendingNnueChanges(void);
+
+FLAG
+ReadNnueNetwork(FILE *p, CHAR *szFilename);
+
+FLAG
+LoadNnueNetwork(CHAR *szFilename);
+
+FLAG
+NnueNetworkIsLoaded(void);
+
+SCORE
+NnueEval(SEARCHER_THREAD_CONTEXT *ctx);
+
+SCORE
+NnueEvalPosition(POSITION *pos);
+
+//
+// testnnue.c
+//
+void
+TestNnue(void);
+
 //
 // eval.c
 //
@@ -2569,15 +3060,29 @@ ImportEvalDNA(char *p);
 FLAG
 ReadEvalDNA(char *szFilename);
 
+extern SCORE g_iPsqt[2][14][128];
+
+void
+InitializePsqt(void);
+
+void
+ComputePsqt(POSITION *pos);
 
 
 SCORE
 Eval(SEARCHER_THREAD_CONTEXT *, SCORE, SCORE);
 
+void
+ClearLazyEvalStats(void);
+
 FLAG
 EvalPasserRaces(POSITION *,
                 PAWN_HASH_ENTRY *);
 
+void
+EvalMaterialTerms(POSITION *pos,
+                  MATERIAL_HASH_ENTRY *pEntry);
+
 ULONG
 CountKingSafetyDefects(POSITION *pos,
                        ULONG uSide);
@@ -2630,11 +3135,7 @@ SlowFirstBit(BITBOARD bb);
 ULONG CDECL
 SlowLastBit(BITBOARD bb);
 
-#ifdef CROUTINES
-#define CountBits SlowCountBits
-#define FirstBit SlowFirstBit
-#define LastBit SlowLastBit
-#endif
+extern ULONG (CDECL *g_pfnCountBits)(BITBOARD bb);
 
 COOR
 CoorFromBitBoardRank8ToRank1(BITBOARD *pbb);
@@ -2642,8 +3143,15 @@ CoorFromBitBoardRank8ToRank1(BITBOARD *pbb);
 COOR
 CoorFromBitBoardRank1ToRank8(BITBOARD *pbb);
 
+#if defined(CROUTINES)
+#define CountBits SlowCountBits
+#define FirstBit SlowFirstBit
+#define LastBit SlowLastBit
+#define GetAttacks SlowGetAttacks
+
+#elif defined(ASM_ROUTINES)
 //
-// x86.asm
+// x86.asm / x64.asm
 //
 ULONG CDECL
 CountBits(BITBOARD bb);
@@ -2654,6 +3162,78 @@ FirstBit(BITBOARD bb);
 ULONG CDECL
 LastBit(BITBOARD bb);
 
+void CDECL
+GetAttacks(SEE_LIST *pList,
+           POSITION *pos,
+           COOR cSquare,
+           ULONG uSide);
+
+#elif defined(__GNUC__)
+//
+// Compiler intrinsics.  The bit scans are single instructions on
+// every 64 bit target we care about (bsf/bsr or tzcnt/lzcnt on x86-64,
+// rbit+clz/clz on AArch64) so they are always inlined.  popcnt is not
+// part of the x86-64 baseline: when the compiler is allowed to assume
+// it (-march=native, -mpopcnt) CountBits inlines to the opcode,
+// otherwise it calls through g_pfnCountBits which InitializeBitboards
+// points at the fastest version the cpu supports.
+//
+static INLINE ULONG
+FirstBit(BITBOARD bb)
+{
+    return((0 != bb) ? (ULONG)__builtin_ctzll(bb) + 1 : 0);
+}
+
+static INLINE ULONG
+LastBit(BITBOARD bb)
+{
+    return((0 != bb) ? 64 - (ULONG)__builtin_clzll(bb) : 0);
+}
+
+#if defined(__POPCNT__) || defined(__aarch64__)
+#define CPU_HAS_POPCNT
+static INLINE ULONG
+CountBits(BITBOARD bb)
+{
+    return((ULONG)__builtin_popcountll(bb));
+}
+#else
+#define CountBits(bb)              (*g_pfnCountBits)(bb)
+#endif
+#define GetAttacks SlowGetAttacks
+
+#elif defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+static INLINE ULONG
+FirstBit(BITBOARD bb)
+{
+    unsigned long u;
+    return(_BitScanForward64(&u, bb) ? (ULONG)u + 1 : 0);
+}
+
+static INLINE ULONG
+LastBit(BITBOARD bb)
+{
+    unsigned long u;
+    return(_BitScanReverse64(&u, bb) ? (ULONG)u + 1 : 0);
+}
+
+#define CountBits(bb)              (*g_pfnCountBits)(bb)
+#define GetAttacks SlowGetAttacks
+
+#else
+#define CountBits SlowCountBits
+#define FirstBit SlowFirstBit
+#define LastBit SlowLastBit
+#define GetAttacks SlowGetAttacks
+#endif
+
+//
+// Interlocked operations.  These return the value that was in *pDest
+// before the exchange (LockCompareExchange) or the new value
+// (LockIncrement / LockDecrement), just like the asm versions did.
+//
+#if defined(ASM_ROUTINES)
 ULONG CDECL
 LockCompareExchange(volatile void *pDest,
                     ULONG uExch,
@@ -2665,31 +3245,33 @@ LockIncrement(volatile void *pDest);
 ULONG CDECL
 LockDecrement(volatile void *pDest);
 
-FLAG CDECL
-CanUseParallelOpcodes();
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#define LockCompareExchange(pDest, uExch, uComp) \
+    ((ULONG)_InterlockedCompareExchange((volatile long *)(pDest), \
+                                        (long)(uExch), (long)(uComp)))
+#define LockIncrement(pDest) \
+    ((ULONG)_InterlockedIncrement((volatile long *)(pDest)))
+#define LockDecrement(pDest) \
+    ((ULONG)_InterlockedDecrement((volatile long *)(pDest)))
 
-ULONG CDECL
-ParallelCompareUlong(ULONG uComparand, void *pComparators);
-
-ULONG CDECL
-ParallelCompareVector(void *pComparand, void *pComparators);
-
-void CDECL
-GetAttacks(SEE_LIST *pList,
-           POSITION *pos,
-           COOR cSquare,
-           ULONG uSide);
+#else
+#define LockCompareExchange(pDest, uExch, uComp) \
+    (__sync_val_compare_and_swap((volatile ULONG *)(pDest), \
+                                 (ULONG)(uComp), (ULONG)(uExch)))
+#define LockIncrement(pDest) \
+    (__sync_add_and_fetch((volatile ULONG *)(pDest), 1))
+#define LockDecrement(pDest) \
+    (__sync_sub_and_fetch((volatile ULONG *)(pDest), 1))
+#endif
 
 void CDECL
 SlowGetAttacks(SEE_LIST *pList,
                POSITION *pos,
                COOR cSquare,
                ULONG uSide);
-#ifdef CROUTINES
-#define GetAttacks SlowGetAttacks
-#endif
 
-#ifdef _X86_
+#if defined(_X86_) && defined(ASM_ROUTINES)
 //
 // Note: this is most of the stuff that x86.asm assumes about the
 // internal data structures.  If any of this fails then either the
@@ -2725,13 +3307,22 @@ SlowGetAttacks(SEE_LIST *pList,
 void
 TestBitboards(void);
 
+//
+// testbitbase.c
+//
+void
+TestBitbases(void);
+
 //
 // dynamic.c
 //
-extern ULONG g_HistoryCounters[14][128];
+#define MERGE_HISTORY_BETWEEN_SEARCHES
 
 ULONG
-GetMoveFailHighPercentage(MOVE mv);
+GetMoveFailHighPercentage(SEARCHER_THREAD_CONTEXT *ctx, MOVE mv);
+
+HISTORY_TABLE *
+GetHistoryTable(ULONG uThreadNumber);
 
 void
 UpdateDynamicMoveOrdering(SEARCHER_THREAD_CONTEXT *ctx,
@@ -2740,9 +3331,6 @@ UpdateDynamicMoveOrdering(SEARCHER_THREAD_CONTEXT *ctx,
                           SCORE iScore,
                           ULONG uCurrent);
 
-void
-NewKillerMove(SEARCHER_THREAD_CONTEXT *ctx, MOVE mv, SCORE iScore);
-
 FLAG
 InitializeDynamicMoveOrdering(void);
 
@@ -2755,12 +3343,6 @@ ClearDynamicMoveOrdering(void);
 void
 MaintainDynamicMoveOrdering(void);
 
-void
-IncrementMoveHistoryCounter(MOVE mv, ULONG u);
-
-void
-DecrementMoveHistoryCounter(MOVE mv, ULONG u);
-
 //
 // split.c
 //
@@ -2779,6 +3361,10 @@ ClearHelperThreadIdleness(void);
 void
 DumpHelperIdlenessReport(void);
 
+ULONG
+GetHelperIdlePercentages(OUT double *pdIdle,
+                         IN ULONG uMax);
+
 SCORE
 StartParallelSearch(IN SEARCHER_THREAD_CONTEXT *ctx,
                     IN OUT SCORE *piAlpha,
@@ -2795,9 +3381,6 @@ InitializeSearcherContext(POSITION *pos, SEARCHER_THREAD_CONTEXT *ctx);
 void
 ReInitializeSearcherContext(POSITION *pos, SEARCHER_THREAD_CONTEXT *ctx);
 
-void
-InitializeLightweightSearcherContext(POSITION *pos,
-                                     LIGHTWEIGHT_SEARCHER_CONTEXT *ctx);
 
 //
 // book.c
@@ -2877,12 +3460,20 @@ TestDraw(void);
 //
 // probe.c
 //
+#define DEFAULT_EGTB_CACHE_SIZE (8 * 1024 * 1024)
+
 FLAG
 ProbeEGTB(SEARCHER_THREAD_CONTEXT *ctx, SCORE *score);
 
 void
 InitializeEGTB(void);
 
+void
+ResizeEGTBCache(void);
+
+void
+ApplyPendingEGTBCacheResize(void);
+
 void
 CleanupEGTB(void);
 
@@ -2953,12 +3544,42 @@ GenerateRandomLegalSymetricPosition(POSITION *pos);
 void
 InitializeInteriorNodeRecognizers(void);
 
+RECOGNIZER *
+GetInteriorNodeRecognizer(POSITION *pos);
+
+//
+// bitbase.c
+//
+void
+InitializeBitbases(void);
+
+FLAG
+ProbeKPKBitbase(ULONG uStrong,
+                COOR cStrongKing,
+                COOR cWeakKing,
+                COOR cPawn,
+                ULONG uToMove);
+
 ULONG
 RecognLookup(SEARCHER_THREAD_CONTEXT *ctx,
              SCORE *piScore,
              FLAG fProbeEGTB);
 
 #ifdef EVAL_HASH
+extern ULONG g_uEvalHashTableSizeEntries;
+
+FLAG
+InitializeEvalHashSystem(void);
+
+void
+CleanupEvalHashSystem(void);
+
+void
+ClearEvalHashTables(void);
+
+EVAL_HASH_ENTRY *
+GetEvalHashTable(ULONG uThreadNumber);
+
 void
 ClearEvalHashStats(void);
 
@@ -573,6 +573,13 @@ Return value:
             Trace("Error reading dna file.\n");
         } else {
             Trace("Loaded dna file \"%s\"\n", argv[2]);
+            ClearPawnHashTables();
+#ifdef EVAL_HASH
+            ClearEvalHashTables();
+#endif
+            ClearMaterialHashTable();
+            ClearLazyEvalStats();
+            RecomputeRootPositionPsqt();
             p = ExportEvalDNA();
             Log("(New) dna: %s\n", p);
             free(p);
@@ -696,7 +703,7 @@ Return value:
              u < ctx->sMoveStack.uEnd[0];
              u++)
         {
-            mv = ctx->sMoveStack.mvf[u].mv;
+            mv = ctx->sMoveStack.mv[u];
             if (MakeMove(ctx, mv))
             {
                 ASSERT(!InCheck(&(ctx->sPosition), GET_COLOR(mv.pMoved)));
@@ -705,7 +712,7 @@ Return value:
                 Trace("%2u. %s (%d)\t", 
                       uLegal, 
                       MoveToSan(mv, &(ctx->sPosition)),
-                      ctx->sMoveStack.mvf[u].iValue);
+                      ctx->sMoveStack.iValue[u]);
                 if (uLegal % 3 == 0)
                 {
                     Trace("\n");
@@ -777,6 +784,11 @@ Return value:
 
 **/
 {
+    if (TRUE == g_Options.fRunningUnderUci)
+    {
+        UciGo(argc, argv, pos);
+        return;
+    }
     if (pos->uToMove == WHITE)
     {
         TellGamelistThatIPlayColor(WHITE);
@@ -865,26 +877,27 @@ Return value:
 **/
 {
     ULONG x;
+    ULONG uMinutes, uIncrement;
 
     if (argc < 4)
     {
         Trace("Error (syntax): %s\n", argv[0]);
     } else {
         g_Options.uMovesPerTimePeriod = atoi(OnlyDigits(argv[1]));
-        g_Options.uMyClock = atoi(OnlyDigits(argv[2]));
-        g_Options.uMyIncrement = atoi(OnlyDigits(argv[3]));
+        uMinutes = atoi(OnlyDigits(argv[2]));
+        uIncrement = atoi(OnlyDigits(argv[3]));
+        g_Options.uMyClockMs = uMinutes * 60 * 1000;
+        g_Options.uMyIncrementMs = uIncrement * 1000;
 
         g_Options.eClock = CLOCK_NORMAL;
-        if (g_Options.uMyIncrement)
+        if (uIncrement)
         {
             g_Options.eClock = CLOCK_INCREMENT;
         }
         
-        x = (g_Options.uMyClock + ((g_Options.uMyIncrement * 2) / 3));
-        g_Options.uMyClock *= 60;
-        
+        x = (uMinutes + ((uIncrement * 2) / 3));
         Trace("etime = %u (clock %u and inc %u)\n", x,
-              g_Options.uMyClock, g_Options.uMyIncrement);
+              uMinutes * 60, uIncrement);
         if (x <= 6)
         {
             Trace("bullet game\n");
@@ -1076,13 +1089,13 @@ Return value:
     if (argc < 2)
     {
         Trace("My opponent's clock stands at %u sec remaining.\n",
-              g_Options.uOpponentsClock);
+              g_Options.uOpponentsClockMs / 1000);
         
         switch (g_Options.eClock)
         {
             case CLOCK_FIXED:
                 Trace("The move timer is fixed, %u sec / move.\n",
-                      g_Options.uMyIncrement);
+                      g_Options.uMyIncrementMs / 1000);
                 break;
             case CLOCK_NORMAL:
                 if (g_Options.uMovesPerTimePeriod != 0)
@@ -1098,7 +1111,7 @@ Return value:
             case CLOCK_INCREMENT:
                 Trace("The move timer is increment, additional %u sec "
                       "/ move.\n",
-                      g_Options.uMyIncrement);
+                      g_Options.uMyIncrementMs / 1000);
                 break;
             case CLOCK_NONE:
             default:
@@ -1109,7 +1122,7 @@ Return value:
         x = atoi(argv[1]);
         if (x >= 0)
         {
-            g_Options.uOpponentsClock = x / 100; // convert to seconds
+            g_Options.uOpponentsClockMs = x * 10; // centiseconds to ms
         } else {
             Trace("Error (invalid time): %d\n", x);
         }
@@ -1561,12 +1574,12 @@ Return value:
     if (argc < 2)
     {
         Trace("My clock stands at %u sec remaining.\n",
-              g_Options.uMyClock);
+              g_Options.uMyClockMs / 1000);
         switch (g_Options.eClock)
         {
             case CLOCK_FIXED:
                 Trace("The move timer is fixed, %u sec / move.\n",
-                      g_Options.uMyIncrement);
+                      g_Options.uMyIncrementMs / 1000);
                 break;
             case CLOCK_NORMAL:
                 if (g_Options.uMovesPerTimePeriod != 0)
@@ -1582,7 +1595,7 @@ Return value:
             case CLOCK_INCREMENT:
                 Trace("The move timer is increment, additional %u sec "
                       "/ move.\n",
-                      g_Options.uMyIncrement);
+                      g_Options.uMyIncrementMs / 1000);
                 break;
             case CLOCK_NONE:
             default:
@@ -1593,7 +1606,7 @@ Return value:
         x = atoi(argv[1]);
         if (x >= 0)
         {
-            g_Options.uMyIncrement = x;
+            g_Options.uMyIncrementMs = x * 1000;
             g_Options.eClock = CLOCK_FIXED;
         } else {
             Trace("Error (illegal time per move): %u\n", x);
@@ -1762,13 +1775,13 @@ Return value:
     if (argc < 2)
     {
         Trace("My clock stands at %u sec remaining.\n",
-              g_Options.uMyClock);
+              g_Options.uMyClockMs / 1000);
         
         switch (g_Options.eClock)
         {
             case CLOCK_FIXED:
                 Trace("The move timer is fixed, %u sec / move.\n",
-                      g_Options.uMyIncrement);
+                      g_Options.uMyIncrementMs / 1000);
                 break;
             case CLOCK_NORMAL:
                 if (g_Options.uMovesPerTimePeriod != 0)
@@ -1784,7 +1797,7 @@ Return value:
             case CLOCK_INCREMENT:
                 Trace("The move timer is increment, additional %u sec "
                       "/ move.\n",
-                      g_Options.uMyIncrement);
+                      g_Options.uMyIncrementMs / 1000);
                 break;
             case CLOCK_NONE:
             default:
@@ -1795,7 +1808,7 @@ Return value:
         x = atoi(argv[1]);
         if (x >= 0)
         {
-            g_Options.uMyClock = x / 100; // convert to seconds
+            g_Options.uMyClockMs = x * 10; // centiseconds to ms
         } else {
             Trace("Error (illegal time): %d\n", x);
         }
@@ -2122,6 +2135,12 @@ COMMAND_PARSER_ENTRY g_ParserTable[] =
       FALSE,
       FALSE,
       "Set a problem id name" },
+    { "isready",
+      IsReadyCommand,
+      TRUE,
+      FALSE,
+      FALSE,
+      "UCI: answer readyok" },
     { "level",
       LevelCommand,
       FALSE,
@@ -2170,6 +2189,18 @@ COMMAND_PARSER_ENTRY g_ParserTable[] =
       FALSE,
       TRUE,
       "Play the other side" },
+    { "ponderhit",
+      PonderHitCommand,
+      TRUE,
+      FALSE,
+      FALSE,
+      "UCI: the ponder move was played, start the clock" },
+    { "position",
+      PositionCommand,
+      FALSE,
+      FALSE,
+      FALSE,
+      "UCI: set the position (startpos|fen ...) [moves ...]" },
     { "post",
       PostCommand,
       TRUE,
@@ -2236,6 +2267,12 @@ COMMAND_PARSER_ENTRY g_ParserTable[] =
       FALSE,
       TRUE,
       "Set engine maximum search depth" },
+    { "serve",
+      ServeCommand,
+      FALSE,
+      FALSE,
+      FALSE,
+      "Run an analysis server (EPD requests in, JSON lines out)" },
     { "set",
       SetCommand,
       TRUE,
@@ -2248,6 +2285,12 @@ COMMAND_PARSER_ENTRY g_ParserTable[] =
       FALSE,
       TRUE,
       "Load a board position" },
+    { "setoption",
+      SetOptionCommand,
+      FALSE,
+      FALSE,
+      FALSE,
+      "UCI: set an option (Hash, Threads, Move Overhead)" },
     { "solution",
       SolutionCommand,
       FALSE,
@@ -2266,6 +2309,18 @@ COMMAND_PARSER_ENTRY g_ParserTable[] =
       FALSE,
       TRUE,
       "Set the engine search time" },
+    { "stop",
+      StopCommand,
+      TRUE,
+      FALSE,
+      FALSE,
+      "UCI: stop searching and post the best move" },
+    { "telemetry",
+      TelemetryCommand,
+      FALSE,
+      FALSE,
+      FALSE,
+      "Write a JSON line per iteration and move to a file (or off)" },
     { "test",
       TestCommand,
       FALSE,
@@ -2278,6 +2333,18 @@ COMMAND_PARSER_ENTRY g_ParserTable[] =
       FALSE,
       TRUE,
       "Tell the engine how its clock stands" },
+    { "uci",
+      UciCommand,
+      FALSE,
+      FALSE,
+      FALSE,
+      "Switch to the UCI protocol" },
+    { "ucinewgame",
+      UciNewGameCommand,
+      FALSE,
+      FALSE,
+      FALSE,
+      "UCI: get ready for a new game" },
     { "undo",
       UndoCommand,
       FALSE,
@@ -2439,6 +2506,16 @@ Return value:
     {
         ASSERT(g_Options.fPondering || g_Options.fThinking);
         p = pDontFree = PeekNextInput();
+
+        //
+        // While the analysis server is searching, the input queued
+        // up behind it is (probably) its next request.  Leave it alone
+        // until the server gets to it.
+        //
+        if (TRUE == AnalysisServerIsRunning())
+        {
+            goto end;
+        }
     } else {
         p = pFreeThis = BlockingReadInput();
     }
@@ -2596,6 +2673,7 @@ Return value:
             if (IS_SAME_MOVE(mv, g_Options.mvPonder))
             {
                 Trace("PREDICTED MOVE PLAYED --> converting to search\n");
+                PonderHit();
                 g_Options.fSuccessfulPonder = TRUE;
                 g_Options.fPondering = FALSE;
                 g_Options.fThinking = TRUE;
@@ -2603,6 +2681,7 @@ Return value:
                 goto consume_if_searching;
             } else {
                 g_MoveTimer.bvFlags |= TIMER_STOPPING;
+                PonderMiss(FLIP(GET_COLOR(mv.pMoved)));
                 if (TRUE == OfficiallyMakeMove(mv, 0, FALSE))
                 {
                     Trace("NONPREDICTED MOVE PLAYED --> stop pondering now\n");
@@ -2610,7 +2689,7 @@ Return value:
                 } else {
                     UtilPanic(GOT_ILLEGAL_MOVE_WHILE_PONDERING,
                               GetRootPosition(),
-                              (void *)mv.uMove,
+                              (void *)(uintptr_t)mv.uMove,
                               NULL,
                               NULL,
                               __FILE__, __LINE__);
@@ -2621,7 +2700,7 @@ Return value:
             {
                 UtilPanic(CANNOT_OFFICIALLY_MAKE_MOVE,
                           GetRootPosition(),
-                          (void *)mv.uMove,
+                          (void *)(uintptr_t)mv.uMove,
                           NULL,
                           NULL,
                           __FILE__, __LINE__);
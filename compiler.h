@@ -24,6 +24,7 @@ Revision History:
 #if defined _MSC_VER
 
 #include <io.h>
+#include <stddef.h>
 
 #pragma warning(disable:4201) // nonstandard extension: nameless struct/union
 #pragma warning(disable:4214) // nonstandard extension: bitfields struct
@@ -51,6 +52,8 @@ Revision History:
 #elif defined __GNUC__
 
 #include <unistd.h>
+#include <stddef.h>
+#include <stdint.h>
 
 extern int errno;
 
@@ -65,10 +68,13 @@ extern int errno;
 #define ALIGN64 // __attribute__ (aligned(64)) does not work
 #define COMPILER_LONGLONG          long long
 #define COMPILER_VSNPRINTF         vsnprintf
-#ifndef SIXTYFOUR
+#if defined(__i386__)
 #define CDECL                      __attribute__((cdecl))
-#endif
 #define FASTCALL                   __attribute__((__regparm__(3)))
+#else
+#define CDECL
+#define FASTCALL
+#endif
 #define INLINE                     __inline__
 #define FORCEINLINE                __attribute__((always_inline))
 #define NORETURN                   __attribute__((noreturn))
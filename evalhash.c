@@ -22,6 +22,154 @@ Revision History:
 #ifdef EVAL_HASH
 
 extern ULONG g_uIterateDepth;
+ULONG g_uEvalHashTableSizeEntries = 0;
+static EVAL_HASH_ENTRY *g_pEvalHashTables[MAX_SEARCHER_THREADS];
+static ULONG g_uNumEvalHashTables = 0;
+
+//
+// Entries are stored with their key XORed with their data words so
+// that, when the table is shared between threads, a reader can detect
+// an entry torn by a concurrent writer without taking a lock.
+//
+#define EVAL_HASH_ENTRY_CHECKSUM(e) ((e).u.u64Data[0] ^ (e).u.u64Data[1])
+
+FLAG
+InitializeEvalHashSystem(void)
+/*++
+
+Routine description:
+
+    Allocate the eval hash table(s): one per searcher thread or, if
+    the user asked for --sharedevalhash, a single table that every
+    thread probes.
+
+Parameters:
+
+    void
+
+Return value:
+
+    FLAG
+
+--*/
+{
+    ULONG u;
+
+    if (!IS_A_POWER_OF_2(g_Options.uNumEvalHashEntries))
+    {
+        return(FALSE);
+    }
+    g_uEvalHashTableSizeEntries = g_Options.uNumEvalHashEntries;
+    g_uNumEvalHashTables = 1;
+#ifdef MP
+    if (FALSE == g_Options.fSharedEvalHash)
+    {
+        g_uNumEvalHashTables = g_Options.uNumProcessors;
+    }
+#endif
+    ASSERT(g_uNumEvalHashTables <= MAX_SEARCHER_THREADS);
+    for (u = 0; u < g_uNumEvalHashTables; u++)
+    {
+        ASSERT(g_pEvalHashTables[u] == NULL);
+        g_pEvalHashTables[u] = 
+            SystemAllocateMemory(g_uEvalHashTableSizeEntries *
+                                 sizeof(EVAL_HASH_ENTRY));
+    }
+    ClearEvalHashTables();
+    return(TRUE);
+}
+
+
+void
+CleanupEvalHashSystem(void)
+/*++
+
+Routine description:
+
+    Free the eval hash table(s).
+
+Parameters:
+
+    void
+
+Return value:
+
+    void
+
+--*/
+{
+    ULONG u;
+
+    for (u = 0; u < g_uNumEvalHashTables; u++)
+    {
+        if (NULL != g_pEvalHashTables[u])
+        {
+            SystemFreeMemory(g_pEvalHashTables[u]);
+            g_pEvalHashTables[u] = NULL;
+        }
+    }
+    g_uNumEvalHashTables = 0;
+    g_uEvalHashTableSizeEntries = 0;
+}
+
+
+void
+ClearEvalHashTables(void)
+/*++
+
+Routine description:
+
+    Zero out the eval hash table(s).  Called when a new game starts
+    and when the eval weights change underneath the cached scores.
+
+Parameters:
+
+    void
+
+Return value:
+
+    void
+
+--*/
+{
+    ULONG u;
+
+    for (u = 0; u < g_uNumEvalHashTables; u++)
+    {
+        memset(g_pEvalHashTables[u], 0,
+               g_uEvalHashTableSizeEntries * sizeof(EVAL_HASH_ENTRY));
+    }
+}
+
+
+EVAL_HASH_ENTRY *
+GetEvalHashTable(ULONG uThreadNumber)
+/*++
+
+Routine description:
+
+    Return the eval hash table that searcher thread number
+    uThreadNumber should use.  NULL if the tables are not allocated
+    yet; only eval cares.
+
+Parameters:
+
+    ULONG uThreadNumber
+
+Return value:
+
+    EVAL_HASH_ENTRY *
+
+--*/
+{
+    if (uThreadNumber >= g_uNumEvalHashTables)
+    {
+        ASSERT(g_uNumEvalHashTables <= 1);
+        uThreadNumber = 0;
+    }
+    return(g_pEvalHashTables[uThreadNumber]);
+}
+
 
 SCORE 
 GetRoughEvalScore(IN OUT SEARCHER_THREAD_CONTEXT *ctx, 
@@ -44,7 +192,9 @@ Routine description:
     2. Otherwise possibly probe the eval hash -- if there's a score in
     it then we can return quickly.
     
-    3. Otherwise do a (very) rough material estimate.
+    3. Otherwise do a (very) rough estimate: material and the
+    incrementally maintained piece square terms plus the last known
+    size of the positional component.
 
 Parameters:
 
@@ -60,8 +210,10 @@ Return value:
 --*/
 {
     POSITION *pos = &(ctx->sPosition);
+    EVAL_HASH_ENTRY e;
     UINT64 u64Key;
     ULONG u;
+    SCORE iPsqt;
 
     if (ctx->uPly <= 4)
     {
@@ -70,14 +222,18 @@ Return value:
     else if ((fUseHash) || (ctx->uPly <= (g_uIterateDepth / 2)))
     {
         u64Key = (pos->u64PawnSig ^ pos->u64NonPawnSig);
-        u = (ULONG)u64Key & (EVAL_HASH_TABLE_SIZE - 1);
-        if (ctx->rgEvalHash[u].u64Key == u64Key)
+        u = (ULONG)u64Key & (g_uEvalHashTableSizeEntries - 1);
+        e = ctx->pEvalHash[u];
+        if ((e.u64Key ^ EVAL_HASH_ENTRY_CHECKSUM(e)) == u64Key)
         {
-            ctx->uPositional = ctx->rgEvalHash[u].uPositional;
-            return(ctx->rgEvalHash[u].iEval);
+            ctx->uPositional = e.u.s.uPositional;
+            return(e.u.s.iEval);
         }
     }
-    return(pos->iMaterialBalance[pos->uToMove] + ctx->uPositional);
+    u = GAME_PHASE(pos);
+    iPsqt = (TAPERED_PSQT(pos, pos->uToMove, u) -
+             TAPERED_PSQT(pos, FLIP(pos->uToMove), u));
+    return(pos->iMaterialBalance[pos->uToMove] + iPsqt + ctx->uPositional);
 }
 
 
@@ -103,14 +259,15 @@ Return value:
 {
     POSITION *pos = &(ctx->sPosition);
     UINT64 u64Key = (pos->u64PawnSig ^ pos->u64NonPawnSig);
-    ULONG u = (ULONG)u64Key & (EVAL_HASH_TABLE_SIZE - 1);
+    ULONG u = (ULONG)u64Key & (g_uEvalHashTableSizeEntries - 1);
+    EVAL_HASH_ENTRY e = ctx->pEvalHash[u];
 
-    if (ctx->rgEvalHash[u].u64Key == u64Key)
+    if ((e.u64Key ^ EVAL_HASH_ENTRY_CHECKSUM(e)) == u64Key)
     {
-        ctx->uPositional = ctx->rgEvalHash[u].uPositional;
-        pos->cTrapped[WHITE] = ctx->rgEvalHash[u].cTrapped[WHITE];
-        pos->cTrapped[BLACK] = ctx->rgEvalHash[u].cTrapped[BLACK];
-        return(ctx->rgEvalHash[u].iEval);
+        ctx->uPositional = e.u.s.uPositional;
+        pos->cTrapped[WHITE] = e.u.s.cTrapped[WHITE];
+        pos->cTrapped[BLACK] = e.u.s.cTrapped[BLACK];
+        return(e.u.s.iEval);
     }
     return(INVALID_SCORE);
 }
@@ -123,7 +280,7 @@ StoreEvalHash(IN OUT SEARCHER_THREAD_CONTEXT *ctx,
 Routine description:
 
     Store a score in the eval hash table (which is pointed to
-    indirectly via ctx).
+    indirectly via ctx and may be shared with other threads).
 
 Parameters:
 
@@ -138,11 +295,14 @@ Return value:
 {
     POSITION *pos = &(ctx->sPosition);
     UINT64 u64Key = (pos->u64PawnSig ^ pos->u64NonPawnSig);
-    ULONG u = (ULONG)u64Key & (EVAL_HASH_TABLE_SIZE - 1);
-    ctx->rgEvalHash[u].u64Key = u64Key;
-    ctx->rgEvalHash[u].iEval = iScore;
-    ctx->rgEvalHash[u].uPositional = ctx->uPositional;
-    ctx->rgEvalHash[u].cTrapped[WHITE] = pos->cTrapped[WHITE];
-    ctx->rgEvalHash[u].cTrapped[BLACK] = pos->cTrapped[BLACK];
+    ULONG u = (ULONG)u64Key & (g_uEvalHashTableSizeEntries - 1);
+    EVAL_HASH_ENTRY e;
+
+    e.u.s.iEval = iScore;
+    e.u.s.uPositional = ctx->uPositional;
+    e.u.s.cTrapped[WHITE] = pos->cTrapped[WHITE];
+    e.u.s.cTrapped[BLACK] = pos->cTrapped[BLACK];
+    e.u64Key = u64Key ^ EVAL_HASH_ENTRY_CHECKSUM(e);
+    ctx->pEvalHash[u] = e;
 }
 #endif // EVAL_HASH
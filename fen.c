@@ -702,6 +702,8 @@ Return value:
 
     p->u64NonPawnSig = ComputeSig(p);
     p->u64PawnSig = ComputePawnSig(p);
+    p->u64MaterialSig = ComputeMaterialSig(p);
+    ComputePsqt(p);
     p->iMaterialBalance[WHITE] =
         ((SCORE)(p->uNonPawnMaterial[WHITE] + p->uPawnMaterial[WHITE]) -
          (SCORE)(p->uNonPawnMaterial[BLACK] + p->uPawnMaterial[BLACK]));
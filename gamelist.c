@@ -229,6 +229,29 @@ Return value:
     g_GameData.sHeader.result.eResult = RESULT_IN_PROGRESS;
 }
 
+void
+RecomputeRootPositionPsqt(void)
+/**
+
+Routine description:
+
+    The eval's piece square tables changed (e.g. new DNA was loaded)
+    so recompute the root position's piece square accumulators to
+    match them.
+
+Parameters:
+
+    void
+
+Return value:
+
+    void
+
+**/
+{
+    ComputePsqt(&g_RootPosition);
+}
+
 FLAG 
 SetRootPosition(CHAR *szFen)
 /**
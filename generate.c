@@ -430,19 +430,19 @@ Return value:
 {
     PIECE pMoved = pos->rgSquare[cFrom].pPiece;
     ULONG uPly = pStack->uPly;
-    MOVE_STACK_MOVE_VALUE_FLAGS *pMvf;
+    MOVE *pMv;
 
     ASSERT(pMoved);
     ASSERT(GET_COLOR(pMoved) == pos->uToMove);
     ASSERT(IS_ON_BOARD(cFrom));
     ASSERT(IS_ON_BOARD(cTo));
 
-    pMvf = &(pStack->mvf[pStack->uEnd[uPly]]);
-    pMvf->mv.uMove = MAKE_MOVE_WITH_NO_PROM_OR_FLAGS(cFrom, cTo, pMoved, pCap);
+    pMv = &(pStack->mv[pStack->uEnd[uPly]]);
+    pMv->uMove = MAKE_MOVE_WITH_NO_PROM_OR_FLAGS(cFrom, cTo, pMoved, pCap);
     pStack->uEnd[uPly]++;
 
-    ASSERT(pMvf->mv.uMove == MAKE_MOVE(cFrom, cTo, pMoved, pCap, 0, 0));
-    ASSERT(SanityCheckMove(pos, pMvf->mv));
+    ASSERT(pMv->uMove == MAKE_MOVE(cFrom, cTo, pMoved, pCap, 0, 0));
+    ASSERT(SanityCheckMove(pos, *pMv));
 }
 
 
@@ -473,7 +473,7 @@ Return value:
     PIECE pMoved = BLACK_PAWN | pos->uToMove;
     PIECE pCaptured = FLIP(pMoved);
     ULONG uPly = pStack->uPly;
-    MOVE_STACK_MOVE_VALUE_FLAGS *pMvf;
+    MOVE *pMv;
 
     ASSERT(pCaptured == (BLACK_PAWN | (FLIP(pos->uToMove))));
     ASSERT(IS_ON_BOARD(cFrom));
@@ -483,12 +483,12 @@ Return value:
     ASSERT(IS_PAWN(pos->rgSquare[cFrom].pPiece));
     ASSERT(GET_COLOR(pos->rgSquare[cFrom].pPiece) == pos->uToMove);
 
-    pMvf = &(pStack->mvf[pStack->uEnd[uPly]]);
-    pMvf->mv.uMove =
+    pMv = &(pStack->mv[pStack->uEnd[uPly]]);
+    pMv->uMove =
         MAKE_MOVE(cFrom, cTo, pMoved, pCaptured, 0, MOVE_FLAG_SPECIAL);
     pStack->uEnd[uPly]++;
 
-    ASSERT(SanityCheckMove(pos, pMvf->mv));
+    ASSERT(SanityCheckMove(pos, *pMv));
 }
 
 
@@ -518,7 +518,7 @@ Return value:
 {
     PIECE pMoved = BLACK_KING | pos->uToMove;
     ULONG uPly = pStack->uPly;
-    MOVE_STACK_MOVE_VALUE_FLAGS *pMvf;
+    MOVE *pMv;
 
     ASSERT(IS_ON_BOARD(cFrom));
     ASSERT(IS_ON_BOARD(cTo));
@@ -526,11 +526,11 @@ Return value:
     ASSERT(IS_KING(pos->rgSquare[cFrom].pPiece));
     ASSERT(GET_COLOR(pos->rgSquare[cFrom].pPiece) == pos->uToMove);
 
-    pMvf = &(pStack->mvf[pStack->uEnd[uPly]]);
-    pMvf->mv.uMove = MAKE_MOVE(cFrom, cTo, pMoved, 0, 0, MOVE_FLAG_SPECIAL);
+    pMv = &(pStack->mv[pStack->uEnd[uPly]]);
+    pMv->uMove = MAKE_MOVE(cFrom, cTo, pMoved, 0, 0, MOVE_FLAG_SPECIAL);
     pStack->uEnd[uPly]++;
 
-    ASSERT(SanityCheckMove(pos, pMvf->mv));
+    ASSERT(SanityCheckMove(pos, *pMv));
 }
 
 
@@ -564,7 +564,7 @@ Return value:
     PIECE pMoved = BLACK_PAWN | pos->uToMove;
     PIECE pCaptured = pos->rgSquare[cTo].pPiece;
     ULONG uPly = pStack->uPly;
-    MOVE_STACK_MOVE_VALUE_FLAGS *pMvf;
+    MOVE *pMv;
     ULONG u;
 
 #define ARRAY_LENGTH_TARG (4)
@@ -582,11 +582,11 @@ Return value:
 
     for (u = 0; u < ARRAY_LENGTH_TARG; u++)
     {
-        pMvf = &(pStack->mvf[pStack->uEnd[uPly]]);
-        pMvf->mv.uMove = MAKE_MOVE(cFrom, cTo, pMoved, pCaptured,
+        pMv = &(pStack->mv[pStack->uEnd[uPly]]);
+        pMv->uMove = MAKE_MOVE(cFrom, cTo, pMoved, pCaptured,
                                    pTarg[u] | pos->uToMove, MOVE_FLAG_SPECIAL);
         pStack->uEnd[uPly]++;
-        ASSERT(SanityCheckMove(pos, pMvf->mv));
+        ASSERT(SanityCheckMove(pos, *pMv));
     }
 #undef ARRAY_LENGTH_TARG
 }
@@ -618,7 +618,7 @@ Return value:
 {
     PIECE pMoved = BLACK_PAWN | pos->uToMove;
     ULONG uPly = pStack->uPly;
-    MOVE_STACK_MOVE_VALUE_FLAGS *pMvf;
+    MOVE *pMv;
 
     ASSERT(IS_ON_BOARD(cFrom));
     ASSERT(IS_ON_BOARD(cTo));
@@ -626,11 +626,11 @@ Return value:
     ASSERT(RANK4(cTo) || RANK5(cTo));
     ASSERT(IS_PAWN(pos->rgSquare[cFrom].pPiece));
 
-    pMvf = &(pStack->mvf[pStack->uEnd[uPly]]);
-    pMvf->mv.uMove = MAKE_MOVE(cFrom, cTo, pMoved, 0, 0, MOVE_FLAG_SPECIAL);
+    pMv = &(pStack->mv[pStack->uEnd[uPly]]);
+    pMv->uMove = MAKE_MOVE(cFrom, cTo, pMoved, 0, 0, MOVE_FLAG_SPECIAL);
     pStack->uEnd[uPly]++;
 
-    ASSERT(SanityCheckMove(pos, pMvf->mv));
+    ASSERT(SanityCheckMove(pos, *pMv));
 }
 
 
@@ -2450,11 +2450,10 @@ Return value:
     ULONG u;
     MOVE mv;
     SCORE s;
-    MOVE_STACK_MOVE_VALUE_FLAGS mvf;
     ULONG uHashMoveLoc = (ULONG)-1;
     ULONG uColor = pos->uToMove;
     PRECOMP_KILLERS sKillers[4];
-    COOR cEnprise = GetEnprisePiece(pos, uColor);
+    COOR cEnprise = GetEnprisePiece(ctx, uColor);
 
     //
     // We have generated all moves here.  We also know that we are not
@@ -2498,14 +2497,14 @@ Return value:
          u < pStack->uEnd[uPly];
          u++)
     {
-        mv = pStack->mvf[u].mv;
+        mv = pStack->mv[u];
         ASSERT(mv.uMove);
         ASSERT(GET_COLOR(mv.pMoved) == uColor);
         if (!IS_SAME_MOVE(mv, mvHash))
         {
 #ifdef DEBUG
-            pStack->mvf[u].iValue = -MAX_INT;
-            pStack->mvf[u].bvFlags = 0;
+            pStack->iValue[u] = -MAX_INT;
+            pStack->bvFlags[u] = 0;
 #endif
             //
             // 1. Hash move (already handled by search, all we have to
@@ -2572,8 +2571,8 @@ Return value:
                       (mv.cFrom == cEnprise));
                 ASSERT(s >= 0);
             }
-            pStack->mvf[u].iValue = s;
-            ASSERT(pStack->mvf[u].iValue != -MAX_INT);
+            pStack->iValue[u] = s;
+            ASSERT(pStack->iValue[u] != -MAX_INT);
         }
         else
         {
@@ -2581,7 +2580,7 @@ Return value:
             uHashMoveLoc = u;
 #ifdef DEBUG
             ASSERT((mv.cFrom == mvHash.cFrom) && (mv.cTo == mvHash.cTo));
-            pStack->mvf[u].bvFlags |= MVF_MOVE_SEARCHED;
+            pStack->bvFlags[u] |= MVF_MOVE_SEARCHED;
 #endif
         }
 
@@ -2597,10 +2596,10 @@ Return value:
         ASSERT(MOVE_COUNT(ctx, uPly) >= 1);
         ASSERT(uHashMoveLoc >= pStack->uBegin[uPly]);
         ASSERT(uHashMoveLoc < pStack->uEnd[uPly]);
-        mvf = pStack->mvf[uHashMoveLoc];
-        pStack->mvf[uHashMoveLoc] = pStack->mvf[pStack->uEnd[uPly] - 1];
 #ifdef DEBUG
-        pStack->mvf[pStack->uEnd[uPly] - 1] = mvf;
+        SWAP_MOVE_STACK_ENTRIES(pStack, uHashMoveLoc, pStack->uEnd[uPly] - 1);
+#else
+        COPY_MOVE_STACK_ENTRY(pStack, uHashMoveLoc, pStack->uEnd[uPly] - 1);
 #endif
         pStack->uEnd[uPly]--;
     }
@@ -2636,7 +2635,6 @@ Return value:
     ULONG u;
     MOVE mv;
     SCORE s;
-    MOVE_STACK_MOVE_VALUE_FLAGS mvf;
     ULONG uHashMoveLoc = (ULONG)-1;
     COOR c;
     ULONG v;
@@ -2657,16 +2655,16 @@ Return value:
          u < pStack->uEnd[uPly];
          u++)
     {
-        mv = pStack->mvf[u].mv;
+        mv = pStack->mv[u];
         ASSERT(mv.uMove);
         ASSERT(GET_COLOR(mv.pMoved) == pos->uToMove);
         if (!IS_SAME_MOVE(mv, mvHash))
         {
 #ifdef DEBUG
-            pStack->mvf[u].iValue = -MAX_INT;
-            pStack->mvf[u].bvFlags = 0;
+            pStack->iValue[u] = -MAX_INT;
+            pStack->bvFlags[u] = 0;
 #endif
-            pStack->mvf[u].mv.bvFlags |= MOVE_FLAG_ESCAPING_CHECK;
+            pStack->mv[u].bvFlags |= MOVE_FLAG_ESCAPING_CHECK;
 
             //
             // 1. Hash move (already handled by search, all we have to
@@ -2778,8 +2776,8 @@ Return value:
                     }
                 }
             }
-            pStack->mvf[u].iValue = s;
-            ASSERT(pStack->mvf[u].iValue != -MAX_INT);
+            pStack->iValue[u] = s;
+            ASSERT(pStack->iValue[u] != -MAX_INT);
         }
         else
         {
@@ -2787,7 +2785,7 @@ Return value:
             uHashMoveLoc = u;
 #ifdef DEBUG
             ASSERT((mv.cFrom == mvHash.cFrom) && (mv.cTo == mvHash.cTo));
-            pStack->mvf[u].bvFlags |= MVF_MOVE_SEARCHED;
+            pStack->bvFlags[u] |= MVF_MOVE_SEARCHED;
 #endif
         }
     } // next move
@@ -2802,10 +2800,10 @@ Return value:
         ASSERT(MOVE_COUNT(ctx, uPly) >= 1);
         ASSERT(uHashMoveLoc >= pStack->uBegin[uPly]);
         ASSERT(uHashMoveLoc < pStack->uEnd[uPly]);
-        mvf = pStack->mvf[uHashMoveLoc];
-        pStack->mvf[uHashMoveLoc] = pStack->mvf[pStack->uEnd[uPly] - 1];
 #ifdef DEBUG
-        pStack->mvf[pStack->uEnd[uPly] - 1] = mvf;
+        SWAP_MOVE_STACK_ENTRIES(pStack, uHashMoveLoc, pStack->uEnd[uPly] - 1);
+#else
+        COPY_MOVE_STACK_ENTRY(pStack, uHashMoveLoc, pStack->uEnd[uPly] - 1);
 #endif
         pStack->uEnd[uPly]--;
     }
@@ -2851,7 +2849,7 @@ Return value:
     MOVE mv;
     MOVE mvLast = (pi-1)->mv;
     SCORE s;
-    COOR cEnprise = GetEnprisePiece(pos, uColor);
+    COOR cEnprise = GetEnprisePiece(ctx, uColor);
 
     //
     // We have generate all moves or just legal escapes from check
@@ -2868,13 +2866,13 @@ Return value:
          u < pStack->uEnd[uPly];
          u++)
     {
-        mv = pStack->mvf[u].mv;
+        mv = pStack->mv[u];
         ASSERT(GET_COLOR(mv.pMoved) == uColor);
 #ifdef DEBUG
-        pStack->mvf[u].iValue = -MAX_INT;
-        pStack->mvf[u].bvFlags = 0;
+        pStack->iValue[u] = -MAX_INT;
+        pStack->bvFlags[u] = 0;
 #endif
-        pStack->mvf[u].mv.bvFlags |= WouldGiveCheck(ctx, mv);
+        pStack->mv[u].bvFlags |= WouldGiveCheck(ctx, mv);
 
         //
         // 1. There can't be a hash move so don't worry about it
@@ -2912,7 +2910,7 @@ Return value:
                 //
                 // Bonus if it checks too
                 //
-                s += (pStack->mvf[u].mv.bvFlags & MOVE_FLAG_CHECKING) * 4;
+                s += (pStack->mv[u].bvFlags & MOVE_FLAG_CHECKING) * 4;
 
                 //
                 // Bonus for capturing last moved enemy piece.
@@ -2929,7 +2927,7 @@ Return value:
                 // to bail as soon as it sees the first zero so no
                 // need to keep real SEE scores on these.
                 //
-                s = (pStack->mvf[u].mv.bvFlags & MOVE_FLAG_CHECKING);
+                s = (pStack->mv[u].bvFlags & MOVE_FLAG_CHECKING);
                 ASSERT(s >= 0);
             }
         }
@@ -2939,7 +2937,7 @@ Return value:
         //
         else
         {
-            s = (pStack->mvf[u].mv.bvFlags & MOVE_FLAG_CHECKING) * 2;
+            s = (pStack->mv[u].bvFlags & MOVE_FLAG_CHECKING) * 2;
             ASSERT(s >= 0);
             ASSERT(s < SORT_THESE_FIRST);
         }
@@ -2950,13 +2948,13 @@ Return value:
         //
         if (s > 0)
         {
-            ASSERT(IS_CAPTURE_OR_PROMOTION(pStack->mvf[u].mv) ||
-                   IS_CHECKING_MOVE(pStack->mvf[u].mv));
+            ASSERT(IS_CAPTURE_OR_PROMOTION(pStack->mv[u]) ||
+                   IS_CHECKING_MOVE(pStack->mv[u]));
             s += (mv.cFrom == cEnprise) * (PIECE_VALUE(mv.pMoved) / 4);
             ASSERT(s > 0);
         }
-        pStack->mvf[u].iValue = s;
-        ASSERT(pStack->mvf[u].iValue != -MAX_INT);
+        pStack->iValue[u] = s;
+        ASSERT(pStack->iValue[u] != -MAX_INT);
 
     } // next move
 }
@@ -3015,11 +3013,11 @@ Return value:
          u < pStack->uEnd[uPly];
          u++)
     {
-        mv = pStack->mvf[u].mv;
+        mv = pStack->mv[u];
         ASSERT(GET_COLOR(mv.pMoved) == uColor);
 #ifdef DEBUG
-        pStack->mvf[u].iValue = -MAX_INT;
-        pStack->mvf[u].bvFlags = 0;
+        pStack->iValue[u] = -MAX_INT;
+        pStack->bvFlags[u] = 0;
 #endif
         //
         // 1. There can't be a hash move so don't worry about it
@@ -3063,8 +3061,8 @@ Return value:
                 ASSERT(s > 0);
             }
         }
-        pStack->mvf[u].iValue = s;
-        ASSERT(pStack->mvf[u].iValue != -MAX_INT);
+        pStack->iValue[u] = s;
+        ASSERT(pStack->iValue[u] != -MAX_INT);
 
     } // next move
 }
@@ -3094,7 +3092,7 @@ Parameters:
 
        OUT: ctx->sMoveStack.uBegin[ctx->uPly] is set,
             ctx->sMoveStack.uEnd[ctx->uPly] is set,
-            ctx->sMoveStack.mvf[begin..end] are populated
+            ctx->sMoveStack.mv/iValue/bvFlags[begin..end] are populated
 
     MOVE mvHash : the hash move to not generate
 
@@ -3152,6 +3150,7 @@ Return value:
     pStack->uPly = uPly;
     pStack->uEnd[uPly] = pStack->uBegin[uPly];
     pStack->sGenFlags[uPly].uAllGenFlags = 0;
+    INC(ctx->sCounters.movepick.u64Generates);
     
     switch(uType)
     {
@@ -3196,7 +3195,7 @@ Return value:
                      uReturn < pStack->uEnd[uPly];
                      uReturn++)
                 {
-                    pStack->mvf[uReturn].mv.bvFlags |=
+                    pStack->mv[uReturn].bvFlags |=
                         MOVE_FLAG_ESCAPING_CHECK;
                 }
             }
@@ -3221,7 +3220,7 @@ Return value:
          u < pStack->uEnd[uPly];
          u++)
     {
-        mv = pStack->mvf[u].mv;
+        mv = pStack->mv[u];
         ASSERT(!IS_SAME_MOVE(mv, mvHash));
         SanityCheckMove(pos, mv);
 
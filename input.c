@@ -15,6 +15,11 @@ Abstract:
     because: 1. I see no performance reason to make all threads able
     to consume input and 2. it makes the locking assumptions easier.
 
+    Pushing an event signals g_uInputEvent, which a reader blocked on
+    an empty queue is waiting on, and raises TIMER_INPUT_PENDING so
+    that a running search notices it at its very next node instead of
+    at the move timer's next tick.
+
 Author:
 
     Scott Gasch (scott.gasch@gmail.com) 14 May 2004
@@ -27,61 +32,127 @@ Revision History:
 
 #include "chess.h"
 
-DLIST_ENTRY g_InputEventList;
-volatile static ULONG g_uInputLock;
+//
+// Input events live in a ring of string pointers.  The input thread
+// is the producer and the main engine thread is the only consumer so
+// the consumer side (Peek/Read/NumberOfPending) takes no lock at all:
+// an event is published by bumping g_uNumInputEvents with an
+// interlocked op after its slot is filled and released the same way
+// after its slot is emptied.  The main thread occasionally pushes
+// input too (the initial command, scripts, the analysis server) so
+// producers serialize among themselves with g_uInputProducerLock.
+//
+#define INPUT_RING_SIZE          (1024)   // must be a power of two
+#define INPUT_RING_MASK          (INPUT_RING_SIZE - 1)
+#define INPUT_WAIT_MS            (100)
+
+static CHAR *volatile g_szInputRing[INPUT_RING_SIZE];
+static ULONG g_uInputHead;                    // consumer's next slot
+static ULONG g_uInputTail;                    // producer's next slot
+volatile static ULONG g_uInputProducerLock;
 extern CHAR g_szInitialCommand[SMALL_STRING_LEN_CHAR];
 
-#define INPUT_IS_LOCKED (g_uInputLock != 0)
-#define LOCK_INPUT \
-    AcquireSpinLock(&g_uInputLock); \
-    ASSERT(INPUT_IS_LOCKED);
-#define UNLOCK_INPUT \
-    ASSERT(INPUT_IS_LOCKED); \
-    ReleaseSpinLock(&g_uInputLock); 
 volatile FLAG g_fExitProgram = FALSE;
 volatile ULONG g_uNumInputEvents;
 
-typedef struct _INPUT_EVENT
-{
-    DLIST_ENTRY links;
-    CHAR *szInput;
-}
-INPUT_EVENT;
-
-ULONG g_uBlockingInputLock = 0;
+//
+// Signalled once per event pushed so that a reader blocked on an
+// empty queue wakes up right away.
+//
+ULONG g_uInputEvent = (ULONG)-1;
 
 static void 
 _WaitUntilTheresInputToRead(void) 
 {
-    if (g_uBlockingInputLock != (ULONG)-1) 
+    if (g_uInputEvent != (ULONG)-1) 
     {
-        SystemObtainSemaphoreResource(g_uBlockingInputLock);
-        SystemReleaseSemaphoreResource(g_uBlockingInputLock);
+        (void)SystemWaitForEvent(g_uInputEvent, INPUT_WAIT_MS);
     }
     else 
     {
-        SystemDeferExecution(100);
+        SystemDeferExecution(INPUT_WAIT_MS);
     }
 }
 
 
-static void 
-_UnblockBlockedReaders(void) 
+static void
+_EnqueueInput(CHAR *szInput)
+/**
+
+Routine description:
+
+    Put one input event on the tail of the ring, wake up anyone
+    waiting for input and tell a running search that there's input
+    for it to look at right away rather than at the next move timer
+    tick.
+
+Parameters:
+
+    CHAR *szInput : the event, allocated by the caller
+
+Return value:
+
+    static void
+
+**/
 {
-    if (g_uBlockingInputLock != (ULONG)-1)
+    AcquireSpinLock(&g_uInputProducerLock);
+    while (g_uNumInputEvents >= INPUT_RING_SIZE)
+    {
+        //
+        // The ring is full; the engine is way behind.  Wait for it to
+        // catch up rather than dropping input.
+        //
+        ReleaseSpinLock(&g_uInputProducerLock);
+        SystemDeferExecution(1);
+        AcquireSpinLock(&g_uInputProducerLock);
+    }
+    ASSERT(NULL == g_szInputRing[g_uInputTail & INPUT_RING_MASK]);
+    g_szInputRing[g_uInputTail & INPUT_RING_MASK] = szInput;
+    g_uInputTail++;
+    (void)LockIncrement(&g_uNumInputEvents);
+    ReleaseSpinLock(&g_uInputProducerLock);
+
+    if (g_uInputEvent != (ULONG)-1)
     {
-        SystemReleaseSemaphoreResource(g_uBlockingInputLock);
+        SystemSignalEvent(g_uInputEvent);
     }
+    SetMoveTimerFlag(TIMER_INPUT_PENDING);
 }
 
 
-static void 
-_BlockBlockingReaders(void) 
+static void
+_FreeQueuedInput(void)
+{
+    CHAR *p;
+
+    while (NULL != (p = ReadNextInput()))
+    {
+        SystemFreeMemory(p);
+    }
+}
+
+
+static FLAG
+_LooksLikeEpdRecord(CHAR *p)
 {
-    if (g_uBlockingInputLock != (ULONG)-1)
+    ULONG uSlashes = 0;
+
+    while ((*p) && (isspace(*p))) p++;
+    while ((*p) && (!isspace(*p)))
     {
-        SystemObtainSemaphoreResource(g_uBlockingInputLock);
+        if (*p == '/')
+        {
+            uSlashes++;
+        }
+        else if ((NULL == strchr("pnbrqkPNBRQK", *p)) &&
+                 ((*p < '1') || (*p > '8')))
+        {
+            return(FALSE);
+        }
+        p++;
     }
+    return(uSlashes == 7);
 }
 
 
@@ -104,20 +175,24 @@ Return value:
 
 **/
 {
-    INPUT_EVENT *pEvent;
+    CHAR *szEvent;
     FLAG fDone = FALSE;
     FLAG fInQuote, fSemi;
+    FLAG fEpd, fQuit;
     CHAR *p;
     CHAR *q;
-    
+
+    //
+    // An EPD record uses semi-colons to terminate its opcodes so never
+    // split a line that begins with a position.
+    //
+    fEpd = _LooksLikeEpdRecord(buf);
     do
     {
-        pEvent = (INPUT_EVENT *)SystemAllocateMemory(sizeof(INPUT_EVENT));
-        
         // 
         // Note: you can specify more than one command per line using
-        // a semi-colon to separate them.  If the semi-colon is quoted,
-        // though, ignore it.
+        // a semi-colon to separate them.  If the semi-colon is quoted
+        // or part of an EPD record, though, ignore it.
         //
         fInQuote = FALSE;
         fSemi = FALSE;
@@ -127,7 +202,7 @@ Return value:
             switch(*p)
             {
                 case ';':
-                    if (FALSE == fInQuote)
+                    if ((FALSE == fInQuote) && (FALSE == fEpd))
                     {
                         *p = '\0';
                         fSemi = TRUE;
@@ -150,33 +225,30 @@ Return value:
             }
         }
         while((FALSE == fDone) && (FALSE == fSemi));
-        pEvent->szInput = STRDUP(buf);
-        
-        //
-        // Push it onto the queue
-        //
-        LOCK_INPUT;
-        InsertTailList(&g_InputEventList, &(pEvent->links));
-        g_uNumInputEvents++;
-        if (g_uNumInputEvents == 1) 
-        {
-            _UnblockBlockedReaders();
-        }
-        q = pEvent->szInput;
+        szEvent = STRDUP(buf);
+        q = szEvent;
         ASSERT(q);
         while(*q && isspace(*q)) q++;
 #ifdef DEBUG
         Trace("INPUT THREAD SAW (event %u): %s", 
-              g_uNumInputEvents, 
-              pEvent->szInput);
+              g_uNumInputEvents + 1, 
+              szEvent);
 #endif
-        if (!STRNCMPI("quit", q, 4)) 
+        fQuit = (!STRNCMPI("quit", q, 4));
+
+        //
+        // Push it onto the queue
+        //
+        _EnqueueInput(szEvent);
+        if (TRUE == fQuit) 
         {
             g_fExitProgram = TRUE;
-            UNLOCK_INPUT;
+            if (g_uInputEvent != (ULONG)-1)
+            {
+                SystemSignalEvent(g_uInputEvent);
+            }
             return;
         }
-        UNLOCK_INPUT;
 
         buf = (p + 1);
     }
@@ -208,15 +280,14 @@ Return value:
     setbuf(stdin, NULL);
     setbuf(stderr, NULL);
     
-    g_uBlockingInputLock = SystemCreateSemaphore(1);
-    if (g_uBlockingInputLock == (ULONG)-1) 
+    g_uInputEvent = SystemCreateEvent();
+    if (g_uInputEvent == (ULONG)-1) 
     {
-        Bug("_InitInputSystemCommonCode: Failed to create input semaphore.\n");
+        Bug("_InitInputSystemCommonCode: Failed to create input event.\n");
     }
     g_uNumInputEvents = 0;
-    _BlockBlockingReaders();
-    InitializeListHead(&g_InputEventList);
-    g_uInputLock = 0;
+    g_uInputHead = g_uInputTail = 0;
+    g_uInputProducerLock = 0;
     if (g_szInitialCommand[0] != '\0')
     {
         Trace("INPUT SYSTEM INIT: Pushing \"%s\"\n", g_szInitialCommand);
@@ -281,8 +352,6 @@ Return value:
 **/
 {
     static CHAR buf[SMALL_STRING_LEN_CHAR];
-    INPUT_EVENT *pEvent;
-    DLIST_ENTRY *p;
     FLAG fFailure;
 #ifdef USE_READLINE
     CHAR *pReadline = NULL;
@@ -325,18 +394,11 @@ Return value:
         PushNewInput(buf);
     }
     Trace("INPUT THREAD: thread terminating.\n");
-    
+
     //
-    // Free the queue
+    // Whatever is left on the queue belongs to the main thread now;
+    // BlockingReadInput frees it on the way out.
     //
-    while(!IsListEmpty(&g_InputEventList))
-    {
-        p = RemoveHeadList(&g_InputEventList);
-        pEvent = CONTAINING_STRUCT(p, INPUT_EVENT, links);
-        SystemFreeMemory(pEvent->szInput);
-        SystemFreeMemory(pEvent);
-    }
-    g_uNumInputEvents = (ULONG)-1;
     return(0);
 }
 
@@ -380,10 +442,8 @@ PeekNextInput(void)
 Routine description:
 
     Peek at what the next input event will be without consuming it.
-    Because only one thread can be consuming events from the queue at
-    a time (presumably the same thread that called this Peek function)
-    it should be safe to do this without a lock.  But the overhead is
-    low so I lock here anyway.
+    Only the main engine thread consumes events so it can do this
+    without a lock: the event at the head stays put until it reads it.
 
 Parameters:
 
@@ -395,17 +455,11 @@ Return value:
 
 **/
 {
-    INPUT_EVENT *p;
-    char *q = NULL;
-
-    LOCK_INPUT;
-    if (!IsListEmpty(&g_InputEventList))
+    if (0 == g_uNumInputEvents)
     {
-        p = CONTAINING_STRUCT(g_InputEventList.pFlink, INPUT_EVENT, links);
-        q = p->szInput;
+        return(NULL);
     }
-    UNLOCK_INPUT;
-    return(q);
+    return(g_szInputRing[g_uInputHead & INPUT_RING_MASK]);
 }
 
 
@@ -427,24 +481,19 @@ Return value:
 
 **/
 {
-    CHAR *pRet = NULL;
-    INPUT_EVENT *p;
-    DLIST_ENTRY *q;
+    CHAR *pRet;
+    ULONG u;
 
-    LOCK_INPUT;
-    if (!IsListEmpty(&g_InputEventList))
+    if (0 == g_uNumInputEvents)
     {
-        q = RemoveHeadList(&g_InputEventList);
-        p = CONTAINING_STRUCT(q, INPUT_EVENT, links);
-        g_uNumInputEvents--;
-        if (g_uNumInputEvents == 0)
-        {
-            _BlockBlockingReaders();
-        }
-        pRet = p->szInput;
-        SystemFreeMemory(p);
+        return(NULL);
     }
-    UNLOCK_INPUT;
+    u = g_uInputHead & INPUT_RING_MASK;
+    pRet = g_szInputRing[u];
+    ASSERT(NULL != pRet);
+    g_szInputRing[u] = NULL;
+    g_uInputHead++;
+    (void)LockDecrement(&g_uNumInputEvents);
     return(pRet);
 }
 
@@ -471,21 +520,19 @@ Return value:
 
     do
     {
-        _WaitUntilTheresInputToRead();
         if (TRUE == g_fExitProgram) 
         {
-            if (-1 != g_uBlockingInputLock) 
-            {
-                SystemDeleteSemaphore(g_uBlockingInputLock);
-            }
+            _FreeQueuedInput();
             return(NULL);
         }
         pCh = ReadNextInput();
-        if (NULL != pCh)
+        if (NULL == pCh)
         {
-            if (strlen(pCh) > 0) break;
-            SystemFreeMemory(pCh);
+            _WaitUntilTheresInputToRead();
+            continue;
         }
+        if (strlen(pCh) > 0) break;
+        SystemFreeMemory(pCh);
     }
     while(1);
     return(pCh);
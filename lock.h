@@ -85,6 +85,18 @@ __forceinline void Lock(volatile LONG * hPtr)
 #      define Lock(v)			OSSpinLockLock(&(v))
 #      define Unlock(v)			OSSpinLockUnlock(&(v))
 
+#    elif !defined(__i386__) && !defined(__x86_64__)
+                        /* anything else gcc targets, e.g. AArch64 */
+
+#      define lock_t           volatile int
+#      define LockInit(v)      ((v) = 0)
+#      define LockFree(v)      ((v) = 0)
+#      define Lock(v)          do {                                        \
+                             while(__sync_lock_test_and_set(&(v), 1) != 0) \
+                                 while(v);                               \
+                           } while (0)
+#      define Unlock(v)        (__sync_lock_release(&(v)))
+
 #    else                       /* X86 */
 
 #      undef Pause
@@ -79,10 +79,14 @@ Return value:
 #ifdef DUMP_TREE
     Trace("    Search tree dumpfile generation enabled\n");
 #endif
-    Trace("    Hash sizes: %u Mb (main), %u Mb / thread (pawn), %u Mb / thread (eval)\n", 
+    Trace("    Hash sizes: %u Mb (main), %u Mb %s (pawn), %u Mb %s (eval), "
+          "%u Mb (position)\n", 
           (g_uHashTableSizeEntries * sizeof(HASH_ENTRY)) / MB,
-          PAWN_HASH_TABLE_SIZE * sizeof(PAWN_HASH_ENTRY) / MB,
-          EVAL_HASH_TABLE_SIZE * sizeof(EVAL_HASH_ENTRY) / MB);
+          g_uPawnHashTableSizeEntries * sizeof(PAWN_HASH_ENTRY) / MB,
+          g_Options.fSharedPawnHash ? "shared" : "/ thread",
+          g_uEvalHashTableSizeEntries * sizeof(EVAL_HASH_ENTRY) / MB,
+          g_Options.fSharedEvalHash ? "shared" : "/ thread",
+          g_uPositionHashTableSizeEntries * sizeof(POSITION_HASH_ENTRY) / MB);
     Trace("    QCheckPlies: %u\n", QPLIES_OF_NON_CAPTURE_CHECKS);
     Trace("    FutilityBase: %u\n", FUTILITY_BASE_MARGIN);
     p = ExportEvalDNA();
@@ -192,6 +196,13 @@ Return value:
     SetMyName();
     ClearDynamicMoveOrdering();
     ClearHashTable();
+    ClearPositionHashTable();
+    ClearPawnHashTables();
+#ifdef EVAL_HASH
+    ClearEvalHashTables();
+#endif
+    ClearMaterialHashTable();
+    ClearLazyEvalStats();
     ResetOpeningBook();
     return(TRUE);
 }
@@ -275,7 +286,7 @@ Return value:
     //
     memset(&g_Options, 0, sizeof(g_Options));
     g_szInitialCommand[0] = '\0';
-    g_Options.uMyClock = g_Options.uOpponentsClock = 600;
+    g_Options.uMyClockMs = g_Options.uOpponentsClockMs = 600 * 1000;
     g_Options.fGameIsRated = FALSE;
     g_Options.fOpponentIsComputer = FALSE;
     g_Options.uSecPerMove = 0;
@@ -285,8 +296,9 @@ Return value:
     g_Options.mvPonder.uMove = 0;
     g_Options.fShouldPost = TRUE;
     g_Options.fForceDrawWorthZero = FALSE;
-    g_Options.uMyIncrement = 0;
+    g_Options.uMyIncrementMs = 0;
     g_Options.uMovesPerTimePeriod = 0;
+    g_Options.uMovesToGo = 0;
     g_Options.szAnalyzeProgressReport[0] = '\0';
     g_Options.fShouldAnnounceOpening = TRUE;
     g_Options.eClock = CLOCK_NONE;
@@ -298,10 +310,23 @@ Return value:
     strcpy(g_Options.szLogfile, "typhoon.log");
     strcpy(g_Options.szBookName, "book.bin");
     g_Options.uNumHashTableEntries = 0x10000;
+    g_Options.uNumPawnHashEntries = DEFAULT_PAWN_HASH_ENTRIES;
+    g_Options.uNumEvalHashEntries = DEFAULT_EVAL_HASH_ENTRIES;
+    g_Options.uNumPositionHashEntries = DEFAULT_POSITION_HASH_ENTRIES;
+    g_Options.uEGTBCacheSize = DEFAULT_EGTB_CACHE_SIZE;
+    g_Options.uEGTBProbeDepth = 0;
+    g_Options.fSharedPawnHash = TRUE;
+    g_Options.fSharedEvalHash = FALSE;
+    g_Options.fUseNnue = FALSE;
+    strcpy(g_Options.szEvalType, "classic");
+    g_Options.szNnueFile[0] = '\0';
+    g_Options.szTelemetryFile[0] = '\0';
     g_Options.uNumProcessors = 1;
     g_Options.fStatusLine = TRUE;
     g_Options.iResignThreshold = 0;
     g_Options.u64MaxNodeCount = 0ULL;
+    g_Options.uMoveOverhead = DEFAULT_MOVE_OVERHEAD_MS;
+    g_Options.uMultiPv = 1;
 
     i = 1;
     while(i < argc)
@@ -311,7 +336,7 @@ Return value:
         {
             g_Options.uNumProcessors = (ULONG)atoi(argv[i+1]);
             if ((g_Options.uNumProcessors == 0) ||
-                (g_Options.uNumProcessors > 64))
+                (g_Options.uNumProcessors > MAX_SEARCHER_THREADS))
             {
                 g_Options.uNumProcessors = 2;
             }
@@ -334,6 +359,56 @@ Return value:
                                  sizeof(HASH_ENTRY));
             i++;
         }
+        else if ((!STRCMPI(argv[i], "--pawnhash")) && (argc > i))
+        {
+            g_Options.uNumPawnHashEntries =
+                _ParseHashOption(argv[i+1],
+                                 sizeof(PAWN_HASH_ENTRY));
+            if (g_Options.uNumPawnHashEntries == 0)
+            {
+                g_Options.uNumPawnHashEntries = 1;
+            }
+            i++;
+        }
+        else if ((!STRCMPI(argv[i], "--evalhash")) && (argc > i))
+        {
+            g_Options.uNumEvalHashEntries =
+                _ParseHashOption(argv[i+1],
+                                 sizeof(EVAL_HASH_ENTRY));
+            if (g_Options.uNumEvalHashEntries == 0)
+            {
+                g_Options.uNumEvalHashEntries = 1;
+            }
+            i++;
+        }
+        else if ((!STRCMPI(argv[i], "--poshash")) && (argc > i))
+        {
+            g_Options.uNumPositionHashEntries =
+                _ParseHashOption(argv[i+1],
+                                 sizeof(POSITION_HASH_ENTRY));
+            if (g_Options.uNumPositionHashEntries == 0)
+            {
+                g_Options.uNumPositionHashEntries = 1;
+            }
+            i++;
+        }
+        else if (!STRCMPI(argv[i], "--sharedpawnhash"))
+        {
+            g_Options.fSharedPawnHash = TRUE;
+        }
+        else if (!STRCMPI(argv[i], "--privatepawnhash"))
+        {
+            g_Options.fSharedPawnHash = FALSE;
+        }
+        else if (!STRCMPI(argv[i], "--sharedevalhash"))
+        {
+            g_Options.fSharedEvalHash = TRUE;
+        }
+        else if ((!STRCMPI(argv[i], "--egtbcache")) && (argc > i))
+        {
+            g_Options.uEGTBCacheSize = _ParseHashOption(argv[i+1], 1);
+            i++;
+        }
         else if ((!STRCMPI(argv[i], "--egtbpath")) && (argc > i))
         {
             if (!strcmp(argv[i+1], "-")) {
@@ -343,6 +418,14 @@ Return value:
             }
             i++;
         }
+        else if ((!STRCMPI(argv[i], "--nnue")) && (argc > i + 1))
+        {
+            strncpy(g_Options.szNnueFile, argv[i+1],
+                    SMALL_STRING_LEN_CHAR - 1);
+            g_Options.szNnueFile[SMALL_STRING_LEN_CHAR - 1] = '\0';
+            strcpy(g_Options.szEvalType, "nnue");
+            i++;
+        }
         else if (!STRCMPI(argv[i], "--book") && argc > i)
         {
             if (!strcmp(argv[i+1], "-")) {
@@ -352,6 +435,23 @@ Return value:
             }
             i++;
         }
+        else if ((!STRCMPI(argv[i], "--moveoverhead")) && (argc > i))
+        {
+            g_Options.uMoveOverhead = (ULONG)atoi(argv[i+1]);
+            i++;
+        }
+        else if ((!STRCMPI(argv[i], "--multipv")) && (argc > i + 1))
+        {
+            g_Options.uMultiPv = (ULONG)atoi(argv[i+1]);
+            i++;
+        }
+        else if ((!STRCMPI(argv[i], "--telemetry")) && (argc > i + 1))
+        {
+            strncpy(g_Options.szTelemetryFile, argv[i+1],
+                    SMALL_STRING_LEN_CHAR - 1);
+            g_Options.szTelemetryFile[SMALL_STRING_LEN_CHAR - 1] = '\0';
+            i++;
+        }
         else if (!STRCMPI(argv[i], "--batch"))
         {
             g_Options.fNoInputThread = TRUE;
@@ -377,13 +477,28 @@ Return value:
         }
         else if (!STRCMPI(argv[i], "--help")) {
             Trace("Usage: %s [--batch] [--command arg] [--logfile arg] [--egtbpath arg]\n"
-                  "                [--dnafile arg] [--cpus arg] [--hash arg]\n\n"
+                  "                [--egtbcache arg] [--dnafile arg] [--cpus arg] [--hash arg]\n"
+                  "                [--pawnhash arg] [--evalhash arg] [--poshash arg]\n"
+                  "                [--sharedpawnhash] [--privatepawnhash] [--sharedevalhash]\n"
+                  "                [--nnue arg] [--moveoverhead arg] [--multipv arg]\n"
+                  "                [--telemetry arg]\n\n"
                   "    --batch    : operate the engine without an input thread\n"
                   "    --book     : specify the opening book to use or '-' for none\n"
                   "    --command  : specify initial command(s) (requires arg)\n"
                   "    --cpus     : indicate the number of cpus to use (1..64)\n"
                   "    --hash     : indicate desired hash size (e.g. 16m, 1g)\n"
+                  "    --pawnhash : indicate desired pawn hash size (e.g. 32m)\n"
+                  "    --evalhash : indicate desired eval hash size per thread (e.g. 32m)\n"
+                  "    --poshash  : indicate desired position hash size (e.g. 8m)\n"
+                  "    --sharedpawnhash : use one pawn hash for all threads (default)\n"
+                  "    --privatepawnhash : use a separate pawn hash per thread\n"
+                  "    --sharedevalhash : use one eval hash for all threads\n"
+                  "    --nnue     : load an NNUE network and evaluate with it\n"
+                  "    --moveoverhead : ms per move lost to the GUI/network (default 50)\n"
+                  "    --multipv  : search and report this many root lines (1..16)\n"
+                  "    --telemetry : append a JSON line per iteration and move to a file\n"
                   "    --egtbpath : supplies the egtb path or '-' for none\n"
+                  "    --egtbcache : indicate desired egtb cache size (e.g. 32m)\n"
                   "    --logfile  : indicate desired output logfile name or '-' for none\n"
                   "    --dnafile  : indicate desired eval profile input (requres arg)\n\n"
                   "Example: %s --hash 256m --cpus 2\n"
@@ -449,7 +564,10 @@ Return value:
 **/
 {
     srand((unsigned int)time(0));
+    InitializeBitboards();
     InitializeOptions(argc, argv);
+    InitializePsqt();
+    InitializeNnue();
     InitializeTreeDump();
     InitializeEGTB();
     InitializeSigSystem();
@@ -457,15 +575,24 @@ Return value:
     InitializeSearchDepthArray();
     InitializeWhiteSquaresTable();
     InitializeVectorDeltaTable();
+    InitializeSeeRayTable();
     InitializeSwapTable();
     InitializeDistanceTable();
+    InitializeBitbases();
+    InitializePawnHashSystem();
+#ifdef EVAL_HASH
+    InitializeEvalHashSystem();
+#endif
     InitializeOpeningBook();
     InitializeDynamicMoveOrdering();
     InitializeHashSystem();
     InitializePositionHashSystem();
+    InitializeMaterialHashSystem();
 #ifdef MP
     InitializeParallelSearch();
 #endif
+    InitializeMoveTimer();
+    InitializeTelemetry();
     VERIFY(PreGameReset(TRUE));
     (void)BeginLogging();
     return TRUE;
@@ -491,6 +618,8 @@ Return value:
 
 **/
 {
+    StopTelemetry();
+    CleanupMoveTimer();
     CleanupOpeningBook();
     CleanupEGTB();
     CleanupDynamicMoveOrdering();
@@ -498,6 +627,12 @@ Return value:
     CleanupParallelSearch();
 #endif
     CleanupPositionHashSystem();
+    CleanupMaterialHashSystem();
+    CleanupNnue();
+#ifdef EVAL_HASH
+    CleanupEvalHashSystem();
+#endif
+    CleanupPawnHashSystem();
     CleanupHashSystem();
     CleanupTreeDump();
     CleanupOptions();
@@ -580,9 +715,12 @@ Return value:
     TestEval();
 #endif
     TestBitboards();
+    TestBitbases();
+    TestNnue();
     TestSan();
     TestIcs();
     TestGetAttacks();
+    TestSEE();
     TestMoveGenerator();
     TestLegalMoveGenerator();
     TestFenCode();
@@ -591,6 +729,7 @@ Return value:
     TestIsAttacked();
     TestMakeUnmakeMove();
     TestSearch();
+    TestMultiPvSearch();
 
     return(TRUE);
 }
@@ -0,0 +1,202 @@
+/**
+
+Copyright (c) Scott Gasch
+
+Module Name:
+
+    materialhash.c
+
+Abstract:
+
+    A small hash table of facts that depend only on the material on
+    the board: which interior node recognizer applies, the material
+    only eval terms (bad trades, bishop pairs), the army size scalers
+    used by the piece evaluators, the game phase and a drawish scale
+    factor (e.g. for opposite colored bishops).  It is keyed by the
+    incrementally maintained POSITION.u64MaterialSig so RecognLookup
+    and Eval get all of this with one cacheline read instead of
+    rederiving it from piece counts at every node.
+
+    There are only a few hundred distinct material configurations in
+    a typical search so the table is small and shared by all threads.
+    Entries are a pure function of their key (and the eval DNA) so
+    two threads racing to fill the same one is harmless as long as a
+    reader can tell a torn entry from a good one: the key is stored
+    XORed with the data words like the shared eval hash does.
+
+Revision History:
+
+**/
+
+#include "chess.h"
+
+static MATERIAL_HASH_ENTRY *g_pMaterialHash = NULL;
+
+#define MATERIAL_HASH_ENTRY_CHECKSUM(e) \
+    ((e).u.u64Data[0] ^ (e).u.u64Data[1] ^ (e).u.u64Data[2])
+
+void
+InitializeMaterialHashSystem(void)
+/**
+
+Routine description:
+
+    Allocate the material hash table.
+
+Parameters:
+
+    void
+
+Return value:
+
+    void
+
+**/
+{
+    ASSERT(IS_A_POWER_OF_2(MATERIAL_HASH_ENTRIES));
+    ASSERT(sizeof(MATERIAL_HASH_ENTRY) == 32);
+    ASSERT(g_pMaterialHash == NULL);
+    g_pMaterialHash =
+        SystemAllocateMemory(MATERIAL_HASH_ENTRIES *
+                             sizeof(MATERIAL_HASH_ENTRY));
+    ClearMaterialHashTable();
+}
+
+
+void
+CleanupMaterialHashSystem(void)
+/**
+
+Routine description:
+
+    Free the material hash table.
+
+Parameters:
+
+    void
+
+Return value:
+
+    void
+
+**/
+{
+    if (NULL != g_pMaterialHash)
+    {
+        SystemFreeMemory(g_pMaterialHash);
+        g_pMaterialHash = NULL;
+    }
+}
+
+
+void
+ClearMaterialHashTable(void)
+/**
+
+Routine description:
+
+    Zero out the material hash table.  Called when a new game starts
+    and when the eval weights change underneath the cached terms.  A
+    zeroed entry never matches because material signatures always
+    have MATERIAL_SIG_VALID set.
+
+Parameters:
+
+    void
+
+Return value:
+
+    void
+
+**/
+{
+    if (NULL != g_pMaterialHash)
+    {
+        memset(g_pMaterialHash, 0,
+               MATERIAL_HASH_ENTRIES * sizeof(MATERIAL_HASH_ENTRY));
+    }
+}
+
+
+static void
+_ComputeMaterialHashEntry(IN POSITION *pos,
+                          OUT MATERIAL_HASH_ENTRY *pEntry)
+/**
+
+Routine description:
+
+    Fill in the data part of a material hash entry for pos.
+
+Parameters:
+
+    POSITION *pos,
+    MATERIAL_HASH_ENTRY *pEntry
+
+Return value:
+
+    static void
+
+**/
+{
+    memset(&(pEntry->u), 0, sizeof(pEntry->u));
+    pEntry->u.s.pRecognizer = GetInteriorNodeRecognizer(pos);
+    EvalMaterialTerms(pos, pEntry);
+}
+
+
+void
+MaterialHashLookup(IN POSITION *pos,
+                   OUT MATERIAL_HASH_ENTRY *pEntry)
+/**
+
+Routine description:
+
+    Copy the material hash entry for pos' material into *pEntry,
+    computing (and storing) it first on a miss.  On return
+    pEntry->u64Key is the plain material signature.
+
+Parameters:
+
+    POSITION *pos,
+    MATERIAL_HASH_ENTRY *pEntry
+
+Return value:
+
+    void
+
+**/
+{
+    UINT64 u64Sig = pos->u64MaterialSig;
+    MATERIAL_HASH_ENTRY *pSlot;
+    ULONG u;
+#ifdef DEBUG
+    MATERIAL_HASH_ENTRY sCheck;
+#endif
+
+    ASSERT(u64Sig & MATERIAL_SIG_VALID);
+    ASSERT(u64Sig == ComputeMaterialSig(pos));
+    u = (ULONG)((u64Sig * 0x9E3779B97F4A7C15ULL) >> 32);
+    pSlot = &(g_pMaterialHash[u & (MATERIAL_HASH_ENTRIES - 1)]);
+    *pEntry = *pSlot;
+#ifndef EVAL_DUMP
+    if ((pEntry->u64Key ^ MATERIAL_HASH_ENTRY_CHECKSUM(*pEntry)) == u64Sig)
+    {
+#ifdef DEBUG
+        _ComputeMaterialHashEntry(pos, &sCheck);
+        ASSERT(!memcmp(&(sCheck.u), &(pEntry->u), sizeof(sCheck.u)));
+#endif
+        pEntry->u64Key = u64Sig;
+        return;
+    }
+#endif
+
+    //
+    // Miss (or an entry torn by a concurrent writer): build it.  Note
+    // that under EVAL_DUMP we always do this so that the material
+    // terms show up in the eval trace.
+    //
+    _ComputeMaterialHashEntry(pos, pEntry);
+    pEntry->u64Key = u64Sig ^ MATERIAL_HASH_ENTRY_CHECKSUM(*pEntry);
+    *pSlot = *pEntry;
+    pEntry->u64Key = u64Sig;
+}
@@ -70,6 +70,10 @@ Return value:
         ASSERT(IS_SQUARE_WHITE(cTo));
     }
 #endif
+    pos->iPsqt[PSQT_MG][c] += (g_iPsqt[PSQT_MG][p][cTo] -
+                               g_iPsqt[PSQT_MG][p][cFrom]);
+    pos->iPsqt[PSQT_EG][c] += (g_iPsqt[PSQT_EG][p][cTo] -
+                               g_iPsqt[PSQT_EG][p][cFrom]);
     pos->rgSquare[cTo].pPiece = p;
     pos->rgSquare[cTo].uIndex = uIndex;
 #ifdef DEBUG
@@ -121,6 +125,10 @@ Return value:
     pos->cPawns[c][uIndex] = cTo;
     pos->u64PawnSig ^= g_u64PawnSigSeeds[cFrom][c];
     pos->u64PawnSig ^= g_u64PawnSigSeeds[cTo][c];
+    pos->iPsqt[PSQT_MG][c] += (g_iPsqt[PSQT_MG][p][cTo] -
+                               g_iPsqt[PSQT_MG][p][cFrom]);
+    pos->iPsqt[PSQT_EG][c] += (g_iPsqt[PSQT_EG][p][cTo] -
+                               g_iPsqt[PSQT_EG][p][cFrom]);
     pos->rgSquare[cTo].pPiece = p;
     pos->rgSquare[cTo].uIndex = uIndex;
 #ifdef DEBUG
@@ -171,6 +179,10 @@ Return value:
     ASSERT(IS_VALID_COLOR(c));
     ASSERT(pos->cNonPawns[c][uIndex] == cFrom);
     pos->cNonPawns[c][uIndex] = cTo;
+    pos->iPsqt[PSQT_MG][c] += (g_iPsqt[PSQT_MG][p][cTo] -
+                               g_iPsqt[PSQT_MG][p][cFrom]);
+    pos->iPsqt[PSQT_EG][c] += (g_iPsqt[PSQT_EG][p][cTo] -
+                               g_iPsqt[PSQT_EG][p][cFrom]);
     pos->rgSquare[cTo].pPiece = p;
     pos->rgSquare[cTo].uIndex = uIndex;
 #ifdef DEBUG
@@ -220,6 +232,10 @@ Return value:
     ASSERT(IS_VALID_COLOR(c));
     ASSERT(pos->cPawns[c][uIndex] == cFrom);
     pos->cPawns[c][uIndex] = cTo;
+    pos->iPsqt[PSQT_MG][c] += (g_iPsqt[PSQT_MG][p][cTo] -
+                               g_iPsqt[PSQT_MG][p][cFrom]);
+    pos->iPsqt[PSQT_EG][c] += (g_iPsqt[PSQT_EG][p][cTo] -
+                               g_iPsqt[PSQT_EG][p][cFrom]);
     pos->rgSquare[cTo].pPiece = p;
     pos->rgSquare[cTo].uIndex = uIndex;
 #ifdef DEBUG
@@ -279,6 +295,9 @@ Return value:
     pos->iMaterialBalance[color] -= pv;
     pos->iMaterialBalance[FLIP(color)] += pv;
     ASSERT(pos->iMaterialBalance[WHITE] * -1 == pos->iMaterialBalance[BLACK]);
+    pos->u64MaterialSig -= MATERIAL_SIG_DELTA(pLifted, cSquare);
+    pos->iPsqt[PSQT_MG][color] -= g_iPsqt[PSQT_MG][pLifted][cSquare];
+    pos->iPsqt[PSQT_EG][color] -= g_iPsqt[PSQT_EG][pLifted][cSquare];
     
     if (IS_PAWN(pLifted))
     {
@@ -413,6 +432,9 @@ Return value:
     pos->iMaterialBalance[color] -= pv;
     pos->iMaterialBalance[FLIP(color)] += pv;
     ASSERT(pos->iMaterialBalance[WHITE] * -1 == pos->iMaterialBalance[BLACK]);
+    pos->u64MaterialSig -= MATERIAL_SIG_DELTA(pLifted, cSquare);
+    pos->iPsqt[PSQT_MG][color] -= g_iPsqt[PSQT_MG][pLifted][cSquare];
+    pos->iPsqt[PSQT_EG][color] -= g_iPsqt[PSQT_EG][pLifted][cSquare];
     
     if (IS_PAWN(pLifted))
     {
@@ -521,6 +543,9 @@ Return value:
     pos->iMaterialBalance[color] += pv;
     pos->iMaterialBalance[FLIP(color)] -= pv;
     ASSERT(pos->iMaterialBalance[WHITE] * -1 == pos->iMaterialBalance[BLACK]);
+    pos->u64MaterialSig += MATERIAL_SIG_DELTA(pPiece, cSquare);
+    pos->iPsqt[PSQT_MG][color] += g_iPsqt[PSQT_MG][pPiece][cSquare];
+    pos->iPsqt[PSQT_EG][color] += g_iPsqt[PSQT_EG][pPiece][cSquare];
     
     if (IS_PAWN(pPiece))
     {
@@ -612,6 +637,9 @@ Return value:
     pos->iMaterialBalance[color] += pv;
     pos->iMaterialBalance[FLIP(color)] -= pv;
     ASSERT(pos->iMaterialBalance[WHITE] * -1 == pos->iMaterialBalance[BLACK]);
+    pos->u64MaterialSig += MATERIAL_SIG_DELTA(pPiece, cSquare);
+    pos->iPsqt[PSQT_MG][color] += g_iPsqt[PSQT_MG][pPiece][cSquare];
+    pos->iPsqt[PSQT_EG][color] += g_iPsqt[PSQT_EG][pPiece][cSquare];
     
     if (IS_PAWN(pPiece))
     {
@@ -1172,7 +1200,7 @@ Return value:
          x < ctx->sMoveStack.uEnd[ctx->uPly];
          x++)
     {
-        mv = ctx->sMoveStack.mvf[x].mv;
+        mv = ctx->sMoveStack.mv[x];
         if (IS_SAME_MOVE(mvUser, mv))
         {
             if (TRUE == MakeMove(ctx, mv))
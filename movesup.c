@@ -22,6 +22,11 @@ Revision History:
 **/
 
 #include "chess.h"
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 COOR 
 FasterExposesCheck(POSITION *pos,
@@ -988,6 +993,108 @@ Return value:
 }
 
 
+static INLINE ULONG
+_ArgMaxScore(SCORE *piValue,
+             ULONG u,
+             ULONG uEnd)
+/**
+
+Routine description:
+
+    Return the index of the first (lowest index) maximum value in
+    piValue[u..uEnd).  This is the inner loop of the move picker so
+    it's vectorized where we know how: four SCOREs at a time with SSE2
+    (part of the x86-64 baseline) or NEON.  Each lane remembers its
+    own best value / index using a strict greater than so that ties
+    resolve to the earliest move, exactly like the scalar loop.
+
+Parameters:
+
+    SCORE *piValue : the move stack's value array
+    ULONG u : first index to consider
+    ULONG uEnd : one past the last index to consider
+
+Return value:
+
+    ULONG : index of the best value
+
+**/
+{
+    ULONG uLoc = u;
+    SCORE iBestVal;
+    ULONG v = u + 1;
+#if defined(__SSE2__) || defined(__aarch64__)
+    ULONG x;
+    SCORE iLane[4];
+    ULONG uLane[4];
+
+    if (uEnd - u >= 8)
+    {
+#if defined(__SSE2__)
+        __m128i vBest = _mm_loadu_si128((__m128i *)&(piValue[u]));
+        __m128i vLoc = _mm_setr_epi32(u, u + 1, u + 2, u + 3);
+        __m128i vFour = _mm_set1_epi32(4);
+        __m128i vCur = vLoc;
+        __m128i vVal, vGt;
+
+        for (v = u + 4; v + 4 <= uEnd; v += 4)
+        {
+            vCur = _mm_add_epi32(vCur, vFour);
+            vVal = _mm_loadu_si128((__m128i *)&(piValue[v]));
+            vGt = _mm_cmpgt_epi32(vVal, vBest);
+            vBest = _mm_or_si128(_mm_and_si128(vGt, vVal),
+                                 _mm_andnot_si128(vGt, vBest));
+            vLoc = _mm_or_si128(_mm_and_si128(vGt, vCur),
+                                _mm_andnot_si128(vGt, vLoc));
+        }
+        _mm_storeu_si128((__m128i *)iLane, vBest);
+        _mm_storeu_si128((__m128i *)uLane, vLoc);
+#else
+        int32x4_t vBest = vld1q_s32(&(piValue[u]));
+        uint32x4_t vLoc = { u, u + 1, u + 2, u + 3 };
+        uint32x4_t vFour = vdupq_n_u32(4);
+        uint32x4_t vCur = vLoc;
+        uint32x4_t vGt;
+        int32x4_t vVal;
+
+        for (v = u + 4; v + 4 <= uEnd; v += 4)
+        {
+            vCur = vaddq_u32(vCur, vFour);
+            vVal = vld1q_s32(&(piValue[v]));
+            vGt = vcgtq_s32(vVal, vBest);
+            vBest = vbslq_s32(vGt, vVal, vBest);
+            vLoc = vbslq_u32(vGt, vCur, vLoc);
+        }
+        vst1q_s32(iLane, vBest);
+        vst1q_u32(uLane, vLoc);
+#endif
+        uLoc = uLane[0];
+        iBestVal = iLane[0];
+        for (x = 1; x < 4; x++)
+        {
+            if ((iLane[x] > iBestVal) ||
+                ((iLane[x] == iBestVal) && (uLane[x] < uLoc)))
+            {
+                iBestVal = iLane[x];
+                uLoc = uLane[x];
+            }
+        }
+        ASSERT(piValue[uLoc] == iBestVal);
+    }
+#endif
+    iBestVal = piValue[uLoc];
+    for (; v < uEnd; v++)
+    {
+        if (piValue[v] > iBestVal)
+        {
+            iBestVal = piValue[v];
+            uLoc = v;
+        }
+    }
+    return(uLoc);
+}
+
+
 void FASTCALL 
 SelectBestWithHistory(SEARCHER_THREAD_CONTEXT *ctx,
                       ULONG u)
@@ -999,6 +1106,11 @@ Routine description:
     at generation time) that has not been played yet this ply and move
     it to the front of the move list to be played next.
 
+    This is the picker for the first SEARCH_SORT_LIMIT moves at full
+    width nodes.  Non-capture moves' values are adjusted by their
+    history counters which change as the subtrees below this node are
+    searched so we can't presort here; it's a scalar scan.
+
 Parameters:
 
     SEARCHER_THREAD_CONTEXT *ctx,
@@ -1016,31 +1128,34 @@ Return value:
     ULONG uLoc;
     SCORE iVal;
     MOVE mv;
-    MOVE_STACK_MOVE_VALUE_FLAGS mvfTemp;
     
     ASSERT(ctx->sMoveStack.uBegin[ctx->uPly] <= uEnd);
     ASSERT(u >= ctx->sMoveStack.uBegin[ctx->uPly]);
     ASSERT(u < uEnd);
+    INC(ctx->sCounters.movepick.u64HistoryPicks);
+#ifdef PERF_COUNTERS
+    ctx->sCounters.movepick.u64Scanned += (uEnd - u);
+#endif
     
     //
     // Linear search from u..ctx->sMoveStack.uEnd[ctx->uPly] for the
     // move with the best value.
     //
-    iBestVal = ctx->sMoveStack.mvf[u].iValue;
-    mv = ctx->sMoveStack.mvf[u].mv;
+    iBestVal = ctx->sMoveStack.iValue[u];
+    mv = ctx->sMoveStack.mv[u];
     if (!IS_CAPTURE_OR_PROMOTION(mv))
     {
-        iBestVal += g_HistoryCounters[mv.pMoved][mv.cTo];
+        iBestVal += ctx->pHistory->uCounters[mv.pMoved][mv.cTo];
     }
     uLoc = u;
     
     for (v = u + 1; v < uEnd; v++)
     {
-        iVal = ctx->sMoveStack.mvf[v].iValue;
-        mv = ctx->sMoveStack.mvf[v].mv;
+        iVal = ctx->sMoveStack.iValue[v];
+        mv = ctx->sMoveStack.mv[v];
         if (!IS_CAPTURE_OR_PROMOTION(mv))
         {
-            iVal += g_HistoryCounters[mv.pMoved][mv.cTo];
+            iVal += ctx->pHistory->uCounters[mv.pMoved][mv.cTo];
         }
         if (iVal > iBestVal)
         {
@@ -1052,9 +1167,7 @@ Return value:
     //
     // Note: the if here slows down the code, just swap em.
     //
-    mvfTemp = ctx->sMoveStack.mvf[u];
-    ctx->sMoveStack.mvf[u] = ctx->sMoveStack.mvf[uLoc];
-    ctx->sMoveStack.mvf[uLoc] = mvfTemp;
+    SWAP_MOVE_STACK_ENTRIES(&(ctx->sMoveStack), u, uLoc);
 }
 
 
@@ -1069,6 +1182,10 @@ Routine description:
     at generation time) that has not been played yet this ply and move
     it to the front of the move list to be played next.
 
+    This is the picker used by qsearch, check evasions and the IID /
+    rescore code; the values are fixed so it's a straight (vectorized)
+    argmax over the move stack's value array.
+
 Parameters:
 
     SEARCHER_THREAD_CONTEXT *ctx,
@@ -1080,41 +1197,92 @@ Return value:
 
 **/
 {
-    register ULONG v;
-    register ULONG uEnd = ctx->sMoveStack.uEnd[ctx->uPly];
-    register SCORE iBestVal;
+    ULONG uEnd = ctx->sMoveStack.uEnd[ctx->uPly];
     ULONG uLoc;
-    SCORE iVal;
-    MOVE_STACK_MOVE_VALUE_FLAGS mvfTemp;
     
     ASSERT(ctx->sMoveStack.uBegin[ctx->uPly] <= uEnd);
     ASSERT(u >= ctx->sMoveStack.uBegin[ctx->uPly]);
     ASSERT(u < uEnd);
+    INC(ctx->sCounters.movepick.u64PlainPicks);
+#ifdef PERF_COUNTERS
+    ctx->sCounters.movepick.u64Scanned += (uEnd - u);
+#endif
     
+    uLoc = _ArgMaxScore(ctx->sMoveStack.iValue, u, uEnd);
+
     //
-    // Linear search from u..ctx->sMoveStack.uEnd[ctx->uPly] for the
-    // move with the best value.
+    // Note: the if here slows down the code, just swap em.
     //
-    iBestVal = ctx->sMoveStack.mvf[u].iValue;
-    uLoc = u;
-    for (v = u + 1; v < uEnd; v++)
+    SWAP_MOVE_STACK_ENTRIES(&(ctx->sMoveStack), u, uLoc);
+}
+
+
+void
+SortMovesWithHistory(SEARCHER_THREAD_CONTEXT *ctx,
+                     ULONG u)
+/**
+
+Routine description:
+
+    Sort all moves from u..end of ply by their history adjusted value,
+    best first.  This is for places where every move will be handed
+    out before any of them is searched (i.e. a split node) so the
+    history values can't change under us and a single sort beats
+    calling SelectBestWithHistory once per move.
+
+Parameters:
+
+    SEARCHER_THREAD_CONTEXT *ctx,
+    ULONG u
+
+Return value:
+
+    void
+
+**/
+{
+    MOVE_STACK *pStack = &(ctx->sMoveStack);
+    ULONG uEnd = pStack->uEnd[ctx->uPly];
+    SCORE iKey[MAX_MOVES_PER_PLY];
+    SCORE iVal, iSortKey;
+    MOVE mv;
+    BITV bv;
+    ULONG v;
+    int x;
+    
+    ASSERT(pStack->uBegin[ctx->uPly] <= uEnd);
+    ASSERT(u >= pStack->uBegin[ctx->uPly]);
+    ASSERT(uEnd - u <= MAX_MOVES_PER_PLY);
+    INC(ctx->sCounters.movepick.u64Sorts);
+
+    //
+    // Insertion sort on the history adjusted key.
+    //
+    for (v = u; v < uEnd; v++)
     {
-        iVal = ctx->sMoveStack.mvf[v].iValue;
-        if (iVal > iBestVal)
+        iVal = pStack->iValue[v];
+        mv = pStack->mv[v];
+        bv = pStack->bvFlags[v];
+        iSortKey = iVal;
+        if (!IS_CAPTURE_OR_PROMOTION(mv))
         {
-            iBestVal = iVal;
-            uLoc = v;
+            iSortKey += ctx->pHistory->uCounters[mv.pMoved][mv.cTo];
         }
+        for (x = (int)(v - u) - 1;
+             (x >= 0) && (iKey[x] < iSortKey);
+             x--)
+        {
+            iKey[x + 1] = iKey[x];
+            COPY_MOVE_STACK_ENTRY(pStack, u + x + 1, u + x);
+        }
+        iKey[x + 1] = iSortKey;
+        pStack->iValue[u + x + 1] = iVal;
+        pStack->mv[u + x + 1] = mv;
+        pStack->bvFlags[u + x + 1] = bv;
     }
-
-    //
-    // Note: the if here slows down the code, just swap em.
-    //
-    mvfTemp = ctx->sMoveStack.mvf[u];
-    ctx->sMoveStack.mvf[u] = ctx->sMoveStack.mvf[uLoc];
-    ctx->sMoveStack.mvf[uLoc] = mvfTemp;
 }
 
+
 void FASTCALL 
 SelectMoveAtRoot(SEARCHER_THREAD_CONTEXT *ctx,
                  ULONG u)
@@ -1122,6 +1290,9 @@ SelectMoveAtRoot(SEARCHER_THREAD_CONTEXT *ctx,
 
 Routine description:
 
+    Pick the best move at the root that RootSearch has not tried yet
+    this iteration and move it to position u.
+
 Parameters:
 
     SEARCHER_THREAD_CONTEXT *ctx,
@@ -1138,12 +1309,12 @@ Return value:
     SCORE iBestVal = -INFINITY;
     ULONG uLoc = v;
     SCORE iVal;
-    MOVE_STACK_MOVE_VALUE_FLAGS mvfTemp;
     
     ASSERT(ctx->sMoveStack.uBegin[ctx->uPly] <= uEnd);
     ASSERT(u >= ctx->sMoveStack.uBegin[ctx->uPly]);
     ASSERT(u < uEnd);
     ASSERT(MOVE_COUNT(ctx, ctx->uPly) >= 1);
+    INC(ctx->sCounters.movepick.u64RootPicks);
     
     //
     // Find the first move that we have not already searched.  It will
@@ -1151,9 +1322,9 @@ Return value:
     //
     do
     {
-        if (!(ctx->sMoveStack.mvf[v].bvFlags & MVF_MOVE_SEARCHED))
+        if (!(ctx->sMoveStack.bvFlags[v] & MVF_MOVE_SEARCHED))
         {
-            iBestVal = ctx->sMoveStack.mvf[v].iValue;
+            iBestVal = ctx->sMoveStack.iValue[v];
             uLoc = v;
             break;
         }
@@ -1168,9 +1339,9 @@ Return value:
     //
     for (v = uLoc + 1; v < uEnd; v++)
     {
-        if (!(ctx->sMoveStack.mvf[v].bvFlags & MVF_MOVE_SEARCHED))
+        if (!(ctx->sMoveStack.bvFlags[v] & MVF_MOVE_SEARCHED))
         {
-            iVal = ctx->sMoveStack.mvf[v].iValue;
+            iVal = ctx->sMoveStack.iValue[v];
             if (iVal > iBestVal)
             {
                 iBestVal = iVal;
@@ -1182,9 +1353,7 @@ Return value:
     //
     // Move the best move we found into position u.
     //
-    mvfTemp = ctx->sMoveStack.mvf[u];
-    ctx->sMoveStack.mvf[u] = ctx->sMoveStack.mvf[uLoc];
-    ctx->sMoveStack.mvf[uLoc] = mvfTemp;
+    SWAP_MOVE_STACK_ENTRIES(&(ctx->sMoveStack), u, uLoc);
 }
 
 
@@ -1217,7 +1386,7 @@ Perft(SEARCHER_THREAD_CONTEXT *ctx,
          u < ctx->sMoveStack.uEnd[uPly];
          u++)
     {
-        mv = ctx->sMoveStack.mvf[u].mv;
+        mv = ctx->sMoveStack.mv[u];
         if (MakeMove(ctx, mv))
         {
             Perft(ctx, uDepth - 1);
@@ -1256,7 +1425,7 @@ Return value:
 
 **/
 {
-    LIGHTWEIGHT_SEARCHER_CONTEXT ctx;
+    SEARCHER_THREAD_CONTEXT ctx;
     ULONG u;
     ULONG uDepth;
     double dBegin, dTime;
@@ -1274,14 +1443,14 @@ Return value:
         return;
     }
 
-    InitializeLightweightSearcherContext(pos, &ctx);
+    InitializeSearcherContext(pos, &ctx);
     
     g_uPerftTotalNodes = g_uPerftGenerates = 0ULL;
     dBegin = SystemTimeStamp();
     for (u = 1; u <= uDepth; u++) 
     {
         g_uPerftNodeCount = 0ULL;
-        Perft((SEARCHER_THREAD_CONTEXT *)&ctx, u);
+        Perft(&ctx, u);
         Trace("%u. %" COMPILER_LONGLONG_UNSIGNED_FORMAT " node%s, "
                   "%" COMPILER_LONGLONG_UNSIGNED_FORMAT " generate%s.\n",
               u, 
@@ -0,0 +1,979 @@
+/**
+
+Copyright (c) Scott Gasch
+
+Module Name:
+
+    nnue.c
+
+Abstract:
+
+    An efficiently updatable neural network (NNUE) evaluator that can
+    be used instead of the hand written eval in eval.c.  It is
+    selected at runtime with "set evaltype nnue" once a network has
+    been loaded with "set nnuefile <filename>" (or --nnue <filename>
+    on the commandline).  Networks are trained offline; this is only
+    the engine side: the input features, the accumulators and the
+    inference.
+
+    The network is a HalfKP style 40960 -> 2x256 -> 1 net.  There is
+    one input feature per (own king square, non-king piece, square)
+    as seen from each side's perspective; squares are numbered a1 = 0
+    .. h8 = 63 for white and mirrored vertically for black so both
+    halves share the same weights.  The first layer outputs of both
+    halves are kept in int16 "accumulators".  To evaluate, the side to
+    move's half and then the other half are clipped to 0..NNUE_CLIP
+    and dotted with the int16 output weights; the int32 sum plus the
+    output bias divided by the net's output divisor is the score in
+    centipawns for the side to move.
+
+    A non-king piece moving touches at most four features so the
+    accumulators are updated incrementally along the line being
+    searched.  SEARCHER_THREAD_CONTEXT holds one accumulator per ply.
+    MakeMove already records the move made at each ply (and the
+    signature of the position it was made from) in ctx->sPlyInfo and
+    that is all the "dirty piece" information needed: when Eval is
+    called the accumulator at the current ply is brought up to date
+    from the nearest ancestor ply whose accumulator is still valid
+    (or refreshed from scratch if a king moved in between).  Since
+    the stack is indexed by ply, UnmakeMove has nothing to undo.  Each
+    accumulator half is tagged with the signature of the position it
+    was computed for XORed with a per-network salt which makes stale
+    entries from a sibling line, an earlier search or an older
+    network easy to spot.
+
+    The weight file is little endian: a NNUE_FILE_HEADER followed by
+    the feature biases (SHORT[NNUE_HIDDEN]), the feature weights
+    (SHORT[NNUE_INPUTS][NNUE_HIDDEN]) and the output weights
+    (SHORT[2 * NNUE_HIDDEN], side to move's half first).
+
+    The inner loops have an AVX2 version that is used when the
+    compiler targets AVX2 (e.g. make NATIVE=1) and a plain C version
+    otherwise.  Both compute exactly the same thing.
+
+Revision History:
+
+**/
+
+#include "chess.h"
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#define NNUE_FILE_MAGIC           (0x45554E54) // "TNUE"
+#define NNUE_FILE_VERSION         (1)
+
+typedef struct _NNUE_FILE_HEADER
+{
+    ULONG uMagic;
+    ULONG uVersion;
+    ULONG uInputs;                   // must be NNUE_INPUTS
+    ULONG uHidden;                   // must be NNUE_HIDDEN
+    ULONG uOutputDivisor;            // output sum / this = centipawns
+    INT iOutputBias;
+}
+NNUE_FILE_HEADER;
+
+typedef struct _NNUE_NETWORK
+{
+    SHORT *piFeatureBias;            // [NNUE_HIDDEN]
+    SHORT *piFeatureWeight;          // [NNUE_INPUTS][NNUE_HIDDEN]
+    SHORT *piOutputWeight;           // [2 * NNUE_HIDDEN]
+    INT iOutputBias;
+    ULONG uOutputDivisor;
+    UINT64 u64Salt;                  // see NNUE_ACCUMULATOR.u64Sig
+}
+NNUE_NETWORK;
+
+static NNUE_NETWORK g_Nnue;
+static ULONG g_uNnueLoads = 0;
+
+//
+// "set NNUEFile" / "set EvalType" that arrived during a search; see
+// ApplyPendingNnueChanges.
+//
+static FLAG g_fNnueFilePending = FALSE;
+static FLAG g_fEvalTypePending = FALSE;
+
+#define NNUE_NETWORK_BYTES \
+    ((NNUE_HIDDEN + NNUE_INPUTS * NNUE_HIDDEN + 2 * NNUE_HIDDEN) * \
+     sizeof(SHORT))
+
+//
+// The most features one move can add or remove from one half.
+//
+#define NNUE_MAX_DELTA            (32)
+
+static INLINE ULONG
+_NnueFeature(IN ULONG uPerspective,
+             IN COOR cKing,
+             IN PIECE p,
+             IN COOR c)
+/**
+
+Routine description:
+
+    Compute the input feature number of non-king piece p on square c
+    from uPerspective's point of view when uPerspective's king is on
+    cKing.
+
+Parameters:
+
+    ULONG uPerspective,
+    COOR cKing,
+    PIECE p,
+    COOR c
+
+Return value:
+
+    static INLINE ULONG
+
+**/
+{
+    ULONG uKing = COOR_TO_BIT_NUMBER(cKing);
+    ULONG uSquare = COOR_TO_BIT_NUMBER(c);
+    ULONG uKind = PIECE_TYPE(p) - PAWN;
+
+    ASSERT(IS_VALID_COLOR(uPerspective));
+    ASSERT(IS_ON_BOARD(cKing));
+    ASSERT(IS_ON_BOARD(c));
+    ASSERT(IS_VALID_PIECE(p));
+    ASSERT(!IS_KING(p));
+
+    //
+    // Bit numbers count from a8; renumber from the perspective side's
+    // own back rank.
+    //
+    if (uPerspective == WHITE)
+    {
+        uKing ^= 56;
+        uSquare ^= 56;
+    }
+    if (GET_COLOR(p) != uPerspective)
+    {
+        uKind += 5;
+    }
+    ASSERT(uKind < 10);
+    return((uKing * 10 + uKind) * 64 + uSquare);
+}
+
+
+static void
+_NnueApplyDelta(OUT SHORT *piDest,
+                IN SHORT *piSrc,
+                IN ULONG *puAdd,
+                IN ULONG uNumAdd,
+                IN ULONG *puSub,
+                IN ULONG uNumSub)
+/**
+
+Routine description:
+
+    piDest = piSrc + the weights of features puAdd - the weights of
+    features puSub.  piDest and piSrc may be the same.
+
+Parameters:
+
+    SHORT *piDest,
+    SHORT *piSrc,
+    ULONG *puAdd,
+    ULONG uNumAdd,
+    ULONG *puSub,
+    ULONG uNumSub
+
+Return value:
+
+    static void
+
+**/
+{
+    SHORT *pW = g_Nnue.piFeatureWeight;
+    ULONG u, x;
+#if defined(__AVX2__)
+    __m256i v;
+
+    for (x = 0; x < NNUE_HIDDEN; x += 16)
+    {
+        v = _mm256_loadu_si256((__m256i *)(piSrc + x));
+        for (u = 0; u < uNumAdd; u++)
+        {
+            v = _mm256_add_epi16(v,
+                _mm256_loadu_si256((__m256i *)
+                                   (pW + puAdd[u] * NNUE_HIDDEN + x)));
+        }
+        for (u = 0; u < uNumSub; u++)
+        {
+            v = _mm256_sub_epi16(v,
+                _mm256_loadu_si256((__m256i *)
+                                   (pW + puSub[u] * NNUE_HIDDEN + x)));
+        }
+        _mm256_storeu_si256((__m256i *)(piDest + x), v);
+    }
+#else
+    if (piDest != piSrc)
+    {
+        memcpy(piDest, piSrc, NNUE_HIDDEN * sizeof(SHORT));
+    }
+    for (u = 0; u < uNumAdd; u++)
+    {
+        for (x = 0; x < NNUE_HIDDEN; x++)
+        {
+            piDest[x] += pW[puAdd[u] * NNUE_HIDDEN + x];
+        }
+    }
+    for (u = 0; u < uNumSub; u++)
+    {
+        for (x = 0; x < NNUE_HIDDEN; x++)
+        {
+            piDest[x] -= pW[puSub[u] * NNUE_HIDDEN + x];
+        }
+    }
+#endif
+}
+
+
+static INT
+_NnueOutput(IN SHORT *piUs,
+            IN SHORT *piThem)
+/**
+
+Routine description:
+
+    Run the output layer over the side to move's (piUs) and the other
+    side's (piThem) accumulators.
+
+Parameters:
+
+    SHORT *piUs,
+    SHORT *piThem
+
+Return value:
+
+    static INT : the raw output sum including the bias
+
+**/
+{
+    SHORT *pW = g_Nnue.piOutputWeight;
+    INT iSum = g_Nnue.iOutputBias;
+    ULONG x;
+#if defined(__AVX2__)
+    __m256i vZero = _mm256_setzero_si256();
+    __m256i vClip = _mm256_set1_epi16(NNUE_CLIP);
+    __m256i vSum = _mm256_setzero_si256();
+    __m256i v;
+    __m128i v128;
+
+    for (x = 0; x < NNUE_HIDDEN; x += 16)
+    {
+        v = _mm256_loadu_si256((__m256i *)(piUs + x));
+        v = _mm256_min_epi16(_mm256_max_epi16(v, vZero), vClip);
+        vSum = _mm256_add_epi32(vSum,
+            _mm256_madd_epi16(v, _mm256_loadu_si256((__m256i *)(pW + x))));
+        v = _mm256_loadu_si256((__m256i *)(piThem + x));
+        v = _mm256_min_epi16(_mm256_max_epi16(v, vZero), vClip);
+        vSum = _mm256_add_epi32(vSum,
+            _mm256_madd_epi16(v, _mm256_loadu_si256((__m256i *)
+                                                    (pW + NNUE_HIDDEN + x))));
+    }
+    v128 = _mm_add_epi32(_mm256_castsi256_si128(vSum),
+                         _mm256_extracti128_si256(vSum, 1));
+    v128 = _mm_add_epi32(v128, _mm_shuffle_epi32(v128, 0x4E));
+    v128 = _mm_add_epi32(v128, _mm_shuffle_epi32(v128, 0xB1));
+    iSum += _mm_cvtsi128_si32(v128);
+#else
+    INT i;
+
+    for (x = 0; x < NNUE_HIDDEN; x++)
+    {
+        i = piUs[x];
+        i = MIN(MAX(i, 0), NNUE_CLIP);
+        iSum += i * pW[x];
+        i = piThem[x];
+        i = MIN(MAX(i, 0), NNUE_CLIP);
+        iSum += i * pW[NNUE_HIDDEN + x];
+    }
+#endif
+    return(iSum);
+}
+
+
+static void
+_NnueRefresh(IN POSITION *pos,
+             IN ULONG uPerspective,
+             OUT SHORT *piDest)
+/**
+
+Routine description:
+
+    Compute uPerspective's accumulator for pos from scratch.
+
+Parameters:
+
+    POSITION *pos,
+    ULONG uPerspective,
+    SHORT *piDest
+
+Return value:
+
+    static void
+
+**/
+{
+    ULONG uFeatures[NNUE_MAX_DELTA];
+    ULONG uNum = 0;
+    COOR cKing = pos->cNonPawns[uPerspective][0];
+    ULONG uColor;
+    ULONG u;
+    COOR c;
+
+    ASSERT(IS_KING(pos->rgSquare[cKing].pPiece));
+    FOREACH_COLOR(uColor)
+    {
+        for (u = 1; u < pos->uNonPawnCount[uColor][0]; u++)
+        {
+            c = pos->cNonPawns[uColor][u];
+            uFeatures[uNum++] = _NnueFeature(uPerspective, cKing,
+                                             pos->rgSquare[c].pPiece, c);
+        }
+        for (u = 0; u < pos->uPawnCount[uColor]; u++)
+        {
+            c = pos->cPawns[uColor][u];
+            uFeatures[uNum++] = _NnueFeature(uPerspective, cKing,
+                                             pos->rgSquare[c].pPiece, c);
+        }
+    }
+    ASSERT(uNum <= NNUE_MAX_DELTA);
+    _NnueApplyDelta(piDest, g_Nnue.piFeatureBias, uFeatures, uNum, NULL, 0);
+}
+
+
+static void
+_NnueApplyMove(IN ULONG uPerspective,
+               IN COOR cKing,
+               IN MOVE mv,
+               IN SHORT *piSrc,
+               OUT SHORT *piDest)
+/**
+
+Routine description:
+
+    Compute uPerspective's accumulator after mv from the one before
+    it.  uPerspective's king must not be the piece moving.
+
+Parameters:
+
+    ULONG uPerspective,
+    COOR cKing : uPerspective's king
+    MOVE mv,
+    SHORT *piSrc : accumulator before mv
+    SHORT *piDest : accumulator after mv
+
+Return value:
+
+    static void
+
+**/
+{
+    static const int iSign[2] = { -1, +1 };
+    ULONG uAdd[2], uSub[2];
+    ULONG uNumAdd = 0, uNumSub = 0;
+    PIECE pRook;
+
+    if (mv.uMove != 0)
+    {
+        if (IS_CASTLE(mv))
+        {
+            ASSERT(GET_COLOR(mv.pMoved) != uPerspective);
+            pRook = BLACK_ROOK | GET_COLOR(mv.pMoved);
+            switch(mv.cTo)
+            {
+                case C1:
+                    uSub[uNumSub++] = _NnueFeature(uPerspective, cKing,
+                                                   pRook, A1);
+                    uAdd[uNumAdd++] = _NnueFeature(uPerspective, cKing,
+                                                   pRook, D1);
+                    break;
+                case G1:
+                    uSub[uNumSub++] = _NnueFeature(uPerspective, cKing,
+                                                   pRook, H1);
+                    uAdd[uNumAdd++] = _NnueFeature(uPerspective, cKing,
+                                                   pRook, F1);
+                    break;
+                case C8:
+                    uSub[uNumSub++] = _NnueFeature(uPerspective, cKing,
+                                                   pRook, A8);
+                    uAdd[uNumAdd++] = _NnueFeature(uPerspective, cKing,
+                                                   pRook, D8);
+                    break;
+                case G8:
+                    uSub[uNumSub++] = _NnueFeature(uPerspective, cKing,
+                                                   pRook, H8);
+                    uAdd[uNumAdd++] = _NnueFeature(uPerspective, cKing,
+                                                   pRook, F8);
+                    break;
+                default:
+                    ASSERT(FALSE);
+                    break;
+            }
+        }
+        else
+        {
+            if (!IS_KING(mv.pMoved))
+            {
+                uSub[uNumSub++] = _NnueFeature(uPerspective, cKing,
+                                               mv.pMoved, mv.cFrom);
+                uAdd[uNumAdd++] = _NnueFeature(uPerspective, cKing,
+                                               (mv.pPromoted ?
+                                                mv.pPromoted : mv.pMoved),
+                                               mv.cTo);
+            }
+            else
+            {
+                ASSERT(GET_COLOR(mv.pMoved) != uPerspective);
+            }
+            if (mv.pCaptured)
+            {
+                uSub[uNumSub++] = _NnueFeature(uPerspective, cKing,
+                                               mv.pCaptured,
+                                               (IS_ENPASSANT(mv) ?
+                                                mv.cTo + iSign[GET_COLOR(mv.pMoved)] * 16 :
+                                                mv.cTo));
+            }
+        }
+    }
+    ASSERT(uNumAdd <= ARRAY_LENGTH(uAdd));
+    ASSERT(uNumSub <= ARRAY_LENGTH(uSub));
+    _NnueApplyDelta(piDest, piSrc, uAdd, uNumAdd, uSub, uNumSub);
+}
+
+
+static INLINE UINT64
+_NnuePlySig(IN SEARCHER_THREAD_CONTEXT *ctx,
+            IN ULONG uPly)
+{
+    POSITION *pos = &(ctx->sPosition);
+
+    if (uPly == ctx->uPly)
+    {
+        return((pos->u64NonPawnSig ^ pos->u64PawnSig) ^ g_Nnue.u64Salt);
+    }
+    ASSERT(uPly < ctx->uPly);
+    return(ctx->sPlyInfo[uPly].u64Sig ^ g_Nnue.u64Salt);
+}
+
+
+static void
+_NnueUpdateAccumulator(IN OUT SEARCHER_THREAD_CONTEXT *ctx,
+                       IN ULONG uPerspective)
+/**
+
+Routine description:
+
+    Make uPerspective's half of the accumulator at ctx->uPly valid for
+    the current position.  Walk back up the line to the nearest ply
+    whose accumulator is valid and replay the moves since then; if
+    uPerspective's king moved on the way (or nothing is valid) just
+    recompute it from scratch.
+
+Parameters:
+
+    SEARCHER_THREAD_CONTEXT *ctx,
+    ULONG uPerspective
+
+Return value:
+
+    static void
+
+**/
+{
+    POSITION *pos = &(ctx->sPosition);
+    COOR cKing = pos->cNonPawns[uPerspective][0];
+    ULONG uPly = ctx->uPly;
+    ULONG u;
+    MOVE mv;
+
+    if (ctx->sNnue[uPly].u64Sig[uPerspective] == _NnuePlySig(ctx, uPly))
+    {
+        INC(ctx->sCounters.nnue.u64Hits);
+        return;
+    }
+
+    for (u = uPly; u > 0; u--)
+    {
+        mv = ctx->sPlyInfo[u - 1].mv;
+        if ((mv.uMove != 0) &&
+            IS_KING(mv.pMoved) &&
+            (GET_COLOR(mv.pMoved) == uPerspective))
+        {
+            break;
+        }
+        if (ctx->sNnue[u - 1].u64Sig[uPerspective] ==
+            _NnuePlySig(ctx, u - 1))
+        {
+            //
+            // Found one; bring the plies after it up to date.
+            //
+            for (u = u - 1; u < uPly; u++)
+            {
+                _NnueApplyMove(uPerspective,
+                               cKing,
+                               ctx->sPlyInfo[u].mv,
+                               ctx->sNnue[u].iValue[uPerspective],
+                               ctx->sNnue[u + 1].iValue[uPerspective]);
+                ctx->sNnue[u + 1].u64Sig[uPerspective] =
+                    _NnuePlySig(ctx, u + 1);
+                INC(ctx->sCounters.nnue.u64Updates);
+            }
+            return;
+        }
+    }
+
+    _NnueRefresh(pos, uPerspective, ctx->sNnue[uPly].iValue[uPerspective]);
+    ctx->sNnue[uPly].u64Sig[uPerspective] = _NnuePlySig(ctx, uPly);
+    INC(ctx->sCounters.nnue.u64Refreshes);
+}
+
+
+static SCORE
+_NnueScore(IN INT iRaw)
+/**
+
+Routine description:
+
+    Scale a raw network output to a score.
+
+Parameters:
+
+    INT iRaw
+
+Return value:
+
+    static SCORE
+
+**/
+{
+    INT i = iRaw / (INT)g_Nnue.uOutputDivisor;
+
+    i = MIN(MAX(i, -NNUE_MAX_SCORE), +NNUE_MAX_SCORE);
+    return((SCORE)i);
+}
+
+
+SCORE
+NnueEval(IN SEARCHER_THREAD_CONTEXT *ctx)
+/**
+
+Routine description:
+
+    Evaluate the position in ctx with the loaded network using (and
+    updating) the accumulator stack in ctx.
+
+Parameters:
+
+    SEARCHER_THREAD_CONTEXT *ctx
+
+Return value:
+
+    SCORE : the score for the side to move
+
+**/
+{
+    POSITION *pos = &(ctx->sPosition);
+    NNUE_ACCUMULATOR *pAcc = &(ctx->sNnue[ctx->uPly]);
+#ifdef DEBUG
+    SHORT iCheck[NNUE_HIDDEN];
+#endif
+
+    ASSERT(NnueNetworkIsLoaded());
+    ASSERT(ctx->uPly <= MAX_PLY_PER_SEARCH);
+    _NnueUpdateAccumulator(ctx, BLACK);
+    _NnueUpdateAccumulator(ctx, WHITE);
+#ifdef DEBUG
+    _NnueRefresh(pos, BLACK, iCheck);
+    ASSERT(!memcmp(iCheck, pAcc->iValue[BLACK], sizeof(iCheck)));
+    _NnueRefresh(pos, WHITE, iCheck);
+    ASSERT(!memcmp(iCheck, pAcc->iValue[WHITE], sizeof(iCheck)));
+#endif
+    return(_NnueScore(_NnueOutput(pAcc->iValue[pos->uToMove],
+                                  pAcc->iValue[FLIP(pos->uToMove)])));
+}
+
+
+SCORE
+NnueEvalPosition(IN POSITION *pos)
+/**
+
+Routine description:
+
+    Evaluate pos with the loaded network from scratch.
+
+Parameters:
+
+    POSITION *pos
+
+Return value:
+
+    SCORE : the score for the side to move
+
+**/
+{
+    SHORT iAcc[2][NNUE_HIDDEN];
+
+    ASSERT(NnueNetworkIsLoaded());
+    _NnueRefresh(pos, BLACK, iAcc[BLACK]);
+    _NnueRefresh(pos, WHITE, iAcc[WHITE]);
+    return(_NnueScore(_NnueOutput(iAcc[pos->uToMove],
+                                  iAcc[FLIP(pos->uToMove)])));
+}
+
+
+FLAG
+NnueNetworkIsLoaded(void)
+{
+    return(g_Nnue.piFeatureBias != NULL);
+}
+
+
+static void
+_NnueEvaluatorChanged(void)
+/**
+
+Routine description:
+
+    The static eval just changed (new weights or a different
+    evaluator) so every score cached under the old one is stale.
+    Throw out the main hash table and the eval hashes.
+
+Parameters:
+
+    void
+
+Return value:
+
+    void
+
+**/
+{
+    ClearHashTable();
+    ClearEvalHashTables();
+}
+
+
+FLAG
+ReadNnueNetwork(IN FILE *p,
+                IN CHAR *szFilename)
+/**
+
+Routine description:
+
+    Read a network from an open weight file and, if it's good, make
+    it the current network.  The old network (if any) stays in place
+    if the file can't be read.  This frees the old weights so it must
+    not be called while a search is running.
+
+Parameters:
+
+    FILE *p : positioned at the start of the network
+    CHAR *szFilename : for messages
+
+Return value:
+
+    FLAG
+
+**/
+{
+    NNUE_FILE_HEADER sHeader;
+    NNUE_NETWORK sNet;
+    SHORT *pMem = NULL;
+    FLAG fRet = FALSE;
+
+    if ((1 != fread(&sHeader, sizeof(sHeader), 1, p)) ||
+        (sHeader.uMagic != NNUE_FILE_MAGIC) ||
+        (sHeader.uVersion != NNUE_FILE_VERSION))
+    {
+        Trace("Error (not a version %u NNUE file): %s\n",
+              NNUE_FILE_VERSION, szFilename);
+        goto end;
+    }
+    if ((sHeader.uInputs != NNUE_INPUTS) ||
+        (sHeader.uHidden != NNUE_HIDDEN) ||
+        (sHeader.uOutputDivisor == 0))
+    {
+        Trace("Error (NNUE file is %ux%u/%u, expected %ux%u): %s\n",
+              sHeader.uInputs, sHeader.uHidden, sHeader.uOutputDivisor,
+              NNUE_INPUTS, NNUE_HIDDEN, szFilename);
+        goto end;
+    }
+
+    pMem = SystemAllocateMemory(NNUE_NETWORK_BYTES);
+    sNet.piFeatureBias = pMem;
+    sNet.piFeatureWeight = sNet.piFeatureBias + NNUE_HIDDEN;
+    sNet.piOutputWeight = sNet.piFeatureWeight + NNUE_INPUTS * NNUE_HIDDEN;
+    sNet.iOutputBias = sHeader.iOutputBias;
+    sNet.uOutputDivisor = sHeader.uOutputDivisor;
+    if (1 != fread(pMem, NNUE_NETWORK_BYTES, 1, p))
+    {
+        Trace("Error (truncated NNUE file): %s\n", szFilename);
+        goto end;
+    }
+
+    //
+    // Looks good, swap it in.  A new salt invalidates every
+    // accumulator computed with the old weights.
+    //
+    if (NULL != g_Nnue.piFeatureBias)
+    {
+        SystemFreeMemory(g_Nnue.piFeatureBias);
+    }
+    g_uNnueLoads++;
+    sNet.u64Salt = (UINT64)g_uNnueLoads * 0x9E3779B97F4A7C15ULL;
+    g_Nnue = sNet;
+    pMem = NULL;
+    Trace("Loaded NNUE network from \"%s\" (%ux%u).\n",
+          szFilename, NNUE_INPUTS, NNUE_HIDDEN);
+    if (g_Options.fUseNnue)
+    {
+        _NnueEvaluatorChanged();
+    }
+    fRet = TRUE;
+
+ end:
+    if (NULL != pMem) SystemFreeMemory(pMem);
+    return(fRet);
+}
+
+
+FLAG
+LoadNnueNetwork(IN CHAR *szFilename)
+/**
+
+Routine description:
+
+    Open a weight file and hand it to ReadNnueNetwork.
+
+Parameters:
+
+    CHAR *szFilename
+
+Return value:
+
+    FLAG
+
+**/
+{
+    FILE *p;
+    FLAG fRet;
+
+    p = fopen(szFilename, "rb");
+    if (NULL == p)
+    {
+        Trace("Failed to open file \"%s\"\n", szFilename);
+        return(FALSE);
+    }
+    fRet = ReadNnueNetwork(p, szFilename);
+    fclose(p);
+    return(fRet);
+}
+
+
+static void
+_SelectEvalTypeNow(void)
+/**
+
+Routine description:
+
+    Pick the evaluator named by g_Options.szEvalType: "classic"
+    (eval.c) or "nnue".  NNUE needs a network so fall back to classic
+    if none is loaded.
+
+Parameters:
+
+    void
+
+Return value:
+
+    void
+
+**/
+{
+    FLAG fWasNnue = g_Options.fUseNnue;
+
+    g_fEvalTypePending = FALSE;
+    if (!STRCMPI(g_Options.szEvalType, "nnue"))
+    {
+        if (FALSE == NnueNetworkIsLoaded())
+        {
+            Trace("Error (no NNUE network loaded, set NNUEFile first)\n");
+            strcpy(g_Options.szEvalType, "classic");
+            g_Options.fUseNnue = FALSE;
+        }
+        else
+        {
+            g_Options.fUseNnue = TRUE;
+        }
+    }
+    else if (!STRCMPI(g_Options.szEvalType, "classic"))
+    {
+        g_Options.fUseNnue = FALSE;
+    }
+    else
+    {
+        Trace("Error (unknown eval type, must be classic or nnue): %s\n",
+              g_Options.szEvalType);
+        strcpy(g_Options.szEvalType,
+               (g_Options.fUseNnue) ? "nnue" : "classic");
+    }
+    if (fWasNnue != g_Options.fUseNnue)
+    {
+        _NnueEvaluatorChanged();
+    }
+}
+
+
+static void
+_InitializeNnueNow(void)
+/**
+
+Routine description:
+
+    Load the network named by g_Options.szNnueFile (if any) and then
+    revalidate the eval type.
+
+Parameters:
+
+    void
+
+Return value:
+
+    void
+
+**/
+{
+    g_fNnueFilePending = FALSE;
+    if (g_Options.szNnueFile[0] != '\0')
+    {
+        (void)LoadNnueNetwork(g_Options.szNnueFile);
+    }
+    _SelectEvalTypeNow();
+}
+
+
+void
+SelectEvalType(void)
+/**
+
+Routine description:
+
+    Called at startup and when the EvalType variable changes.  "set"
+    works while we are thinking or pondering; switching evaluators in
+    the middle of a tree would mix scores from both so in that case
+    the change waits for the next search (see
+    ApplyPendingNnueChanges).
+
+Parameters:
+
+    void
+
+Return value:
+
+    void
+
+**/
+{
+    if (g_Options.fThinking || g_Options.fPondering)
+    {
+        Trace("EvalType change will take effect at the next search.\n");
+        g_fEvalTypePending = TRUE;
+        return;
+    }
+    _SelectEvalTypeNow();
+}
+
+
+void
+InitializeNnue(void)
+/**
+
+Routine description:
+
+    Called at startup and when the NNUEFile variable changes: load
+    the network named by g_Options.szNnueFile (if any) and then
+    revalidate the eval type.  Loading frees the old weights, which
+    searcher threads may be reading, so during a search this waits
+    for the next one (see ApplyPendingNnueChanges).
+
+Parameters:
+
+    void
+
+Return value:
+
+    void
+
+**/
+{
+    if (g_Options.fThinking || g_Options.fPondering)
+    {
+        Trace("NNUEFile change will take effect at the next search.\n");
+        g_fNnueFilePending = TRUE;
+        return;
+    }
+    _InitializeNnueNow();
+}
+
+
+void
+ApplyPendingNnueChanges(void)
+/**
+
+Routine description:
+
+    Called at the start of a search, before any thread evaluates, to
+    carry out NNUEFile / EvalType changes that had to be put off.
+
+Parameters:
+
+    void
+
+Return value:
+
+    void
+
+**/
+{
+    if (g_fNnueFilePending)
+    {
+        _InitializeNnueNow();
+    }
+    else if (g_fEvalTypePending)
+    {
+        _SelectEvalTypeNow();
+    }
+}
+
+
+void
+CleanupNnue(void)
+/**
+
+Routine description:
+
+    Free the network.
+
+Parameters:
+
+    void
+
+Return value:
+
+    void
+
+**/
+{
+    if (NULL != g_Nnue.piFeatureBias)
+    {
+        SystemFreeMemory(g_Nnue.piFeatureBias);
+    }
+    memset(&g_Nnue, 0, sizeof(g_Nnue));
+    g_Options.fUseNnue = FALSE;
+}
@@ -22,6 +22,224 @@ Revision History:
 
 #include "chess.h"
 
+ULONG g_uPawnHashTableSizeEntries = 0;
+static PAWN_HASH_ENTRY *g_pPawnHashTables[MAX_SEARCHER_THREADS];
+static ULONG g_uNumPawnHashTables = 0;
+
+static UINT64
+_PawnHashEntryChecksum(IN const PAWN_HASH_ENTRY *pHash)
+/**
+
+Routine description:
+
+    XOR together all of the data words in a pawn hash entry (i.e. all
+    but the key).  When the pawn hash is shared between threads
+    entries are stored with their key XORed with this so that a
+    reader can detect an entry torn by a concurrent writer without
+    taking a lock.
+
+Parameters:
+
+    const PAWN_HASH_ENTRY *pHash
+
+Return value:
+
+    UINT64
+
+**/
+{
+    UINT64 u64Words[sizeof(PAWN_HASH_ENTRY) / sizeof(UINT64)];
+    UINT64 u64Sum = 0;
+    ULONG u;
+
+    memcpy(u64Words, pHash, sizeof(u64Words));
+    for (u = 1; u < ARRAY_LENGTH(u64Words); u++)
+    {
+        u64Sum ^= u64Words[u];
+    }
+    return(u64Sum);
+}
+
+
+FLAG
+InitializePawnHashSystem(void)
+/**
+
+Routine description:
+
+    Allocate the pawn hash table(s): by default a single table that
+    every thread probes or, if the user asked for --privatepawnhash,
+    one per searcher thread.
+
+Parameters:
+
+    void
+
+Return value:
+
+    FLAG
+
+**/
+{
+    ULONG u;
+
+    if (!IS_A_POWER_OF_2(g_Options.uNumPawnHashEntries))
+    {
+        return(FALSE);
+    }
+    if (g_Options.uNumPawnHashEntries < PAWN_HASH_WAYS)
+    {
+        g_Options.uNumPawnHashEntries = PAWN_HASH_WAYS;
+    }
+    g_uPawnHashTableSizeEntries = g_Options.uNumPawnHashEntries;
+    g_uNumPawnHashTables = 1;
+#ifdef MP
+    if (FALSE == g_Options.fSharedPawnHash)
+    {
+        g_uNumPawnHashTables = g_Options.uNumProcessors;
+    }
+#endif
+    ASSERT(g_uNumPawnHashTables <= MAX_SEARCHER_THREADS);
+    for (u = 0; u < g_uNumPawnHashTables; u++)
+    {
+        ASSERT(g_pPawnHashTables[u] == NULL);
+        g_pPawnHashTables[u] = 
+            SystemAllocateMemory(g_uPawnHashTableSizeEntries * 
+                                 sizeof(PAWN_HASH_ENTRY));
+    }
+    ClearPawnHashTables();
+    return(TRUE);
+}
+
+
+void
+CleanupPawnHashSystem(void)
+/**
+
+Routine description:
+
+    Free the pawn hash table(s).
+
+Parameters:
+
+    void
+
+Return value:
+
+    void
+
+**/
+{
+    ULONG u;
+
+    for (u = 0; u < g_uNumPawnHashTables; u++)
+    {
+        if (NULL != g_pPawnHashTables[u])
+        {
+            SystemFreeMemory(g_pPawnHashTables[u]);
+            g_pPawnHashTables[u] = NULL;
+        }
+    }
+    g_uNumPawnHashTables = 0;
+    g_uPawnHashTableSizeEntries = 0;
+}
+
+
+void
+ClearPawnHashTables(void)
+/**
+
+Routine description:
+
+    Zero out the pawn hash table(s).  Called when a new game starts
+    and when the eval weights change underneath the cached scores.
+    Positions with no pawns at all have a zero pawn signature so the
+    keys of the cleared entries are set to something else; otherwise
+    such a position would "hit" an empty entry (e.g. one with all of
+    its stormer squares on a8).
+
+Parameters:
+
+    void
+
+Return value:
+
+    void
+
+**/
+{
+    ULONG u, v;
+
+    for (u = 0; u < g_uNumPawnHashTables; u++)
+    {
+        memset(g_pPawnHashTables[u], 0, 
+               g_uPawnHashTableSizeEntries * sizeof(PAWN_HASH_ENTRY));
+        for (v = 0; v < g_uPawnHashTableSizeEntries; v++)
+        {
+            g_pPawnHashTables[u][v].u64Key = ~0ULL;
+        }
+    }
+}
+
+
+PAWN_HASH_ENTRY *
+GetPawnHashTable(ULONG uThreadNumber)
+/**
+
+Routine description:
+
+    Return the pawn hash table that searcher thread number
+    uThreadNumber should use.  NULL if the tables are not allocated
+    yet; only eval cares.
+
+Parameters:
+
+    ULONG uThreadNumber
+
+Return value:
+
+    PAWN_HASH_ENTRY *
+
+**/
+{
+    if (uThreadNumber >= g_uNumPawnHashTables)
+    {
+        ASSERT(g_uNumPawnHashTables <= 1);
+        uThreadNumber = 0;
+    }
+    return(g_pPawnHashTables[uThreadNumber]);
+}
+
+
+static INLINE PAWN_HASH_ENTRY *
+_PawnHashBucket(IN SEARCHER_THREAD_CONTEXT *ctx,
+                IN UINT64 u64Sig)
+/**
+
+Routine description:
+
+    Return a pointer to the first entry of the bucket that a pawn
+    signature maps to.  A bucket is PAWN_HASH_WAYS consecutive
+    entries.
+
+Parameters:
+
+    SEARCHER_THREAD_CONTEXT *ctx,
+    UINT64 u64Sig
+
+Return value:
+
+    PAWN_HASH_ENTRY *
+
+**/
+{
+    ULONG u = (ULONG)u64Sig & (g_uPawnHashTableSizeEntries - 1);
+
+    u &= ~(PAWN_HASH_WAYS - 1);
+    ASSERT(u + PAWN_HASH_WAYS <= g_uPawnHashTableSizeEntries);
+    return(&(ctx->pPawnHash[u]));
+}
+
 
 PAWN_HASH_ENTRY *
 PawnHashLookup(SEARCHER_THREAD_CONTEXT *ctx) 
@@ -32,14 +250,17 @@ Routine description:
     Called by eval with a pointer to a POSITION, look in our pawn hash
     to see if we have an entry that matches the pawn structure in the
     POSITION.  If so, "check out" that entry and return a pointer to
-    it.
+    it.  Both ways of the bucket the signature maps to are checked.
 
-    Note: there is a multi-probing scheme in place to remove
-    contention on MP machines.
+    On a hit in a table that is private to this thread the pointer is
+    into the table itself.  If the table is shared the entry is copied
+    into a scratch entry in the context and validated there.  On a
+    miss the scratch entry comes back with a key that does not match;
+    the caller can fill it in and publish it with PawnHashStore.
 
 Parameters:
 
-    POSITION *pos
+    SEARCHER_THREAD_CONTEXT *ctx
 
 Return value:
 
@@ -47,7 +268,71 @@ Return value:
 
 **/
 {
-    POSITION *pos = &(ctx->sPosition);
-    ULONG u = (ULONG)pos->u64PawnSig & (PAWN_HASH_TABLE_SIZE - 1);
-    return(&(ctx->rgPawnHash[u]));
+    UINT64 u64Sig = ctx->sPosition.u64PawnSig;
+    PAWN_HASH_ENTRY *pBucket = _PawnHashBucket(ctx, u64Sig);
+    PAWN_HASH_ENTRY *pHash = &(ctx->sPawnHashScratch);
+    ULONG u;
+
+    for (u = 0; u < PAWN_HASH_WAYS; u++)
+    {
+        if (FALSE == g_Options.fSharedPawnHash)
+        {
+            if (pBucket[u].u64Key == u64Sig)
+            {
+                return(&(pBucket[u]));
+            }
+        }
+        else
+        {
+            memcpy(pHash, &(pBucket[u]), sizeof(PAWN_HASH_ENTRY));
+            if ((pHash->u64Key ^ _PawnHashEntryChecksum(pHash)) == u64Sig)
+            {
+                pHash->u64Key = u64Sig;
+                return(pHash);
+            }
+        }
+    }
+    pHash->u64Key = ~u64Sig;
+    return(pHash);
+}
+
+
+void
+PawnHashStore(SEARCHER_THREAD_CONTEXT *ctx,
+              PAWN_HASH_ENTRY *pHash)
+/**
+
+Routine description:
+
+    Called by eval after it has populated the pawn hash entry that it
+    got back from a missed PawnHashLookup.  The new entry goes into
+    the first way of its bucket and whatever was there is moved down
+    to the second way, evicting the least recently stored entry.
+    Entries in a shared table are stored with their key XORed with
+    their checksum so that copying one that another thread is busy
+    writing yields an entry that simply fails to match.
+
+Parameters:
+
+    SEARCHER_THREAD_CONTEXT *ctx,
+    PAWN_HASH_ENTRY *pHash
+
+Return value:
+
+    void
+
+**/
+{
+    PAWN_HASH_ENTRY *pBucket;
+
+    ASSERT(pHash == &(ctx->sPawnHashScratch));
+    ASSERT(pHash->u64Key == ctx->sPosition.u64PawnSig);
+    ASSERT(PAWN_HASH_WAYS == 2);
+    pBucket = _PawnHashBucket(ctx, pHash->u64Key);
+    memcpy(&(pBucket[1]), &(pBucket[0]), sizeof(PAWN_HASH_ENTRY));
+    memcpy(&(pBucket[0]), pHash, sizeof(PAWN_HASH_ENTRY));
+    if (TRUE == g_Options.fSharedPawnHash)
+    {
+        pBucket[0].u64Key = pHash->u64Key ^ _PawnHashEntryChecksum(pHash);
+    }
 }
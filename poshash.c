@@ -10,6 +10,21 @@ Abstract:
 
     A hash table of information about positions.
 
+    Each entry is packed into a single 64 bit word so that it can be
+    read and written atomically; no locks are needed even though Eval
+    on every searcher thread writes here.  The layout is:
+
+        bits  0..15 : cEnprise[BLACK], cEnprise[WHITE]
+        bits 16..31 : cTrapped[BLACK], cTrapped[WHITE]
+        bits 32..39 : uEnpriseCount[BLACK], uEnpriseCount[WHITE] (4 each)
+        bits 40..62 : the same bits of the position signature (check)
+        bit  63     : entry is valid
+
+    The low bits of the signature pick the slot and bits 40..62 of it
+    are kept in the entry to verify a hit.  Updates are a plain
+    read-modify-write; if two threads race on one entry one of their
+    updates is lost, which is fine for a table of hints.
+
 Author:
 
     Scott Gasch (SGasch) 11 Nov 2006
@@ -20,38 +35,71 @@ Revision History:
 
 #include "chess.h"
 
-#define NUM_POSITION_HASH_ENTRIES (1048576) // 16Mb
-POSITION_HASH_ENTRY g_PositionHash[NUM_POSITION_HASH_ENTRIES];
-
-#ifdef MP
-#define NUM_POSITION_HASH_LOCKS (512)
-volatile static ULONG g_uPositionHashLocks[NUM_POSITION_HASH_LOCKS];
-#define POSITION_HASH_IS_LOCKED(x) ((g_uPositionHashLocks[(x)]) != 0)
-#define LOCK_POSITION_HASH(x) \
-    AcquireSpinLock(&(g_uPositionHashLocks[(x)])); \
-    ASSERT(POSITION_HASH_IS_LOCKED(x))
-#define UNLOCK_POSITION_HASH(x) \
-    ASSERT(POSITION_HASH_IS_LOCKED(x)); \
-    ReleaseSpinLock(&(g_uPositionHashLocks[(x)]))
-#else
-#define POSITION_HASH_IS_LOCKED(x)
-#define LOCK_HASH(x)
-#define UNLOCK_HASH(x)
-#endif
+ULONG g_uPositionHashTableSizeEntries = 0;
+static POSITION_HASH_ENTRY *g_pPositionHash = NULL;
+
+#define PH_VALID              (0x8000000000000000ULL)
+#define PH_CHECK_MASK         (0x7FFFFF0000000000ULL)
+#define PH_CHECK(sig)         (((sig) & PH_CHECK_MASK) | PH_VALID)
+#define PH_IS_HIT(e, sig)     (((e) & (PH_CHECK_MASK | PH_VALID)) == \
+                               PH_CHECK(sig))
+
+#define PH_ENPRISE_SHIFT(s)   (8 * (s))
+#define PH_TRAPPED_SHIFT(s)   (16 + 8 * (s))
+#define PH_COUNT_SHIFT(s)     (32 + 4 * (s))
+
+#define PH_ENPRISE(e, s)      ((COOR)(((e) >> PH_ENPRISE_SHIFT(s)) & 0xFF))
+#define PH_TRAPPED(e, s)      ((COOR)(((e) >> PH_TRAPPED_SHIFT(s)) & 0xFF))
+#define PH_COUNT(e, s)        ((ULONG)(((e) >> PH_COUNT_SHIFT(s)) & 0xF))
+
+#define PH_SET(e, shift, mask, x) \
+    (((e) & ~((UINT64)(mask) << (shift))) | ((UINT64)(x) << (shift)))
+
+//
+// A fresh entry: nothing en prise or trapped for either side.
+//
+#define PH_EMPTY(sig)                                          \
+    (PH_CHECK(sig) |                                           \
+     ((UINT64)ILLEGAL_COOR << PH_ENPRISE_SHIFT(BLACK)) |       \
+     ((UINT64)ILLEGAL_COOR << PH_ENPRISE_SHIFT(WHITE)) |       \
+     ((UINT64)ILLEGAL_COOR << PH_TRAPPED_SHIFT(BLACK)) |       \
+     ((UINT64)ILLEGAL_COOR << PH_TRAPPED_SHIFT(WHITE)))
+
+void
+InitializePositionHashSystem(void)
+{
+    ULONG u = g_Options.uNumPositionHashEntries;
+
+    ASSERT(g_pPositionHash == NULL);
+    if ((u == 0) || !IS_A_POWER_OF_2(u))
+    {
+        u = DEFAULT_POSITION_HASH_ENTRIES;
+    }
+    g_uPositionHashTableSizeEntries = u;
+    g_pPositionHash =
+        SystemAllocateMemory(u * sizeof(POSITION_HASH_ENTRY));
+    ClearPositionHashTable();
+}
 
 void
-InitializePositionHashSystem(void) 
+CleanupPositionHashSystem(void)
 {
-    memset(&g_PositionHash, 0, sizeof(g_PositionHash));
-#ifdef MP
-    memset(&g_uPositionHashLocks, 0, sizeof(g_uPositionHashLocks));
-#endif
+    if (NULL != g_pPositionHash)
+    {
+        SystemFreeMemory(g_pPositionHash);
+        g_pPositionHash = NULL;
+    }
+    g_uPositionHashTableSizeEntries = 0;
 }
 
 void
-CleanupPositionHashSystem(void) 
+ClearPositionHashTable(void)
 {
-    ; // do nothing
+    if (NULL != g_pPositionHash)
+    {
+        memset(g_pPositionHash, 0,
+               g_uPositionHashTableSizeEntries * sizeof(POSITION_HASH_ENTRY));
+    }
 }
 
 static INLINE UINT64 PositionToSignatureIgnoringMove(POSITION *pos)
@@ -60,217 +108,170 @@ static INLINE UINT64 PositionToSignatureIgnoringMove(POSITION *pos)
 }
 
 // Note: sig must be pre-shifted to ignore the side-to-move bit.
-static INLINE ULONG PositionSigToHashPosition(UINT64 u64Sig) 
+static INLINE POSITION_HASH_ENTRY *PositionSigToHashEntry(UINT64 u64Sig)
 {
     ULONG u = (ULONG)u64Sig;
-    u &= (NUM_POSITION_HASH_ENTRIES - 1);
-    ASSERT(u < NUM_POSITION_HASH_ENTRIES);
-    return u;
+    u &= (g_uPositionHashTableSizeEntries - 1);
+    ASSERT(u < g_uPositionHashTableSizeEntries);
+    return(&(g_pPositionHash[u]));
 }
 
-#ifdef MP
-static INLINE ULONG HashPositionToLockNumber(ULONG u) 
+//
+// Read the entry for ctx's position; a miss reads as an empty entry.
+//
+static INLINE UINT64
+ProbePositionHash(SEARCHER_THREAD_CONTEXT *ctx)
 {
-    u &= (NUM_POSITION_HASH_LOCKS - 1);
-    ASSERT(u < NUM_POSITION_HASH_LOCKS);
-    return u;
+    UINT64 u64Sig = PositionToSignatureIgnoringMove(&ctx->sPosition);
+    UINT64 e = *PositionSigToHashEntry(u64Sig);
+
+    INC(ctx->sCounters.poshash.u64Probes);
+    if (PH_IS_HIT(e, u64Sig))
+    {
+        INC(ctx->sCounters.poshash.u64Hits);
+        return(e);
+    }
+    return(PH_EMPTY(u64Sig));
+}
+
+//
+// Is the piece at c (according to a hash entry) really there and
+// really uSide's?  The check bits are not the whole signature so
+// guard against the (rare) false hit before using the square.
+//
+static INLINE FLAG
+SquareHoldsPieceOfSide(POSITION *pos, COOR c, ULONG uSide)
+{
+    PIECE p;
+
+    if (!IS_ON_BOARD(c)) return(FALSE);
+    p = pos->rgSquare[c].pPiece;
+    return((p != 0) && (GET_COLOR(p) == uSide) && (!IS_PAWN(p)));
 }
-#endif
 
 void
-StoreEnprisePiece(POSITION *pos, COOR cSquare) 
+StoreEnprisePiece(SEARCHER_THREAD_CONTEXT *ctx, COOR cSquare)
 {
+    POSITION *pos = &ctx->sPosition;
     UINT64 u64Sig = PositionToSignatureIgnoringMove(pos);
-    ULONG uEntry = PositionSigToHashPosition(u64Sig);
-    POSITION_HASH_ENTRY *pHash = &(g_PositionHash[uEntry]);
+    POSITION_HASH_ENTRY *pHash = PositionSigToHashEntry(u64Sig);
+    UINT64 e = *pHash;
     PIECE p = pos->rgSquare[cSquare].pPiece;
     ULONG uColor = GET_COLOR(p);
-#ifdef MP
-    ULONG uLock = HashPositionToLockNumber(uEntry);
-    LOCK_POSITION_HASH(uLock);
-#endif
+    ULONG uCount;
+
     ASSERT(p && IS_VALID_PIECE(p));
     ASSERT(!IS_PAWN(p));
     ASSERT(CAN_FIT_IN_UCHAR(cSquare));
     ASSERT(IS_ON_BOARD(cSquare));
-    pHash->cEnprise[uColor] = (UCHAR)cSquare;
-    ASSERT(pHash->uEnpriseCount[uColor] < 16);
-    pHash->uEnpriseCount[uColor] += 1;
-    if (pHash->u64Sig != u64Sig) 
+    INC(ctx->sCounters.poshash.u64Stores);
+    if (!PH_IS_HIT(e, u64Sig))
+    {
+        e = PH_EMPTY(u64Sig);
+    }
+    e = PH_SET(e, PH_ENPRISE_SHIFT(uColor), 0xFF, cSquare);
+    uCount = PH_COUNT(e, uColor);
+    if (uCount < 0xF)
     {
-        pHash->u64Sig = u64Sig;
-        pHash->uEnpriseCount[uColor] = 1;
-        pHash->cTrapped[uColor] = ILLEGAL_COOR;
-        uColor = FLIP(uColor);
-        pHash->cEnprise[uColor] = ILLEGAL_COOR;
-        pHash->cTrapped[uColor] = ILLEGAL_COOR;
-        pHash->uEnpriseCount[uColor] = 0;
+        e = PH_SET(e, PH_COUNT_SHIFT(uColor), 0xF, uCount + 1);
     }
-#ifdef MP
-    UNLOCK_POSITION_HASH(uLock);
-#endif
+    *pHash = e;
 }
 
 void
-StoreTrappedPiece(POSITION *pos, COOR cSquare) 
+StoreTrappedPiece(SEARCHER_THREAD_CONTEXT *ctx, COOR cSquare)
 {
+    POSITION *pos = &ctx->sPosition;
     UINT64 u64Sig = PositionToSignatureIgnoringMove(pos);
-    ULONG uEntry = PositionSigToHashPosition(u64Sig);
-    POSITION_HASH_ENTRY *pHash = &(g_PositionHash[uEntry]);
+    POSITION_HASH_ENTRY *pHash = PositionSigToHashEntry(u64Sig);
+    UINT64 e = *pHash;
     PIECE p = pos->rgSquare[cSquare].pPiece;
     ULONG uColor = GET_COLOR(p);
-#ifdef MP
-    ULONG uLock = HashPositionToLockNumber(uEntry);
-    LOCK_POSITION_HASH(uLock);
-#endif
+
     ASSERT(p && IS_VALID_PIECE(p));
     ASSERT(!IS_PAWN(p));
     ASSERT(CAN_FIT_IN_UCHAR(cSquare));
     ASSERT(IS_ON_BOARD(cSquare));
-    pHash->cTrapped[uColor] = cSquare;
-    if (pHash->u64Sig != u64Sig) 
+    INC(ctx->sCounters.poshash.u64Stores);
+    if (!PH_IS_HIT(e, u64Sig))
     {
-        pHash->u64Sig = u64Sig;
-        pHash->cEnprise[uColor] = ILLEGAL_COOR;
-        pHash->uEnpriseCount[uColor] = 0;
-        uColor = FLIP(uColor);
-        pHash->cEnprise[uColor] = ILLEGAL_COOR;
-        pHash->cTrapped[uColor] = ILLEGAL_COOR;
-        pHash->uEnpriseCount[uColor] = 0;
+        e = PH_EMPTY(u64Sig);
     }
-#ifdef MP
-    UNLOCK_POSITION_HASH(uLock);
-#endif
+    e = PH_SET(e, PH_TRAPPED_SHIFT(uColor), 0xFF, cSquare);
+    *pHash = e;
 }
 
 COOR
-GetEnprisePiece(POSITION *pos, ULONG uSide)
+GetEnprisePiece(SEARCHER_THREAD_CONTEXT *ctx, ULONG uSide)
 {
-    UINT64 u64Sig = PositionToSignatureIgnoringMove(pos);
-    ULONG uEntry = PositionSigToHashPosition(u64Sig);
-    POSITION_HASH_ENTRY *pHash = &(g_PositionHash[uEntry]);
-    COOR c = ILLEGAL_COOR;
-#ifdef MP
-    ULONG uLock = HashPositionToLockNumber(uEntry);
-    LOCK_POSITION_HASH(uLock);
-#endif
-    if (pHash->u64Sig == u64Sig)
-    {
-        c = pHash->cEnprise[uSide];
-    }
-#ifdef MP
-    UNLOCK_POSITION_HASH(uLock);
-#endif
-    return c;
+    return(PH_ENPRISE(ProbePositionHash(ctx), uSide));
 }
 
 COOR
-GetTrappedPiece(POSITION *pos, ULONG uSide)
+GetTrappedPiece(SEARCHER_THREAD_CONTEXT *ctx, ULONG uSide)
 {
-    UINT64 u64Sig = PositionToSignatureIgnoringMove(pos);
-    ULONG uEntry = PositionSigToHashPosition(u64Sig);
-    POSITION_HASH_ENTRY *pHash = &(g_PositionHash[uEntry]);
-    COOR c = ILLEGAL_COOR;
-#ifdef MP
-    ULONG uLock = HashPositionToLockNumber(uEntry);
-    LOCK_POSITION_HASH(uLock);
-#endif
-    if (pHash->u64Sig == u64Sig)
-    {
-        c = pHash->cTrapped[uSide];
-    }
-#ifdef MP
-    UNLOCK_POSITION_HASH(uLock);
-#endif
-    return c;
+    return(PH_TRAPPED(ProbePositionHash(ctx), uSide));
 }
 
 FLAG
-SideCanStandPat(POSITION *pos, ULONG uSide)
+SideCanStandPat(SEARCHER_THREAD_CONTEXT *ctx, ULONG uSide)
 {
-    UINT64 u64Sig = PositionToSignatureIgnoringMove(pos);
-    ULONG uEntry = PositionSigToHashPosition(u64Sig);
-    POSITION_HASH_ENTRY *pHash = &(g_PositionHash[uEntry]);
-    FLAG fStand = TRUE;
-#ifdef MP
-    ULONG uLock = HashPositionToLockNumber(uEntry);
-    LOCK_POSITION_HASH(uLock);
-#endif
-    if (pHash->u64Sig == u64Sig) 
-    {
-        fStand = ((pHash->cTrapped[uSide] == ILLEGAL_COOR) &&
-                  (pHash->uEnpriseCount[uSide] < 2));
-    }
-#ifdef MP
-    UNLOCK_POSITION_HASH(uLock);
-#endif
-    return fStand;
+    UINT64 e = ProbePositionHash(ctx);
+
+    return((PH_TRAPPED(e, uSide) == ILLEGAL_COOR) &&
+           (PH_COUNT(e, uSide) < 2));
 }
 
 ULONG
-ValueOfMaterialInTroubleDespiteMove(POSITION *pos, ULONG uSide) 
+ValueOfMaterialInTroubleDespiteMove(SEARCHER_THREAD_CONTEXT *ctx,
+                                    ULONG uSide)
 {
-    UINT64 u64Sig = PositionToSignatureIgnoringMove(pos);
-    ULONG uEntry = PositionSigToHashPosition(u64Sig);
-    POSITION_HASH_ENTRY *pHash = &(g_PositionHash[uEntry]);
+    POSITION *pos = &ctx->sPosition;
+    UINT64 e = ProbePositionHash(ctx);
     ULONG u = 0;
     COOR c;
-#ifdef MP
-    ULONG uLock = HashPositionToLockNumber(uEntry);
-    LOCK_POSITION_HASH(uLock);
-#endif
-    if (pHash->u64Sig == u64Sig) 
+
+    if (PH_COUNT(e, uSide) > 1)
     {
-        if (pHash->uEnpriseCount[uSide] > 1) 
+        c = PH_ENPRISE(e, uSide);
+        if (SquareHoldsPieceOfSide(pos, c, uSide))
         {
-            c = pHash->cEnprise[uSide];
-            ASSERT(IS_ON_BOARD(c));
             u = PIECE_VALUE(pos->rgSquare[c].pPiece);
             ASSERT(u);
         }
-        c = pHash->cTrapped[uSide];
-        if (IS_ON_BOARD(c)) 
-        {
-            u = MAXU(u, PIECE_VALUE(pos->rgSquare[c].pPiece));
-            ASSERT(u);
-        }
     }
-#ifdef MP
-    UNLOCK_POSITION_HASH(uLock);
-#endif
+    c = PH_TRAPPED(e, uSide);
+    if (SquareHoldsPieceOfSide(pos, c, uSide))
+    {
+        u = MAXU(u, PIECE_VALUE(pos->rgSquare[c].pPiece));
+        ASSERT(u);
+    }
     return u;
 }
 
 ULONG
-ValueOfMaterialInTroubleAfterNull(POSITION *pos, ULONG uSide)
+ValueOfMaterialInTroubleAfterNull(SEARCHER_THREAD_CONTEXT *ctx,
+                                  ULONG uSide)
 {
-    UINT64 u64Sig = PositionToSignatureIgnoringMove(pos);
-    ULONG uEntry = PositionSigToHashPosition(u64Sig);
-    POSITION_HASH_ENTRY *pHash = &(g_PositionHash[uEntry]);
+    POSITION *pos = &ctx->sPosition;
+    UINT64 e = ProbePositionHash(ctx);
     ULONG u = 0;
     COOR c;
-#ifdef MP
-    ULONG uLock = HashPositionToLockNumber(uEntry);
-    LOCK_POSITION_HASH(uLock);
-#endif
-    if (pHash->u64Sig == u64Sig) 
+
+    if (PH_COUNT(e, uSide))
     {
-        if (pHash->uEnpriseCount[uSide])
+        c = PH_ENPRISE(e, uSide);
+        if (SquareHoldsPieceOfSide(pos, c, uSide))
         {
-            c = pHash->cEnprise[uSide];
-            ASSERT(IS_ON_BOARD(c));
             u += PIECE_VALUE(pos->rgSquare[c].pPiece);
             ASSERT(u);
         }
-        c = pHash->cTrapped[uSide];
-        if (IS_ON_BOARD(c))
-        {
-            u = MAXU(PIECE_VALUE(pos->rgSquare[c].pPiece), u);
-            ASSERT(u);
-        }
     }
-#ifdef MP
-    UNLOCK_POSITION_HASH(uLock);
-#endif
+    c = PH_TRAPPED(e, uSide);
+    if (SquareHoldsPieceOfSide(pos, c, uSide))
+    {
+        u = MAXU(PIECE_VALUE(pos->rgSquare[c].pPiece), u);
+        ASSERT(u);
+    }
     return u;
 }
@@ -26,8 +26,6 @@ Revision History:
 #define XX (127)                              // sq not on the board
 #define C_PIECES (3)                          // max num pieces of one color
 
-ULONG g_uEgtbLock = 0;
-
 //
 // define INDEX type
 // 
@@ -105,8 +103,8 @@ extern int TB_CRC_CHECK;
 // Globals
 // 
 static int EGTBMenCount = 0;
+static FLAG g_fEGTBCacheResizePending = FALSE;
 void *egtb_cache = NULL;
-#define EGTB_CACHE_SIZE (8*1024*1024)
 
 
 void 
@@ -136,20 +134,119 @@ Return value:
         if (0 != EGTBMenCount) 
         {
             Trace("Found %d-men endgame tablebases.\n\n", EGTBMenCount);
-            if (NULL != egtb_cache) 
-            {
-                SystemFreeMemory(egtb_cache);
-                egtb_cache = NULL;
-            }
-            egtb_cache = SystemAllocateMemory(EGTB_CACHE_SIZE);
-            if (NULL != egtb_cache)
-            {
-                FTbSetCacheSize(egtb_cache, EGTB_CACHE_SIZE);
-            }
+            ResizeEGTBCache();
         }
     }
 }
 
+static void
+_ResizeEGTBCacheNow(void)
+/**
+
+Routine description:
+
+    [Re]Allocate the EGTB chunk cache at g_Options.uEGTBCacheSize
+    bytes.  Tables that are stored uncompressed are memory mapped by
+    egtb.cpp and do not use this cache at all; it holds decompressed
+    chunks of the others.  A size of zero means no cache (only mapped
+    tables can be probed then).  The caller must make sure nobody is
+    probing: ProbeEGTB does not take a lock.
+
+Parameters:
+
+    void (uses g_Options.uEGTBCacheSize)
+
+Return value:
+
+    void
+
+**/
+{
+    ULONG uSize = g_Options.uEGTBCacheSize;
+
+    g_fEGTBCacheResizePending = FALSE;
+    if (0 == EGTBMenCount)
+    {
+        return;
+    }
+    FTbSetCacheSize(NULL, 0);
+    if (NULL != egtb_cache) 
+    {
+        SystemFreeMemory(egtb_cache);
+        egtb_cache = NULL;
+    }
+    if (0 == uSize)
+    {
+        return;
+    }
+    egtb_cache = SystemAllocateMemory(uSize);
+    if (NULL != egtb_cache)
+    {
+        if (!FTbSetCacheSize(egtb_cache, uSize))
+        {
+            Trace("Error (egtb cache size too small): %u\n", uSize);
+            SystemFreeMemory(egtb_cache);
+            egtb_cache = NULL;
+        }
+    }
+}
+
+void
+ResizeEGTBCache(void)
+/**
+
+Routine description:
+
+    Called once the EGTB system is initialized and when the user uses
+    "set" to change the cache size.  "set" works while we are thinking
+    or pondering and freeing the cache under a running probe would be
+    fatal, so in that case just remember to do it when the next search
+    starts (see ApplyPendingEGTBCacheResize).
+
+Parameters:
+
+    void (uses g_Options.uEGTBCacheSize)
+
+Return value:
+
+    void
+
+**/
+{
+    if (g_Options.fThinking || g_Options.fPondering)
+    {
+        Trace("EGTB cache resize will take effect at the next search.\n");
+        g_fEGTBCacheResizePending = TRUE;
+        return;
+    }
+    _ResizeEGTBCacheNow();
+}
+
+void
+ApplyPendingEGTBCacheResize(void)
+/**
+
+Routine description:
+
+    Called at the start of a search, before any thread can probe, to
+    carry out a cache resize that ResizeEGTBCache had to put off.
+
+Parameters:
+
+    void
+
+Return value:
+
+    void
+
+**/
+{
+    if (g_fEGTBCacheResizePending)
+    {
+        _ResizeEGTBCacheNow();
+    }
+}
+
 void 
 CleanupEGTB(void)
 /**
@@ -212,6 +309,9 @@ Return value:
     COOR c; 
     PIECE p;
     PfnCalcIndex fp;
+#ifdef PERF_COUNTERS
+    double dStart;
+#endif
 
     //
     // EGTB initialized?
@@ -227,6 +327,9 @@ Return value:
         return(FALSE);
     }
     INC(ctx->sCounters.egtb.uProbes);
+#ifdef PERF_COUNTERS
+    dStart = SystemTimeStamp();
+#endif
     memset(pcCount, 0, sizeof(pcCount));
 
     for (x = 0;
@@ -331,7 +434,11 @@ Return value:
         pcCount[5 + p]++;
     }
 
-    AcquireSpinLock(&g_uEgtbLock);
+    //
+    // Note: no lock here.  Computing the index is a pure function and
+    // egtb.cpp's table lookup is safe to call from all the searcher
+    // threads at once.
+    //
     iTB = IDescFindFromCounters(pcCount);
     if (iTB == 0) 
     {
@@ -421,12 +528,12 @@ Return value:
     fResult = TRUE;
 
  end:
-    ReleaseSpinLock(&g_uEgtbLock);
 #ifdef PERF_COUNTERS
     if (fResult == TRUE)
     {
         INC(ctx->sCounters.egtb.uHits);
     }
+    ctx->sCounters.egtb.dProbeSeconds += SystemTimeStamp() - dStart;
 #endif
     return(fResult);
 }
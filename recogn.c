@@ -33,8 +33,6 @@ static COOR QUEENING_SQUARE_BY_COLOR_FILE[2][8] =
 #define RECOGN_INDEX(w, b) \
     (((b) | (w)) + (32 * ((w) && (b))))
 
-typedef ULONG RECOGNIZER(SEARCHER_THREAD_CONTEXT *ctx, SCORE *piScore);
-
 static RECOGNIZER *g_pRecognizers[64];
 static BITV g_bvRecognizerAvailable[32];
 
@@ -860,86 +858,6 @@ Return value:
     return(RECOGN_EXACT);
 }
 
-static void
-_GetPassersCriticalSquares(IN ULONG uColor,
-                           IN COOR cPawn, 
-                           IN OUT COOR *cSquare)
-/**
-
-Routine description:
-
-    In an effort to classify KPK positions I read some stuff in
-    "Pandolfini's Endgame Course" about critical squares.  A critical
-    square of a passed pawn is one that, if occupied by the friendly
-    king, is sufficient to queen that pawn by force.  This code is a
-    helper routing for the KPK recognizer that returns the critical
-    square given a pawn's location for color uColor.
-
-    Note: rook pawns only have one critical square so this code
-    returns the same square three times in this case.
-
-Parameters:
-
-    ULONG uColor,
-    COOR cPawn,
-    COOR *cSquare
-
-Return value:
-
-    static void
-
-**/
-{
-    static COOR cCriticalSquare[2][128] = 
-    {
-        {    
-            0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88,   0,0,0,0,0,0,0,0,
-            0x61, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x66,   0,0,0,0,0,0,0,0,
-            0x61, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x66,   0,0,0,0,0,0,0,0,
-            0x61, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x66,   0,0,0,0,0,0,0,0,
-            0x61, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x66,   0,0,0,0,0,0,0,0,
-            0x61, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x66,   0,0,0,0,0,0,0,0,
-            0x61, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x66,   0,0,0,0,0,0,0,0,
-            0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88,   0,0,0,0,0,0,0,0,
-        },
-        {    
-            0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88,   0,0,0,0,0,0,0,0,
-            0x11, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x16,   0,0,0,0,0,0,0,0,
-            0x11, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x16,   0,0,0,0,0,0,0,0,
-            0x11, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x16,   0,0,0,0,0,0,0,0,
-            0x11, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x16,   0,0,0,0,0,0,0,0,
-            0x11, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x16,   0,0,0,0,0,0,0,0,
-            0x11, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x16,   0,0,0,0,0,0,0,0,
-            0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88,   0,0,0,0,0,0,0,0,
-        } 
-    };
-    ULONG uFile = FILE(cPawn);
-
-    ASSERT(IS_VALID_COLOR(uColor));
-    ASSERT(IS_ON_BOARD(cPawn));
-    ASSERT((RANK(cPawn) != 1) && (RANK(cPawn) != 8));
-    
-    if ((uFile == A) || (uFile == H))
-    {
-        cSquare[0] = cCriticalSquare[uColor][cPawn];
-        cSquare[1] = cCriticalSquare[uColor][cPawn];
-        cSquare[2] = cCriticalSquare[uColor][cPawn];
-        goto end;
-    }
-    cSquare[1] = cCriticalSquare[uColor][cPawn];
-    cSquare[0] = cSquare[1] - 1;
-    cSquare[2] = cSquare[1] + 1;
-    
- end:
-    ASSERT(cSquare[0] != 0);
-    ASSERT(cSquare[1] != 0);
-    ASSERT(cSquare[2] != 0);
-    ASSERT(IS_ON_BOARD(cSquare[0]));
-    ASSERT(IS_ON_BOARD(cSquare[1]));
-    ASSERT(IS_ON_BOARD(cSquare[2]));
-}
-
-
 static ULONG 
 _RecognizeKPK(IN SEARCHER_THREAD_CONTEXT *ctx, 
               IN OUT SCORE *piScore)
@@ -963,9 +881,6 @@ Return value:
     ULONG uStrong;
     ULONG uWeak;
     COOR cPawn, cQueen;
-    COOR cCritical[3];
-    ULONG uDist[2];
-    ULONG u;
     PAWN_HASH_ENTRY *pHash;
     POSITION *pos = &ctx->sPosition;
 
@@ -974,6 +889,48 @@ Return value:
     ASSERT(_NothingBut(pos, PAWN, WHITE));
     ASSERT(_NothingBut(pos, PAWN, BLACK));
 
+    //
+    // A lone pawn against a bare king: the KPK bitbase knows the
+    // answer exactly.
+    //
+    if ((pos->uPawnCount[WHITE] + pos->uPawnCount[BLACK]) == 1)
+    {
+        uStrong = WHITE;
+        if (pos->uPawnCount[WHITE] == 0)
+        {
+            uStrong = BLACK;
+        }
+        uWeak = FLIP(uStrong);
+        cPawn = pos->cPawns[uStrong][0];
+        ASSERT(IS_ON_BOARD(cPawn));
+        ASSERT(IS_PAWN(pos->rgSquare[cPawn].pPiece));
+
+        if (FALSE == ProbeKPKBitbase(uStrong,
+                                     pos->cNonPawns[uStrong][0],
+                                     pos->cNonPawns[uWeak][0],
+                                     cPawn,
+                                     pos->uToMove))
+        {
+            *piScore = 0;
+            return(RECOGN_EXACT);
+        }
+
+        //
+        // It's a win but we do not know how long it takes so this is
+        // only a bound.
+        //
+        cQueen = QUEENING_SQUARE_BY_COLOR_FILE[uStrong][FILE(cPawn)];
+        *piScore = (pos->iMaterialBalance[uStrong] +
+                    VALUE_QUEEN + (2 * VALUE_PAWN) -
+                    (RANK_DISTANCE(cPawn, cQueen) * 32));
+        if (pos->uToMove == uWeak)
+        {
+            *piScore *= -1;
+            return(RECOGN_UPPER);
+        }
+        return(RECOGN_LOWER);
+    }
+
     //
     // Look to see if one side has a winning passed pawn
     //
@@ -1028,102 +985,18 @@ Return value:
 
     //
     // If we get here then no one has a winning passer and one side
-    // has only a lone king -- no pawns.  Do some more "sophisticated"
-    // analysis looking for a won passer.  Also: this is at best a
-    // draw for the weak side.
+    // has only a lone king against several pawns.  This may still be
+    // won for the strong side but it is at best a draw for the weak
+    // side.
     //
     uStrong = WHITE;
     if (pos->uPawnCount[WHITE] == 0)
     {
         uStrong = BLACK;
     }
-    ASSERT(pos->uPawnCount[uStrong] > 0);
-    uWeak = FLIP(uStrong);
-    ASSERT(pos->uPawnCount[uWeak] == 0);
-        
-    if (pos->uPawnCount[uStrong] > 1)
-    {
-        *piScore = 0;
-        if (pos->uToMove == uStrong)
-        {
-            return(RECOGN_LOWER);
-        }
-        return(RECOGN_UPPER);
-    }
-
-    //
-    // The side with pawns has only one pawn, do some more
-    // sophisticated analysis here to spot winning KPK
-    // configurations earlier by using "critical squares"
-    // 
-    ASSERT(pos->uPawnCount[uStrong] == 1);
-    cPawn = pos->cPawns[uStrong][0];
-    ASSERT(IS_ON_BOARD(cPawn));
-    ASSERT(IS_PAWN(pos->rgSquare[cPawn].pPiece));
-            
-    //
-    // Step 1: the strong king must be closer to the pawn than
-    // the weak king.
-    //
-    uDist[uStrong] = DISTANCE(pos->cNonPawns[uStrong][0], cPawn);
-    ASSERT((1 <= uDist[uStrong]) && (uDist[uStrong] <= 7));
-    uDist[uWeak] = DISTANCE(pos->cNonPawns[uWeak][0], cPawn);
-    ASSERT((1 <= uDist[uWeak]) && (uDist[uWeak] <= 7));
-    if (uDist[uStrong] <= uDist[uWeak])
-    {
-        //
-        // Step 2: the strong king must be closer to one of the
-        // passer's critical squares than the weak king.
-        //
-        _GetPassersCriticalSquares(uStrong, cPawn, cCritical);
-        for (u = 0; u < 3; u++)
-        {
-            uDist[uStrong] = DISTANCE(pos->cNonPawns[uStrong][0], 
-                                      cCritical[u]);
-            ASSERT((0 <= uDist[uStrong]) && (uDist[uStrong] <= 7));
-            uDist[uWeak] = DISTANCE(pos->cNonPawns[uWeak][0], 
-                                    cCritical[u]);
-            
-            //
-            // Assume if the weak side is on move he will move
-            // towards the critical square.  Also assume that
-            // in so doing he will increase the path that the
-            // strong king must take to get to the critical
-            // square.
-            //
-            if (uDist[uWeak] > 0) {
-                uDist[uWeak] -= (pos->uToMove == uWeak);
-            }
-            if (uDist[uStrong] > 0) {
-                uDist[uStrong] += (pos->uToMove == uWeak) * 2;
-            }
-            ASSERT((0 <= uDist[uWeak]) && (uDist[uWeak] <= 7));
-            if (uDist[uStrong] < uDist[uWeak])
-            {
-                cQueen = 
-                    QUEENING_SQUARE_BY_COLOR_FILE[uStrong][FILE(cPawn)];
-                *piScore = (pos->iMaterialBalance[uStrong] +
-                            VALUE_QUEEN + (2 * VALUE_PAWN) -
-                            (RANK_DISTANCE(cPawn, cQueen) * 32));
-                if (pos->uToMove == uWeak)
-                {
-                    *piScore *= -1;
-                    return(RECOGN_UPPER);
-                }
-                return(RECOGN_LOWER);
-            }
-        }
-    }
+    ASSERT(pos->uPawnCount[uStrong] > 1);
+    ASSERT(pos->uPawnCount[FLIP(uStrong)] == 0);
 
-    //
-    // If we get here then the weak king is as close to or
-    // closer to the lone passer than the strong king -or- the
-    // weak king is as close to or closer to the passer's
-    // critical squares than the strong king.  This may still
-    // be won for the strong side but we don't know -- the
-    // logic is ugly.  This is still at best drawn for the
-    // weak side though.
-    //
     *piScore = 0;
     if (pos->uToMove == uStrong)
     {
@@ -1249,6 +1122,51 @@ Return value:
 }
 
 
+RECOGNIZER *
+GetInteriorNodeRecognizer(IN POSITION *pos)
+/**
+
+Routine description:
+
+    Find the interior node recognizer, if any, for the material on
+    the board.  This is only called when filling in a material hash
+    entry (see materialhash.c); RecognLookup gets the answer from
+    there.
+
+Parameters:
+
+    POSITION *pos
+
+Return value:
+
+    RECOGNIZER * : the recognizer or NULL if there isn't one
+
+**/
+{
+    ULONG uSig[2];
+    
+    if ((pos->uNonPawnCount[WHITE][0] <= 3) &&
+        (pos->uNonPawnCount[BLACK][0] <= 3))
+    {
+        uSig[BLACK] = _MakeMaterialSig((pos->uPawnCount[BLACK] > 0),
+                                       (pos->uNonPawnCount[BLACK][KNIGHT] > 0),
+                                       (pos->uNonPawnCount[BLACK][BISHOP] > 0),
+                                       (pos->uNonPawnCount[BLACK][ROOK] > 0),
+                                       (pos->uNonPawnCount[BLACK][QUEEN] > 0));
+        uSig[WHITE] = _MakeMaterialSig((pos->uPawnCount[WHITE] > 0),
+                                       (pos->uNonPawnCount[WHITE][KNIGHT] > 0),
+                                       (pos->uNonPawnCount[WHITE][BISHOP] > 0),
+                                       (pos->uNonPawnCount[WHITE][ROOK] > 0),
+                                       (pos->uNonPawnCount[WHITE][QUEEN] > 0));
+        if (g_bvRecognizerAvailable[uSig[WHITE]] & (1 << uSig[BLACK]))
+        {
+            return(g_pRecognizers[RECOGN_INDEX(uSig[WHITE], uSig[BLACK])]);
+        }
+    }
+    return(NULL);
+}
+
+
 ULONG 
 RecognLookup(IN SEARCHER_THREAD_CONTEXT *ctx,
              IN OUT SCORE *piScore,
@@ -1277,40 +1195,23 @@ Return value:
 {
     ULONG uVal;
     POSITION *pos = &ctx->sPosition;
-    ULONG uSig[2];
-    RECOGNIZER *pRec;
+    MATERIAL_HASH_ENTRY sMaterial;
     SCORE iScore;
 
     //
-    // Try interior node recognizers
+    // Try interior node recognizers.  The material hash knows which
+    // one (if any) applies to the material on the board.
     // 
-    if ((pos->uNonPawnCount[WHITE][0] <= 3) &&
-        (pos->uNonPawnCount[BLACK][0] <= 3))
+    MaterialHashLookup(pos, &sMaterial);
+    if (NULL != sMaterial.u.s.pRecognizer)
     {
-        uSig[BLACK] = _MakeMaterialSig((pos->uPawnCount[BLACK] > 0),
-                                       (pos->uNonPawnCount[BLACK][KNIGHT] > 0),
-                                       (pos->uNonPawnCount[BLACK][BISHOP] > 0),
-                                       (pos->uNonPawnCount[BLACK][ROOK] > 0),
-                                       (pos->uNonPawnCount[BLACK][QUEEN] > 0));
-        uSig[WHITE] = _MakeMaterialSig((pos->uPawnCount[WHITE] > 0),
-                                       (pos->uNonPawnCount[WHITE][KNIGHT] > 0),
-                                       (pos->uNonPawnCount[WHITE][BISHOP] > 0),
-                                       (pos->uNonPawnCount[WHITE][ROOK] > 0),
-                                       (pos->uNonPawnCount[WHITE][QUEEN] > 0));
-        pRec = g_pRecognizers[RECOGN_INDEX(uSig[WHITE], uSig[BLACK])];
-        if (NULL != pRec)
+        uVal = sMaterial.u.s.pRecognizer(ctx, &iScore);
+        if (UNRECOGNIZED != uVal)
         {
-            if (g_bvRecognizerAvailable[uSig[WHITE]] & (1 << uSig[BLACK]))
-            {
-                uVal = pRec(ctx, &iScore);
-                if (UNRECOGNIZED != uVal)
-                {
-                    *piScore = iScore;
-                    ASSERT((-NMATE < iScore) && (iScore < +NMATE));
-                    ASSERT(_SanityCheckRecognizers(ctx, iScore, uVal));
-                    return(uVal);
-                }
-            }
+            *piScore = iScore;
+            ASSERT((-NMATE < iScore) && (iScore < +NMATE));
+            ASSERT(_SanityCheckRecognizers(ctx, iScore, uVal));
+            return(uVal);
         }
     }
 
@@ -32,6 +32,292 @@ ULONG g_uExtensionReduction[MAX_PLY_PER_SEARCH];
 FLAG g_fCanSplit[MAX_PLY_PER_SEARCH];
 SCORE g_iRootScore[2] = {0, 0};
 SCORE g_iScore;
+ASPIRATION_POLICY g_AspirationPolicy =
+{
+    60,                                       // iMinDelta
+    400,                                      // iMaxDelta
+    600,                                      // iScoreJump
+    0.5,                                      // dVolatilityWeight
+    2.0,                                      // dFailHighGrowth
+    2.5                                       // dFailLowGrowth
+};
+
+//
+// The best few root moves (and their PVs) of a MultiPV search at
+// the current depth, sorted by score.
+//
+typedef struct _MULTI_PV_LINE
+{
+    MOVE mv;
+    SCORE iScore;
+    MOVE PV[MAX_PLY_PER_SEARCH];
+} MULTI_PV_LINE;
+
+static MULTI_PV_LINE g_MultiPv[MAX_MULTI_PV];
+static ULONG g_uNumMultiPvLines = 0;
+
+//
+// How pondering has been going, and which of our moves the last
+// ponder search that missed was preparing for.
+//
+typedef struct _PONDER_STATS
+{
+    ULONG uHits;
+    ULONG uMisses;
+    double dSecondsSaved;
+    ULONG uMissColor;
+    ULONG uMissMoveNumber;                    // 0 if none
+} PONDER_STATS;
+
+static PONDER_STATS g_PonderStats;
+
+//
+// How much work the last search threw away re-searching root fail
+// highs and fail lows at the same depth.
+//
+typedef struct _RESEARCH_STATS
+{
+    ULONG uFailHighs;
+    ULONG uFailLows;
+    UINT64 u64Nodes;                          // nodes in re-searches
+} RESEARCH_STATS;
+
+static RESEARCH_STATS g_ResearchStats;
+
+//
+// How many nodes were under each root move the last time it was
+// searched.  Entries are found by move, not by move stack slot,
+// because SelectMoveAtRoot shuffles the root moves around as it
+// picks them.
+//
+#define ROOT_NODECOUNT_HASH_SIZE (256)
+
+typedef struct _ROOT_NODECOUNT_ENTRY
+{
+    MOVE mv;
+    ULONG uDepth;
+    UINT64 u64Nodes;
+} ROOT_NODECOUNT_ENTRY;
+
+static ROOT_NODECOUNT_ENTRY g_RootNodecountHash[ROOT_NODECOUNT_HASH_SIZE];
+static ULONG g_uRootNodecountDepth = 0;
+
+
+void
+ClearRootNodecountHash(void)
+/**
+
+Routine description:
+
+    Forget the root move nodecounts from the last search.
+
+Parameters:
+
+    void
+
+Return value:
+
+    void
+
+**/
+{
+    memset(g_RootNodecountHash, 0, sizeof(g_RootNodecountHash));
+    g_uRootNodecountDepth = 0;
+}
+
+
+static ROOT_NODECOUNT_ENTRY *
+_LookupRootNodecount(MOVE mv)
+/**
+
+Routine description:
+
+    Find the root nodecount hash entry for mv or, if it has none yet,
+    the empty entry it should use.  There are fewer root moves than
+    entries so the probe always terminates.
+
+Parameters:
+
+    MOVE mv
+
+Return value:
+
+    static ROOT_NODECOUNT_ENTRY *
+
+**/
+{
+    ULONG u = ((ULONG)mv.cFrom * 7 + (ULONG)mv.cTo * 3 + mv.pPromoted);
+
+    ASSERT(MAX_MOVES_PER_PLY < ROOT_NODECOUNT_HASH_SIZE);
+    u &= (ROOT_NODECOUNT_HASH_SIZE - 1);
+    while ((g_RootNodecountHash[u].mv.uMove != 0) &&
+           (!IS_SAME_MOVE(g_RootNodecountHash[u].mv, mv)))
+    {
+        u = (u + 1) & (ROOT_NODECOUNT_HASH_SIZE - 1);
+    }
+    return(&(g_RootNodecountHash[u]));
+}
+
+
+static void
+_RecordRootNodecount(MOVE mv,
+                     ULONG uDepth,
+                     UINT64 u64Nodes)
+/**
+
+Routine description:
+
+    Remember how many nodes were under root move mv at uDepth.  The
+    count comes from the master's counters which, by the time a split
+    below the move is over, include what the helper threads searched
+    there (see _SetFinalStats in split.c).
+
+Parameters:
+
+    MOVE mv,
+    ULONG uDepth,
+    UINT64 u64Nodes
+
+Return value:
+
+    static void
+
+**/
+{
+    ROOT_NODECOUNT_ENTRY *p = _LookupRootNodecount(mv);
+
+    p->mv = mv;
+    p->mv.bvFlags = 0;
+    p->uDepth = uDepth;
+    p->u64Nodes = u64Nodes;
+    g_uRootNodecountDepth = uDepth;
+}
+
+
+UINT64
+GetRootRivalNodecount(SEARCHER_THREAD_CONTEXT *ctx)
+/**
+
+Routine description:
+
+    Return the size of the biggest subtree under a root move other
+    than the best one at the deepest depth searched.  A rival that
+    needed a lot of nodes to refute is a sign that the best move may
+    change.
+
+Parameters:
+
+    SEARCHER_THREAD_CONTEXT *ctx
+
+Return value:
+
+    UINT64
+
+**/
+{
+    ULONG u;
+    UINT64 u64Max = 0;
+
+    for (u = 0; u < ROOT_NODECOUNT_HASH_SIZE; u++)
+    {
+        if ((g_RootNodecountHash[u].mv.uMove != 0) &&
+            (g_RootNodecountHash[u].uDepth == g_uRootNodecountDepth) &&
+            (!IS_SAME_MOVE(g_RootNodecountHash[u].mv, ctx->mvRootMove)))
+        {
+            u64Max = MAX(u64Max, g_RootNodecountHash[u].u64Nodes);
+        }
+    }
+    return(u64Max);
+}
+
+
+FLAG
+GetMultiPvLine(ULONG u,
+               MOVE *pmv,
+               SCORE *piScore)
+/**
+
+Routine description:
+
+    Return the move and score of line u (0 is the best) from the last
+    depth of the last MultiPV search.
+
+Parameters:
+
+    ULONG u,
+    MOVE *pmv,
+    SCORE *piScore
+
+Return value:
+
+    FLAG : FALSE if there is no such line
+
+**/
+{
+    if (u >= g_uNumMultiPvLines)
+    {
+        return(FALSE);
+    }
+    *pmv = g_MultiPv[u].mv;
+    *piScore = g_MultiPv[u].iScore;
+    return(TRUE);
+}
+
+
+static void
+_RankRootMovesByNodecount(SEARCHER_THREAD_CONTEXT *ctx)
+/**
+
+Routine description:
+
+    Between iterations: order the root moves by how big their sub-
+    trees were last iteration.  The moves that were hard to refute
+    are the likeliest to take over as best so look at them early.
+    The best move (and the last best move / other MultiPV lines) keep
+    the values that RootSearch gave them so they stay in front.
+
+Parameters:
+
+    SEARCHER_THREAD_CONTEXT *ctx
+
+Return value:
+
+    static void
+
+**/
+{
+    ROOT_NODECOUNT_ENTRY *p;
+    UINT64 u64Max = 0;
+    ULONG uShift = 0;
+    ULONG u;
+
+    for (u = ctx->sMoveStack.uBegin[ctx->uPly];
+         u < ctx->sMoveStack.uEnd[ctx->uPly];
+         u++)
+    {
+        p = _LookupRootNodecount(ctx->sMoveStack.mv[u]);
+        u64Max = MAX(u64Max, p->u64Nodes);
+    }
+    if (u64Max == 0)
+    {
+        return;
+    }
+    while ((u64Max >> uShift) > (MAX_INT / 4))
+    {
+        uShift++;
+    }
+
+    for (u = ctx->sMoveStack.uBegin[ctx->uPly];
+         u < ctx->sMoveStack.uEnd[ctx->uPly];
+         u++)
+    {
+        if (ctx->sMoveStack.iValue[u] < MAX_INT / 2)
+        {
+            p = _LookupRootNodecount(ctx->sMoveStack.mv[u]);
+            ctx->sMoveStack.iValue[u] = (SCORE)(p->u64Nodes >> uShift);
+        }
+    }
+}
 
 
 static void
@@ -86,6 +372,89 @@ Return value:
 }
 
 
+void
+PonderHit(void)
+/**
+
+Routine description:
+
+    The opponent played the move we were pondering on and the ponder
+    search is being converted into a real one.  Everything it has
+    searched so far (root move list, hash table generation, history)
+    carries straight over; the time it has spent is time saved.
+
+Parameters:
+
+    void
+
+Return value:
+
+    void
+
+**/
+{
+    g_PonderStats.uHits++;
+    g_PonderStats.dSecondsSaved +=
+        SystemTimeStamp() - g_MoveTimer.dStartTime;
+}
+
+
+void
+PonderMiss(ULONG uColor)
+/**
+
+Routine description:
+
+    The opponent didn't play the move we were pondering on.  The
+    ponder search is thrown away but what it stored in the hash table
+    and history is (mostly) about the positions we are going to search
+    next.  Remember which of our moves it was preparing for so that
+    Think doesn't age the hash table and history all over again.
+
+Parameters:
+
+    ULONG uColor : the color we're playing
+
+Return value:
+
+    void
+
+**/
+{
+    g_PonderStats.uMisses++;
+    g_PonderStats.uMissColor = uColor;
+    g_PonderStats.uMissMoveNumber = GetMoveNumber(uColor);
+}
+
+
+static FLAG
+_SearchFollowsPonderMiss(ULONG uColor)
+/**
+
+Routine description:
+
+    Is the search we're about to start for the same move as the last
+    ponder search that missed?  Only answers TRUE once per miss.
+
+Parameters:
+
+    ULONG uColor : the side to move
+
+Return value:
+
+    static FLAG
+
+**/
+{
+    FLAG fRet = ((g_PonderStats.uMissMoveNumber != 0) &&
+                 (g_PonderStats.uMissColor == uColor) &&
+                 (g_PonderStats.uMissMoveNumber == GetMoveNumber(uColor)));
+
+    g_PonderStats.uMissMoveNumber = 0;
+    return(fRet);
+}
+
+
 void
 SetMoveTimerForSearch(FLAG fSwitchOver, ULONG uColor)
 /**
@@ -106,9 +475,10 @@ Return value:
 **/
 {
     ULONG uMovesDone = GetMoveNumber(uColor);
-    double dClock = (double)g_Options.uMyClock;
-    double dSec = 0;
-    ULONG uMargin = 0;
+    double dClock = (double)g_Options.uMyClockMs / 1000.0;
+    double dIncrement = (double)g_Options.uMyIncrementMs / 1000.0;
+    double dOverhead = (double)g_Options.uMoveOverhead / 1000.0;
+    double dSoft, dHard;
     ULONG uMovesToDo;
 
     //
@@ -122,49 +492,38 @@ Return value:
     }
 
     //
-    // Check the clock more often in search if there is little time
-    // left on the clock -- we can't afford an oversearch when the
-    // bullet game is down to the wire.
+    // The clock is watched by the move timer thread (see timer.c) so
+    // search doesn't poll it; the node mask only says how often to
+    // check the node count limit, if there is one.
     //
-#ifdef DEBUG
-    g_MoveTimer.uNodeCheckMask = 0x800 - 1;
-#else
-    if (WeAreRunningASuite())
-    {
-        g_MoveTimer.uNodeCheckMask = 0x20000 - 1;
-    }
-    else if (g_Options.u64MaxNodeCount) 
-    {
-        g_MoveTimer.uNodeCheckMask = 0x1000 - 1;
-    }
-    else
-    {
-        if (dClock < 10.0)
-        {
-            g_MoveTimer.uNodeCheckMask = 0x400 - 1;
-        }
-        else
-        {
-            g_MoveTimer.uNodeCheckMask = 0x8000 - 1;
-        }
-    }
-#endif
+    g_MoveTimer.uNodeCheckMask = 0x1000 - 1;
 
     switch (g_Options.eClock)
     {
         //
-        // Fixed time per move.  Think for g_uMyIncrement seconds exactly and
-        // no hard time limit.
+        // Fixed time per move.  Think for uMyIncrementMs
+        // (less the move overhead) exactly and no hard time limit.
         //
         case CLOCK_FIXED:
-            dSec = (double)g_Options.uMyIncrement;
-            uMargin = 0;
+            dSoft = dHard = MAX(dIncrement - dOverhead,
+                                TIMER_MIN_SEARCH_TIME);
+            g_MoveTimer.bvFlags &= ~TIMER_MANAGED;
             break;
 
         //
         // N moves per time control or entire game in time control.
         //
         case CLOCK_NORMAL:
+            if (g_Options.uMovesToGo != 0)
+            {
+                //
+                // The GUI told us how many moves are left to do.
+                //
+                ComputeMoveTimeBudget(dClock, 0.0, g_Options.uMovesToGo,
+                                      uMovesDone, &dSoft, &dHard);
+                g_MoveTimer.bvFlags |= TIMER_MANAGED;
+                break;
+            }
             if (g_Options.uMovesPerTimePeriod != 0)
             {
                 //
@@ -179,53 +538,35 @@ Return value:
                       uMovesToDo, TimeToString(dClock));
 #endif
                 ASSERT(uMovesToDo <= g_Options.uMovesPerTimePeriod);
-                dSec = (dClock / (double)uMovesToDo);
-                dSec *= 0.95;
-                uMargin = (ULONG)(dSec * 2.2);
-                if (uMovesToDo <= 5)
-                {
-                    dSec *= 0.75;
-                    uMargin /= 2;
-                }
+                ComputeMoveTimeBudget(dClock, 0.0, uMovesToDo, uMovesDone,
+                                      &dSoft, &dHard);
+                g_MoveTimer.bvFlags |= TIMER_MANAGED;
                 break;
             }
-            else
-            {
-                //
-                // Fixed time finish entire game.
-                //
+
+            //
+            // Fixed time finish entire game.
+            //
 #ifdef DEBUG
-                Trace("SetMoveTimer: finish the game in %s sec.\n",
-                      TimeToString(dClock));
+            Trace("SetMoveTimer: finish the game in %s sec.\n",
+                  TimeToString(dClock));
 #endif
-                dSec = dClock / 60;
-                uMargin = (ULONG)(dSec * 2.2);
-            }
+            ComputeMoveTimeBudget(dClock, 0.0, 0, uMovesDone,
+                                  &dSoft, &dHard);
+            g_MoveTimer.bvFlags |= TIMER_MANAGED;
             break;
 
         //
         // We get back a certain number of seconds with each move made.
         //
         case CLOCK_INCREMENT:
-            dSec = g_Options.uMyIncrement;
-            dSec += (dClock / 50);
-            uMargin = (int)(dSec * 2.2);
-
 #ifdef DEBUG
-            Trace("SetMoveTimer: finish the game in %s sec (+%u per move).\n",
-                  TimeToString(dClock), g_Options.uMyIncrement);
+            Trace("SetMoveTimer: finish the game in %s sec (+%s per move).\n",
+                  TimeToString(dClock), TimeToString(dIncrement));
 #endif
-
-            //
-            // If we are running out of time, think for less than the
-            // increment.
-            //
-            if (dClock < 20.0)
-            {
-                dSec -= g_Options.uMyIncrement;
-                uMargin = 0;
-            }
-            ASSERT(dSec > 0);
+            ComputeMoveTimeBudget(dClock, dIncrement, g_Options.uMovesToGo,
+                                  uMovesDone, &dSoft, &dHard);
+            g_MoveTimer.bvFlags |= TIMER_MANAGED;
             break;
 
         case CLOCK_NONE:
@@ -234,15 +575,24 @@ Return value:
 #endif
             g_MoveTimer.dHardTimeLimit = -1;
             g_MoveTimer.dSoftTimeLimit = -1;
+            g_MoveTimer.bvFlags &= ~TIMER_MANAGED;
             goto post;
 
         default:
             ASSERT(FALSE);
+            dSoft = dHard = TIMER_MIN_SEARCH_TIME;
             break;
     }
-    if ((dSec + uMargin) >= (dClock * 7 / 8)) uMargin = 0;
-    g_MoveTimer.dSoftTimeLimit = g_MoveTimer.dStartTime + dSec;
-    g_MoveTimer.dHardTimeLimit = g_MoveTimer.dStartTime + dSec + uMargin;
+    ASSERT(dSoft <= dHard);
+    g_MoveTimer.dOptimalTime = dSoft;
+
+    //
+    // Note: the timer thread takes a soft limit of -1 to mean no
+    // limits at all so when converting a ponder set the hard limit
+    // first.
+    //
+    g_MoveTimer.dHardTimeLimit = g_MoveTimer.dStartTime + dHard;
+    g_MoveTimer.dSoftTimeLimit = g_MoveTimer.dStartTime + dSoft;
 
  post:
     if (TRUE == g_Options.fShouldPost)
@@ -264,7 +614,7 @@ Return value:
             }
         }
 #ifdef DEBUG
-        Trace("SetMoveTimer: Checking input and timer every %u nodes.\n",
+        Trace("SetMoveTimer: Checking node limit every %u nodes.\n",
               g_MoveTimer.uNodeCheckMask);
 #endif
     }
@@ -325,46 +675,11 @@ Return value:
 
     memset(ctx, 0, sizeof(SEARCHER_THREAD_CONTEXT));
     ReInitializeSearcherContext(pos, ctx);
-    ctx->sMoveStack.uUnblockedKeyValue[0] = 1;
-    for (u = 1;
-         u < MAX_PLY_PER_SEARCH;
-         u++)
-    {
-        ctx->sMoveStack.uUnblockedKeyValue[u] =
-            ctx->sMoveStack.uUnblockedKeyValue[u-1] + 0x28F5C28;
-    }
-}
-
-
-void
-InitializeLightweightSearcherContext(POSITION *pos,
-                                     LIGHTWEIGHT_SEARCHER_CONTEXT *ctx)
-/**
-
-Routine description:
-
-    Initialize a LIGHTWEIGHT_SEARCHER_CONTEXT structure.
-
-Parameters:
-
-    POSITION *pos,
-    LIGHTWEIGHT_SEARCHER_CONTEXT *ctx
-
-Return value:
-
-    void
-
-**/
-{
-    ULONG u;
-
-    memset(ctx, 0, sizeof(LIGHTWEIGHT_SEARCHER_CONTEXT));
-    if (NULL != pos)
-    {
-        memmove(&(ctx->sPosition), pos, sizeof(POSITION));
-    }
-    ctx->uPly = 0;
-    ctx->uPositional = 133;
+    ctx->pPawnHash = GetPawnHashTable(ctx->uThreadNumber);
+#ifdef EVAL_HASH
+    ctx->pEvalHash = GetEvalHashTable(ctx->uThreadNumber);
+#endif
+    ctx->pHistory = GetHistoryTable(ctx->uThreadNumber);
     ctx->sMoveStack.uUnblockedKeyValue[0] = 1;
     for (u = 1;
          u < MAX_PLY_PER_SEARCH;
@@ -394,10 +709,10 @@ Return value:
 
 **/
 {
-    double d;
+    double d, n;
     char buf[256];
 #ifdef PERF_COUNTERS
-    double n;
+    ULONG u;
 #endif
     d = (double)g_MoveTimer.dEndTime - (double)g_MoveTimer.dStartTime + 0.01;
     ASSERT(d);
@@ -420,6 +735,25 @@ Return value:
                  ctx->szLastPV);
         Trace("tellothers %s\n", buf);
     }
+    if (g_PonderStats.uHits + g_PonderStats.uMisses > 0)
+    {
+        n = (double)(g_PonderStats.uHits + g_PonderStats.uMisses);
+        Trace("Ponder hit rate: %5.1f percent (%u hits, %u misses), "
+              "%5.1f sec saved.\n",
+              ((double)g_PonderStats.uHits / n) * 100.0,
+              g_PonderStats.uHits, g_PonderStats.uMisses,
+              g_PonderStats.dSecondsSaved);
+    }
+    if (g_ResearchStats.uFailHighs + g_ResearchStats.uFailLows > 0)
+    {
+        n = (double)ctx->sCounters.tree.u64TotalNodeCount + 1;
+        Trace("Root re-searches: %u fail highs, %u fail lows, %"
+              COMPILER_LONGLONG_UNSIGNED_FORMAT
+              " nodes (%4.1f percent).\n",
+              g_ResearchStats.uFailHighs, g_ResearchStats.uFailLows,
+              g_ResearchStats.u64Nodes,
+              ((double)g_ResearchStats.u64Nodes / n) * 100.0);
+    }
 #ifdef MP
 #ifdef PERF_COUNTERS
     if (ctx->sCounters.parallel.uNumSplits > 0)
@@ -451,6 +785,37 @@ Return value:
     ASSERT(d);
     n = (double)(ctx->sCounters.pawnhash.u64Hits);
     Trace("Pawn hash hitrate: %5.3f percent.\n", (n/d) * 100.0);
+    d = (double)(ctx->sCounters.poshash.u64Probes) + 1;
+    ASSERT(d);
+    n = (double)(ctx->sCounters.poshash.u64Hits);
+    Trace("Position hash hitrate: %5.3f percent (%" 
+          COMPILER_LONGLONG_UNSIGNED_FORMAT " probes, %"
+          COMPILER_LONGLONG_UNSIGNED_FORMAT " stores).\n", 
+          (n/d) * 100.0, 
+          ctx->sCounters.poshash.u64Probes,
+          ctx->sCounters.poshash.u64Stores);
+    if (g_Options.fUseNnue)
+    {
+        Trace("NNUE accumulators: %" COMPILER_LONGLONG_UNSIGNED_FORMAT
+              " current, %" COMPILER_LONGLONG_UNSIGNED_FORMAT
+              " incremental updates, %" COMPILER_LONGLONG_UNSIGNED_FORMAT
+              " refreshes.\n",
+              ctx->sCounters.nnue.u64Hits,
+              ctx->sCounters.nnue.u64Updates,
+              ctx->sCounters.nnue.u64Refreshes);
+    }
+    if (ctx->sCounters.egtb.uProbes > 0)
+    {
+        d = (double)(ctx->sCounters.egtb.uProbes);
+        n = (double)(ctx->sCounters.egtb.uHits);
+        Trace("EGTB: %u probes, %u hits (%5.3f percent), "
+              "%6.1f usec average latency (%5.3f sec total).\n",
+              ctx->sCounters.egtb.uProbes,
+              ctx->sCounters.egtb.uHits,
+              (n/d) * 100.0,
+              (ctx->sCounters.egtb.dProbeSeconds / d) * 1000000.0,
+              ctx->sCounters.egtb.dProbeSeconds);
+    }
     n = (double)(ctx->sCounters.tree.u64NullMoveSuccess);
     d = (double)(ctx->sCounters.tree.u64NullMoves) + 1;
     ASSERT(d);
@@ -519,6 +884,22 @@ Return value:
     d = (double)ctx->sCounters.tree.u64BetaCutoffs + 1;
     Trace("First move beta cutoff rate was %5.3f percent.\n",
           ((n / d) * 100.0));
+    n = (double)(ctx->sCounters.movepick.u64HistoryPicks +
+                 ctx->sCounters.movepick.u64PlainPicks +
+                 ctx->sCounters.movepick.u64RootPicks);
+    d = (double)ctx->sCounters.movepick.u64Generates + 1;
+    Trace("Move picking: %5.2f picks/node (%"
+          COMPILER_LONGLONG_UNSIGNED_FORMAT " history, %"
+          COMPILER_LONGLONG_UNSIGNED_FORMAT " plain, %"
+          COMPILER_LONGLONG_UNSIGNED_FORMAT " root, %"
+          COMPILER_LONGLONG_UNSIGNED_FORMAT " sorts), "
+          "%5.2f moves scanned/pick.\n",
+          (n / d),
+          ctx->sCounters.movepick.u64HistoryPicks,
+          ctx->sCounters.movepick.u64PlainPicks,
+          ctx->sCounters.movepick.u64RootPicks,
+          ctx->sCounters.movepick.u64Sorts,
+          ((double)ctx->sCounters.movepick.u64Scanned / (n + 1)));
 #ifdef LAZY_EVAL
     d = (double)ctx->sCounters.tree.u64LazyEvals;
     d += (double)ctx->sCounters.tree.u64FullEvals;
@@ -529,6 +910,20 @@ Return value:
           ((double)ctx->sCounters.tree.u64EvalHashHits / d) * 100.0,
           ((double)ctx->sCounters.tree.u64LazyEvals / d) * 100.0,
           ((double)ctx->sCounters.tree.u64FullEvals / d) * 100.0);
+    Trace("Lazy eval exits: ");
+    for (u = 0; u < LAZY_EVAL_STAGES; u++)
+    {
+        Trace("%s%" COMPILER_LONGLONG_UNSIGNED_FORMAT " %s "
+              "(%" COMPILER_LONGLONG_UNSIGNED_FORMAT "/%"
+              COMPILER_LONGLONG_UNSIGNED_FORMAT " sampled wrong)",
+              (u == 0) ? "" : ", ",
+              ctx->sCounters.lazy.u64Exits[u],
+              (u == LAZY_STAGE_PAWNS) ? "pawns" :
+              (u == LAZY_STAGE_MINORS) ? "minors" : "kings",
+              ctx->sCounters.lazy.u64Wrong[u],
+              ctx->sCounters.lazy.u64Verified[u]);
+    }
+    Trace("\n");
 #endif
     Trace("Extensions: (%u +, %u q+, %u 1mv, %u !kmvs, %u mult+, %u pawn\n"
           "             %u threat, %u zug, %u sing, %u endg, %u bm, %u recap)\n",
@@ -584,6 +979,7 @@ Return value:
     SCORE iScore;
     ULONG uNextDepth;
     UINT64 u64StartingNodeCount;
+    UINT64 u64MoveNodes;
     ULONG uNumLegalMoves;
 
 #ifdef DEBUG
@@ -609,9 +1005,9 @@ Return value:
          x++)
     {
         SelectMoveAtRoot(ctx, x);
-        if (ctx->sMoveStack.mvf[x].bvFlags & MVF_MOVE_SEARCHED) break;
-        ctx->sMoveStack.mvf[x].bvFlags |= MVF_MOVE_SEARCHED;
-        mv = ctx->sMoveStack.mvf[x].mv;
+        if (ctx->sMoveStack.bvFlags[x] & MVF_MOVE_SEARCHED) break;
+        ctx->sMoveStack.bvFlags[x] |= MVF_MOVE_SEARCHED;
+        mv = ctx->sMoveStack.mv[x];
         mv.bvFlags |= WouldGiveCheck(ctx, mv);
 
         if (MakeMove(ctx, mv))
@@ -665,23 +1061,25 @@ Return value:
                   x + 1,
                   MoveToSan(mv, &ctx->sPosition),
                   u64StartingNodeCount,
-                  ctx->sMoveStack.mvf[x].iValue,
+                  ctx->sMoveStack.iValue[x],
                   iScore);
             ASSERT(PositionsAreEquivalent(&pi->sPosition, &ctx->sPosition));
 #endif
             //
             // Keep track of how many moves are under each one we
-            // search and use this as the basis for root move ordering
-            // next iteration.
+            // search.  This orders the moves if we have to search
+            // this depth again and Iterate ranks the root moves on
+            // it before the next depth.
             //
-            u64StartingNodeCount = (ctx->sCounters.tree.u64TotalNodeCount -
-                                    u64StartingNodeCount);
-            u64StartingNodeCount >>= 9;
+            u64MoveNodes = (ctx->sCounters.tree.u64TotalNodeCount -
+                            u64StartingNodeCount);
+            _RecordRootNodecount(mv, uDepth, u64MoveNodes);
+            u64StartingNodeCount = u64MoveNodes >> 9;
             u64StartingNodeCount &= (MAX_INT / 4);
-            ctx->sMoveStack.mvf[x].iValue =
+            ctx->sMoveStack.iValue[x] =
                 (SCORE)(u64StartingNodeCount + iScore);
 #ifdef DEBUG
-            Trace("next_predict: %d\n", ctx->sMoveStack.mvf[x].iValue);
+            Trace("next_predict: %d\n", ctx->sMoveStack.iValue[x]);
             ASSERT(iBestScore <= iAlpha);
             ASSERT(iAlpha < iBeta);
 #endif
@@ -702,7 +1100,8 @@ Return value:
                     ctx->mvRootMove = mv;
                     ctx->iRootScore = iScore;
                     ctx->uRootDepth = uDepth;
-                    ctx->sMoveStack.mvf[x].iValue = MAX_INT;
+                    ctx->u64RootMoveNodes = u64MoveNodes;
+                    ctx->sMoveStack.iValue[x] = MAX_INT;
 
                     //
                     // If there was a previous PV move then knock its
@@ -713,9 +1112,9 @@ Return value:
                          y < x;
                          y++)
                     {
-                        if (ctx->sMoveStack.mvf[y].iValue == MAX_INT)
+                        if (ctx->sMoveStack.iValue[y] == MAX_INT)
                         {
-                            ctx->sMoveStack.mvf[y].iValue /= 2;
+                            ctx->sMoveStack.iValue[y] /= 2;
                         }
                     }
 
@@ -730,9 +1129,9 @@ Return value:
                                                   mv,
                                                   iScore,
                                                   x + 1);
-                        UtilPrintPV(ctx, iAlpha, iBeta, iScore, mv);
+                        UtilPrintPV(ctx, iAlpha, iBeta, iScore, mv, 1);
                         KEEP_TRACK_OF_FIRST_MOVE_FHs(iBestScore == -INFINITY);
-                        ctx->sMoveStack.mvf[x].bvFlags &= ~MVF_MOVE_SEARCHED;
+                        ctx->sMoveStack.bvFlags[x] &= ~MVF_MOVE_SEARCHED;
                         goto end;
                     }
                     else
@@ -740,7 +1139,7 @@ Return value:
                         //
                         // Root PV change...
                         //
-                        UtilPrintPV(ctx, iAlpha, iBeta, iScore, mv);
+                        UtilPrintPV(ctx, iAlpha, iBeta, iScore, mv, 1);
                         iAlpha = iScore;
                     }
 				}
@@ -756,7 +1155,7 @@ Return value:
         //
         ASSERT(iBestScore <= iAlpha);
         ASSERT(PositionsAreEquivalent(pos, &pi->sPosition));
-        UtilPrintPV(ctx, iAlpha, iBeta, iBestScore, mv);
+        UtilPrintPV(ctx, iAlpha, iBeta, iBestScore, mv, 1);
     }
 
  end:
@@ -765,6 +1164,184 @@ Return value:
 
 
 
+static SCORE
+_RootSearchMultiPv(SEARCHER_THREAD_CONTEXT *ctx,
+                   ULONG uNumLines,
+                   ULONG uDepth)
+/**
+
+Routine description:
+
+    Search at the root of the whole tree for the best uNumLines moves
+    instead of just the best one.  The first uNumLines moves are
+    searched with a full window.  After that the score of the worst
+    line we have is the alpha bound for a minimal window search of
+    each remaining move; a move that beats it is searched again to
+    get its real score and bumps that line.  At the end the root
+    moves are reordered by score for the next depth and every line
+    is posted.
+
+    The best line becomes the root move / PV just as it would in a
+    RootSearch.
+
+Parameters:
+
+    SEARCHER_THREAD_CONTEXT *ctx,
+    ULONG uNumLines,
+    ULONG uDepth
+
+Return value:
+
+    SCORE : the score of the best line or INVALID_SCORE if the
+            search was stopped before it finished this depth
+
+**/
+{
+    PLY_INFO *pi = &ctx->sPlyInfo[ctx->uPly];
+    MOVE mv;
+    ULONG x, y;
+    SCORE iScore;
+    SCORE iAlpha;
+    ULONG uNextDepth;
+    UINT64 u64StartingNodeCount;
+    UINT64 u64MoveNodes;
+
+    ASSERT((uNumLines > 1) && (uNumLines <= MAX_MULTI_PV));
+    ASSERT((ctx->uPly == 0) || (ctx->uPly == 1)); // 1 is for under a ponder
+    ctx->sCounters.tree.u64TotalNodeCount++;
+    pi->PV[ctx->uPly] = NULLMOVE;
+    pi->mvBest = NULLMOVE;
+    g_MoveTimer.bvFlags |= TIMER_SEARCHING_FIRST_MOVE;
+    g_uNumMultiPvLines = 0;
+
+    for (x = ctx->sMoveStack.uBegin[ctx->uPly];
+         x < ctx->sMoveStack.uEnd[ctx->uPly];
+         x++)
+    {
+        SelectMoveAtRoot(ctx, x);
+        if (ctx->sMoveStack.bvFlags[x] & MVF_MOVE_SEARCHED) break;
+        ctx->sMoveStack.bvFlags[x] |= MVF_MOVE_SEARCHED;
+        mv = ctx->sMoveStack.mv[x];
+        mv.bvFlags |= WouldGiveCheck(ctx, mv);
+
+        if (MakeMove(ctx, mv))
+        {
+            u64StartingNodeCount = ctx->sCounters.tree.u64TotalNodeCount;
+            uNextDepth = uDepth - ONE_PLY;
+            if (IS_CHECKING_MOVE(mv))
+            {
+                uNextDepth += HALF_PLY;
+                ctx->sPlyInfo[ctx->uPly].iExtensionAmount = HALF_PLY;
+            }
+
+            ctx->sSearchFlags.fVerifyNullmove = TRUE;
+            ctx->sSearchFlags.uQsearchDepth = 0;
+            if (g_uNumMultiPvLines < uNumLines)
+            {
+                //
+                // Not enough lines yet, full -inf..+inf window
+                //
+                iScore = -Search(ctx, -INFINITY, +INFINITY, uNextDepth);
+            }
+            else
+            {
+                //
+                // Does this move beat the worst line?  If so, get its
+                // real score with a worst..+inf window.
+                //
+                iAlpha = g_MultiPv[uNumLines - 1].iScore;
+                iScore = -Search(ctx, -iAlpha - 1, -iAlpha, uNextDepth);
+                if (iScore > iAlpha)
+                {
+                    iScore = -Search(ctx, -INFINITY, -iAlpha, uNextDepth);
+                }
+            }
+            ctx->sSearchFlags.fVerifyNullmove = FALSE;
+            UnmakeMove(ctx, mv);
+            if (WE_SHOULD_STOP_SEARCHING)
+            {
+                iScore = INVALID_SCORE;
+                goto end;
+            }
+
+            u64MoveNodes = (ctx->sCounters.tree.u64TotalNodeCount -
+                            u64StartingNodeCount);
+            _RecordRootNodecount(mv, uDepth, u64MoveNodes);
+            u64StartingNodeCount = u64MoveNodes >> 9;
+            u64StartingNodeCount &= (MAX_INT / 4);
+            ctx->sMoveStack.iValue[x] =
+                (SCORE)(u64StartingNodeCount + iScore);
+
+            if ((g_uNumMultiPvLines < uNumLines) ||
+                (iScore > g_MultiPv[uNumLines - 1].iScore))
+            {
+                //
+                // A new line; insert it in score order, dropping the
+                // worst line if we already had enough.
+                //
+                UpdatePV(ctx, mv);
+                if (g_uNumMultiPvLines < uNumLines)
+                {
+                    g_uNumMultiPvLines++;
+                }
+                y = g_uNumMultiPvLines - 1;
+                while ((y > 0) && (g_MultiPv[y - 1].iScore < iScore))
+                {
+                    g_MultiPv[y] = g_MultiPv[y - 1];
+                    y--;
+                }
+                g_MultiPv[y].mv = mv;
+                g_MultiPv[y].iScore = iScore;
+                memcpy(g_MultiPv[y].PV, pi->PV, sizeof(pi->PV));
+                if (y == 0)
+                {
+                    pi->mvBest = mv;
+                    ctx->mvRootMove = mv;
+                    ctx->iRootScore = iScore;
+                    ctx->uRootDepth = uDepth;
+                    ctx->u64RootMoveNodes = u64MoveNodes;
+                }
+                else
+                {
+                    memcpy(pi->PV, g_MultiPv[0].PV, sizeof(pi->PV));
+                }
+            }
+            g_MoveTimer.bvFlags &= ~TIMER_SEARCHING_FIRST_MOVE;
+        }
+    }
+    ASSERT(g_uNumMultiPvLines > 0);
+
+    //
+    // Search the lines first, best to worst, at the next depth and
+    // post them all.
+    //
+    for (x = ctx->sMoveStack.uBegin[ctx->uPly];
+         x < ctx->sMoveStack.uEnd[ctx->uPly];
+         x++)
+    {
+        for (y = 0; y < g_uNumMultiPvLines; y++)
+        {
+            if (IS_SAME_MOVE(ctx->sMoveStack.mv[x], g_MultiPv[y].mv))
+            {
+                ctx->sMoveStack.iValue[x] = MAX_INT - (SCORE)y;
+                break;
+            }
+        }
+    }
+    for (y = 0; y < g_uNumMultiPvLines; y++)
+    {
+        memcpy(pi->PV, g_MultiPv[y].PV, sizeof(pi->PV));
+        UtilPrintPV(ctx, -INFINITY, +INFINITY, g_MultiPv[y].iScore,
+                    g_MultiPv[y].mv, y + 1);
+    }
+    memcpy(pi->PV, g_MultiPv[0].PV, sizeof(pi->PV));
+    iScore = g_MultiPv[0].iScore;
+
+ end:
+    return(iScore);
+}
+
+
 static GAME_RESULT
 _DetectPreMoveTerminalStates(SEARCHER_THREAD_CONTEXT *ctx,
                              FLAG fInCheck,
@@ -824,7 +1401,7 @@ _DetectPreMoveTerminalStates(SEARCHER_THREAD_CONTEXT *ctx,
     for (u = ctx->sMoveStack.uBegin[ctx->uPly];
          u < ctx->sMoveStack.uEnd[ctx->uPly];
          u++) {
-        mv = ctx->sMoveStack.mvf[u].mv;
+        mv = ctx->sMoveStack.mv[u];
         if (MakeMove(ctx, mv)) {
             mvLegal = mv;
             uNumLegal += 1;
@@ -884,6 +1461,13 @@ Return value:
     GAME_RESULT ret;
     FLAG fInCheck = InCheck(&ctx->sPosition, ctx->sPosition.uToMove);
 
+    // Under UCI the GUI adjudicates and we didn't really move.
+    if (g_Options.fRunningUnderUci) {
+        ret.eResult = RESULT_IN_PROGRESS;
+        ret.szDescription[0] = '\0';
+        return ret;
+    }
+
     // Did we just make the 50th+ move without progress?
     if (ctx->sPosition.uFifty >= 100) {
         ret.eResult = RESULT_DRAW;
@@ -970,43 +1554,81 @@ _IterateSetSearchGlobals(ULONG uDepth)
 }
 
 
-#define SKIP_GRADUAL_OPENING 600
-#define INITIAL_HALF_WINDOW  75
-#define FIRST_FAIL_STEP      150
-#define SECOND_FAIL_STEP     375
+static SCORE
+_IterateInitialDelta(double dVolatility)
+/**
+
+Routine description:
+
+    Pick the half width of the aspiration window for the next depth
+    based on how much the score has been moving around lately.
+
+Parameters:
+
+    double dVolatility : average recent score change between depths
+
+Return value:
+
+    static SCORE
+
+**/
+{
+    ASPIRATION_POLICY *p = &g_AspirationPolicy;
+    double d;
+
+    d = (double)p->iMinDelta + p->dVolatilityWeight * dVolatility;
+    d = MIN(d, (double)p->iMaxDelta);
+    return((SCORE)MAX(d, 1.0));
+}
+
 
 void
 _IterateWidenWindow(ULONG uColor,
                     SCORE iScore,
                     SCORE *piBound,
-                    ULONG *puState,
+                    SCORE *piDelta,
+                    double dGrowth,
                     int iDir)
+/**
+
+Routine description:
+
+    The root search failed high (iDir == +1) or low (iDir == -1) with
+    iScore.  Grow that side's half window geometrically and move the
+    bound out past iScore, or open it all the way if the window is
+    already wide or the score jumped a long way.
+
+Parameters:
+
+    ULONG uColor,
+    SCORE iScore,
+    SCORE *piBound : the bound to move (beta or alpha)
+    SCORE *piDelta : that side's half window
+    double dGrowth,
+    int iDir
+
+Return value:
+
+    void
+
+**/
 {
+    ASPIRATION_POLICY *p = &g_AspirationPolicy;
     SCORE iRoughScore = g_iRootScore[uColor];
-    static SCORE _Steps[] =
-    {
-        FIRST_FAIL_STEP,
-        SECOND_FAIL_STEP,
-        INFINITY
-    };
-
-//    Trace("State = %u.\n", *puState);
-//    Trace("Bound from %d to ", *piBound);
-    if ((abs(iRoughScore - iScore) > SKIP_GRADUAL_OPENING) ||
-        (*puState == 2))
+    double d;
+
+    d = (double)*piDelta * MAX(dGrowth, 1.1);
+    if ((abs(iRoughScore - iScore) > p->iScoreJump) ||
+        (d > (double)p->iMaxDelta))
     {
         *piBound = iDir * INFINITY;
-        *puState = 2;
+        *piDelta = INFINITY;
     }
     else
     {
-        ASSERT(*puState < 2);
-        *piBound = iScore;
-        *piBound += iDir * _Steps[*puState];
-        *puState += 1;
+        *piDelta = (SCORE)d;
+        *piBound = iScore + iDir * *piDelta;
     }
-//    Trace("%d.\n", *piBound);
-//    Trace("State = %u\n", *puState);
 }
 
 
@@ -1032,13 +1654,19 @@ Return value:
 {
     ULONG uNumRootFailLows = 0;
     ULONG uDepth;
-    ULONG uFailState = 0;
+    SCORE iLowDelta = _IterateInitialDelta(0.0);
+    SCORE iHighDelta = _IterateInitialDelta(0.0);
+    SCORE iLastScore = 0;
+    double dVolatility = 0.0;
+    UINT64 u64StartingNodeCount;
+    FLAG fResearch;
     ULONG uColor;
     ULONG u;
     SCORE iAlpha = -INFINITY;
     SCORE iBeta = +INFINITY;
     SCORE iScore;
     FLAG fInCheck = InCheck(&(ctx->sPosition), ctx->sPosition.uToMove);
+    ULONG uNumLines;
     MOVE mv;
     GAME_RESULT ret;
 #ifdef DEBUG
@@ -1047,6 +1675,13 @@ Return value:
     VerifyPositionConsistency(&board, FALSE);
 #endif
 
+    //
+    // Nobody is searching yet; carry out any "set" that had to wait
+    // for that.
+    //
+    ApplyPendingEGTBCacheResize();
+    ApplyPendingNnueChanges();
+
     uColor = ctx->sPosition.uToMove;
     g_iRootScore[uColor] = GetRoughEvalScore(ctx, iAlpha, iBeta, TRUE);
     g_iRootScore[FLIP(uColor)] = -g_iRootScore[uColor];
@@ -1059,6 +1694,8 @@ Return value:
     GenerateMoves(ctx, NULLMOVE, (fInCheck ? GENERATE_ESCAPES : 
                                              GENERATE_ALL_MOVES));
     ASSERT(ctx->sMoveStack.uBegin[0] == 0);
+    ClearRootNodecountHash();
+    memset(&g_ResearchStats, 0, sizeof(g_ResearchStats));
 
     //
     // See if we are sitting at a checkmate or stalemate position; no
@@ -1091,6 +1728,13 @@ Return value:
         goto end;
     }
 
+    //
+    // How many root lines are we searching for?
+    //
+    uNumLines = MINU(MAXU(g_Options.uMultiPv, 1), MAX_MULTI_PV);
+    uNumLines = MINU(uNumLines, MOVE_COUNT(ctx, ctx->uPly));
+
+    ArmMoveTimer(ctx);
     for (uDepth = 1;
          uDepth <= g_Options.uMaxDepth;
          uDepth++)
@@ -1099,11 +1743,12 @@ Return value:
         // Re-rank the moves based on nodecounts and mark all moves as
         // not yet searched at this depth.
         //
+        _RankRootMovesByNodecount(ctx);
         for (u = ctx->sMoveStack.uBegin[ctx->uPly];
              u < ctx->sMoveStack.uEnd[ctx->uPly];
              u++)
         {
-            ctx->sMoveStack.mvf[u].bvFlags &= ~MVF_MOVE_SEARCHED;
+            ctx->sMoveStack.bvFlags[u] &= ~MVF_MOVE_SEARCHED;
         }
 
         //
@@ -1111,19 +1756,45 @@ Return value:
         // globals used by the search.
         //
         _IterateSetSearchGlobals(uDepth);
+        fResearch = FALSE;
+        ctx->sCounters.tree.uMaxPly = 0;
 
         //
         // Try to get a PV for this depth before we're out of time...
         //
         do
         {
+            //
+            // MultiPV searches don't use an aspiration window.
+            //
+            if (uNumLines > 1)
+            {
+                iScore = _RootSearchMultiPv(ctx,
+                                            uNumLines,
+                                            uDepth * ONE_PLY + HALF_PLY);
+                if (g_MoveTimer.bvFlags & TIMER_STOPPING) break;
+                ASSERT(iScore == ctx->iRootScore);
+                ASSERT(SanityCheckMove(&ctx->sPosition, ctx->mvRootMove));
+                g_iRootScore[uColor] = iScore;
+                g_iRootScore[FLIP(uColor)] = -iScore;
+                (void)CheckTestSuiteMove(ctx->mvRootMove, iScore, uDepth);
+                break;
+            }
+
             if (iBeta > INFINITY) iBeta = +INFINITY;
             if (iAlpha < -INFINITY) iAlpha = -INFINITY;
             if (iAlpha >= iBeta) iAlpha = iBeta - 1;
+            u64StartingNodeCount = ctx->sCounters.tree.u64TotalNodeCount;
             iScore = RootSearch(ctx,
                                 iAlpha,
                                 iBeta,
                                 uDepth * ONE_PLY + HALF_PLY);
+            if (TRUE == fResearch)
+            {
+                g_ResearchStats.u64Nodes +=
+                    (ctx->sCounters.tree.u64TotalNodeCount -
+                     u64StartingNodeCount);
+            }
             if (g_MoveTimer.bvFlags & TIMER_STOPPING) break;
             mv = ctx->mvRootMove;
 
@@ -1135,13 +1806,21 @@ Return value:
                 ASSERT(iScore == ctx->iRootScore);
                 ASSERT(mv.uMove);
                 ASSERT(SanityCheckMove(&ctx->sPosition, mv));
-                iAlpha = iScore - INITIAL_HALF_WINDOW;
-                iBeta = iScore + INITIAL_HALF_WINDOW;
+                if (uDepth > 1)
+                {
+                    dVolatility = (3.0 * dVolatility +
+                                   (double)MIN(abs(iScore - iLastScore),
+                                               g_AspirationPolicy.iMaxDelta))
+                        / 4.0;
+                }
+                iLastScore = iScore;
+                iLowDelta = iHighDelta = _IterateInitialDelta(dVolatility);
+                iAlpha = iScore - iLowDelta;
+                iBeta = iScore + iHighDelta;
                 g_iRootScore[uColor] = iScore;
                 g_iRootScore[FLIP(uColor)] = -iScore;
                 g_MoveTimer.bvFlags &= ~TIMER_RESOLVING_ROOT_FH;
                 g_MoveTimer.bvFlags &= ~TIMER_RESOLVING_ROOT_FL;
-                uFailState = 0;
                 (void)CheckTestSuiteMove(mv, iScore, uDepth);
                 break;
             }
@@ -1159,7 +1838,10 @@ Return value:
                 {
                     g_MoveTimer.bvFlags |= TIMER_MANY_ROOT_FLS;
                 }
-                _IterateWidenWindow(uColor, iScore, &iAlpha, &uFailState, -1);
+                g_ResearchStats.uFailLows++;
+                fResearch = TRUE;
+                _IterateWidenWindow(uColor, iScore, &iAlpha, &iLowDelta,
+                                    g_AspirationPolicy.dFailLowGrowth, -1);
 
                 //
                 // Consider all moves again with wider window...
@@ -1168,7 +1850,7 @@ Return value:
                      u < ctx->sMoveStack.uEnd[ctx->uPly];
                      u++)
                 {
-                    ctx->sMoveStack.mvf[u].bvFlags &= ~MVF_MOVE_SEARCHED;
+                    ctx->sMoveStack.bvFlags[u] &= ~MVF_MOVE_SEARCHED;
                 }
             }
 
@@ -1181,7 +1863,10 @@ Return value:
                 ASSERT(mv.uMove);
                 ASSERT(SanityCheckMove(&ctx->sPosition, mv));
                 g_MoveTimer.bvFlags |= TIMER_RESOLVING_ROOT_FH;
-                _IterateWidenWindow(uColor, iScore, &iBeta, &uFailState, +1);
+                g_ResearchStats.uFailHighs++;
+                fResearch = TRUE;
+                _IterateWidenWindow(uColor, iScore, &iBeta, &iHighDelta,
+                                    g_AspirationPolicy.dFailHighGrowth, +1);
             }
         }
         while(1); // repeat until we run out of time or fall inside a..b
@@ -1195,6 +1880,16 @@ Return value:
         // or 4. there was user input and we unrolled the search.
         //
 
+        //
+        // Let the time manager adjust the soft limit based on how
+        // this depth went (and stop if the next one can't finish).
+        //
+        if (!(g_MoveTimer.bvFlags & TIMER_STOPPING))
+        {
+            UpdateMoveTimerAfterIteration(ctx, uDepth, iScore);
+            TelemetryIteration(ctx, uDepth, iScore);
+        }
+
         //
         // TODO: Scale back history between iterative depths?
         //
@@ -1223,9 +1918,43 @@ Return value:
         //
         if (g_MoveTimer.bvFlags & TIMER_STOPPING) break;
     }
+    DisarmMoveTimer();
     g_Options.u64NodesSearched = ctx->sCounters.tree.u64TotalNodeCount;
     g_MoveTimer.dEndTime = SystemTimeStamp();
 
+    //
+    // Input can stop the search at its very first node, before any
+    // root move was searched.  Fall back on the hash move or else the
+    // best ordered legal move in that case rather than returning no
+    // move at all.
+    //
+    if (0 == ctx->mvRootMove.uMove)
+    {
+        MOVE mvHash = GetPonderMove(&(ctx->sPosition));
+        SCORE iBest = -MAX_INT;
+        for (u = ctx->sMoveStack.uBegin[ctx->uPly];
+             u < ctx->sMoveStack.uEnd[ctx->uPly];
+             u++)
+        {
+            mv = ctx->sMoveStack.mv[u];
+            if (((IS_SAME_MOVE(mv, mvHash)) ||
+                 (ctx->sMoveStack.iValue[u] > iBest)) &&
+                (TRUE == MakeMove(ctx, mv)))
+            {
+                UnmakeMove(ctx, mv);
+                ctx->mvRootMove = mv;
+                if (IS_SAME_MOVE(mv, mvHash)) break;
+                iBest = ctx->sMoveStack.iValue[u];
+            }
+        }
+        ctx->sPlyInfo[ctx->uPly].PV[ctx->uPly] = ctx->mvRootMove;
+        ctx->sPlyInfo[ctx->uPly].PV[ctx->uPly + 1] = NULLMOVE;
+    }
+    TelemetryMove(ctx,
+                  g_ResearchStats.uFailHighs,
+                  g_ResearchStats.uFailLows,
+                  g_ResearchStats.u64Nodes);
+
     //
     // Here we are at the end of a search.  If we were:
     //
@@ -1273,6 +2002,16 @@ Return value:
 **/
 {
     MOVE mv = ctx->mvRootMove;
+
+    //
+    // Under UCI the GUI keeps the game; just tell it what we'd play.
+    //
+    if (TRUE == g_Options.fRunningUnderUci)
+    {
+        UciPostBestMove(ctx);
+        g_Options.fPondering = g_Options.fThinking = FALSE;
+        return;
+    }
     ASSERT(mv.uMove);
 
     if (TRUE == g_Options.fThinking)
@@ -1291,7 +2030,7 @@ Return value:
             {
                 UtilPanic(CANNOT_OFFICIALLY_MAKE_MOVE,
                           GetRootPosition(),
-                          (void *)g_Options.mvPonder.uMove,
+                          (void *)(uintptr_t)g_Options.mvPonder.uMove,
                           NULL,
                           NULL,
                           __FILE__,
@@ -1311,7 +2050,7 @@ Return value:
         {
             UtilPanic(CANNOT_OFFICIALLY_MAKE_MOVE,
                       GetRootPosition(),
-                      (void *)mv.uMove,
+                      (void *)(uintptr_t)mv.uMove,
                       NULL,
                       NULL,
                       __FILE__,
@@ -1358,7 +2097,8 @@ Return value:
     //
     // When do we not want to ponder
     //
-    if ((g_Options.ePlayMode == FORCE_MODE) || (g_Options.uMyClock < 10))
+    if ((g_Options.ePlayMode == FORCE_MODE) ||
+        (g_Options.uMyClockMs < 10 * 1000))
     {
         g_Options.fPondering = FALSE;
         return ret;
@@ -1377,11 +2117,12 @@ Return value:
 
     //
     // Prepare to ponder by doing some maintenance on the dynamic move
-    // ordering scheme counters, changing the dirty tag in the hash
-    // code, and clearing the root nodes-per-move hash.
+    // ordering scheme counters and changing the dirty tag in the hash
+    // code.
     //
     MaintainDynamicMoveOrdering();
     DirtyHashTable();
+    g_PonderStats.uMissMoveNumber = 0;
 
     //
     // Make the move ponder move.
@@ -1453,16 +2194,24 @@ Return value:
 
     //
     // Prepare to think by doing some maintenance on the dynamic move
-    // ordering scheme counters, changing the dirty tag in the hash
-    // code, and clearing the root nodes-per-move hash.
+    // ordering scheme counters and changing the dirty tag in the hash
+    // code.
     //
     if (NULL != (p = PositionToFen(&(ctx.sPosition))))
     {
         Trace("The root position is: %s\n", p);
         SystemFreeMemory(p);
     }
-    MaintainDynamicMoveOrdering();
-    DirtyHashTable();
+    //
+    // ...unless we just pondered this move and the opponent didn't
+    // play what we expected; that search did it already and what it
+    // left behind is still current.
+    //
+    if (FALSE == _SearchFollowsPonderMiss(pos->uToMove))
+    {
+        MaintainDynamicMoveOrdering();
+        DirtyHashTable();
+    }
 
     //
     // Check the opening book, maybe it has a move for us.
@@ -1503,6 +2252,7 @@ Return value:
     GAME_RESULT ret = Iterate(&ctx);
     if (ret.eResult == RESULT_IN_PROGRESS) {
         if (g_Options.iResignThreshold != 0 &&
+            !g_Options.fRunningUnderUci &&
             g_iRootScore[ctx.sPosition.uToMove] < g_Options.iResignThreshold) {
             _resign_count++;
             if (_resign_count > 2) {
@@ -1521,6 +2271,11 @@ Return value:
         MakeTheMove(&ctx);
         return _DetectPostMoveTerminalStates(&ctx);
     } else {
+        if (g_Options.fRunningUnderUci) {
+            ctx.mvRootMove.uMove = 0;
+            MakeTheMove(&ctx);
+            ret.eResult = RESULT_IN_PROGRESS;
+        }
         return ret;
     }
 }
@@ -197,7 +197,8 @@ Return value:
 
 **/
 {
-    static LIGHTWEIGHT_SEARCHER_CONTEXT ctx;
+    static SEARCHER_THREAD_CONTEXT ctx;
+    static FLAG fInitialized = FALSE;
     CHAR *p, *q;
     PIECE pPieceType = PAWN;
     ULONG u;
@@ -317,9 +318,17 @@ Return value:
                 break;
         }
         
-        InitializeLightweightSearcherContext(pos, &ctx);
+        if (FALSE == fInitialized)
+        {
+            InitializeSearcherContext(pos, &ctx);
+            fInitialized = TRUE;
+        }
+        else
+        {
+            ReInitializeSearcherContext(pos, &ctx);
+        }
         mv.uMove = 0;
-        GenerateMoves((SEARCHER_THREAD_CONTEXT *)&ctx,
+        GenerateMoves(&ctx,
                       mv,
                       (InCheck(pos, pos->uToMove) ? GENERATE_ESCAPES :
                                                     GENERATE_ALL_MOVES));
@@ -327,7 +336,7 @@ Return value:
              u < ctx.sMoveStack.uEnd[0];
              u++)
         {
-            mv = ctx.sMoveStack.mvf[u].mv;
+            mv = ctx.sMoveStack.mv[u];
             pMoved = mv.pMoved;
             if (PIECE_TYPE(pMoved) == pPieceType)
             {
@@ -339,9 +348,9 @@ Return value:
                 if ((mv.cTo == cTo) &&
                     (mv.pPromoted == pPromoted))
                 {
-                    if (TRUE == MakeMove((SEARCHER_THREAD_CONTEXT *)&ctx, mv))
+                    if (TRUE == MakeMove(&ctx, mv))
                     {
-                        UnmakeMove((SEARCHER_THREAD_CONTEXT *)&ctx, mv);
+                        UnmakeMove(&ctx, mv);
                         cFrom = mv.cFrom;
                         cTo = mv.cTo;
                         uNumMatches++;
@@ -413,7 +413,8 @@ Return value:
         fclose(p);
 
         // Banner and end results
-        dMult = (double)g_Options.uMyIncrement / (double)SUITE_NUM_HISTOGRAM;
+        dMult = ((double)g_Options.uMyIncrementMs / 1000.0 /
+                 (double)SUITE_NUM_HISTOGRAM);
         Banner();
         Trace("\n"
               "TEST SCRIPT execution complete.  Final statistics:\n"
@@ -588,9 +589,9 @@ Return value:
         (g_SuiteCounters.uCurrentSolvedPlies > 4) &&
         (iScore >= 0))
     {
-        if (((g_Options.uMyIncrement != 0) &&
+        if (((g_Options.uMyIncrementMs != 0) &&
              (SystemTimeStamp() - g_MoveTimer.dStartTime >=
-              (double)g_Options.uMyIncrement / 3)) ||
+              (double)g_Options.uMyIncrementMs / 3000.0)) ||
             ((g_Options.uMaxDepth != 0) &&
              (uDepth >= g_Options.uMaxDepth / 3)))
         {
@@ -644,8 +645,8 @@ Return value:
             g_SuiteCounters.dSigmaSolutionTime += 
                 g_SuiteCounters.dCurrentSolutionTime;
 
-            dMult = (double)g_Options.uMyIncrement / 
-                (double)SUITE_NUM_HISTOGRAM;
+            dMult = ((double)g_Options.uMyIncrementMs / 1000.0 /
+                     (double)SUITE_NUM_HISTOGRAM);
             ASSERT(SUITE_NUM_HISTOGRAM > 0);
             for (y = 1; y <= SUITE_NUM_HISTOGRAM; y++)
             {
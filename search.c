@@ -260,8 +260,11 @@ Search(IN SEARCHER_THREAD_CONTEXT *ctx,
     }
 
     // Probe interior node recognizers; allow probes of ondisk EGTB files
-    // if it looks like we can get hit.
-    switch(RecognLookup(ctx, &iScore, ctx->uPly <= (g_uIterateDepth / 2)))
+    // if it looks like we can get hit and there is enough depth left
+    // below this node to pay for a disk access.
+    switch(RecognLookup(ctx, &iScore, 
+                        ((ctx->uPly <= (g_uIterateDepth / 2)) &&
+                         (uDepth >= g_Options.uEGTBProbeDepth * ONE_PLY))))
     {
         case UNRECOGNIZED:
             break;
@@ -403,7 +406,7 @@ Search(IN SEARCHER_THREAD_CONTEXT *ctx,
                     // Deepening" or something like it.
                     if ((iAlpha + 1 != iBeta) &&
                         (mvHash.uMove == 0) &&
-                        (ctx->sMoveStack.mvf[x].iValue < SORT_THESE_FIRST) &&
+                        (ctx->sMoveStack.iValue[x] < SORT_THESE_FIRST) &&
                         (uDepth >= FOUR_PLY))
                     {
                         ASSERT(uDepth >= (IID_R_FACTOR + ONE_PLY));
@@ -426,7 +429,7 @@ Search(IN SEARCHER_THREAD_CONTEXT *ctx,
                     (ctx->uPly >= 2) &&
                     (iOrigExtend == 0) &&
                     (ctx->sPlyInfo[ctx->uPly - 2].iExtensionAmount <= 0) &&
-                    (ValueOfMaterialInTroubleDespiteMove(pos, pos->uToMove)))
+                    (ValueOfMaterialInTroubleDespiteMove(ctx, pos->uToMove)))
                 {
                     uFutilityMargin = (iAlpha - iRoughEval) / 2;
                     ASSERT(uFutilityMargin);
@@ -443,11 +446,11 @@ Search(IN SEARCHER_THREAD_CONTEXT *ctx,
                     {
                         SelectBestWithHistory(ctx, x);
                     }
-                    mv = ctx->sMoveStack.mvf[x].mv;
+                    mv = ctx->sMoveStack.mv[x];
 #ifdef DEBUG
-                    ASSERT(0 == (ctx->sMoveStack.mvf[x].bvFlags &
+                    ASSERT(0 == (ctx->sMoveStack.bvFlags[x] &
                                  MVF_MOVE_SEARCHED));
-                    ctx->sMoveStack.mvf[x].bvFlags |= MVF_MOVE_SEARCHED;
+                    ctx->sMoveStack.bvFlags[x] |= MVF_MOVE_SEARCHED;
 #endif
                     mv.bvFlags |= WouldGiveCheck(ctx, mv);
 
@@ -479,7 +482,7 @@ Search(IN SEARCHER_THREAD_CONTEXT *ctx,
             ASSERT(x != 0);
             ASSERT(PositionsAreEquivalent(pos, &pi->sPosition));
             ASSERT(iBestScore <= iAlpha);
-            ctx->sMoveStack.mvf[x-1].bvFlags &= ~MVF_MOVE_SEARCHED;
+            ctx->sMoveStack.bvFlags[x-1] &= ~MVF_MOVE_SEARCHED;
             iScore = StartParallelSearch(ctx,
                                          &iAlpha,
                                          iBeta,
@@ -729,7 +732,7 @@ _ShouldWeConsiderThisMove(IN SEARCHER_THREAD_CONTEXT *ctx,
                           IN FLAG fGeneratedChecks)
 {
     MOVE mvLast = ctx->sPlyInfo[ctx->uPly - 1].mv;
-    MOVE mv = ctx->sMoveStack.mvf[uMoveNum].mv;
+    MOVE mv = ctx->sMoveStack.mv[uMoveNum];
     ULONG uColor;
     SCORE i;
 
@@ -752,7 +755,7 @@ _ShouldWeConsiderThisMove(IN SEARCHER_THREAD_CONTEXT *ctx,
             }
         }
 
-        i = ctx->sMoveStack.mvf[uMoveNum].iValue;
+        i = ctx->sMoveStack.iValue[uMoveNum];
         if (i >= SORT_THESE_FIRST)
         {
             i &= STRIP_OFF_FLAGS;
@@ -897,11 +900,11 @@ QSearchFromCheckNoStandPat(IN SEARCHER_THREAD_CONTEXT *ctx,
          x++)
     {
         SelectBestNoHistory(ctx, x);
-        mv = ctx->sMoveStack.mvf[x].mv;
+        mv = ctx->sMoveStack.mv[x];
         mv.bvFlags |= WouldGiveCheck(ctx, mv);
 #ifdef DEBUG
-        ASSERT(0 == (ctx->sMoveStack.mvf[x].bvFlags & MVF_MOVE_SEARCHED));
-        ctx->sMoveStack.mvf[x].bvFlags |= MVF_MOVE_SEARCHED;
+        ASSERT(0 == (ctx->sMoveStack.bvFlags[x] & MVF_MOVE_SEARCHED));
+        ctx->sMoveStack.bvFlags[x] |= MVF_MOVE_SEARCHED;
 #endif
 
         // Note: no selectivity at in-check nodes; search every reply.
@@ -1032,17 +1035,17 @@ QSearchInDangerNoStandPat(IN SEARCHER_THREAD_CONTEXT *ctx,
          x++)
     {
         SelectBestNoHistory(ctx, x);
-        mv = ctx->sMoveStack.mvf[x].mv;
+        mv = ctx->sMoveStack.mv[x];
 #ifdef DEBUG
-        ASSERT(0 == (ctx->sMoveStack.mvf[x].bvFlags & MVF_MOVE_SEARCHED));
-        ctx->sMoveStack.mvf[x].bvFlags |= MVF_MOVE_SEARCHED;
+        ASSERT(0 == (ctx->sMoveStack.bvFlags[x] & MVF_MOVE_SEARCHED));
+        ctx->sMoveStack.bvFlags[x] |= MVF_MOVE_SEARCHED;
 #endif
 
         // Prune except when pruning all moves could cause us to return
         // -INFINITY (mated) erroneously.
         if (iAlpha > -INFINITY)
         {
-            if (ctx->sMoveStack.mvf[x].iValue <= 0)
+            if (ctx->sMoveStack.iValue[x] <= 0)
             {
                 ASSERT(SanityCheckMoves(ctx, x, VERIFY_BEFORE | VERIFY_AFTER));
                 goto end;
@@ -1170,6 +1173,10 @@ QSearch(IN SEARCHER_THREAD_CONTEXT *ctx,
 #endif
 
     INC(ctx->sCounters.tree.u64QNodeCount);
+    if (ctx->uPly > ctx->sCounters.tree.uMaxPly)
+    {
+        ctx->sCounters.tree.uMaxPly = ctx->uPly;
+    }
     pi->iExtensionAmount = 0;
     if (TRUE == CommonSearchInit(ctx,
                                  &iAlpha,
@@ -1230,7 +1237,7 @@ QSearch(IN SEARCHER_THREAD_CONTEXT *ctx,
     // his position looks dangerous (i.e. more than one piece en prise
     // or a piece trapped).  Fail low if there's nothing that looks
     // good on this line.
-    if (SideCanStandPat(pos, pos->uToMove) == FALSE)
+    if (SideCanStandPat(ctx, pos->uToMove) == FALSE)
     {
         iBestScore = QSearchInDangerNoStandPat(ctx, iAlpha, iBeta);
         goto end;
@@ -1283,7 +1290,7 @@ QSearch(IN SEARCHER_THREAD_CONTEXT *ctx,
          x++)
     {
         SelectBestNoHistory(ctx, x);
-        if (ctx->sMoveStack.mvf[x].iValue <= 0)
+        if (ctx->sMoveStack.iValue[x] <= 0)
         {
             // We are only intersted in winning/even captures/promotions
             // and (if fIncludeChecks is TRUE) some checking moves too.
@@ -1293,10 +1300,10 @@ QSearch(IN SEARCHER_THREAD_CONTEXT *ctx,
             ASSERT(iBestScore > -NMATE);
             goto end;
         }
-        mv = ctx->sMoveStack.mvf[x].mv;
+        mv = ctx->sMoveStack.mv[x];
 #ifdef DEBUG
-        ASSERT(0 == (ctx->sMoveStack.mvf[x].bvFlags & MVF_MOVE_SEARCHED));
-        ctx->sMoveStack.mvf[x].bvFlags |= MVF_MOVE_SEARCHED;
+        ASSERT(0 == (ctx->sMoveStack.bvFlags[x] & MVF_MOVE_SEARCHED));
+        ctx->sMoveStack.bvFlags[x] |= MVF_MOVE_SEARCHED;
 #endif
 
         if (FALSE == _ShouldWeConsiderThisMove(ctx,
@@ -68,10 +68,12 @@ CheckInputAndTimers(IN SEARCHER_THREAD_CONTEXT *ctx)
 
 Routine description:
 
-    This code is called from search when the total number of nodes
-    searched is a multiple of g_MoveTimer.uNodeCheckMask.  Its job is
-    to check for user input waiting on the input queue and to check to
-    see if we are over a time limit.
+    This code is called from search when the move timer thread has
+    raised TIMER_INPUT_PENDING or, in a node limited search, when the
+    number of nodes searched is a multiple of g_MoveTimer.uNodeCheckMask.
+    Its job is to process user input waiting on the input queue and
+    check the node limit.  Time limits are watched by the move timer
+    thread (see timer.c) which sets TIMER_STOPPING by itself.
 
 Parameters:
 
@@ -84,14 +86,17 @@ Return value:
 
 **/
 {
-    double dTimeStamp;
-
     //
     // See if there's user input to process.
     //
-    if ((ctx->uThreadNumber == 0) && (NumberOfPendingInputEvents() != 0))
+    if ((ctx->uThreadNumber == 0) &&
+        (g_MoveTimer.bvFlags & TIMER_INPUT_PENDING))
     {
-        ParseUserInput(TRUE);
+        ClearMoveTimerFlag(TIMER_INPUT_PENDING);
+        if (NumberOfPendingInputEvents() != 0)
+        {
+            ParseUserInput(TRUE);
+        }
 
         //
         // If the user input can be handled in the middle of the
@@ -106,54 +111,6 @@ Return value:
         }
     }
 
-    //
-    // Also check time limits now.
-    //
-    if (-1 != g_MoveTimer.dSoftTimeLimit)
-    {
-        dTimeStamp = SystemTimeStamp();
-        if ((g_MoveTimer.bvFlags & TIMER_CURRENT_OBVIOUS) ||
-            (g_MoveTimer.bvFlags & TIMER_CURRENT_WONT_UNBLOCK))
-        {
-            Trace("OBVIOUS MOVE / WON'T UNBLOCK --> stop searching now\n");
-            g_MoveTimer.bvFlags |= TIMER_STOPPING;
-            return(TRUE);
-        }
-
-        if (dTimeStamp > g_MoveTimer.dSoftTimeLimit)
-        {
-            //
-            // If we have exceeded the soft time limit, move now unless...
-            //
-            if ((!(g_MoveTimer.bvFlags & TIMER_JUST_OUT_OF_BOOK)) &&
-                (!(g_MoveTimer.bvFlags & TIMER_ROOT_POSITION_CRITICAL)) &&
-                (!(g_MoveTimer.bvFlags & TIMER_RESOLVING_ROOT_FL)) &&
-                (!(g_MoveTimer.bvFlags & TIMER_RESOLVING_ROOT_FH)) &&
-                (!(g_MoveTimer.bvFlags & TIMER_MANY_ROOT_FLS)) &&
-                (g_MoveTimer.bvFlags & TIMER_SEARCHING_FIRST_MOVE))
-            {
-                Trace("SOFT TIMER (%3.1f sec) --> "
-                      "stop searching now\n",
-                      dTimeStamp - g_MoveTimer.dStartTime);
-                g_MoveTimer.bvFlags |= TIMER_STOPPING;
-                return(TRUE);
-            }
-        }
-
-        //
-        // If we have exceeded the hard limit, we have to move no matter
-        // what.
-        //
-        if (dTimeStamp > g_MoveTimer.dHardTimeLimit)
-        {
-            Trace("HARD TIMER (%3.1f sec) --> "
-                  "stop searching now\n",
-                  dTimeStamp - g_MoveTimer.dStartTime);
-            g_MoveTimer.bvFlags |= TIMER_STOPPING;
-            return(TRUE);
-        }
-    }
-
     // 
     // Also check raw node count limit here.
     //
@@ -235,7 +192,7 @@ Return value:
         ((ctx->uPly < 3) ||
          (!IS_SAME_MOVE(mv, ctx->mvKiller[ctx->uPly-3][0]) &&
           !IS_SAME_MOVE(mv, ctx->mvKiller[ctx->uPly-3][1]))) &&
-        (GetMoveFailHighPercentage(mv) <= 10))
+        (GetMoveFailHighPercentage(ctx, mv) <= 10))
     {
         ASSERT(!InCheck(&ctx->sPosition, ctx->sPosition.uToMove));
         return(TRUE);
@@ -254,8 +211,8 @@ ComputeMoveScore(IN SEARCHER_THREAD_CONTEXT *ctx,
     if (uMoveNum != (ULONG)-1)
     {
         ASSERT(uMoveNum < MAX_MOVE_STACK);
-        ASSERT(IS_SAME_MOVE(mv, ctx->sMoveStack.mvf[uMoveNum].mv));
-        iMoveScore = ctx->sMoveStack.mvf[uMoveNum].iValue;
+        ASSERT(IS_SAME_MOVE(mv, ctx->sMoveStack.mv[uMoveNum]));
+        iMoveScore = ctx->sMoveStack.iValue[uMoveNum];
         if (iMoveScore >= SORT_THESE_FIRST)
         {
             ASSERT(iMoveScore > 0);
@@ -529,7 +486,7 @@ Return value:
          x++)
     {
         SelectBestNoHistory(ctx, x);
-        mv = ctx->sMoveStack.mvf[x].mv;
+        mv = ctx->sMoveStack.mv[x];
         mv.bvFlags |= WouldGiveCheck(ctx, mv);
         if (TRUE == MakeMove(ctx, mv))
         {
@@ -546,7 +503,7 @@ Return value:
                 }
             }
             UnmakeMove(ctx, mv);
-            ctx->sMoveStack.mvf[x].iValue = iScore;
+            ctx->sMoveStack.iValue[x] = iScore;
             if (iScore > iBestScore)
             {
                 uBest = x;
@@ -568,10 +525,10 @@ Return value:
     //
     while(x < ctx->sMoveStack.uEnd[ctx->uPly])
     {
-        ctx->sMoveStack.mvf[x].iValue = -INFINITY;
+        ctx->sMoveStack.iValue[x] = -INFINITY;
         x++;
     }
-    ctx->sMoveStack.mvf[uBest].iValue |= SORT_THESE_FIRST;
+    ctx->sMoveStack.iValue[uBest] |= SORT_THESE_FIRST;
     ASSERT(IS_VALID_SCORE(iBestScore));
     return(iBestScore);
 }
@@ -715,7 +672,7 @@ Return value:
              v < ctx->sMoveStack.uEnd[u];
              v++)
         {
-            if (IS_SAME_MOVE(q->mv, ctx->sMoveStack.mvf[v].mv))
+            if (IS_SAME_MOVE(q->mv, ctx->sMoveStack.mv[v]))
             {
                 Trace("%u/%u", v - ctx->sMoveStack.uBegin[u] + 1,
                       MOVE_COUNT(ctx, u));
@@ -800,12 +757,16 @@ Return value:
     ASSERT(*piAlpha < *piBeta);
 
     //
-    // Increment node count and see if we need to check input / timer
+    // Increment node count and see if we need to check input / node
+    // limits.  Time limits are enforced by the move timer thread.
     //
     ctx->sCounters.tree.u64TotalNodeCount++;
     ASSERT(ctx->sCounters.tree.u64TotalNodeCount > 0);
-    if ((ctx->sCounters.tree.u64TotalNodeCount &
-         g_MoveTimer.uNodeCheckMask) == 0)
+    if (((g_MoveTimer.bvFlags & TIMER_INPUT_PENDING) &&
+         (ctx->uThreadNumber == 0)) ||
+        ((g_Options.u64MaxNodeCount != 0ULL) &&
+         ((ctx->sCounters.tree.u64TotalNodeCount &
+           g_MoveTimer.uNodeCheckMask) == 0)))
     {
         (void)CheckInputAndTimers(ctx);
     }
@@ -961,7 +922,7 @@ WeShouldTryNullmovePruning(SEARCHER_THREAD_CONTEXT *ctx,
             ASSERT(u <= 6);
             if ((iRoughEval + _iDistAlphaSkipNull[u] <= iAlpha) ||
                 ((iRoughEval + _iDistAlphaSkipNull[u] / 2 <= iAlpha) &&
-                 (ValueOfMaterialInTroubleAfterNull(pos, pos->uToMove))))
+                 (ValueOfMaterialInTroubleAfterNull(ctx, pos->uToMove))))
             {
                 return FALSE;
             }
@@ -1059,7 +1020,7 @@ TryNullmovePruning(SEARCHER_THREAD_CONTEXT *ctx,
         {
             ASSERT(GET_COLOR(mv.pCaptured) == FLIP(pos->uToMove));
             ASSERT(mv.pCaptured == pos->rgSquare[mv.cTo].pPiece);
-            StoreEnprisePiece(pos, mv.cTo);
+            StoreEnprisePiece(ctx, mv.cTo);
             mvRef = ctx->mvNullmoveRefutations[ctx->uPly - 2];
             if ((mvRef.uMove) &&
                 (mvRef.pCaptured == mv.pCaptured) &&
@@ -1160,8 +1121,8 @@ Return value:
     {
         for (x = uCurrent; x < ctx->sMoveStack.uEnd[ctx->uPly]; x++)
         {
-            ASSERT(ctx->sMoveStack.mvf[x].iValue <= 0);
-            ASSERT(!IS_CHECKING_MOVE(ctx->sMoveStack.mvf[x].mv));
+            ASSERT(ctx->sMoveStack.iValue[x] <= 0);
+            ASSERT(!IS_CHECKING_MOVE(ctx->sMoveStack.mv[x]));
         }
     }
 
@@ -1174,7 +1135,7 @@ Return value:
              ((x >= ctx->sMoveStack.uBegin[ctx->uPly]) && (x != (ULONG)-1));
              x--)
         {
-            ASSERT(ctx->sMoveStack.mvf[x].bvFlags & MVF_MOVE_SEARCHED);
+            ASSERT(ctx->sMoveStack.bvFlags[x] & MVF_MOVE_SEARCHED);
         }
     }
     return(TRUE);
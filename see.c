@@ -507,12 +507,78 @@ Return value:
 }
 
 
+static ULONG
+_SeeTieBreak(IN POSITION *pos,
+             IN ULONG uColor,
+             IN COOR cTarget,
+             IN COOR c,
+             IN COOR cPinner)
+/**
+
+Routine description:
+
+    Rank a legal candidate attacker against others of the same value.
+    When a piece leaves c it may uncover a slider lined up behind it:
+    if that slider is ours it joins the exchange early (good), if it
+    is the enemy's we just handed them another recapture (bad).  Next
+    a piece that is only free to move because its pinner was the last
+    piece "moved" is preferred; per the cIgnore hack it will count as
+    pinned again on our next turn so it is now or never.  Anything
+    still tied goes by square.  Both SEE implementations use this to
+    choose among equal value attackers so they pick the same piece.  Like _AddXRays this looks at the real
+    board, not at what the exchange has removed.
+
+Parameters:
+
+    POSITION *pos : the board
+    ULONG uColor : side choosing an attacker
+    COOR cTarget : the square being fought over
+    COOR c : location of the candidate attacker
+    COOR cPinner : what ExposesCheck said about c (off board if unpinned)
+
+Return value:
+
+    static ULONG : sort key, lower is better
+
+**/
+{
+    int iIndex = (int)cTarget - (int)c;
+    int iDelta;
+    COOR cIndex;
+    PIECE p;
+    ULONG uKey = 2;
+
+    if (0 != (CHECK_VECTOR_WITH_INDEX(iIndex, BLACK) & (1 << QUEEN)))
+    {
+        iDelta = CHECK_DELTA_WITH_INDEX(iIndex);
+        for (cIndex = c + iDelta;
+             IS_ON_BOARD(cIndex);
+             cIndex += iDelta)
+        {
+            p = pos->rgSquare[cIndex].pPiece;
+            if (!IS_EMPTY(p))
+            {
+                if (0 != (CHECK_VECTOR_WITH_INDEX((int)cIndex - (int)cTarget,
+                                                  GET_COLOR(p)) &
+                          (1 << PIECE_TYPE(p))))
+                {
+                    uKey = (GET_COLOR(p) == uColor) ? 0 : 4;
+                }
+                break;
+            }
+        }
+    }
+    return(((uKey + !IS_ON_BOARD(cPinner)) << 8) | c);
+}
+
+
 #ifdef SEE_HEAPS
 static PIECE
 _MinLegalPiece(IN POSITION *pos,
                IN ULONG uColor,
                IN SEE_LIST *pList,
                IN SEE_LIST *pOther,
+               IN COOR cTarget,
                IN COOR *pc,
                IN COOR cIgnore)
 /**
@@ -521,12 +587,11 @@ Routine description:
 
     Return the piece from the SEE list with the lowest value that is
     not pinned to its own king.  Because we are storing the SEE_LISTS
-    as heaps, this is only an approximate value in the event that the
-    real min value piece is indeed pinned to its own king.  I
-    considered sorting the list in this case but it seems like (in
-    tests) this inaccuracy really has little or no impact on the
-    search tree size.  The speedup with heaps instead of sorted lists
-    seems worth the price.
+    as heaps the first legal piece found is not necessarily the
+    cheapest if the heap head is pinned, so once one is found the
+    rest of the heap is checked for a cheaper legal piece.  Ties
+    between legal pieces of the same value are broken by
+    _SeeTieBreak so that we agree with BitboardSEE.
 
 Parameters:
 
@@ -534,6 +599,7 @@ Parameters:
     ULONG uColor  : the color on move
     SEE_LIST *pList : the list we're selecting from
     SEE_LIST *pOther : the other side's list
+    COOR cTarget : the square being fought over
     COOR *pc,
     COOR cIgnore
 
@@ -546,6 +612,8 @@ Return value:
     COOR cKing;
     PIECE p;
     register ULONG x;
+    ULONG y;
+    ULONG u, uBest;
     COOR c;
 
     //
@@ -566,7 +634,7 @@ Return value:
         {
             if (pOther->uCount == 0)
             {
-                *pc = pList->data[0].cLoc;
+                *pc = pList->data[x].cLoc;
 
                 //
                 // Note: if p is a king and we allow them to play it then
@@ -602,6 +670,37 @@ Return value:
             //
             if (!IS_ON_BOARD(c) || (c == cIgnore))
             {
+                //
+                // If the heap head was pinned x may not be the least
+                // valuable legal piece; look for a cheaper one.  Among
+                // legal pieces of the same value _SeeTieBreak picks.
+                //
+                uBest = _SeeTieBreak(pos, uColor, cTarget,
+                                     pList->data[x].cLoc, c);
+                for (y = 0;
+                     y < pList->uCount;
+                     y++)
+                {
+                    if ((y == x) ||
+                        (pList->data[y].uVal > pList->data[x].uVal) ||
+                        (IS_KING(pList->data[y].pPiece)))
+                    {
+                        continue;
+                    }
+                    c = ExposesCheck(pos, pList->data[y].cLoc, cKing);
+                    if (!IS_ON_BOARD(c) || (c == cIgnore))
+                    {
+                        u = _SeeTieBreak(pos, uColor, cTarget,
+                                         pList->data[y].cLoc, c);
+                        if ((pList->data[y].uVal < pList->data[x].uVal) ||
+                            (u < uBest))
+                        {
+                            uBest = u;
+                            x = y;
+                        }
+                    }
+                }
+                p = pList->data[x].pPiece;
                 *pc = pList->data[x].cLoc;
                 _RemoveItem(pList, x);
                 return(p);
@@ -622,6 +721,7 @@ _MinLegalPiece(IN POSITION *pos,
                IN ULONG uColor,
                IN SEE_LIST *pList,
                IN SEE_LIST *pOther,
+               IN COOR cTarget,
                IN COOR *pc,
                IN COOR cIgnore)
 /**
@@ -629,7 +729,8 @@ _MinLegalPiece(IN POSITION *pos,
 Routine description:
 
     Return the piece from the SEE list with the lowest value that is
-    not pinned to its own king.
+    not pinned to its own king.  Ties between legal pieces of the
+    same value are broken by _SeeTieBreak.
 
 Parameters:
 
@@ -637,6 +738,7 @@ Parameters:
     ULONG uColor  : the color on move
     SEE_LIST *pList : the list we're selecting from
     SEE_LIST *pOther : the other side's list
+    COOR cTarget : the square being fought over
     COOR *pc,
     COOR cIgnore
 
@@ -649,6 +751,8 @@ Return value:
     COOR cKing;
     PIECE p;
     register ULONG x;
+    ULONG y;
+    ULONG u, uBest;
     COOR c;
 
     //
@@ -694,6 +798,35 @@ Return value:
             //
             if (!IS_ON_BOARD(c) || (c == cIgnore))
             {
+                //
+                // Among legal pieces of the same value _SeeTieBreak
+                // picks.
+                //
+                uBest = _SeeTieBreak(pos, uColor, cTarget,
+                                     pList->data[x].cLoc, c);
+                for (y = 0;
+                     y < pList->uCount;
+                     y++)
+                {
+                    if ((y == x) ||
+                        (pList->data[y].uVal != pList->data[x].uVal) ||
+                        (IS_KING(pList->data[y].pPiece)))
+                    {
+                        continue;
+                    }
+                    c = ExposesCheck(pos, pList->data[y].cLoc, cKing);
+                    if (!IS_ON_BOARD(c) || (c == cIgnore))
+                    {
+                        u = _SeeTieBreak(pos, uColor, cTarget,
+                                         pList->data[y].cLoc, c);
+                        if (u < uBest)
+                        {
+                            uBest = u;
+                            x = y;
+                        }
+                    }
+                }
+                p = pList->data[x].pPiece;
                 *pc = pList->data[x].cLoc;
                 _RemoveItem(pList, x);
                 return(p);
@@ -819,15 +952,16 @@ Return value:
 
 
 SCORE
-SEE(IN POSITION *pos,
-    IN MOVE mv)
+ListSEE(IN POSITION *pos,
+        IN MOVE mv)
 /**
 
 Routine description:
 
     Given a board and a move on the board, estimate the value of the
     move by considering the friend/enemy pieces that attack the move's
-    destination square.
+    destination square.  This is the original SEE_LIST based code;
+    see BitboardSEE below for the version used by default.
 
 Parameters:
 
@@ -909,6 +1043,7 @@ Return value:
                                 uWhoseTurn,
                                 &(rgPieces[uWhoseTurn]),
                                 &(rgPieces[FLIP(uWhoseTurn)]),
+                                mv.cTo,
                                 &cFrom,
                                 cFrom);
         if (0 == pPiece) break;               // no legal piece
@@ -958,24 +1093,508 @@ Return value:
         uListIndex--;
     }
 
-#ifdef TEST_BROKEN
-    iSign = DebugSEE(pos, mv);
+    return(rgiList[0]);
+}
+
+
+//
+// Bitboard SEE
+//
+// Rather than building and sorting/heapifying a SEE_LIST of attackers
+// per side, BitboardSEE keeps an occupancy bitboard and one attacker
+// bitboard per side and piece type.  Attackers (and x-rays uncovered
+// as pieces come off the square) are found by masking a precomputed
+// ray from the target square with the occupancy and taking the
+// nearest set bit.  Picking the least valuable attacker is then just
+// a walk up the piece types.
+//
+static BITBOARD g_bbSeeRays[64][8];
+static ULONG g_uSeeRayIndex[35];
+static const int g_iSeeRayDeltas[8] = {
+    -17, -16, -15, -1, +1, +15, +16, +17
+};
+static const int g_iSeeKnightDeltas[8] = {
+    -33, -31, -18, -14, +14, +18, +31, +33
+};
+
+#ifdef SEE_PARITY
+ULONG g_uSeeParityCalls = 0;
+ULONG g_uSeeParityListMismatches = 0;
+ULONG g_uSeeParityDebugMismatches = 0;
+#endif
+
+void
+InitializeSeeRayTable(void)
+/**
+
+Routine description:
+
+    Build the ray bitboards used by BitboardSEE.  g_bbSeeRays[sq][r]
+    has a bit set for every square from sq (exclusive) to the edge of
+    the board in direction g_iSeeRayDeltas[r].  Rays 0..3 run towards
+    bit 0 (a8) and rays 4..7 run towards bit 63 (h1).
+
+Parameters:
+
+    void
+
+Return value:
+
+    void
+
+**/
+{
+    COOR c, cRay;
+    ULONG u;
+
+    memset(g_bbSeeRays, 0, sizeof(g_bbSeeRays));
+    memset(g_uSeeRayIndex, 0xFF, sizeof(g_uSeeRayIndex));
+    for (u = 0; u < ARRAY_LENGTH(g_iSeeRayDeltas); u++)
+    {
+        g_uSeeRayIndex[g_iSeeRayDeltas[u] + 17] = u;
+    }
+
+    FOREACH_SQUARE(c)
+    {
+        if (!IS_ON_BOARD(c)) continue;
+        for (u = 0; u < ARRAY_LENGTH(g_iSeeRayDeltas); u++)
+        {
+            for (cRay = c + g_iSeeRayDeltas[u];
+                 IS_ON_BOARD(cRay);
+                 cRay += g_iSeeRayDeltas[u])
+            {
+                g_bbSeeRays[COOR_TO_BIT_NUMBER(c)][u] |= COOR_TO_BB(cRay);
+            }
+        }
+    }
+}
+
+
+static INLINE COOR
+_SeeNearestOnRay(IN BITBOARD bbOccupied,
+                 IN COOR cTarget,
+                 IN ULONG uRay)
+/**
+
+Routine description:
+
+    Find the closest occupied square to cTarget in direction uRay.
+
+Parameters:
+
+    BITBOARD bbOccupied : occupied squares
+    COOR cTarget : the square we are looking from
+    ULONG uRay : index of the ray direction
+
+Return value:
+
+    static INLINE COOR : the closest occupied square or ILLEGAL_COOR
+
+**/
+{
+    BITBOARD bb;
+    ULONG uBit;
+
+    ASSERT(uRay < 8);
+    bb = g_bbSeeRays[COOR_TO_BIT_NUMBER(cTarget)][uRay] & bbOccupied;
+    if (0 == bb)
+    {
+        return(ILLEGAL_COOR);
+    }
+    uBit = (uRay < 4) ? LastBit(bb) : FirstBit(bb);
+    ASSERT(uBit != 0);
+    return(BIT_NUMBER_TO_COOR(uBit - 1));
+}
+
+
+static INLINE void
+_SeeAddAttackerIfAligned(IN POSITION *pos,
+                         IN COOR cTarget,
+                         IN COOR c,
+                         IN OUT BITBOARD bbAttackers[2][8])
+/**
+
+Routine description:
+
+    Given the closest piece to cTarget along some ray, add it to the
+    attacker bitboards if it moves the right way to hit cTarget.
+
+Parameters:
+
+    POSITION *pos : the board
+    COOR cTarget : the square being fought over
+    COOR c : the closest piece to cTarget along a ray
+    BITBOARD bbAttackers[2][8] : attacker bitboards by color and type
+
+Return value:
+
+    static INLINE void
+
+**/
+{
+    PIECE p;
+
+    if (!IS_ON_BOARD(c)) return;
+    p = pos->rgSquare[c].pPiece;
+    ASSERT(IS_VALID_PIECE(p));
+    if (0 != (CHECK_VECTOR_WITH_INDEX((int)c - (int)cTarget,
+                                      GET_COLOR(p)) &
+              (1 << PIECE_TYPE(p))))
+    {
+        bbAttackers[GET_COLOR(p)][PIECE_TYPE(p)] |= COOR_TO_BB(c);
+    }
+}
+
+
+static void
+_SeeFindAttackers(IN POSITION *pos,
+                  IN COOR cTarget,
+                  IN BITBOARD bbOccupied,
+                  OUT BITBOARD bbAttackers[2][8])
+/**
+
+Routine description:
+
+    Populate the attacker bitboards for both sides.  Sliders, kings
+    and pawns are found with one masked ray lookup per direction;
+    knights are probed directly on the 0x88 board.
+
+Parameters:
+
+    POSITION *pos : the board
+    COOR cTarget : the square being fought over
+    BITBOARD bbOccupied : occupied squares
+    BITBOARD bbAttackers[2][8] : attacker bitboards by color and type
+
+Return value:
+
+    static void
+
+**/
+{
+    ULONG u;
+    COOR c;
+    PIECE p;
+
+    memset(bbAttackers, 0, sizeof(BITBOARD) * 2 * 8);
+    for (u = 0; u < 8; u++)
+    {
+        _SeeAddAttackerIfAligned(pos,
+                                 cTarget,
+                                 _SeeNearestOnRay(bbOccupied, cTarget, u),
+                                 bbAttackers);
+    }
+    for (u = 0; u < ARRAY_LENGTH(g_iSeeKnightDeltas); u++)
+    {
+        c = cTarget + g_iSeeKnightDeltas[u];
+        if (IS_ON_BOARD(c))
+        {
+            p = pos->rgSquare[c].pPiece;
+            if (IS_KNIGHT(p))
+            {
+                bbAttackers[GET_COLOR(p)][KNIGHT] |= COOR_TO_BB(c);
+            }
+        }
+    }
+}
+
+
+static INLINE void
+_SeeAddXRay(IN POSITION *pos,
+            IN COOR cTarget,
+            IN COOR cObstacle,
+            IN BITBOARD bbOccupied,
+            IN OUT BITBOARD bbAttackers[2][8])
+/**
+
+Routine description:
+
+    A piece just left cObstacle (which has already been cleared from
+    bbOccupied).  If it was lined up with cTarget, look past it along
+    the same ray for a slider that is now attacking cTarget.
+
+Parameters:
+
+    POSITION *pos : the board
+    COOR cTarget : the square being fought over
+    COOR cObstacle : the square that was just vacated
+    BITBOARD bbOccupied : occupied squares
+    BITBOARD bbAttackers[2][8] : attacker bitboards by color and type
+
+Return value:
+
+    static INLINE void
+
+**/
+{
+    int iIndex = (int)cTarget - (int)cObstacle;
+    ULONG uRay;
+
+    if (0 == (CHECK_VECTOR_WITH_INDEX(iIndex, BLACK) & (1 << QUEEN)))
+    {
+        return;
+    }
+    uRay = g_uSeeRayIndex[CHECK_DELTA_WITH_INDEX(iIndex) + 17];
+    _SeeAddAttackerIfAligned(pos,
+                             cTarget,
+                             _SeeNearestOnRay(bbOccupied, cTarget, uRay),
+                             bbAttackers);
+}
+
+
+static PIECE
+_SeeMinLegalAttacker(IN POSITION *pos,
+                     IN ULONG uColor,
+                     IN OUT BITBOARD bbAttackers[2][8],
+                     IN COOR cTarget,
+                     OUT COOR *pc,
+                     IN COOR cIgnore)
+/**
+
+Routine description:
+
+    Select (and remove) the least valuable attacker for side uColor
+    that is not pinned to its own king.  The pin test and the cIgnore
+    hack are the same as in the SEE_LIST based _MinLegalPiece so that
+    the two implementations agree.  Knights and bishops have the same
+    value so they are considered together; within a value the tie is
+    broken by _SeeTieBreak, again to match _MinLegalPiece.  The
+    king may only capture if the other side has nothing left to
+    recapture with.
+
+Parameters:
+
+    POSITION *pos : the board
+    ULONG uColor : side to move in the exchange
+    BITBOARD bbAttackers[2][8] : attacker bitboards by color and type
+    COOR cTarget : the square being fought over
+    COOR *pc : returns the location of the chosen attacker
+    COOR cIgnore : location of the piece the other side just moved
+
+Return value:
+
+    static PIECE : the piece chosen or 0 if no legal attacker
+
+**/
+{
+    BITBOARD bb;
+    COOR cKing = pos->cNonPawns[uColor][0];
+    COOR c, cPinner, cBest;
+    ULONG uType, uLast, u, uKey, uBest, uBestType;
+
+    for (uType = PAWN; uType < KING; uType = uLast + 1)
+    {
+        uLast = (uType == KNIGHT) ? BISHOP : uType;
+        uBest = (ULONG)-1;
+        uBestType = 0;
+        cBest = ILLEGAL_COOR;
+        for (u = uType; u <= uLast; u++)
+        {
+            bb = bbAttackers[uColor][u];
+            while (bb)
+            {
+                c = CoorFromBitBoardRank8ToRank1(&bb);
+                cPinner = ExposesCheck(pos, c, cKing);
+                if (!IS_ON_BOARD(cPinner) || (cPinner == cIgnore))
+                {
+                    uKey = _SeeTieBreak(pos, uColor, cTarget, c, cPinner);
+                    if (uKey < uBest)
+                    {
+                        uBest = uKey;
+                        uBestType = u;
+                        cBest = c;
+                    }
+                }
+            }
+        }
+        if (0 != uBestType)
+        {
+            bbAttackers[uColor][uBestType] &= ~COOR_TO_BB(cBest);
+            *pc = cBest;
+            return((uBestType << 1) | uColor);
+        }
+    }
 
-    if ((rgiList[0] != iSign) &&
-        (iSign != INVALID_SCORE))
+    if (bbAttackers[uColor][KING] &&
+        !(bbAttackers[FLIP(uColor)][PAWN] |
+          bbAttackers[FLIP(uColor)][KNIGHT] |
+          bbAttackers[FLIP(uColor)][BISHOP] |
+          bbAttackers[FLIP(uColor)][ROOK] |
+          bbAttackers[FLIP(uColor)][QUEEN] |
+          bbAttackers[FLIP(uColor)][KING]))
     {
-        DumpPosition(pos);
-        DumpMove(mv.uMove);
-        Trace("Real SEE says: %d\n"
-              "Test SEE says: %d\n",
-              rgiList[0], iSign);
-        UtilPanic(TESTCASE_FAILURE,
-                  NULL,
-                  "See mismatch",
-                  rgiList[0], 
-                  iSign,
-                  __FILE__, __LINE__);
+        ASSERT(bbAttackers[uColor][KING] == COOR_TO_BB(cKing));
+        *pc = cKing;
+        memset(bbAttackers[uColor], 0, sizeof(bbAttackers[uColor]));
+        return((KING << 1) | uColor);
     }
+    return(0);
+}
+
+
+#ifdef SEE_PARITY
+static void
+_SeeParityCheck(IN POSITION *pos,
+                IN MOVE mv,
+                IN SCORE iScore)
+/**
+
+Routine description:
+
+    Parity mode: compare a BitboardSEE result against the SEE_LIST
+    implementation and against the brute force DebugSEE.  Mismatches
+    are counted and traced rather than treated as fatal.  BitboardSEE
+    and ListSEE should always agree; DebugSEE sees every pin so a
+    small number of differences from it are expected.
+
+Parameters:
+
+    POSITION *pos : the board
+    MOVE mv : the move
+    SCORE iScore : what BitboardSEE said
+
+Return value:
+
+    static void
+
+**/
+{
+    SCORE iList = ListSEE(pos, mv);
+    SCORE iDebug = DebugSEE(pos, mv);
+
+    g_uSeeParityCalls++;
+    if (iList != iScore)
+    {
+        g_uSeeParityListMismatches++;
+        Trace("SEE parity: %s %s bitboard=%d list=%d\n",
+              PositionToFen(pos), MoveToIcs(mv), iScore, iList);
+    }
+    if ((iDebug != INVALID_SCORE) && (iDebug != iScore))
+    {
+        g_uSeeParityDebugMismatches++;
+        Trace("SEE parity: %s %s bitboard=%d debug=%d\n",
+              PositionToFen(pos), MoveToIcs(mv), iScore, iDebug);
+    }
+    if ((g_uSeeParityCalls & 0xFFFF) == 0)
+    {
+        Trace("SEE parity: %u calls, %u list mismatches, "
+              "%u debug mismatches\n",
+              g_uSeeParityCalls,
+              g_uSeeParityListMismatches,
+              g_uSeeParityDebugMismatches);
+    }
+}
 #endif
-    return(rgiList[0]);
+
+
+SCORE
+BitboardSEE(IN POSITION *pos,
+            IN MOVE mv)
+/**
+
+Routine description:
+
+    Given a board and a move on the board, estimate the value of the
+    move by playing out the capture sequence on its destination
+    square.  Attackers are kept as bitboards (see above) and the
+    swap list is a negamax gain array that is resolved at the end
+    without branching on whose turn it was.
+
+Parameters:
+
+    POSITION *pos,
+    MOVE mv
+
+Return value:
+
+    SCORE : the estimate of the move's score
+
+**/
+{
+    BITBOARD bbAttackers[2][8];
+    BITBOARD bbOccupied = 0;
+    SCORE iGain[32];
+    ULONG uDepth = 0;
+    ULONG uWhoseTurn = GET_COLOR(mv.pMoved);
+    ULONG uInPeril;
+    ULONG uPromValue;
+    ULONG u, v;
+    PIECE pPiece;
+    COOR cTo = mv.cTo;
+    COOR cFrom = mv.cFrom;
+
+    ASSERT(mv.uMove != 0);
+    ASSERT(IS_ON_BOARD(cTo));
+    ASSERT(IS_ON_BOARD(cFrom));
+
+    //
+    // Occupancy from the piece lists.
+    //
+    FOREACH_COLOR(u)
+    {
+        for (v = 0; v < pos->uPawnCount[u]; v++)
+        {
+            bbOccupied |= COOR_TO_BB(pos->cPawns[u][v]);
+        }
+        for (v = 0; v < pos->uNonPawnCount[u][0]; v++)
+        {
+            bbOccupied |= COOR_TO_BB(pos->cNonPawns[u][v]);
+        }
+    }
+    _SeeFindAttackers(pos, cTo, bbOccupied, bbAttackers);
+
+    //
+    // Play the first move -- like ListSEE we assume it is legal.
+    //
+    iGain[0] = (PIECE_VALUE(mv.pCaptured) +
+                PIECE_VALUE(mv.pPromoted));
+    uInPeril = (PIECE_VALUE(mv.pMoved) +
+                PIECE_VALUE(mv.pPromoted));
+    bbOccupied &= ~COOR_TO_BB(cFrom);
+    bbAttackers[uWhoseTurn][PIECE_TYPE(mv.pMoved)] &= ~COOR_TO_BB(cFrom);
+    _SeeAddXRay(pos, cTo, cFrom, bbOccupied, bbAttackers);
+
+    //
+    // Play moves 2..n, recording the gain for the side to move at each
+    // depth assuming the exchange stops there.
+    //
+    do
+    {
+        uWhoseTurn = FLIP(uWhoseTurn);
+        pPiece = _SeeMinLegalAttacker(pos,
+                                      uWhoseTurn,
+                                      bbAttackers,
+                                      cTo,
+                                      &cFrom,
+                                      cFrom);
+        if (0 == pPiece) break;
+
+        uPromValue = IS_PAWN(pPiece) & (RANK1(cTo) | RANK8(cTo));
+        uPromValue *= VALUE_QUEEN;
+        ASSERT((uPromValue == 0) || (uPromValue == VALUE_QUEEN));
+
+        uDepth++;
+        ASSERT(uDepth < ARRAY_LENGTH(iGain));
+        iGain[uDepth] = (SCORE)(uInPeril + uPromValue) - iGain[uDepth - 1];
+        uInPeril = PIECE_VALUE(pPiece) + uPromValue;
+
+        bbOccupied &= ~COOR_TO_BB(cFrom);
+        _SeeAddXRay(pos, cTo, cFrom, bbOccupied, bbAttackers);
+    }
+    while(1);
+
+    //
+    // Either side may decline to continue the exchange: fold the gain
+    // array back up to the root.
+    //
+    while (uDepth > 0)
+    {
+        iGain[uDepth - 1] = -MAX(-iGain[uDepth - 1], iGain[uDepth]);
+        uDepth--;
+    }
+
+#ifdef SEE_PARITY
+    _SeeParityCheck(pos, mv, iGain[0]);
+#endif
+    return(iGain[0]);
 }
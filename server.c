@@ -0,0 +1,879 @@
+/**
+
+Copyright (c) Scott Gasch
+
+Module Name:
+
+    server.c
+
+Abstract:
+
+    A long running analysis server for high volume batch work.  The
+    "serve" command reads a stream of analysis requests, one per
+    line, from stdin or from clients of a Unix domain socket and
+    answers each one with a single line of JSON.
+
+    A request is an EPD record: the four position fields of a FEN
+    (optionally followed by the halfmove clock and move number) and
+    then any of these opcodes:
+
+        id "<string>";   echoed back in the answer
+        acd <n>;         search to depth n
+        acn <n>;         search n nodes
+        acs <x>;         search for x seconds (may be fractional)
+
+    Other opcodes are ignored.  Limits a request doesn't give come
+    from the serve command line and if there are none at all the
+    search gets one second.  The answer looks like:
+
+        {"id":"x","bestmove":"e2e4","ponder":"e7e5",
+         "score":{"cp":31},"depth":12,"nodes":1234567,
+         "time_ms":1000,"pv":["e2e4","e7e5",...]}
+
+    (on one line) or {"id":"x","error":"..."} for a bad request.  A
+    checkmated or stalemated side gets a "result" instead of a
+    bestmove.  Answers always begin with a '{'; anything else that
+    the engine prints on stdout is chatter and clients should skip
+    it.
+
+    Requests are searched one at a time by the main searcher thread;
+    with --cpus the helper threads split the work of each search.
+    The hash table is not cleared between requests so a stream of
+    related positions (e.g. the moves of one game) benefit from each
+    other's searches.  Send "new" to clear it between unrelated
+    streams, "exit" to leave server mode and "quit" to exit the
+    engine.
+
+Revision History:
+
+**/
+
+#include "chess.h"
+
+#define SERVER_DEFAULT_SECONDS    (1.0)
+#define SERVER_ACCEPT_TIMEOUT_MS  (250)
+
+#define SERVE_CONTINUE            (0)
+#define SERVE_EXIT                (1)
+#define SERVE_QUIT                (2)
+
+typedef struct _SERVER_REQUEST
+{
+    CHAR szId[SMALL_STRING_LEN_CHAR];
+    CHAR szFen[SMALL_STRING_LEN_CHAR];
+    ULONG uDepth;                             // 0 = no depth limit
+    UINT64 u64Nodes;                          // 0 = no node limit
+    double dSeconds;                          // 0 = no time limit
+}
+SERVER_REQUEST;
+
+static FLAG g_fServing = FALSE;
+static SERVER_REQUEST g_ServerDefaults;
+
+FLAG
+AnalysisServerIsRunning(void)
+/**
+
+Routine description:
+
+    Is the analysis server running?  If so ParseUserInput must leave
+    queued requests alone while one is being searched.
+
+Parameters:
+
+    void
+
+Return value:
+
+    FLAG
+
+**/
+{
+    return(g_fServing);
+}
+
+
+static void
+_JsonEscape(OUT CHAR *szDest,
+            IN ULONG uLen,
+            IN CHAR *szSrc)
+/**
+
+Routine description:
+
+    Copy szSrc into szDest (uLen chars) escaped for use inside a JSON
+    string.
+
+Parameters:
+
+    CHAR *szDest,
+    ULONG uLen,
+    CHAR *szSrc
+
+Return value:
+
+    static void
+
+**/
+{
+    ULONG u = 0;
+
+    ASSERT(uLen > 7);
+    while ((*szSrc) && (u < uLen - 7))
+    {
+        if ((*szSrc == '"') || (*szSrc == '\\'))
+        {
+            szDest[u++] = '\\';
+            szDest[u++] = *szSrc;
+        }
+        else if ((UCHAR)*szSrc < 0x20)
+        {
+            u += snprintf(&(szDest[u]), uLen - u, "\\u%04x",
+                          (UCHAR)*szSrc);
+        }
+        else
+        {
+            szDest[u++] = *szSrc;
+        }
+        szSrc++;
+    }
+    szDest[u] = '\0';
+}
+
+
+void
+ScoreToJson(OUT CHAR *szDest,
+            IN ULONG uLen,
+            IN SCORE iScore)
+/**
+
+Routine description:
+
+    Write iScore as a JSON object: {"cp":n} or, for a mate score,
+    {"mate":n} with n in moves (negative if we are getting mated).
+
+Parameters:
+
+    CHAR *szDest,
+    ULONG uLen,
+    SCORE iScore
+
+Return value:
+
+    void
+
+**/
+{
+    if (abs(iScore) < NMATE)
+    {
+        snprintf(szDest, uLen, "{\"cp\":%d}", iScore);
+    }
+    else if (iScore > 0)
+    {
+        snprintf(szDest, uLen, "{\"mate\":%d}",
+                 (+INFINITY - iScore + 1) / 2);
+    }
+    else
+    {
+        snprintf(szDest, uLen, "{\"mate\":-%d}",
+                 (+INFINITY + iScore + 1) / 2);
+    }
+}
+
+
+static void
+_Respond(IN FILE *pOut,
+         IN CHAR *szAnswer)
+/**
+
+Routine description:
+
+    Send one answer line to a socket client (pOut) or to stdout if
+    pOut is NULL.  Either way it goes in the log too.
+
+Parameters:
+
+    FILE *pOut,
+    CHAR *szAnswer
+
+Return value:
+
+    static void
+
+**/
+{
+    if (NULL == pOut)
+    {
+        Trace("%s\n", szAnswer);
+        fflush(stdout);
+    }
+    else
+    {
+        fprintf(pOut, "%s\n", szAnswer);
+        fflush(pOut);
+        Log("%s\n", szAnswer);
+    }
+}
+
+
+static void
+_RespondWithError(IN FILE *pOut,
+                  IN SERVER_REQUEST *pReq,
+                  IN CHAR *szError)
+/**
+
+Routine description:
+
+    Answer a request that we could not search.
+
+Parameters:
+
+    FILE *pOut,
+    SERVER_REQUEST *pReq,
+    CHAR *szError
+
+Return value:
+
+    static void
+
+**/
+{
+    CHAR szId[SMALL_STRING_LEN_CHAR];
+    CHAR buf[SMALL_STRING_LEN_CHAR * 2];
+
+    _JsonEscape(szId, ARRAY_LENGTH(szId), pReq->szId);
+    snprintf(buf, ARRAY_LENGTH(buf), "{\"id\":\"%s\",\"error\":\"%s\"}",
+             szId, szError);
+    _Respond(pOut, buf);
+}
+
+
+static FLAG
+_ParseRequest(IN OUT CHAR *szLine,
+              OUT SERVER_REQUEST *pReq)
+/**
+
+Routine description:
+
+    Parse an EPD request line (see the comment at the top of this
+    file) into *pReq.  szLine is chopped up in the process.  This
+    does not validate the position, _PositionIsSearchable does that
+    later.
+
+Parameters:
+
+    CHAR *szLine,
+    SERVER_REQUEST *pReq
+
+Return value:
+
+    static FLAG : TRUE if it looked like a request, FALSE otherwise
+
+**/
+{
+    CHAR *p = szLine;
+    CHAR *q;
+    CHAR *szOp;
+    CHAR *szArg;
+    ULONG u;
+
+    memset(pReq, 0, sizeof(SERVER_REQUEST));
+
+    //
+    // The position part: four fields and maybe the two move counters.
+    //
+    for (u = 0; u < 6; u++)
+    {
+        while ((*p) && (isspace(*p))) p++;
+        if ((!*p) || ((u >= 4) && (!isdigit(*p)))) break;
+        q = p;
+        while ((*q) && (!isspace(*q)) && (*q != ';')) q++;
+        if (strlen(pReq->szFen) + (q - p) + 2 >=
+            ARRAY_LENGTH(pReq->szFen))
+        {
+            return(FALSE);
+        }
+        if (u > 0)
+        {
+            strcat(pReq->szFen, " ");
+        }
+        strncat(pReq->szFen, p, (size_t)(q - p));
+        p = q;
+    }
+    if ((u < 4) || (NULL == strchr(pReq->szFen, '/')))
+    {
+        return(FALSE);
+    }
+
+    //
+    // The opcodes.
+    //
+    while (*p)
+    {
+        while ((*p) && ((isspace(*p)) || (*p == ';'))) p++;
+        if (!*p) break;
+        szOp = p;
+        while ((*p) && (!isspace(*p)) && (*p != ';')) p++;
+        szArg = "";
+        if (*p == ';')
+        {
+            *p++ = '\0';
+        }
+        else if (*p)
+        {
+            *p++ = '\0';
+            while ((*p) && (isspace(*p))) p++;
+            if (*p == '"')
+            {
+                szArg = ++p;
+                while ((*p) && (*p != '"')) p++;
+                if (*p) *p++ = '\0';
+                while ((*p) && (*p != ';')) p++;
+            }
+            else
+            {
+                szArg = p;
+                while ((*p) && (*p != ';')) p++;
+            }
+            if (*p) *p++ = '\0';
+        }
+
+        if (!STRCMPI(szOp, "id"))
+        {
+            strncpy(pReq->szId, szArg, ARRAY_LENGTH(pReq->szId) - 1);
+        }
+        else if (!STRCMPI(szOp, "acd"))
+        {
+            pReq->uDepth = (ULONG)MAX(atoi(szArg), 0);
+        }
+        else if (!STRCMPI(szOp, "acn"))
+        {
+            pReq->u64Nodes = strtoull(szArg, NULL, 10);
+        }
+        else if (!STRCMPI(szOp, "acs"))
+        {
+            pReq->dSeconds = MAX(atof(szArg), 0.0);
+        }
+    }
+    return(TRUE);
+}
+
+
+static FLAG
+_PositionIsSearchable(IN POSITION *pos)
+/**
+
+Routine description:
+
+    FenToPosition is forgiving (it only warns about a missing king,
+    for instance) but the search assumes a legal position and will
+    crash on some illegal ones.  Check that each side has exactly one
+    king, that there are no pawns on the first or last rank and that
+    the side not on move is not in check.  FenToPosition itself
+    already refuses a second king.
+
+Parameters:
+
+    POSITION *pos
+
+Return value:
+
+    static FLAG
+
+**/
+{
+    ULONG uColor;
+    ULONG u;
+    COOR c;
+
+    FOREACH_COLOR(uColor)
+    {
+        if (!IS_ON_BOARD(pos->cNonPawns[uColor][0]) ||
+            !IS_KING(pos->rgSquare[pos->cNonPawns[uColor][0]].pPiece))
+        {
+            return(FALSE);
+        }
+        for (u = 0; u < pos->uPawnCount[uColor]; u++)
+        {
+            c = pos->cPawns[uColor][u];
+            if (RANK1(c) || RANK8(c))
+            {
+                return(FALSE);
+            }
+        }
+    }
+    return(FALSE == InCheck(pos, FLIP(pos->uToMove)));
+}
+
+
+static void
+_ServeRequest(IN SEARCHER_THREAD_CONTEXT *ctx,
+              IN SERVER_REQUEST *pReq,
+              IN FILE *pOut)
+/**
+
+Routine description:
+
+    Search one request and send back the answer.  This is Think
+    without the opening book, the clock and the move.
+
+Parameters:
+
+    SEARCHER_THREAD_CONTEXT *ctx,
+    SERVER_REQUEST *pReq,
+    FILE *pOut
+
+Return value:
+
+    static void
+
+**/
+{
+    static CHAR buf[MEDIUM_STRING_LEN_CHAR];
+    CHAR szId[SMALL_STRING_LEN_CHAR];
+    CHAR szScore[SMALL_STRING_LEN_CHAR];
+    CHAR szPonder[SMALL_STRING_LEN_CHAR];
+    CHAR szPV[SMALL_STRING_LEN_CHAR * 4];
+    ULONG uMaxDepth = g_Options.uMaxDepth;
+    UINT64 u64MaxNodeCount = g_Options.u64MaxNodeCount;
+    ULONG eClock = g_Options.eClock;
+    ULONG uMyIncrementMs = g_Options.uMyIncrementMs;
+    POSITION pos;
+    GAME_RESULT result;
+    double dStart;
+    MOVE mv;
+    ULONG u;
+
+    if ((FALSE == FenToPosition(&pos, pReq->szFen)) ||
+        (FALSE == _PositionIsSearchable(&pos)))
+    {
+        _RespondWithError(pOut, pReq, "illegal position");
+        return;
+    }
+
+    //
+    // Merge in the default limits and make sure there is at least
+    // one limit.
+    //
+    if ((0 == pReq->uDepth) &&
+        (0ULL == pReq->u64Nodes) &&
+        (0.0 == pReq->dSeconds))
+    {
+        pReq->uDepth = g_ServerDefaults.uDepth;
+        pReq->u64Nodes = g_ServerDefaults.u64Nodes;
+        pReq->dSeconds = g_ServerDefaults.dSeconds;
+        if ((0 == pReq->uDepth) &&
+            (0ULL == pReq->u64Nodes) &&
+            (0.0 == pReq->dSeconds))
+        {
+            pReq->dSeconds = SERVER_DEFAULT_SECONDS;
+        }
+    }
+    g_Options.uMaxDepth = MAX_PLY_PER_SEARCH - 1;
+    if (0 != pReq->uDepth)
+    {
+        g_Options.uMaxDepth = MINU(pReq->uDepth, MAX_PLY_PER_SEARCH - 1);
+    }
+    g_Options.u64MaxNodeCount = pReq->u64Nodes;
+    g_Options.eClock = CLOCK_NONE;
+    if (0.0 != pReq->dSeconds)
+    {
+        g_Options.eClock = CLOCK_FIXED;
+        g_Options.uMyIncrementMs = (ULONG)(pReq->dSeconds * 1000.0);
+    }
+
+    //
+    // Search it.
+    //
+    InitializeSearcherContext(&pos, ctx);
+    g_MoveTimer.bvFlags = 0;
+    g_Options.fPondering = FALSE;
+    g_Options.fThinking = TRUE;
+    g_Options.fSuccessfulPonder = FALSE;
+    g_Options.u64NodesSearched = 0ULL;
+    MaintainDynamicMoveOrdering();
+    DirtyHashTable();
+    SetMoveTimerForSearch(FALSE, pos.uToMove);
+#if (PERF_COUNTERS && MP)
+    ClearHelperThreadIdleness();
+#endif
+    dStart = g_MoveTimer.dStartTime;
+    result = Iterate(ctx);
+    g_Options.fThinking = FALSE;
+
+    g_Options.uMaxDepth = uMaxDepth;
+    g_Options.u64MaxNodeCount = u64MaxNodeCount;
+    g_Options.eClock = eClock;
+    g_Options.uMyIncrementMs = uMyIncrementMs;
+
+    //
+    // Answer.
+    //
+    _JsonEscape(szId, ARRAY_LENGTH(szId), pReq->szId);
+    if (RESULT_IN_PROGRESS != result.eResult)
+    {
+        snprintf(buf, ARRAY_LENGTH(buf),
+                 "{\"id\":\"%s\",\"bestmove\":null,\"result\":\"%s\","
+                 "\"reason\":\"%s\"}",
+                 szId,
+                 (RESULT_WHITE_WON == result.eResult) ? "1-0" :
+                 (RESULT_BLACK_WON == result.eResult) ? "0-1" : "1/2-1/2",
+                 result.szDescription);
+        _Respond(pOut, buf);
+        return;
+    }
+
+    ScoreToJson(szScore, ARRAY_LENGTH(szScore), ctx->iRootScore);
+
+    //
+    // The PV starts with the root move.  Stop at the first pseudo
+    // move (hash, recognizer, draw) in it.
+    //
+    szPV[0] = '\0';
+    szPonder[0] = '\0';
+    for (u = 0; u < MAX_PLY_PER_SEARCH; u++)
+    {
+        mv = ctx->sPlyInfo[0].PV[u];
+        if ((0 == mv.uMove) ||
+            (mv.uMove == HASHMOVE.uMove) ||
+            (mv.uMove == RECOGNMOVE.uMove) ||
+            (mv.uMove == DRAWMOVE.uMove) ||
+            (strlen(szPV) + 10 > ARRAY_LENGTH(szPV)))
+        {
+            break;
+        }
+        if ((0 == u) && (!IS_SAME_MOVE(mv, ctx->mvRootMove)))
+        {
+            break;
+        }
+        strcat(szPV, (u > 0) ? ",\"" : "\"");
+        strcat(szPV, MoveToUci(mv));
+        strcat(szPV, "\"");
+        if (1 == u)
+        {
+            snprintf(szPonder, ARRAY_LENGTH(szPonder),
+                     ",\"ponder\":\"%s\"", MoveToUci(mv));
+        }
+    }
+    if (szPV[0] == '\0')
+    {
+        snprintf(szPV, ARRAY_LENGTH(szPV), "\"%s\"",
+                 MoveToUci(ctx->mvRootMove));
+    }
+
+    snprintf(buf, ARRAY_LENGTH(buf),
+             "{\"id\":\"%s\",\"bestmove\":\"%s\"%s,\"score\":%s,"
+             "\"depth\":%u,\"nodes\":%" COMPILER_LONGLONG_UNSIGNED_FORMAT
+             ",\"time_ms\":%u,\"pv\":[%s]}",
+             szId,
+             MoveToUci(ctx->mvRootMove),
+             szPonder,
+             szScore,
+             ctx->uRootDepth / ONE_PLY,
+             g_Options.u64NodesSearched,
+             (ULONG)((SystemTimeStamp() - dStart) * 1000.0),
+             szPV);
+    _Respond(pOut, buf);
+}
+
+
+static CHAR *
+_ReadLine(IN FILE *pIn,
+          OUT CHAR *szLine,
+          IN ULONG uLen,
+          OUT FLAG *pfTooLong)
+/**
+
+Routine description:
+
+    Read the next line from pIn or, if pIn is NULL, from the input
+    thread's queue.  A line that doesn't fit in uLen chars is thrown
+    away (the rest of it too, so it isn't taken for another request)
+    and *pfTooLong is set.
+
+Parameters:
+
+    FILE *pIn,
+    CHAR *szLine,
+    ULONG uLen,
+    FLAG *pfTooLong
+
+Return value:
+
+    static CHAR * : szLine or NULL at the end of the input
+
+**/
+{
+    CHAR *p;
+    int ch;
+
+    *pfTooLong = FALSE;
+    if (NULL != pIn)
+    {
+        if (NULL == fgets(szLine, (int)uLen, pIn))
+        {
+            return(NULL);
+        }
+        if ((strlen(szLine) == uLen - 1) && (szLine[uLen - 2] != '\n'))
+        {
+            ch = fgetc(pIn);
+            if ((ch != EOF) && (ch != '\n'))
+            {
+                *pfTooLong = TRUE;
+                while ((ch != EOF) && (ch != '\n'))
+                {
+                    ch = fgetc(pIn);
+                }
+            }
+        }
+    }
+    else
+    {
+        p = BlockingReadInput();
+        if (NULL == p)
+        {
+            return(NULL);
+        }
+        *pfTooLong = (strlen(p) >= uLen);
+        strncpy(szLine, p, uLen - 1);
+        szLine[uLen - 1] = '\0';
+        SystemFreeMemory(p);
+    }
+    if (TRUE == *pfTooLong)
+    {
+        szLine[0] = '\0';
+    }
+    return(szLine);
+}
+
+
+static ULONG
+_ServeLine(IN SEARCHER_THREAD_CONTEXT *ctx,
+           IN CHAR *szLine,
+           IN FLAG fTooLong,
+           IN FILE *pOut)
+/**
+
+Routine description:
+
+    Handle one line of input to the server: a request or one of the
+    control words "new", "exit" and "quit".
+
+Parameters:
+
+    SEARCHER_THREAD_CONTEXT *ctx,
+    CHAR *szLine,
+    FLAG fTooLong : _ReadLine had to throw the line away
+    FILE *pOut
+
+Return value:
+
+    static ULONG : SERVE_CONTINUE, SERVE_EXIT or SERVE_QUIT
+
+**/
+{
+    SERVER_REQUEST sReq;
+    CHAR *p = szLine;
+    CHAR *q;
+
+    if (TRUE == fTooLong)
+    {
+        memset(&sReq, 0, sizeof(sReq));
+        _RespondWithError(pOut, &sReq, "line too long");
+        return(SERVE_CONTINUE);
+    }
+    while ((*p) && (isspace(*p))) p++;
+    q = p + strlen(p);
+    while ((q > p) && (isspace(*(q - 1)))) q--;
+    *q = '\0';
+    if ((*p == '\0') || (*p == '#'))
+    {
+        return(SERVE_CONTINUE);
+    }
+    if (!STRCMPI(p, "exit"))
+    {
+        return(SERVE_EXIT);
+    }
+    if (!STRCMPI(p, "quit"))
+    {
+        return(SERVE_QUIT);
+    }
+    if (!STRCMPI(p, "new"))
+    {
+        PreGameReset(FALSE);
+        return(SERVE_CONTINUE);
+    }
+    if (TRUE == _ParseRequest(p, &sReq))
+    {
+        _ServeRequest(ctx, &sReq, pOut);
+    }
+    else
+    {
+        _RespondWithError(pOut, &sReq, "not a request");
+    }
+    return(SERVE_CONTINUE);
+}
+
+
+COMMAND(ServeCommand)
+/**
+
+Routine description:
+
+    This function implements the 'serve' engine command.
+
+    Usage:
+
+        serve [socket <path>] [acd <n>] [acn <n>] [acs <x>]
+
+        Run the analysis server described at the top of this file
+        until "exit" or "quit".  Without socket the requests come
+        from stdin, otherwise from clients connecting to a Unix
+        domain socket at path (one at a time; a client that hangs up
+        or says "exit" makes room for the next one).  acd, acn and
+        acs set default limits for requests that don't give any.
+
+Parameters:
+
+    The COMMAND macro hides four arguments from the input parser:
+
+        CHAR *szInput : the full line of input
+        ULONG argc    : number of argument chunks
+        CHAR *argv[]  : array of ptrs to each argument chunk
+        POSITION *pos : a POSITION pointer to operate on
+
+Return value:
+
+    void
+
+**/
+{
+    static CHAR szLine[MEDIUM_STRING_LEN_CHAR];
+    SEARCHER_THREAD_CONTEXT *ctx;
+    CHAR *szSocket = NULL;
+    ULONG uSocket = (ULONG)-1;
+    FLAG fPost = g_Options.fShouldPost;
+    ULONG uRet = SERVE_CONTINUE;
+    FLAG fTooLong;
+    FILE *pIn, *pOut;
+    ULONG u;
+
+    memset(&g_ServerDefaults, 0, sizeof(g_ServerDefaults));
+    for (u = 1; u + 1 < argc; u += 2)
+    {
+        if (!STRCMPI(argv[u], "socket"))
+        {
+            szSocket = argv[u + 1];
+        }
+        else if (!STRCMPI(argv[u], "acd"))
+        {
+            g_ServerDefaults.uDepth = (ULONG)MAX(atoi(argv[u + 1]), 0);
+        }
+        else if (!STRCMPI(argv[u], "acn"))
+        {
+            g_ServerDefaults.u64Nodes = strtoull(argv[u + 1], NULL, 10);
+        }
+        else if (!STRCMPI(argv[u], "acs"))
+        {
+            g_ServerDefaults.dSeconds = MAX(atof(argv[u + 1]), 0.0);
+        }
+        else
+        {
+            break;
+        }
+    }
+    if (u < argc)
+    {
+        Trace("Error (Usage: serve [socket <path>] [acd <n>] [acn <n>] "
+              "[acs <x>]): %s\n", szInput);
+        return;
+    }
+    if (NULL != szSocket)
+    {
+        uSocket = SystemCreateServerSocket(szSocket);
+        if ((ULONG)-1 == uSocket)
+        {
+            Trace("Error (can't listen on socket): %s\n", szSocket);
+            return;
+        }
+    }
+
+    ctx = SystemAllocateMemory(sizeof(SEARCHER_THREAD_CONTEXT));
+    g_Options.fShouldPost = FALSE;
+    g_Options.ePlayMode = FORCE_MODE;
+    g_fServing = TRUE;
+    Trace("Serving analysis requests%s%s.\n",
+          (NULL != szSocket) ? " on " : " on stdin",
+          (NULL != szSocket) ? szSocket : "");
+
+    if (NULL == szSocket)
+    {
+        //
+        // Read requests from stdin; in batch mode no input thread is
+        // reading it so read it directly.
+        //
+        pIn = (TRUE == g_Options.fNoInputThread) ? stdin : NULL;
+        while (SERVE_CONTINUE == uRet)
+        {
+            if ((NULL == _ReadLine(pIn, szLine, ARRAY_LENGTH(szLine),
+                                   &fTooLong)) ||
+                (TRUE == g_fExitProgram))
+            {
+                uRet = SERVE_QUIT;
+                break;
+            }
+            uRet = _ServeLine(ctx, szLine, fTooLong, NULL);
+        }
+    }
+    else
+    {
+        //
+        // Serve socket clients one at a time and keep an eye on the
+        // console between them.
+        //
+        while (SERVE_QUIT != uRet)
+        {
+            if (TRUE == g_fExitProgram)
+            {
+                uRet = SERVE_QUIT;
+                break;
+            }
+            if ((FALSE == g_Options.fNoInputThread) &&
+                (0 != NumberOfPendingInputEvents()))
+            {
+                if (NULL == _ReadLine(NULL, szLine, ARRAY_LENGTH(szLine),
+                                      &fTooLong))
+                {
+                    uRet = SERVE_QUIT;
+                    break;
+                }
+                uRet = _ServeLine(ctx, szLine, fTooLong, NULL);
+                if (SERVE_CONTINUE != uRet) break;
+            }
+            if (FALSE == SystemAcceptServerConnection(
+                             uSocket, SERVER_ACCEPT_TIMEOUT_MS, &pIn, &pOut))
+            {
+                continue;
+            }
+            uRet = SERVE_CONTINUE;
+            while ((SERVE_CONTINUE == uRet) &&
+                   (NULL != _ReadLine(pIn, szLine, ARRAY_LENGTH(szLine),
+                                      &fTooLong)))
+            {
+                uRet = _ServeLine(ctx, szLine, fTooLong, pOut);
+            }
+            fclose(pIn);
+            fclose(pOut);
+        }
+        SystemDeleteServerSocket(uSocket, szSocket);
+    }
+
+    g_fServing = FALSE;
+    g_Options.fShouldPost = fPost;
+    SystemFreeMemory(ctx);
+    Trace("Analysis server done.\n");
+    if (SERVE_QUIT == uRet)
+    {
+        PushNewInput("quit");
+    }
+}
@@ -142,7 +142,7 @@ Return value:
         UtilPanic(DETECTED_INCORRECT_INITIALIZATION,
                   NULL,
                   "signature system",
-                  (void *)uChecksum,
+                  (void *)(uintptr_t)uChecksum,
                   (void *)0xac19ab2b, 
                   __FILE__, __LINE__);
     }
@@ -242,3 +242,40 @@ Return value:
 
     return(u64Sum);
 }
+
+
+UINT64
+ComputeMaterialSig(POSITION *pos)
+/**
+
+Routine description:
+
+    Given a board, recompute the material signature from scratch.
+
+Parameters:
+
+    POSITION *pos
+
+Return value:
+
+    UINT64
+
+**/
+{
+    register COOR c;
+    UINT64 u64Sum = MATERIAL_SIG_VALID;
+    PIECE p;
+
+    FOREACH_SQUARE(c)
+    {
+        if (!IS_ON_BOARD(c)) continue;
+
+        p = pos->rgSquare[c].pPiece;
+        if (!IS_EMPTY(p) && !IS_KING(p))
+        {
+            ASSERT(IS_VALID_PIECE(p));
+            u64Sum += MATERIAL_SIG_DELTA(p, c);
+        }
+    }
+    return(u64Sum);
+}
@@ -88,13 +88,15 @@ void
 HelpSearch(SEARCHER_THREAD_CONTEXT *ctx, ULONG u);
 
 //
-// A struct that holds information about helper threads.
+// A struct that holds information about helper threads.  The context
+// comes first so that its hot head starts a cacheline and does not
+// share one with uAssignment, which the master thread writes.
 //
 typedef struct _HELPER_THREAD
 {
+    SEARCHER_THREAD_CONTEXT ctx;
     ULONG uHandle;
     volatile ULONG uAssignment;
-    SEARCHER_THREAD_CONTEXT ctx;
 #ifdef PERF_COUNTERS
     UINT64 u64IdleCycles;
     UINT64 u64BusyCycles;
@@ -166,6 +168,11 @@ Return value:
 #endif
     InitializeSearcherContext(NULL, ctx);
     ctx->uThreadNumber = uMyId + 1;
+    ctx->pPawnHash = GetPawnHashTable(ctx->uThreadNumber);
+#ifdef EVAL_HASH
+    ctx->pEvalHash = GetEvalHashTable(ctx->uThreadNumber);
+#endif
+    ctx->pHistory = GetHistoryTable(ctx->uThreadNumber);
     do
     {
 #ifdef PERF_COUNTERS
@@ -213,9 +220,9 @@ Return value:
                 {
                     UtilPanic(CANNOT_INITIALIZE_SPLIT,
                               &ctx->sPosition,
-                              (void *)mv.uMove,
+                              (void *)(uintptr_t)mv.uMove,
                               &g_SplitInfo[u],
-                              (void *)v,
+                              (void *)(uintptr_t)v,
                               __FILE__, __LINE__);
                 }
                 v++;
@@ -246,7 +253,9 @@ Return value:
                  v < g_SplitInfo[u].uNumMoves;
                  v++)
             {
-                ctx->sMoveStack.mvf[v] = g_SplitInfo[u].mvf[v];
+                ctx->sMoveStack.iValue[v] = g_SplitInfo[u].mvf[v].iValue;
+                ctx->sMoveStack.mv[v] = g_SplitInfo[u].mvf[v].mv;
+                ctx->sMoveStack.bvFlags[v] = g_SplitInfo[u].mvf[v].bvFlags;
                 ASSERT(SanityCheckMove(&ctx->sPosition, 
                                        g_SplitInfo[u].mvf[v].mv));
             }
@@ -426,6 +435,43 @@ Return value:
         Trace("Helper thread %u: %5.2f percent busy.\n", u, (n / d) * 100.0);
     }
 }
+
+
+ULONG
+GetHelperIdlePercentages(OUT double *pdIdle,
+                         IN ULONG uMax)
+/**
+
+Routine description:
+
+    Fill in how idle each helper thread (up to uMax of them) has been
+    since the search started.
+
+Parameters:
+
+    double *pdIdle : array of uMax percentages
+    ULONG uMax
+
+Return value:
+
+    ULONG : the number of helper threads reported on
+
+**/
+{
+    ULONG u;
+    double n, d;
+
+    for (u = 0;
+         (u < g_uNumHelperThreads) && (u < uMax);
+         u++)
+    {
+        n = (double)g_HelperThreads[u].u64IdleCycles;
+        d = (double)g_HelperThreads[u].u64BusyCycles;
+        d += n;
+        pdIdle[u] = (d > 0.0) ? (n / d) * 100.0 : 0.0;
+    }
+    return(u);
+}
 #endif
 
 
@@ -502,6 +548,7 @@ Return value:
     ULONG u, v;
     ULONG uSplitNum;
     ULONG uOldStart;
+    MOVE_STACK_MOVE_VALUE_FLAGS *pMvf;
 #ifdef DEBUG
     POSITION board;
 
@@ -606,6 +653,7 @@ Return value:
             g_SplitInfo[u].sCounters.tree.u64TotalNodeCount = 0;
             g_SplitInfo[u].sCounters.tree.u64BetaCutoffs = 0;
             g_SplitInfo[u].sCounters.tree.u64BetaCutoffsOnFirstMove = 0;
+            g_SplitInfo[u].sCounters.tree.uMaxPly = 0;
             g_SplitInfo[u].PV[0] = NULLMOVE;
 
             //
@@ -618,30 +666,31 @@ Return value:
             g_SplitInfo[u].uAlreadyDone = uMoveNum - uOldStart + 1;
             ASSERT(g_SplitInfo[u].uAlreadyDone >= 1);
             ctx->sMoveStack.uBegin[ctx->uPly] = uMoveNum;
+
+            //
+            // If we fail high at this node we have done a lot of
+            // work for naught.  We also want to know as soon as
+            // possible so that we can vacate this split point, free
+            // up a worker thread and get back to the main search.  So
+            // forget about the SEARCH_SORT_LIMIT stuff here and sort
+            // the whole list of moves from best..worst in one shot.
+            //
+            SortMovesWithHistory(ctx, uMoveNum);
             for (v = uMoveNum, g_SplitInfo[u].uRemainingMoves = 0;
                  (v < ctx->sMoveStack.uEnd[ctx->uPly]);
                  v++, g_SplitInfo[u].uRemainingMoves++)
             {
                 ASSERT(g_SplitInfo[u].uRemainingMoves >= 0);
                 ASSERT(g_SplitInfo[u].uRemainingMoves < MAX_MOVES_PER_PLY);
-
-                //
-                // If we fail high at this node we have done a lot of
-                // work for naught.  We also want to know as soon as
-                // possible so that we can vacate this split point,
-                // free up a worker thread and get back to the main
-                // search.  So forget about the SEARCH_SORT_LIMIT
-                // stuff here and sort the whole list of moves from
-                // best..worst.
-                //
-                SelectBestWithHistory(ctx, v);
-                ctx->sMoveStack.mvf[v].mv.bvFlags |=
-                    WouldGiveCheck(ctx, ctx->sMoveStack.mvf[v].mv);
-                ASSERT(!(ctx->sMoveStack.mvf[v].bvFlags & MVF_MOVE_SEARCHED));
-                g_SplitInfo[u].mvf[g_SplitInfo[u].uRemainingMoves] =
-                    ctx->sMoveStack.mvf[v];
+                ctx->sMoveStack.mv[v].bvFlags |=
+                    WouldGiveCheck(ctx, ctx->sMoveStack.mv[v]);
+                ASSERT(!(ctx->sMoveStack.bvFlags[v] & MVF_MOVE_SEARCHED));
+                pMvf = &(g_SplitInfo[u].mvf[g_SplitInfo[u].uRemainingMoves]);
+                pMvf->iValue = ctx->sMoveStack.iValue[v];
+                pMvf->mv = ctx->sMoveStack.mv[v];
+                pMvf->bvFlags = ctx->sMoveStack.bvFlags[v];
 #ifdef DEBUG
-                ctx->sMoveStack.mvf[v].bvFlags |= MVF_MOVE_SEARCHED;
+                ctx->sMoveStack.bvFlags[v] |= MVF_MOVE_SEARCHED;
 #endif
             }
             g_SplitInfo[u].uOnDeckMove = 0;
@@ -651,9 +700,9 @@ Return value:
                  v < ctx->sMoveStack.uEnd[ctx->uPly];
                  v++)
             {
-                ASSERT(ctx->sMoveStack.mvf[v].bvFlags & MVF_MOVE_SEARCHED);
+                ASSERT(ctx->sMoveStack.bvFlags[v] & MVF_MOVE_SEARCHED);
                 ASSERT(SanityCheckMove(&ctx->sPosition,
-                                       ctx->sMoveStack.mvf[v].mv));
+                                       ctx->sMoveStack.mv[v]));
             }
 #endif
 
@@ -779,6 +828,8 @@ Return value:
             LOCK_SPLITS;
             ctx->sCounters.tree.u64TotalNodeCount =
                 g_SplitInfo[u].sCounters.tree.u64TotalNodeCount;
+            ctx->sCounters.tree.uMaxPly =
+                g_SplitInfo[u].sCounters.tree.uMaxPly;
             iScore = *piBestScore = g_SplitInfo[u].iBestScore;
             *pmvBest = g_SplitInfo[u].mvBest;
             if ((*piAlpha < iScore) && (iScore < iBeta))
@@ -936,6 +987,9 @@ Return value:
         ctx->sCounters.tree.u64BetaCutoffs;
     g_SplitInfo[u].sCounters.tree.u64BetaCutoffsOnFirstMove += 
         ctx->sCounters.tree.u64BetaCutoffsOnFirstMove;
+    g_SplitInfo[u].sCounters.tree.uMaxPly =
+        MAXU(g_SplitInfo[u].sCounters.tree.uMaxPly,
+             ctx->sCounters.tree.uMaxPly);
 
     //
     // TODO: Any other counters we care about?
@@ -1072,7 +1126,7 @@ Return value:
         ASSERT(IS_VALID_SCORE(iBestScore));
         ASSERT(uMoveNum < MAX_MOVES_PER_PLY);
         ASSERT(IS_SAME_MOVE(mv, 
-          ctx->sMoveStack.mvf[ctx->sMoveStack.uBegin[ctx->uPly]+uMoveNum].mv));
+          ctx->sMoveStack.mv[ctx->sMoveStack.uBegin[ctx->uPly]+uMoveNum]));
         ASSERT(uDepth <= MAX_DEPTH_PER_SEARCH);
         ASSERT(IS_VALID_SCORE(iAlpha));
         ASSERT(IS_VALID_SCORE(iBeta));
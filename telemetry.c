@@ -0,0 +1,593 @@
+/**
+
+Copyright (c) Scott Gasch
+
+Module Name:
+
+    telemetry.c
+
+Abstract:
+
+    An optional machine readable trace of the search.  When it is on
+    (telemetry <file> or --telemetry <file>) the engine appends one
+    JSON object per line to the file after every completed iteration
+    and after every search:
+
+        {"type":"iteration","depth":12,"seldepth":27,"score":{"cp":31},
+         "move":"e2e4","nodes":1234567,"qnodes":601234,"nps":1450000,
+         "time_ms":851,"tt":{...},"first_move_cutoff_pct":91.2,
+         "splits":{...},"helper_idle_pct":[3.1,2.7]}
+
+        {"type":"move", ...the same fields..., "pv":["e2e4","e7e5"],
+         "researches":{"fail_high":1,"fail_low":0,"nodes":4567}}
+
+    Counters that are only kept in PERF_COUNTERS builds (qnodes, hash
+    hits, cutoffs, splits, helper idleness) are null otherwise.
+
+    The search thread never waits on the file: it formats a record
+    into a ring of line buffers and signals a writer thread which
+    does the I/O.  If the writer falls so far behind that the ring is
+    full, or a record does not fit in a line buffer, the record is
+    dropped and counted instead:
+
+        {"type":"dropped","records":3,"oversize":1}
+
+Revision History:
+
+**/
+
+#include "chess.h"
+
+#define TELEMETRY_RING_SIZE      (64)     // must be a power of two
+#define TELEMETRY_RING_MASK      (TELEMETRY_RING_SIZE - 1)
+#define TELEMETRY_LINE_LEN       (2048)
+#define TELEMETRY_WAIT_MS        (250)
+#define TELEMETRY_MAX_HELPERS    (64)
+
+//
+// Only the searcher thread that runs Iterate produces records and
+// only the writer thread consumes them so, like the input ring, the
+// ring takes no lock: a record is published by bumping uQueued with
+// an interlocked op after its slot is filled and released the same
+// way after it has been written.
+//
+typedef struct _TELEMETRY
+{
+    FILE *pFile;
+    CHAR szFilename[SMALL_STRING_LEN_CHAR];
+    ULONG uEvent;
+    ULONG uThread;
+    volatile FLAG fRunning;
+    volatile ULONG uQueued;
+    ULONG uHead;                              // writer's next slot
+    ULONG uTail;                              // searcher's next slot
+    ULONG uDropped;                           // all dropped records
+    ULONG uOversize;                          // ...those too long
+    CHAR szRing[TELEMETRY_RING_SIZE][TELEMETRY_LINE_LEN];
+}
+TELEMETRY;
+
+static TELEMETRY *g_pTelemetry = NULL;
+
+
+static ULONG
+_TelemetryWriterThread(ULONG uUnused)
+/**
+
+Routine description:
+
+    The writer thread: copy queued records to the file until told to
+    stop, then write whatever is left.
+
+Parameters:
+
+    ULONG uUnused
+
+Return value:
+
+    static ULONG
+
+**/
+{
+    TELEMETRY *p = g_pTelemetry;
+    ULONG uReported = 0;
+    ULONG uOversizeReported = 0;
+    ULONG uDropped, uOversize;
+    FLAG fRunning;
+
+    ASSERT(NULL != p);
+    do
+    {
+        (void)SystemWaitForEvent(p->uEvent, TELEMETRY_WAIT_MS);
+        fRunning = p->fRunning;
+        while (p->uQueued > 0)
+        {
+            fputs(p->szRing[p->uHead & TELEMETRY_RING_MASK], p->pFile);
+            fputc('\n', p->pFile);
+            p->uHead++;
+            (void)LockDecrement(&(p->uQueued));
+        }
+        uOversize = p->uOversize;
+        uDropped = p->uDropped;
+        if (uDropped != uReported)
+        {
+            fprintf(p->pFile,
+                    "{\"type\":\"dropped\",\"records\":%u,\"oversize\":%u}\n",
+                    uDropped - uReported, uOversize - uOversizeReported);
+            uReported = uDropped;
+            uOversizeReported = uOversize;
+        }
+        fflush(p->pFile);
+    }
+    while(TRUE == fRunning);
+    return(0);
+}
+
+
+static void
+_TelemetryPost(IN CHAR *szRecord,
+               IN ULONG uLen)
+/**
+
+Routine description:
+
+    Queue one record for the writer thread without waiting for it.
+
+Parameters:
+
+    CHAR *szRecord,
+    ULONG uLen : strlen(szRecord), or TELEMETRY_LINE_LEN if _Append
+        ran out of room building it
+
+Return value:
+
+    static void
+
+**/
+{
+    TELEMETRY *p = g_pTelemetry;
+
+    if (uLen >= TELEMETRY_LINE_LEN)
+    {
+        (void)LockIncrement(&(p->uOversize));
+        (void)LockIncrement(&(p->uDropped));
+        return;
+    }
+    if (p->uQueued >= TELEMETRY_RING_SIZE)
+    {
+        (void)LockIncrement(&(p->uDropped));
+        return;
+    }
+    memcpy(p->szRing[p->uTail & TELEMETRY_RING_MASK], szRecord, uLen + 1);
+    p->uTail++;
+    (void)LockIncrement(&(p->uQueued));
+    SystemSignalEvent(p->uEvent);
+}
+
+
+static void
+_Append(IN OUT CHAR *buf,
+        IN ULONG uLen,
+        IN OUT ULONG *puUsed,
+        IN CHAR *szFormat, ...)
+/**
+
+Routine description:
+
+    printf onto the end of a record.  A truncated record would not be
+    valid JSON so if the text does not fit *puUsed is set to uLen,
+    later appends do nothing and _TelemetryPost drops the record.
+
+Parameters:
+
+    CHAR *buf,
+    ULONG uLen,
+    ULONG *puUsed : how much of buf is already used
+    CHAR *szFormat, ...
+
+Return value:
+
+    static void
+
+**/
+{
+    va_list ap;
+    int i;
+
+    if (*puUsed >= uLen)
+    {
+        return;
+    }
+    va_start(ap, szFormat);
+    i = vsnprintf(buf + *puUsed, uLen - *puUsed, szFormat, ap);
+    va_end(ap);
+    if ((i < 0) || ((ULONG)i >= uLen - *puUsed))
+    {
+        *puUsed = uLen;
+        return;
+    }
+    *puUsed += (ULONG)i;
+}
+
+
+static void
+_AppendSearchStats(IN SEARCHER_THREAD_CONTEXT *ctx,
+                   IN ULONG uDepth,
+                   IN SCORE iScore,
+                   IN OUT CHAR *buf,
+                   IN ULONG uLen,
+                   IN OUT ULONG *puUsed)
+/**
+
+Routine description:
+
+    Add the fields common to iteration and move records.
+
+Parameters:
+
+    SEARCHER_THREAD_CONTEXT *ctx,
+    ULONG uDepth,
+    SCORE iScore,
+    CHAR *buf,
+    ULONG uLen,
+    ULONG *puUsed
+
+Return value:
+
+    static void
+
+**/
+{
+    COUNTERS *c = &(ctx->sCounters);
+    double dSeconds = SystemTimeStamp() - g_MoveTimer.dStartTime;
+#ifdef PERF_COUNTERS
+    double d;
+#ifdef MP
+    double dIdle[TELEMETRY_MAX_HELPERS];
+    ULONG u, uNum;
+#endif
+#endif
+    CHAR szScore[SMALL_STRING_LEN_CHAR];
+
+    ScoreToJson(szScore, ARRAY_LENGTH(szScore), iScore);
+    dSeconds = MAX(dSeconds, 0.001);
+    _Append(buf, uLen, puUsed,
+            "\"depth\":%u,\"seldepth\":%u,\"score\":%s,\"move\":\"%s\","
+            "\"nodes\":%" COMPILER_LONGLONG_UNSIGNED_FORMAT ",",
+            uDepth,
+            (c->tree.uMaxPly > ctx->uPly) ? c->tree.uMaxPly - ctx->uPly : 0,
+            szScore,
+            (ctx->mvRootMove.uMove != 0) ? MoveToUci(ctx->mvRootMove) : "",
+            c->tree.u64TotalNodeCount);
+#ifdef PERF_COUNTERS
+    _Append(buf, uLen, puUsed,
+            "\"qnodes\":%" COMPILER_LONGLONG_UNSIGNED_FORMAT ",",
+            c->tree.u64QNodeCount);
+#else
+    _Append(buf, uLen, puUsed, "\"qnodes\":null,");
+#endif
+    _Append(buf, uLen, puUsed, "\"nps\":%.0f,\"time_ms\":%u,",
+            (double)c->tree.u64TotalNodeCount / dSeconds,
+            (ULONG)(dSeconds * 1000.0));
+
+#ifdef PERF_COUNTERS
+    d = (double)c->hash.u64Probes + 1;
+    _Append(buf, uLen, puUsed,
+            "\"tt\":{\"probes\":%" COMPILER_LONGLONG_UNSIGNED_FORMAT
+            ",\"hit_pct\":%.2f,\"useful_pct\":%.2f,\"upper_pct\":%.2f,"
+            "\"lower_pct\":%.2f,\"exact_pct\":%.2f},",
+            c->hash.u64Probes,
+            ((double)c->hash.u64OverallHits / d) * 100.0,
+            ((double)c->hash.u64UsefulHits / d) * 100.0,
+            ((double)c->hash.u64UpperBoundHits / d) * 100.0,
+            ((double)c->hash.u64LowerBoundHits / d) * 100.0,
+            ((double)c->hash.u64ExactScoreHits / d) * 100.0);
+    d = (double)c->tree.u64BetaCutoffs + 1;
+    _Append(buf, uLen, puUsed, "\"first_move_cutoff_pct\":%.2f,",
+            ((double)c->tree.u64BetaCutoffsOnFirstMove / d) * 100.0);
+    d = (double)c->tree.u64NullMoves + 1;
+    _Append(buf, uLen, puUsed, "\"null_move_success_pct\":%.2f,",
+            ((double)c->tree.u64NullMoveSuccess / d) * 100.0);
+#ifdef MP
+    _Append(buf, uLen, puUsed,
+            "\"splits\":{\"count\":%u,\"terminated\":%u},"
+            "\"helper_idle_pct\":[",
+            c->parallel.uNumSplits,
+            c->parallel.uNumSplitsTerminated);
+    uNum = GetHelperIdlePercentages(dIdle, ARRAY_LENGTH(dIdle));
+    for (u = 0; u < uNum; u++)
+    {
+        _Append(buf, uLen, puUsed, (u > 0) ? ",%.1f" : "%.1f", dIdle[u]);
+    }
+    _Append(buf, uLen, puUsed, "]");
+#else
+    _Append(buf, uLen, puUsed, "\"splits\":null,\"helper_idle_pct\":null");
+#endif
+#else
+    _Append(buf, uLen, puUsed,
+            "\"tt\":null,\"first_move_cutoff_pct\":null,"
+            "\"null_move_success_pct\":null,\"splits\":null,"
+            "\"helper_idle_pct\":null");
+#endif
+}
+
+
+void
+TelemetryIteration(IN SEARCHER_THREAD_CONTEXT *ctx,
+                   IN ULONG uDepth,
+                   IN SCORE iScore)
+/**
+
+Routine description:
+
+    Called by Iterate after it finishes a depth; queue an iteration
+    record if telemetry is on.
+
+Parameters:
+
+    SEARCHER_THREAD_CONTEXT *ctx,
+    ULONG uDepth,
+    SCORE iScore
+
+Return value:
+
+    void
+
+**/
+{
+    CHAR buf[TELEMETRY_LINE_LEN];
+    ULONG uUsed = 0;
+
+    if (NULL == g_pTelemetry)
+    {
+        return;
+    }
+    _Append(buf, ARRAY_LENGTH(buf), &uUsed, "{\"type\":\"iteration\",");
+    _AppendSearchStats(ctx, uDepth, iScore, buf, ARRAY_LENGTH(buf), &uUsed);
+    _Append(buf, ARRAY_LENGTH(buf), &uUsed, "}");
+    _TelemetryPost(buf, uUsed);
+}
+
+
+void
+TelemetryMove(IN SEARCHER_THREAD_CONTEXT *ctx,
+              IN ULONG uFailHighs,
+              IN ULONG uFailLows,
+              IN UINT64 u64ResearchNodes)
+/**
+
+Routine description:
+
+    Called at the end of a search; queue a move record if telemetry
+    is on.
+
+Parameters:
+
+    SEARCHER_THREAD_CONTEXT *ctx,
+    ULONG uFailHighs,
+    ULONG uFailLows,
+    UINT64 u64ResearchNodes
+
+Return value:
+
+    void
+
+**/
+{
+    CHAR buf[TELEMETRY_LINE_LEN];
+    ULONG uUsed = 0;
+    MOVE mv;
+    ULONG u;
+
+    if (NULL == g_pTelemetry)
+    {
+        return;
+    }
+    _Append(buf, ARRAY_LENGTH(buf), &uUsed, "{\"type\":\"move\",");
+    _AppendSearchStats(ctx, ctx->uRootDepth / ONE_PLY, ctx->iRootScore,
+                       buf, ARRAY_LENGTH(buf), &uUsed);
+    //
+    // The PV starts with the root move unless the search stopped in
+    // the middle of a depth before it had one; then it is just the
+    // root move.
+    //
+    _Append(buf, ARRAY_LENGTH(buf), &uUsed, ",\"pv\":[");
+    for (u = ctx->uPly; u < MAX_PLY_PER_SEARCH; u++)
+    {
+        mv = ctx->sPlyInfo[ctx->uPly].PV[u];
+        if ((0 == mv.uMove) ||
+            (mv.uMove == HASHMOVE.uMove) ||
+            (mv.uMove == RECOGNMOVE.uMove) ||
+            (mv.uMove == DRAWMOVE.uMove) ||
+            ((u == ctx->uPly) && (!IS_SAME_MOVE(mv, ctx->mvRootMove))))
+        {
+            break;
+        }
+        _Append(buf, ARRAY_LENGTH(buf), &uUsed,
+                (u > ctx->uPly) ? ",\"%s\"" : "\"%s\"", MoveToUci(mv));
+    }
+    if ((u == ctx->uPly) && (ctx->mvRootMove.uMove != 0))
+    {
+        _Append(buf, ARRAY_LENGTH(buf), &uUsed, "\"%s\"",
+                MoveToUci(ctx->mvRootMove));
+    }
+    _Append(buf, ARRAY_LENGTH(buf), &uUsed,
+            "],\"researches\":{\"fail_high\":%u,\"fail_low\":%u,"
+            "\"nodes\":%" COMPILER_LONGLONG_UNSIGNED_FORMAT "}}",
+            uFailHighs, uFailLows, u64ResearchNodes);
+    _TelemetryPost(buf, uUsed);
+}
+
+
+FLAG
+StartTelemetry(IN CHAR *szFilename)
+/**
+
+Routine description:
+
+    Start appending telemetry records to szFilename (stopping any
+    trace already in progress first).
+
+Parameters:
+
+    CHAR *szFilename
+
+Return value:
+
+    FLAG
+
+**/
+{
+    TELEMETRY *p;
+
+    StopTelemetry();
+    p = SystemAllocateMemory(sizeof(TELEMETRY));
+    memset(p, 0, sizeof(TELEMETRY));
+    strncpy(p->szFilename, szFilename, ARRAY_LENGTH(p->szFilename) - 1);
+    p->pFile = fopen(szFilename, "a");
+    if (NULL == p->pFile)
+    {
+        Trace("Error (can't open telemetry file): %s\n", szFilename);
+        goto fail;
+    }
+    p->uEvent = SystemCreateEvent();
+    if ((ULONG)-1 == p->uEvent)
+    {
+        Trace("Error (can't create telemetry event)\n");
+        fclose(p->pFile);
+        goto fail;
+    }
+    p->fRunning = TRUE;
+    g_pTelemetry = p;
+    if (FALSE == SystemCreateThread(_TelemetryWriterThread, 0, &(p->uThread)))
+    {
+        Trace("Error (can't start telemetry thread)\n");
+        g_pTelemetry = NULL;
+        (void)SystemDeleteEvent(p->uEvent);
+        fclose(p->pFile);
+        goto fail;
+    }
+    return(TRUE);
+
+ fail:
+    SystemFreeMemory(p);
+    return(FALSE);
+}
+
+
+void
+StopTelemetry(void)
+/**
+
+Routine description:
+
+    Stop the telemetry trace, if there is one, after the writer
+    thread has written everything queued.
+
+Parameters:
+
+    void
+
+Return value:
+
+    void
+
+**/
+{
+    TELEMETRY *p = g_pTelemetry;
+
+    if (NULL == p)
+    {
+        return;
+    }
+    p->fRunning = FALSE;
+    SystemSignalEvent(p->uEvent);
+    (void)SystemWaitForThreadToExit(p->uThread);
+    (void)SystemDeleteThread(p->uThread);
+    g_pTelemetry = NULL;
+    (void)SystemDeleteEvent(p->uEvent);
+    fclose(p->pFile);
+    SystemFreeMemory(p);
+}
+
+
+void
+InitializeTelemetry(void)
+/**
+
+Routine description:
+
+    Start the telemetry trace if one was asked for on the command
+    line.
+
+Parameters:
+
+    void
+
+Return value:
+
+    void
+
+**/
+{
+    if (g_Options.szTelemetryFile[0] != '\0')
+    {
+        (void)StartTelemetry(g_Options.szTelemetryFile);
+    }
+}
+
+
+COMMAND(TelemetryCommand)
+/**
+
+Routine description:
+
+    This function implements the 'telemetry' engine command.
+
+    Usage:
+
+        telemetry [<file> | off]
+
+        Append a JSON line per completed iteration and per search to
+        file, or stop doing so.  Without an argument say where the
+        trace is going.
+
+Parameters:
+
+    The COMMAND macro hides four arguments from the input parser:
+
+        CHAR *szInput : the full line of input
+        ULONG argc    : number of argument chunks
+        CHAR *argv[]  : array of ptrs to each argument chunk
+        POSITION *pos : a POSITION pointer to operate on
+
+Return value:
+
+    void
+
+**/
+{
+    if (argc < 2)
+    {
+        if (NULL == g_pTelemetry)
+        {
+            Trace("Telemetry is off.\n");
+        }
+        else
+        {
+            Trace("Telemetry is going to %s (%u records dropped).\n",
+                  g_pTelemetry->szFilename, g_pTelemetry->uDropped);
+        }
+        return;
+    }
+    if (!STRCMPI(argv[1], "off"))
+    {
+        StopTelemetry();
+        Trace("Telemetry is off.\n");
+        return;
+    }
+    if (TRUE == StartTelemetry(argv[1]))
+    {
+        Trace("Telemetry is going to %s.\n", argv[1]);
+    }
+}
@@ -0,0 +1,91 @@
+/**
+
+Copyright (c) Scott Gasch
+
+Module Name:
+
+    testbitbase.c
+
+Abstract:
+
+    Test the endgame bitbases.
+
+Revision History:
+
+**/
+
+#ifdef TEST
+#include "chess.h"
+
+void
+TestBitbases(void)
+/**
+
+Routine description:
+
+    Check the KPK bitbase against some positions whose outcome is
+    known.  Each is given for both sides to move and, where it makes
+    a difference, with the colors reversed.
+
+Parameters:
+
+    void
+
+Return value:
+
+    void
+
+**/
+{
+    static struct
+    {
+        char *szFen;
+        FLAG fWin;
+    }
+    x[] =
+    {
+        // King on the 6th in front of the pawn wins
+        { "4k3/8/4K3/4P3/8/8/8/8 w - - 0 1", TRUE },
+        { "4k3/8/4K3/4P3/8/8/8/8 b - - 0 1", TRUE },
+        { "8/8/8/8/4p3/4k3/8/4K3 w - - 0 1", TRUE },
+        { "8/8/8/8/4p3/4k3/8/4K3 b - - 0 1", TRUE },
+        // Lone king in the corner in front of a rook pawn
+        { "k7/8/8/8/8/8/P7/K7 w - - 0 1", FALSE },
+        { "k7/8/8/8/8/8/P7/K7 b - - 0 1", FALSE },
+        { "7K/7p/8/8/8/8/8/7k w - - 0 1", FALSE },
+        // Stalemate
+        { "4k3/4P3/4K3/8/8/8/8/8 b - - 0 1", FALSE },
+        // Outside the square of the pawn
+        { "7k/8/8/P7/8/8/8/7K b - - 0 1", TRUE },
+        { "k7/8/8/7P/8/8/8/K7 b - - 0 1", TRUE },
+        // Just inside it
+        { "5k2/8/8/8/P7/8/8/7K b - - 0 1", FALSE },
+        { "5k2/8/8/8/P7/8/8/7K w - - 0 1", TRUE },
+    };
+    POSITION pos;
+    ULONG uStrong;
+    ULONG u;
+
+    Trace("Testing endgame bitbases...\n");
+    for (u = 0; u < ARRAY_LENGTH(x); u++)
+    {
+        if (FALSE == FenToPosition(&pos, x[u].szFen))
+        {
+            UtilPanic(TESTCASE_FAILURE,
+                      NULL, "FenToPosition", NULL, NULL,
+                      __FILE__, __LINE__);
+        }
+        uStrong = (pos.uPawnCount[WHITE] > 0) ? WHITE : BLACK;
+        if (ProbeKPKBitbase(uStrong,
+                            pos.cNonPawns[uStrong][0],
+                            pos.cNonPawns[FLIP(uStrong)][0],
+                            pos.cPawns[uStrong][0],
+                            pos.uToMove) != x[u].fWin)
+        {
+            UtilPanic(TESTCASE_FAILURE,
+                      NULL, x[u].szFen, NULL, NULL,
+                      __FILE__, __LINE__);
+        }
+    }
+}
+#endif
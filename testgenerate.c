@@ -61,7 +61,7 @@ PlyTest(SEARCHER_THREAD_CONTEXT *ctx,
          u < ctx->sMoveStack.uEnd[uPly];
          u++)
     {
-        mv = ctx->sMoveStack.mvf[u].mv;
+        mv = ctx->sMoveStack.mv[u];
         mv.bvFlags |= WouldGiveCheck(ctx, mv);
         
         if (MakeMove(ctx, mv))
@@ -208,7 +208,7 @@ TestLegalMoveGenerator(void)
                  v < ctx->sMoveStack.uEnd[0];
                  v++)
             {
-                mv = ctx->sMoveStack.mvf[v].mv;
+                mv = ctx->sMoveStack.mv[v];
                 ASSERT(mv.bvFlags & MOVE_FLAG_ESCAPING_CHECK);
                 if (TRUE == MakeMove(ctx, mv))
                 {
@@ -221,7 +221,7 @@ TestLegalMoveGenerator(void)
                 }
                 else
                 {
-                    ctx->sMoveStack.mvf[v].mv.uMove = 0;
+                    ctx->sMoveStack.mv[v].uMove = 0;
                 }
             }
 
@@ -0,0 +1,191 @@
+/**
+
+Copyright (c) Scott Gasch
+
+Module Name:
+
+    testnnue.c
+
+Abstract:
+
+    Test the NNUE evaluator's incremental accumulator updates.
+
+Revision History:
+
+**/
+
+#ifdef TEST
+#include "chess.h"
+
+static FLAG
+_WriteRandomNetwork(IN FILE *p)
+/**
+
+Routine description:
+
+    Write a network with small random weights in the format that
+    ReadNnueNetwork reads.
+
+Parameters:
+
+    FILE *p
+
+Return value:
+
+    static FLAG
+
+**/
+{
+    ULONG uHeader[6];
+    SHORT iRow[NNUE_HIDDEN];
+    ULONG u, x;
+    FLAG fRet = TRUE;
+
+    uHeader[0] = 0x45554E54;                  // "TNUE"
+    uHeader[1] = 1;
+    uHeader[2] = NNUE_INPUTS;
+    uHeader[3] = NNUE_HIDDEN;
+    uHeader[4] = 16;
+    uHeader[5] = 0;
+    fRet &= (1 == fwrite(uHeader, sizeof(uHeader), 1, p));
+
+    //
+    // The feature biases, one row per feature and the output weights
+    // (as two rows).
+    //
+    for (u = 0; u < 1 + NNUE_INPUTS + 2; u++)
+    {
+        for (x = 0; x < NNUE_HIDDEN; x++)
+        {
+            iRow[x] = (SHORT)((rand() % 129) - 64);
+        }
+        fRet &= (1 == fwrite(iRow, sizeof(iRow), 1, p));
+    }
+    return(fRet);
+}
+
+
+static void
+_CheckIncrementalEval(IN SEARCHER_THREAD_CONTEXT *ctx,
+                      IN ULONG uDepth)
+/**
+
+Routine description:
+
+    Make sure the incrementally updated eval matches one computed from
+    scratch at every node of a full width tree uDepth ply deep.
+
+Parameters:
+
+    SEARCHER_THREAD_CONTEXT *ctx,
+    ULONG uDepth
+
+Return value:
+
+    static void
+
+**/
+{
+    MOVE mv;
+    ULONG u;
+    ULONG uPly;
+
+    if (NnueEval(ctx) != NnueEvalPosition(&(ctx->sPosition)))
+    {
+        UtilPanic(TESTCASE_FAILURE,
+                  NULL, "nnue incremental eval", NULL, NULL,
+                  __FILE__, __LINE__);
+    }
+    if (uDepth == 0)
+    {
+        return;
+    }
+
+    mv.uMove = 0;
+    GenerateMoves(ctx, mv, GENERATE_DONT_SCORE);
+    uPly = ctx->uPly;
+    for (u = ctx->sMoveStack.uBegin[uPly];
+         u < ctx->sMoveStack.uEnd[uPly];
+         u++)
+    {
+        mv = ctx->sMoveStack.mv[u];
+        if (MakeMove(ctx, mv))
+        {
+            _CheckIncrementalEval(ctx, uDepth - 1);
+            UnmakeMove(ctx, mv);
+        }
+    }
+}
+
+
+void
+TestNnue(void)
+/**
+
+Routine description:
+
+    Load a random network and check the incrementally updated eval
+    against a from scratch eval over some positions with castling,
+    en passant, promotions and king moves in them.
+
+Parameters:
+
+    void
+
+Return value:
+
+    void
+
+**/
+{
+    static CHAR *szFens[] =
+    {
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbqkb1r/pp1p1ppp/5n2/2pPp3/8/8/PPP1PPPP/RNBQKBNR w KQkq c6 0 1",
+    };
+    SEARCHER_THREAD_CONTEXT *ctx;
+    POSITION pos;
+    FILE *p;
+    ULONG u;
+
+    Trace("Testing NNUE accumulators...\n");
+    if (TRUE == NnueNetworkIsLoaded())
+    {
+        Trace("    (skipped, a network is already loaded)\n");
+        return;
+    }
+
+    //
+    // The network is ~20Mb; tmpfile() keeps it out of the current
+    // directory and goes away by itself when closed.
+    //
+    p = tmpfile();
+    if ((NULL == p) ||
+        (FALSE == _WriteRandomNetwork(p)) ||
+        (0 != fseek(p, 0, SEEK_SET)) ||
+        (FALSE == ReadNnueNetwork(p, "(random test network)")))
+    {
+        UtilPanic(TESTCASE_FAILURE,
+                  NULL, "ReadNnueNetwork", NULL, NULL,
+                  __FILE__, __LINE__);
+    }
+    fclose(p);
+
+    ctx = SystemAllocateMemory(sizeof(SEARCHER_THREAD_CONTEXT));
+    for (u = 0; u < ARRAY_LENGTH(szFens); u++)
+    {
+        if (FALSE == FenToPosition(&pos, szFens[u]))
+        {
+            UtilPanic(TESTCASE_FAILURE,
+                      NULL, "FenToPosition", NULL, NULL,
+                      __FILE__, __LINE__);
+        }
+        InitializeSearcherContext(&pos, ctx);
+        _CheckIncrementalEval(ctx, 3);
+    }
+    SystemFreeMemory(ctx);
+    CleanupNnue();
+}
+#endif
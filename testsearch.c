@@ -42,7 +42,7 @@ TestSearch(void)
     SEARCHER_THREAD_CONTEXT *ctx;
     POSITION pos;
     ULONG u;
-    FLAG fOver;
+    GAME_RESULT result;
     FLAG fPost = g_Options.fShouldPost;
     FLAG fRet = FALSE;
 
@@ -79,7 +79,7 @@ TestSearch(void)
 #if (PERF_COUNTERS && MP)
         ClearHelperThreadIdleness();
 #endif
-        fOver = Iterate(ctx);
+        result = Iterate(ctx);
 
         //
         // How long did that take?
@@ -94,7 +94,7 @@ TestSearch(void)
         //
         // Did we get a sane move?
         //
-        if (GAME_NOT_OVER == fOver)
+        if (RESULT_IN_PROGRESS == result.eResult)
         {
             if (FALSE == SanityCheckMove(&pos, ctx->mvRootMove))
             {
@@ -104,11 +104,11 @@ TestSearch(void)
             }
         }
 #ifdef DEBUG
-        else if (GAME_WHITE_WON == fOver)
+        else if (RESULT_WHITE_WON == result.eResult)
         {
             ASSERT(InCheck(&pos, BLACK));
         }
-        else if (GAME_BLACK_WON == fOver)
+        else if (RESULT_BLACK_WON == result.eResult)
         {
             ASSERT(InCheck(&pos, WHITE));
         }
@@ -120,4 +120,148 @@ TestSearch(void)
     SystemFreeMemory(ctx);
     return(fRet);
 }
+
+
+static GAME_RESULT
+_TestSearchFromScratch(SEARCHER_THREAD_CONTEXT *ctx,
+                       POSITION *pos,
+                       ULONG uDepth,
+                       ULONG uMultiPv)
+{
+    InitializeSearcherContext(pos, ctx);
+    g_MoveTimer.bvFlags = 0;
+    g_Options.fPondering = FALSE;
+    g_Options.fThinking = TRUE;
+    g_Options.fSuccessfulPonder = FALSE;
+
+    //
+    // Start both searches of a position from the same empty tables so
+    // that the only difference between them is the MultiPV setting.
+    //
+    ClearDynamicMoveOrdering();
+    ClearHashTable();
+    SetMoveTimerForTestingSearch();
+    g_Options.uMaxDepth = uDepth;
+    g_Options.uMultiPv = uMultiPv;
+#if (PERF_COUNTERS && MP)
+    ClearHelperThreadIdleness();
+#endif
+    return(Iterate(ctx));
+}
+
+
+FLAG
+TestMultiPvSearch(void)
+{
+    static CHAR *szFens[] =
+    {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r1bq1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP1QBPPP/R3KB1R b KQ - 0 8",
+    };
+    SEARCHER_THREAD_CONTEXT *ctx;
+    POSITION pos;
+    GAME_RESULT result;
+    MOVE mvBest;
+    SCORE iBest;
+    MOVE mv[MAX_MULTI_PV];
+    SCORE iScore[MAX_MULTI_PV];
+    ULONG uNumLines;
+    ULONG u, x, y;
+    FLAG fPost = g_Options.fShouldPost;
+    ULONG uMultiPv = g_Options.uMultiPv;
+
+    ctx = SystemAllocateMemory(sizeof(SEARCHER_THREAD_CONTEXT));
+    ASSERT(ctx);
+    g_Options.fShouldPost = FALSE;
+    Trace("Testing MultiPV search...\n");
+    for (u = 0; u < ARRAY_LENGTH(szFens); u++)
+    {
+        if (FALSE == FenToPosition(&pos, szFens[u]))
+        {
+            UtilPanic(TESTCASE_FAILURE,
+                      NULL, "FenToPosition", NULL, NULL,
+                      __FILE__, __LINE__);
+        }
+
+        //
+        // Plain search first...
+        //
+        result = _TestSearchFromScratch(ctx, &pos, 4, 1);
+        if (RESULT_IN_PROGRESS != result.eResult)
+        {
+            UtilPanic(TESTCASE_FAILURE,
+                      &pos, "TestMultiPvSearch", NULL, NULL,
+                      __FILE__, __LINE__);
+        }
+        mvBest = ctx->mvRootMove;
+        iBest = ctx->iRootScore;
+
+        //
+        // ...then the same position to the same depth looking for the
+        // best 3 moves.
+        //
+        result = _TestSearchFromScratch(ctx, &pos, 4, 3);
+        if (RESULT_IN_PROGRESS != result.eResult)
+        {
+            UtilPanic(TESTCASE_FAILURE,
+                      &pos, "TestMultiPvSearch", NULL, NULL,
+                      __FILE__, __LINE__);
+        }
+        uNumLines = 0;
+        while ((uNumLines < MAX_MULTI_PV) &&
+               (TRUE == GetMultiPvLine(uNumLines,
+                                       &(mv[uNumLines]),
+                                       &(iScore[uNumLines]))))
+        {
+            uNumLines++;
+        }
+
+        //
+        // We should get 3 distinct, legal root moves back sorted by
+        // score and the best of them should be what the plain search
+        // found.
+        //
+        if (uNumLines != 3)
+        {
+            UtilPanic(TESTCASE_FAILURE,
+                      &pos, "MultiPV line count", NULL, NULL,
+                      __FILE__, __LINE__);
+        }
+        for (x = 0; x < uNumLines; x++)
+        {
+            if ((FALSE == SanityCheckMove(&pos, mv[x])) ||
+                ((x > 0) && (iScore[x] > iScore[x - 1])))
+            {
+                UtilPanic(TESTCASE_FAILURE,
+                          &pos, "MultiPV line order", NULL, NULL,
+                          __FILE__, __LINE__);
+            }
+            for (y = 0; y < x; y++)
+            {
+                if (IS_SAME_MOVE(mv[x], mv[y]))
+                {
+                    UtilPanic(TESTCASE_FAILURE,
+                              &pos, "MultiPV duplicate line", NULL, NULL,
+                              __FILE__, __LINE__);
+                }
+            }
+        }
+        if ((!IS_SAME_MOVE(mv[0], mvBest)) ||
+            (iScore[0] != iBest) ||
+            (!IS_SAME_MOVE(ctx->mvRootMove, mvBest)))
+        {
+            UtilPanic(TESTCASE_FAILURE,
+                      &pos, "MultiPV best line", NULL, NULL,
+                      __FILE__, __LINE__);
+        }
+    }
+
+    g_Options.fShouldPost = fPost;
+    g_Options.uMultiPv = uMultiPv;
+    SystemFreeMemory(ctx);
+    return(TRUE);
+}
 #endif
@@ -26,7 +26,7 @@ Revision History:
 
 #include "chess.h"
 
-#ifdef TEST_BROKEN
+#if defined(TEST) || defined(SEE_PARITY)
 ULONG g_uRootOnMove;
 
 SCORE
@@ -68,7 +68,7 @@ DebugSEERecursive(SEARCHER_THREAD_CONTEXT *ctx,
         // Only consider replies that end up on the same sq as the
         // move.
         //
-        mvReply = ctx->sMoveStack.mvf[x].mv;
+        mvReply = ctx->sMoveStack.mv[x];
         ASSERT(SanityCheckMove(&ctx->sPosition, mvReply));
         if (mvReply.cTo != mv.cTo)
         {
@@ -112,7 +112,6 @@ DebugSEE(POSITION *pos,
     g_uRootOnMove = pos->uToMove;
     if (NULL != ctx)
     {
-        pos->uDangerCount[BLACK] = pos->uDangerCount[WHITE] = 0;
         InitializeSearcherContext(pos, ctx);
         
         GenerateMoves(ctx, (MOVE){0}, GENERATE_DONT_SCORE);
@@ -193,4 +192,187 @@ TestGetAttacks(void)
         }
     }
 }
+
+static MOVE
+_TestSeeSetup(POSITION *pos, char *szFen, char *szMove)
+{
+    MOVE mv;
+
+    if (FALSE == FenToPosition(pos, szFen))
+    {
+        UtilPanic(TESTCASE_FAILURE,
+                  NULL, "FenToPosition", NULL, NULL,
+                  __FILE__, __LINE__);
+    }
+    mv = ParseMoveIcs(szMove, pos);
+    if ((mv.uMove == 0) || !IS_CAPTURE_OR_PROMOTION(mv))
+    {
+        UtilPanic(TESTCASE_FAILURE,
+                  pos, "ParseMoveIcs", NULL, NULL,
+                  __FILE__, __LINE__);
+    }
+    return(mv);
+}
+
+void
+TestSEE(void)
+{
+    //
+    // Exchanges where both SEE routines must agree with the brute
+    // force DebugSEE exactly.  No promotions here: DebugSEE scores
+    // those by net material (the pawn is gone) whereas SEE credits
+    // the full value of the new piece.
+    //
+    static struct
+    {
+        char *szFen;
+        char *szMove;
+        SCORE iValue;
+    }
+    x[] =
+    {
+        { "1k1r4/1pp4p/p7/4p3/8/P5P1/1PP4P/2K1R3 w - - 0 1",
+          "e1e5", 100 },
+        { "8/7n/Kn1BRb2/3q1B2/4Rn2/4Q2N/bk2P3/8 b - - 0 1",
+          "d5d6", -675 },
+        { "8/N2NR3/pp6/1P6/K1N1r1q1/8/2kn2P1/8 b - - 0 1",
+          "g4d7", -675 },
+        { "8/r7/1B1n4/Q1nP1p1P/3K1RP1/4n1n1/1k4r1/8 b - - 0 1",
+          "e3d5", -200 },
+        { "8/1N1NPn2/1N1Rr2p/1p3Bk1/q1B1n3/4N2p/4Kp2/8 b - - 0 1",
+          "a4c4", -475 },
+        { "5k2/8/2r1P1Q1/5QP1/R2bb1Rq/3N1p2/8/3K4 b - - 0 1",
+          "e4f5", 675 },
+        { "8/4r1Br/6pk/8/n3p1K1/q7/1B2B3/8 b - - 0 1",
+          "e7g7", 100 },
+        { "8/3k1b2/Nr6/1qr4N/4b1K1/2P4Q/8/8 b - - 0 1",
+          "c5c3", -400 },
+        { "8/1n1R4/N7/5k2/1Qq1rBr1/3p4/5K1P/8 b - - 0 1",
+          "c4b4", 300 },
+        { "8/2Q3n1/n7/2QN3N/KP6/3kr1rr/1Q6/8 w - - 0 1",
+          "c7g3", -275 },
+        { "8/6K1/Rqn4R/1PnqR2N/q3b1P1/5kn1/7Q/8 w - - 0 1",
+          "e5d5", 475 },
+        { "8/4p3/4R2K/PR5R/3BN2N/q1n1NQ2/P2p2Nk/8 b - - 0 1",
+          "c3b5", 200 },
+        { "8/k4N2/6K1/8/2Nq2P1/4P1q1/b1Qq2P1/8 b - - 0 1",
+          "g3e3", -575 },
+        { "8/6QN/2nB4/krnQ4/1R2R3/8/6Q1/7K w - - 0 1",
+          "d5c5", -175 },
+        { "k7/1p2p1N1/5p2/6Np/1b3K2/7R/1rqPb1bn/8 w - - 0 1",
+          "h3h5", -100 },
+
+        //
+        // A side has two attackers of equal value and one of them
+        // uncovers an x-ray when it moves.  Both routines must pick
+        // the same one (see _SeeTieBreak).
+        //
+        { "6k1/b7/RPn2QNr/3n1b2/R1p1Q3/3R1Q2/3K1b2/8 b - - 0 1",
+          "c4d3", 400 },
+        { "8/bq1R4/8/1qb3K1/8/1R4pB/4k1q1/8 w - - 0 1",
+          "d7b7", 475 },
+        { "8/1Rn2k1n/P5q1/1R4qp/4n2R/7n/2R5/5K2 w - - 0 1",
+          "h4h5", -400 },
+        { "8/5RB1/q1q1R1qP/2k2nq1/4Q3/6R1/5p2/1K6 w - - 0 1",
+          "e6g6", 475 },
+        { "8/2r1b1Q1/4r1B1/R1QNR3/5R2/N2B2N1/k2pK3/8 w - - 0 1",
+          "d5e7", 25 },
+        { "K7/2RQ1r2/3B2k1/2b1Q1qr/2q2q2/4R1r1/P1b4R/8 w - - 0 1",
+          "e5c5", 0 },
+        //
+        // The rook is "pinned" along the line it captures on so only
+        // the king can recapture.
+        //
+        { "3K4/1Qr2Qk1/2R1b2p/N1bB1n2/4R3/4QP2/2p5/8 b - - 0 1",
+          "e6f7", 975 },
+        //
+        // The queen on e3 is only free while the rook that pinned it
+        // is the last piece moved; use it before the other queen.
+        //
+        { "8/1rpp3B/8/6P1/3R1nQ1/K3Qr2/7q/k7 w - - 0 1",
+          "d4f4", 300 },
+    };
+    SEARCHER_THREAD_CONTEXT *ctx;
+    POSITION pos;
+    MOVE mv[MAX_MOVES_PER_PLY];
+    ULONG uNumMoves;
+    ULONG u, v;
+    UINT64 u64Calls = 0;
+    double dListTime = 0.0;
+    double dBitboardTime = 0.0;
+    double dStart;
+    SCORE iSum = 0;
+
+    Trace("Testing SEE...\n");
+    for (u = 0; u < ARRAY_LENGTH(x); u++)
+    {
+        mv[0] = _TestSeeSetup(&pos, x[u].szFen, x[u].szMove);
+        if ((DebugSEE(&pos, mv[0]) != x[u].iValue) ||
+            (ListSEE(&pos, mv[0]) != x[u].iValue) ||
+            (BitboardSEE(&pos, mv[0]) != x[u].iValue))
+        {
+            UtilPanic(TESTCASE_FAILURE,
+                      &pos, x[u].szMove, NULL, NULL,
+                      __FILE__, __LINE__);
+        }
+    }
+
+    //
+    // Random positions: the two routines must agree exactly, then
+    // race them.
+    //
+    ctx = SystemAllocateMemory(sizeof(SEARCHER_THREAD_CONTEXT));
+    InitializeSearcherContext(NULL, ctx);
+    for (u = 0; u < 20000; u++)
+    {
+        GenerateRandomLegalPosition(&pos);
+        ReInitializeSearcherContext(&pos, ctx);
+        GenerateMoves(ctx, (MOVE){0}, GENERATE_DONT_SCORE);
+        uNumMoves = 0;
+        for (v = ctx->sMoveStack.uBegin[0];
+             v < ctx->sMoveStack.uEnd[0];
+             v++)
+        {
+            if (IS_CAPTURE_OR_PROMOTION(ctx->sMoveStack.mv[v]))
+            {
+                mv[uNumMoves++] = ctx->sMoveStack.mv[v];
+            }
+        }
+        if (0 == uNumMoves) continue;
+        u64Calls += uNumMoves;
+        for (v = 0; v < uNumMoves; v++)
+        {
+            if (ListSEE(&pos, mv[v]) != BitboardSEE(&pos, mv[v]))
+            {
+                UtilPanic(TESTCASE_FAILURE,
+                          &pos, "ListSEE != BitboardSEE", NULL, NULL,
+                          __FILE__, __LINE__);
+            }
+        }
+
+        dStart = SystemTimeStamp();
+        for (v = 0; v < 50 * uNumMoves; v++)
+        {
+            iSum += ListSEE(&pos, mv[v % uNumMoves]);
+        }
+        dListTime += SystemTimeStamp() - dStart;
+        dStart = SystemTimeStamp();
+        for (v = 0; v < 50 * uNumMoves; v++)
+        {
+            iSum -= BitboardSEE(&pos, mv[v % uNumMoves]);
+        }
+        dBitboardTime += SystemTimeStamp() - dStart;
+    }
+    SystemFreeMemory(ctx);
+
+    Trace("    %"COMPILER_LONGLONG_UNSIGNED_FORMAT" captures "
+          "(checksum %d)\n", u64Calls, iSum);
+    if ((dListTime > 0.0) && (dBitboardTime > 0.0))
+    {
+        Trace("    ListSEE:     %10.0f calls/sec\n"
+              "    BitboardSEE: %10.0f calls/sec\n",
+              (double)(u64Calls * 50) / dListTime,
+              (double)(u64Calls * 50) / dBitboardTime);
+    }
+}
 #endif // TEST
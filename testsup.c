@@ -228,6 +228,8 @@ GenerateRandomLegalPosition(POSITION *pos)
         }
         pos->u64NonPawnSig = ComputeSig(pos);
         pos->u64PawnSig = ComputePawnSig(pos);
+        pos->u64MaterialSig = ComputeMaterialSig(pos);
+        ComputePsqt(pos);
 
         //
         // See if it's legal
@@ -0,0 +1,571 @@
+/**
+
+Copyright (c) Scott Gasch
+
+Module Name:
+
+    timer.c
+
+Abstract:
+
+    A dedicated move timer thread.  While a search is running it
+    wakes up every MOVE_TIMER_TICK_MS, compares the clock against the
+    soft and hard limits in g_MoveTimer and sets TIMER_STOPPING when
+    the search should unroll.  The input system raises
+    TIMER_INPUT_PENDING itself as soon as user input is queued so that
+    the main searcher thread knows to go look at it; this thread just
+    raises it again while input is waiting in case a racing update
+    erased it (see below).  This way search only has to read one
+    flag word per node instead of polling the clock (and the input
+    queue) every N nodes, and the latency of a stop no longer depends
+    on how fast we are searching.
+
+    The searcher threads update g_MoveTimer.bvFlags without
+    interlocked operations.  This thread uses LockCompareExchange so
+    it never clobbers their bits but a racing plain update can erase
+    a bit that it set.  That's ok: the condition that made it set the
+    bit still holds next tick and it'll just set it again.
+
+    This module is also the time manager.  ComputeMoveTimeBudget
+    splits the clock (less the GUI/network move overhead) into a soft
+    and hard limit for the next move.  Then, in timed games, after
+    each iteration UpdateMoveTimerAfterIteration moves the soft limit
+    around the optimal time based on how stable the best move has
+    been, whether the score just dropped and what fraction of the
+    tree the best move needed.  It also stops the search outright if
+    the next iteration is not predicted to finish in time.
+
+Revision History:
+
+**/
+
+#include "chess.h"
+
+#define MOVE_TIMER_TICK_MS       (1)
+#define MOVE_TIMER_IDLE_MS       (5)
+
+//
+// Time budget
+//
+#define TM_SUDDEN_DEATH_MOVES    (50)     // moves to go at move 1
+#define TM_MIN_MOVES_TO_GO       (20)
+#define TM_HARD_FACTOR           (3.2)    // hard limit = this * soft...
+#define TM_MAX_CLOCK_FRACTION    (0.5)    // ...but at most this much clock
+#define TM_LAST_MOVE_FRACTION    (0.9)
+
+//
+// Per iteration soft limit scaling
+//
+#define TM_MIN_DEPTH             (5)
+#define TM_MAX_SCORE_DROP        (100)
+#define TM_MIN_SCALE             (0.4)
+#define TM_MAX_SCALE             (2.5)
+#define TM_DEFAULT_BRANCHING     (2.5)
+#define TM_MIN_BRANCHING         (1.5)
+#define TM_MAX_BRANCHING         (6.0)
+#define TM_RIVAL_WEIGHT          (0.8)    // extra time per rival share
+
+static const double g_dStabilityScale[] =
+{
+    1.5, 1.25, 1.1, 1.0, 0.9, 0.8
+};
+
+typedef struct _TIME_MANAGER
+{
+    MOVE mvBest;
+    SCORE iLastScore;
+    ULONG uStableIterations;
+    double dIterationStart;
+    double dLastIterationTime;
+    UINT64 u64IterationStartNodes;
+}
+TIME_MANAGER;
+
+static TIME_MANAGER g_TimeManager;
+static volatile FLAG g_fMoveTimerArmed = FALSE;
+static volatile FLAG g_fMoveTimerExit = FALSE;
+static ULONG g_uMoveTimerThreadHandle = (ULONG)-1;
+
+void
+SetMoveTimerFlag(IN BITV bvFlag)
+/**
+
+Routine description:
+
+    Atomically set a bit in g_MoveTimer.bvFlags.
+
+Parameters:
+
+    BITV bvFlag
+
+Return value:
+
+    void
+
+**/
+{
+    BITV bvOld;
+
+    do
+    {
+        bvOld = g_MoveTimer.bvFlags;
+        if (bvOld & bvFlag) return;
+    }
+    while (LockCompareExchange(&(g_MoveTimer.bvFlags),
+                               bvOld | bvFlag,
+                               bvOld) != bvOld);
+}
+
+
+void
+ClearMoveTimerFlag(IN BITV bvFlag)
+/**
+
+Routine description:
+
+    Atomically clear a bit in g_MoveTimer.bvFlags.
+
+Parameters:
+
+    BITV bvFlag
+
+Return value:
+
+    void
+
+**/
+{
+    BITV bvOld;
+
+    do
+    {
+        bvOld = g_MoveTimer.bvFlags;
+        if (!(bvOld & bvFlag)) return;
+    }
+    while (LockCompareExchange(&(g_MoveTimer.bvFlags),
+                               bvOld & ~bvFlag,
+                               bvOld) != bvOld);
+}
+
+
+static FLAG
+_MoveTimerExpired(void)
+/**
+
+Routine description:
+
+    Decide whether the search that is running should stop now based
+    on the time limits in g_MoveTimer.
+
+Parameters:
+
+    void
+
+Return value:
+
+    static FLAG : TRUE if the search should stop
+
+**/
+{
+    BITV bvFlags = g_MoveTimer.bvFlags;
+    double dTimeStamp;
+
+    if (-1 == g_MoveTimer.dSoftTimeLimit)
+    {
+        return(FALSE);
+    }
+    if (bvFlags & TIMER_STOPPING)
+    {
+        return(TRUE);
+    }
+    if (bvFlags & (TIMER_CURRENT_OBVIOUS | TIMER_CURRENT_WONT_UNBLOCK))
+    {
+        Trace("OBVIOUS MOVE / WON'T UNBLOCK --> stop searching now\n");
+        return(TRUE);
+    }
+
+    dTimeStamp = SystemTimeStamp();
+    if (dTimeStamp > g_MoveTimer.dSoftTimeLimit)
+    {
+        //
+        // If we have exceeded the soft time limit, move now unless...
+        //
+        if ((!(bvFlags & TIMER_JUST_OUT_OF_BOOK)) &&
+            (!(bvFlags & TIMER_ROOT_POSITION_CRITICAL)) &&
+            (!(bvFlags & TIMER_RESOLVING_ROOT_FL)) &&
+            (!(bvFlags & TIMER_RESOLVING_ROOT_FH)) &&
+            (!(bvFlags & TIMER_MANY_ROOT_FLS)) &&
+            (bvFlags & TIMER_SEARCHING_FIRST_MOVE))
+        {
+            Trace("SOFT TIMER (%3.1f sec) --> stop searching now\n",
+                  dTimeStamp - g_MoveTimer.dStartTime);
+            return(TRUE);
+        }
+    }
+
+    //
+    // If we have exceeded the hard limit, we have to move no matter
+    // what.
+    //
+    if (dTimeStamp > g_MoveTimer.dHardTimeLimit)
+    {
+        Trace("HARD TIMER (%3.1f sec) --> stop searching now\n",
+              dTimeStamp - g_MoveTimer.dStartTime);
+        return(TRUE);
+    }
+    return(FALSE);
+}
+
+
+static ULONG
+_MoveTimerThreadEntry(UNUSED ULONG uUnused)
+/**
+
+Routine description:
+
+    The entry point of the move timer thread.
+
+Parameters:
+
+    ULONG uUnused
+
+Return value:
+
+    ULONG
+
+**/
+{
+    while ((FALSE == g_fMoveTimerExit) && (TRUE != g_fExitProgram))
+    {
+        if (FALSE == g_fMoveTimerArmed)
+        {
+            SystemDeferExecution(MOVE_TIMER_IDLE_MS);
+            continue;
+        }
+        if (NumberOfPendingInputEvents() != 0)
+        {
+            SetMoveTimerFlag(TIMER_INPUT_PENDING);
+        }
+        if ((TRUE == g_fMoveTimerArmed) && (TRUE == _MoveTimerExpired()))
+        {
+            SetMoveTimerFlag(TIMER_STOPPING);
+        }
+        SystemDeferExecution(MOVE_TIMER_TICK_MS);
+    }
+    return(0);
+}
+
+
+void
+ComputeMoveTimeBudget(IN double dClock,
+                      IN double dIncrement,
+                      IN ULONG uMovesToGo,
+                      IN ULONG uMoveNumber,
+                      OUT double *pdSoft,
+                      OUT double *pdHard)
+/**
+
+Routine description:
+
+    Decide how long to think about the next move.  The time we have
+    for the moves left before the next time control is the clock plus
+    the increments we'll get back for them less the move overhead
+    each one costs.  The soft limit is an even share of that; the
+    hard limit lets a troubled search run over it by a good amount
+    but never spends more than a fixed fraction of the clock.
+
+Parameters:
+
+    double dClock : seconds left on our clock
+    double dIncrement : seconds we get back per move made
+    ULONG uMovesToGo : moves until the next time control, 0 if the
+        rest of the game has to be played on this clock
+    ULONG uMoveNumber : our move number (GetMoveNumber, counts only
+        this side's moves)
+    double *pdSoft : soft limit, seconds from the search start
+    double *pdHard : hard limit, seconds from the search start
+
+Return value:
+
+    void
+
+**/
+{
+    double dOverhead = (double)g_Options.uMoveOverhead / 1000.0;
+    double dUsable;
+    double dSoft, dHard;
+
+    if (uMovesToGo == 0)
+    {
+        uMovesToGo = TM_SUDDEN_DEATH_MOVES - MINU(uMoveNumber,
+                                                  TM_SUDDEN_DEATH_MOVES);
+        uMovesToGo = MAXU(uMovesToGo, TM_MIN_MOVES_TO_GO);
+    }
+    dUsable = (dClock + dIncrement * (double)(uMovesToGo - 1) -
+               dOverhead * (double)uMovesToGo);
+    dSoft = MAX(dUsable, 0.0) / (double)uMovesToGo;
+    dHard = dSoft * TM_HARD_FACTOR;
+    dUsable = MAX(dClock - dOverhead, 0.0);
+    dHard = MIN(dHard, dUsable * ((uMovesToGo == 1) ?
+                                  TM_LAST_MOVE_FRACTION :
+                                  TM_MAX_CLOCK_FRACTION));
+    dHard = MAX(dHard, TIMER_MIN_SEARCH_TIME);
+    dSoft = MAX(MIN(dSoft, dHard), TIMER_MIN_SEARCH_TIME);
+    *pdSoft = dSoft;
+    *pdHard = dHard;
+}
+
+
+void
+UpdateMoveTimerAfterIteration(IN SEARCHER_THREAD_CONTEXT *ctx,
+                              IN ULONG uDepth,
+                              IN SCORE iScore)
+/**
+
+Routine description:
+
+    Called by Iterate when it has a PV for uDepth.  Keep track of how
+    stable the best move is and, if we are managing the time for this
+    search, move the soft limit accordingly:
+
+        1. A best move that just changed gets more time and one that
+           has survived several iterations gets less.
+        2. A score drop gets more time, in proportion to its size.
+        3. A best move whose subtree was most of the tree gets less
+           time (the alternatives were refuted quickly) while one
+           that had to compete with its siblings gets more.
+        4. A rival root move that needed a big subtree to refute
+           (i.e. nearly took over as best) gets more time.
+
+    Then guess how long the next iteration would take from how the
+    last two went and stop now if it can't finish.
+
+Parameters:
+
+    SEARCHER_THREAD_CONTEXT *ctx,
+    ULONG uDepth,
+    SCORE iScore : the score of the PV at uDepth
+
+Return value:
+
+    void
+
+**/
+{
+    TIME_MANAGER *p = &g_TimeManager;
+    double dNow = SystemTimeStamp();
+    double dIteration = dNow - p->dIterationStart;
+    double dLastIteration = p->dLastIterationTime;
+    UINT64 u64Nodes;
+    double dFraction;
+    double dRival;
+    double dScale;
+    double dBranching;
+    double dPredicted;
+    SCORE iDrop = 0;
+
+    u64Nodes = (ctx->sCounters.tree.u64TotalNodeCount -
+                p->u64IterationStartNodes);
+    dFraction = 1.0;
+    dRival = 0.0;
+    if (u64Nodes != 0)
+    {
+        dFraction = (double)ctx->u64RootMoveNodes / (double)u64Nodes;
+        dFraction = MIN(dFraction, 1.0);
+        dRival = (double)GetRootRivalNodecount(ctx) / (double)u64Nodes;
+        dRival = MIN(dRival, 1.0);
+    }
+    if (ctx->mvRootMove.uMove == p->mvBest.uMove)
+    {
+        p->uStableIterations++;
+    }
+    else
+    {
+        p->uStableIterations = 0;
+        p->mvBest = ctx->mvRootMove;
+    }
+    if (uDepth > 1)
+    {
+        iDrop = p->iLastScore - iScore;
+    }
+    p->iLastScore = iScore;
+    p->dLastIterationTime = dIteration;
+    p->dIterationStart = dNow;
+    p->u64IterationStartNodes = ctx->sCounters.tree.u64TotalNodeCount;
+
+    if ((!(g_MoveTimer.bvFlags & TIMER_MANAGED)) ||
+        (uDepth < TM_MIN_DEPTH))
+    {
+        return;
+    }
+
+    dScale = g_dStabilityScale[MINU(p->uStableIterations,
+                                    ARRAY_LENGTH(g_dStabilityScale) - 1)];
+    if (iDrop > 0)
+    {
+        dScale *= 1.0 + ((double)MIN(iDrop, TM_MAX_SCORE_DROP) /
+                         (double)(2 * TM_MAX_SCORE_DROP));
+    }
+    dScale *= 1.3 - 0.6 * dFraction;
+    dScale *= 1.0 + TM_RIVAL_WEIGHT * dRival;
+    dScale = MAX(MIN(dScale, TM_MAX_SCALE), TM_MIN_SCALE);
+    g_MoveTimer.dSoftTimeLimit = MIN(g_MoveTimer.dStartTime +
+                                     g_MoveTimer.dOptimalTime * dScale,
+                                     g_MoveTimer.dHardTimeLimit);
+    if (TRUE == g_Options.fShouldPost)
+    {
+        Trace("TimeManager: depth %u, best move stable for %u, "
+              "drop %d, %4.2f of nodes (rival %4.2f), soft limit x%4.2f "
+              "=> %s\n",
+              uDepth, p->uStableIterations, iDrop, dFraction, dRival,
+              dScale, TimeToString(g_MoveTimer.dSoftTimeLimit -
+                                   g_MoveTimer.dStartTime));
+    }
+
+    //
+    // Can the next iteration finish in time?  Before the soft limit
+    // unless a root fail low or something else critical is going on
+    // and before the hard limit in any case.
+    //
+    dBranching = TM_DEFAULT_BRANCHING;
+    if (dLastIteration > 0.001)
+    {
+        dBranching = dIteration / dLastIteration;
+        dBranching = MAX(MIN(dBranching, TM_MAX_BRANCHING),
+                         TM_MIN_BRANCHING);
+    }
+    dPredicted = dIteration * dBranching;
+    if ((dNow + dPredicted > g_MoveTimer.dHardTimeLimit) ||
+        ((dNow + dPredicted > g_MoveTimer.dSoftTimeLimit) &&
+         (!(g_MoveTimer.bvFlags & (TIMER_RESOLVING_ROOT_FL |
+                                   TIMER_MANY_ROOT_FLS |
+                                   TIMER_ROOT_POSITION_CRITICAL |
+                                   TIMER_JUST_OUT_OF_BOOK)))))
+    {
+        Trace("NEXT ITERATION WON'T FINISH (%3.1f sec predicted) --> "
+              "stop searching now\n", dPredicted);
+        SetMoveTimerFlag(TIMER_STOPPING);
+    }
+}
+
+
+void
+ArmMoveTimer(IN SEARCHER_THREAD_CONTEXT *ctx)
+/**
+
+Routine description:
+
+    Called as a search starts: begin watching the limits in
+    g_MoveTimer and reset the time manager.  The limits may be
+    changed while the timer is armed (e.g. when a ponder search is
+    converted into a real search).
+
+Parameters:
+
+    SEARCHER_THREAD_CONTEXT *ctx
+
+Return value:
+
+    void
+
+**/
+{
+    ASSERT(g_uMoveTimerThreadHandle != (ULONG)-1);
+    memset(&g_TimeManager, 0, sizeof(g_TimeManager));
+    g_TimeManager.dIterationStart = SystemTimeStamp();
+    g_TimeManager.u64IterationStartNodes =
+        ctx->sCounters.tree.u64TotalNodeCount;
+    g_fMoveTimerArmed = TRUE;
+
+    //
+    // Input queued up before the search set up its flags.
+    //
+    if (NumberOfPendingInputEvents() != 0)
+    {
+        SetMoveTimerFlag(TIMER_INPUT_PENDING);
+    }
+}
+
+
+void
+DisarmMoveTimer(void)
+/**
+
+Routine description:
+
+    Called when a search is over: stop watching the limits so that
+    the stale ones from this search don't stop the next one before it
+    sets its own.
+
+Parameters:
+
+    void
+
+Return value:
+
+    void
+
+**/
+{
+    g_fMoveTimerArmed = FALSE;
+    ClearMoveTimerFlag(TIMER_INPUT_PENDING);
+}
+
+
+void
+InitializeMoveTimer(void)
+/**
+
+Routine description:
+
+    Start the move timer thread.
+
+Parameters:
+
+    void
+
+Return value:
+
+    void
+
+**/
+{
+    g_fMoveTimerArmed = FALSE;
+    g_fMoveTimerExit = FALSE;
+    if (FALSE == SystemCreateThread(_MoveTimerThreadEntry,
+                                    0,
+                                    &g_uMoveTimerThreadHandle))
+    {
+        UtilPanic(UNEXPECTED_SYSTEM_CALL_FAILURE,
+                  NULL, "move timer thread", NULL, NULL,
+                  __FILE__, __LINE__);
+    }
+}
+
+
+void
+CleanupMoveTimer(void)
+/**
+
+Routine description:
+
+    Stop the move timer thread and wait for it to exit.
+
+Parameters:
+
+    void
+
+Return value:
+
+    void
+
+**/
+{
+    if (g_uMoveTimerThreadHandle != (ULONG)-1)
+    {
+        g_fMoveTimerArmed = FALSE;
+        g_fMoveTimerExit = TRUE;
+        (void)SystemWaitForThreadToExit(g_uMoveTimerThreadHandle);
+        g_uMoveTimerThreadHandle = (ULONG)-1;
+    }
+}
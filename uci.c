@@ -0,0 +1,976 @@
+/**
+
+Copyright (c) Scott Gasch
+
+Module Name:
+
+    uci.c
+
+Abstract:
+
+    A native UCI front-end.  The "uci" command switches the engine
+    into UCI mode and after that the commands in this module drive
+    the same machinery that the xboard commands do:
+
+        position  sets the root position and the official game list
+        go        fills in g_Options (clocks, depth and node limits)
+                  and sets the play mode so that the main loop calls
+                  Think
+        stop      and ponderhit act on a running search on the fly
+        setoption maps Hash, Threads, Move Overhead and MultiPV onto
+                  g_Options
+
+    The GUI owns the game under UCI.  When a search is done we post
+    "bestmove" (and a move to ponder on) and go back to force mode
+    without changing the root position; the GUI sends the position
+    again before its next "go".  "go infinite" and "go ponder"
+    searches must not post a bestmove until they get a "stop" (or a
+    "ponderhit" in the latter case) even if they run out of things
+    to search first.
+
+Revision History:
+
+**/
+
+#include "chess.h"
+
+extern ULONG g_uIterateDepth;
+
+#define UCI_MAX_HASH_MB          (4096)
+#define UCI_MAX_MOVE_OVERHEAD_MS (5000)
+
+typedef struct _UCI_SEARCH
+{
+    FLAG fPondering;                          // "go ponder", no ponderhit
+    FLAG fInfinite;                           // "go infinite"
+    FLAG fWaitForStop;                        // hold the bestmove
+    ULONG eClock;                             // clock to use at ponderhit
+}
+UCI_SEARCH;
+
+static UCI_SEARCH g_UciSearch;
+
+CHAR *
+MoveToUci(MOVE mv)
+/**
+
+Routine description:
+
+    Convert a MOVE into a UCI ("e7e8q" style) string.  This is the
+    ICS format with the promoted piece in lower case.  Note: not
+    thread safe.
+
+Parameters:
+
+    MOVE mv
+
+Return value:
+
+    CHAR *
+
+**/
+{
+    CHAR *p = MoveToIcs(mv);
+    CHAR *q;
+
+    if (NULL == p)
+    {
+        return("0000");
+    }
+    for (q = p; *q; q++)
+    {
+        *q = tolower(*q);
+    }
+    return(p);
+}
+
+
+static ULONG
+_HashMegabytes(void)
+/**
+
+Routine description:
+
+    How big is the main hash table, in megabytes?
+
+Parameters:
+
+    void
+
+Return value:
+
+    static ULONG
+
+**/
+{
+    UINT64 u64Bytes = (UINT64)g_Options.uNumHashTableEntries *
+                      sizeof(HASH_ENTRY);
+
+    return((ULONG)MAX(u64Bytes / MB, 1));
+}
+
+
+static void
+_SetHashMegabytes(ULONG uMegabytes)
+/**
+
+Routine description:
+
+    Reallocate the main hash table to be (at most) uMegabytes big.
+    The table must be a power of two entries long so round down.
+
+Parameters:
+
+    ULONG uMegabytes
+
+Return value:
+
+    static void
+
+**/
+{
+    UINT64 u64Entries;
+    ULONG u;
+
+    uMegabytes = MINU(MAXU(uMegabytes, 1), UCI_MAX_HASH_MB);
+    u64Entries = ((UINT64)uMegabytes * MB) / sizeof(HASH_ENTRY);
+    u = (ULONG)u64Entries;
+    while(!IS_A_POWER_OF_2(u))
+    {
+        u &= (u - 1);
+    }
+    if (u == g_Options.uNumHashTableEntries)
+    {
+        return;
+    }
+    CleanupHashSystem();
+    g_Options.uNumHashTableEntries = u;
+    if (FALSE == InitializeHashSystem())
+    {
+        UtilPanic(INITIALIZATION_FAILURE,
+                  NULL, "hash table", NULL, NULL,
+                  __FILE__, __LINE__);
+    }
+}
+
+
+static void
+_SetThreads(ULONG uThreads)
+/**
+
+Routine description:
+
+    Change the number of searcher threads.  The helper threads can't
+    be torn down once they are running so this only works while the
+    engine is still single threaded (which it is unless it was
+    started with --cpus).  The per-thread history, pawn hash and eval
+    hash tables are reallocated to match.
+
+Parameters:
+
+    ULONG uThreads
+
+Return value:
+
+    static void
+
+**/
+{
+#ifdef MP
+    uThreads = MINU(MAXU(uThreads, 1), MAX_SEARCHER_THREADS);
+    if (uThreads == g_Options.uNumProcessors)
+    {
+        return;
+    }
+    if (g_uNumHelperThreads != 0)
+    {
+        Trace("info string Threads is fixed at %u once the helpers are "
+              "running\n", g_Options.uNumProcessors);
+        return;
+    }
+    CleanupDynamicMoveOrdering();
+    CleanupPawnHashSystem();
+#ifdef EVAL_HASH
+    CleanupEvalHashSystem();
+#endif
+    g_Options.uNumProcessors = uThreads;
+    if (FALSE == InitializeDynamicMoveOrdering())
+    {
+        UtilPanic(INITIALIZATION_FAILURE,
+                  NULL, "history tables", NULL, NULL,
+                  __FILE__, __LINE__);
+    }
+    if (FALSE == InitializePawnHashSystem())
+    {
+        UtilPanic(INITIALIZATION_FAILURE,
+                  NULL, "pawn hash", NULL, NULL,
+                  __FILE__, __LINE__);
+    }
+#ifdef EVAL_HASH
+    if (FALSE == InitializeEvalHashSystem())
+    {
+        UtilPanic(INITIALIZATION_FAILURE,
+                  NULL, "eval hash", NULL, NULL,
+                  __FILE__, __LINE__);
+    }
+#endif
+    if (FALSE == InitializeParallelSearch())
+    {
+        UtilPanic(INITIALIZATION_FAILURE,
+                  NULL, "parallel search", NULL, NULL,
+                  __FILE__, __LINE__);
+    }
+#else
+    if (uThreads != 1)
+    {
+        Trace("info string this build can only use one thread\n");
+    }
+#endif
+}
+
+
+COMMAND(UciCommand)
+/**
+
+Routine description:
+
+    This function implements the 'uci' engine command.
+
+    Usage:
+
+        uci
+
+    Switch into UCI mode: identify ourselves, list the options that
+    setoption understands and say uciok.
+
+Parameters:
+
+    The COMMAND macro hides four arguments from the input parser:
+
+        CHAR *szInput : the full line of input
+        ULONG argc    : number of argument chunks
+        CHAR *argv[]  : array of ptrs to each argument chunk
+        POSITION *pos : a POSITION pointer to operate on
+
+Return value:
+
+    void
+
+**/
+{
+    g_Options.fRunningUnderUci = TRUE;
+    g_Options.fStatusLine = FALSE;
+    g_Options.fShouldPonder = FALSE;
+    g_Options.fShouldPost = TRUE;
+    g_Options.ePlayMode = FORCE_MODE;
+    memset(&g_UciSearch, 0, sizeof(g_UciSearch));
+
+    Trace("id name Typhoon %s\n", VERSION);
+    Trace("id author Scott Gasch\n");
+    Trace("option name Hash type spin default %u min 1 max %u\n",
+          _HashMegabytes(), UCI_MAX_HASH_MB);
+#ifdef MP
+    Trace("option name Threads type spin default %u min 1 max %u\n",
+          g_Options.uNumProcessors, MAX_SEARCHER_THREADS);
+#else
+    Trace("option name Threads type spin default 1 min 1 max 1\n");
+#endif
+    Trace("option name Move Overhead type spin default %u min 0 max %u\n",
+          g_Options.uMoveOverhead, UCI_MAX_MOVE_OVERHEAD_MS);
+    Trace("option name Ponder type check default false\n");
+    Trace("option name MultiPV type spin default %u min 1 max %u\n",
+          g_Options.uMultiPv, MAX_MULTI_PV);
+    Trace("uciok\n");
+}
+
+
+COMMAND(IsReadyCommand)
+/**
+
+Routine description:
+
+    This function implements the 'isready' engine command.  It is
+    handled on the fly so that the GUI gets an answer even while we
+    are searching.
+
+    Usage:
+
+        isready
+
+Parameters:
+
+    The COMMAND macro hides four arguments from the input parser:
+
+        CHAR *szInput : the full line of input
+        ULONG argc    : number of argument chunks
+        CHAR *argv[]  : array of ptrs to each argument chunk
+        POSITION *pos : a POSITION pointer to operate on
+
+Return value:
+
+    void
+
+**/
+{
+    Trace("readyok\n");
+}
+
+
+COMMAND(UciNewGameCommand)
+/**
+
+Routine description:
+
+    This function implements the 'ucinewgame' engine command.
+
+    Usage:
+
+        ucinewgame
+
+Parameters:
+
+    The COMMAND macro hides four arguments from the input parser:
+
+        CHAR *szInput : the full line of input
+        ULONG argc    : number of argument chunks
+        CHAR *argv[]  : array of ptrs to each argument chunk
+        POSITION *pos : a POSITION pointer to operate on
+
+Return value:
+
+    void
+
+**/
+{
+    PreGameReset(TRUE);
+    g_Options.ePlayMode = FORCE_MODE;
+    g_Options.uMaxDepth = MAX_PLY_PER_SEARCH - 1;
+}
+
+
+COMMAND(PositionCommand)
+/**
+
+Routine description:
+
+    This function implements the 'position' engine command.
+
+    Usage:
+
+        position startpos [moves <move1> ... <moveN>]
+        position fen <fen> [moves <move1> ... <moveN>]
+
+    The move list can be much longer than the command parser's
+    argument limit so it is read out of the raw input line.
+
+Parameters:
+
+    The COMMAND macro hides four arguments from the input parser:
+
+        CHAR *szInput : the full line of input
+        ULONG argc    : number of argument chunks
+        CHAR *argv[]  : array of ptrs to each argument chunk
+        POSITION *pos : a POSITION pointer to operate on
+
+Return value:
+
+    void
+
+**/
+{
+    CHAR szFen[SMALL_STRING_LEN_CHAR];
+    CHAR szMove[SMALL_STRING_LEN_CHAR];
+    CHAR *p;
+    ULONG u;
+    MOVE mv;
+
+    g_Options.ePlayMode = FORCE_MODE;
+    if (argc < 2)
+    {
+        Trace("Error (syntax): %s\n", szInput);
+        return;
+    }
+    if (!STRCMPI(argv[1], "startpos"))
+    {
+        strcpy(szFen, STARTING_POSITION_IN_FEN);
+    }
+    else if (!STRCMPI(argv[1], "fen"))
+    {
+        szFen[0] = '\0';
+        for (u = 2; (u < argc) && STRCMPI(argv[u], "moves"); u++)
+        {
+            if (szFen[0] != '\0')
+            {
+                strncat(szFen, " ", ARRAY_LENGTH(szFen) - strlen(szFen) - 1);
+            }
+            strncat(szFen, argv[u], ARRAY_LENGTH(szFen) - strlen(szFen) - 1);
+        }
+    }
+    else
+    {
+        Trace("Error (syntax): %s\n", szInput);
+        return;
+    }
+    if (FALSE == SetRootPosition(szFen))
+    {
+        Trace("Error (bad fen): %s\n", szFen);
+        return;
+    }
+
+    //
+    // Play the moves, if any, into the official game list so that
+    // search knows about repetitions.
+    //
+    p = strstr(szInput, " moves");
+    if (NULL == p)
+    {
+        return;
+    }
+    p += strlen(" moves");
+    while(*p)
+    {
+        while(*p && isspace(*p)) p++;
+        if (!*p) break;
+        u = 0;
+        while(*p && !isspace(*p) && (u < ARRAY_LENGTH(szMove) - 1))
+        {
+            szMove[u++] = *p++;
+        }
+        szMove[u] = '\0';
+        mv = ParseMoveIcs(szMove, GetRootPosition());
+        if ((0 == mv.uMove) ||
+            (FALSE == OfficiallyMakeMove(mv, 0, FALSE)))
+        {
+            Trace("Error (illegal move): %s\n", szMove);
+            return;
+        }
+    }
+}
+
+
+COMMAND(SetOptionCommand)
+/**
+
+Routine description:
+
+    This function implements the 'setoption' engine command.
+
+    Usage:
+
+        setoption name <id> [value <x>]
+
+    Where <id> is one of the options that 'uci' listed.  Option
+    names can have spaces in them.
+
+Parameters:
+
+    The COMMAND macro hides four arguments from the input parser:
+
+        CHAR *szInput : the full line of input
+        ULONG argc    : number of argument chunks
+        CHAR *argv[]  : array of ptrs to each argument chunk
+        POSITION *pos : a POSITION pointer to operate on
+
+Return value:
+
+    void
+
+**/
+{
+    CHAR szName[SMALL_STRING_LEN_CHAR];
+    CHAR *szValue = NULL;
+    ULONG u;
+
+    if ((argc < 3) || (STRCMPI(argv[1], "name")))
+    {
+        Trace("Error (syntax): %s\n", szInput);
+        return;
+    }
+    szName[0] = '\0';
+    for (u = 2; u < argc; u++)
+    {
+        if (!STRCMPI(argv[u], "value"))
+        {
+            if (u + 1 < argc)
+            {
+                szValue = argv[u + 1];
+            }
+            break;
+        }
+        if (szName[0] != '\0')
+        {
+            strncat(szName, " ", ARRAY_LENGTH(szName) - strlen(szName) - 1);
+        }
+        strncat(szName, argv[u], ARRAY_LENGTH(szName) - strlen(szName) - 1);
+    }
+
+    if (!STRCMPI(szName, "Ponder"))
+    {
+        //
+        // The GUI decides when we ponder (with go ponder) so there is
+        // nothing to do here.
+        //
+        return;
+    }
+    if (NULL == szValue)
+    {
+        Trace("Error (missing value): %s\n", szInput);
+        return;
+    }
+    if (!STRCMPI(szName, "Hash"))
+    {
+        _SetHashMegabytes((ULONG)atoi(szValue));
+    }
+    else if (!STRCMPI(szName, "Threads"))
+    {
+        _SetThreads((ULONG)atoi(szValue));
+    }
+    else if (!STRCMPI(szName, "Move Overhead"))
+    {
+        g_Options.uMoveOverhead = MINU((ULONG)MAX(atoi(szValue), 0),
+                                       UCI_MAX_MOVE_OVERHEAD_MS);
+    }
+    else if (!STRCMPI(szName, "MultiPV"))
+    {
+        g_Options.uMultiPv = MINU((ULONG)MAX(atoi(szValue), 1),
+                                  MAX_MULTI_PV);
+    }
+    else
+    {
+        Trace("info string unknown option %s\n", szName);
+    }
+}
+
+
+COMMAND(StopCommand)
+/**
+
+Routine description:
+
+    This function implements the 'stop' engine command.  It is handled
+    on the fly: stop searching and post the best move we have.
+
+    Usage:
+
+        stop
+
+Parameters:
+
+    The COMMAND macro hides four arguments from the input parser:
+
+        CHAR *szInput : the full line of input
+        ULONG argc    : number of argument chunks
+        CHAR *argv[]  : array of ptrs to each argument chunk
+        POSITION *pos : a POSITION pointer to operate on
+
+Return value:
+
+    void
+
+**/
+{
+    //
+    // Leave fPondering alone: a stop while pondering means the ponder
+    // move wasn't played and UciPostBestMove needs to see that.
+    //
+    g_UciSearch.fWaitForStop = FALSE;
+    if (TRUE == g_Options.fThinking)
+    {
+        Trace("STOP COMMAND --> stop searching now\n");
+        g_MoveTimer.bvFlags |= TIMER_STOPPING;
+    }
+}
+
+
+COMMAND(PonderHitCommand)
+/**
+
+Routine description:
+
+    This function implements the 'ponderhit' engine command.  It is
+    handled on the fly: the opponent played the move we were told to
+    ponder on so turn the infinite ponder search into a timed one.
+    The time spent pondering counts against the new search.
+
+    Usage:
+
+        ponderhit
+
+Parameters:
+
+    The COMMAND macro hides four arguments from the input parser:
+
+        CHAR *szInput : the full line of input
+        ULONG argc    : number of argument chunks
+        CHAR *argv[]  : array of ptrs to each argument chunk
+        POSITION *pos : a POSITION pointer to operate on
+
+Return value:
+
+    void
+
+**/
+{
+    if (FALSE == g_UciSearch.fPondering)
+    {
+        return;
+    }
+    g_UciSearch.fPondering = FALSE;
+    g_UciSearch.fWaitForStop = g_UciSearch.fInfinite;
+    g_Options.eClock = g_UciSearch.eClock;
+    if ((TRUE == g_Options.fThinking) &&
+        (!(g_MoveTimer.bvFlags & TIMER_STOPPING)))
+    {
+        Trace("PONDERHIT --> converting to search\n");
+        PonderHit();
+        SetMoveTimerForSearch(TRUE, pos->uToMove);
+    }
+}
+
+
+void
+UciGo(ULONG argc,
+      CHAR *argv[],
+      POSITION *pos)
+/**
+
+Routine description:
+
+    Handle a UCI 'go' command (GoCommand calls us under UCI):
+
+        go [wtime <ms>] [btime <ms>] [winc <ms>] [binc <ms>]
+           [movestogo <n>] [movetime <ms>] [depth <n>] [nodes <n>]
+           [infinite] [ponder]
+
+    Set up g_Options to match and tell the main loop to search the
+    root position (for the side to move).  A go with no time control
+    in it searches until it reaches its depth or node limit, or until
+    it is stopped.
+
+Parameters:
+
+    ULONG argc,
+    CHAR *argv[],
+    POSITION *pos
+
+Return value:
+
+    void
+
+**/
+{
+    ULONG uColor = pos->uToMove;
+    ULONG uClock[2] = { 0, 0 };
+    ULONG uIncrement[2] = { 0, 0 };
+    ULONG uMovesToGo = 0;
+    ULONG uMoveTime = 0;
+    FLAG fClock = FALSE;
+    ULONG u;
+    INT x;
+
+    memset(&g_UciSearch, 0, sizeof(g_UciSearch));
+    g_Options.uMaxDepth = MAX_PLY_PER_SEARCH - 1;
+    g_Options.u64MaxNodeCount = 0ULL;
+    for (u = 1; u < argc; u++)
+    {
+        if (!STRCMPI(argv[u], "infinite"))
+        {
+            g_UciSearch.fInfinite = TRUE;
+            continue;
+        }
+        if (!STRCMPI(argv[u], "ponder"))
+        {
+            g_UciSearch.fPondering = TRUE;
+            continue;
+        }
+        if (u + 1 >= argc)
+        {
+            break;
+        }
+
+        //
+        // The rest take an argument.  Clocks can be negative if the
+        // GUI lets us run over.
+        //
+        x = MAX(atoi(argv[u + 1]), 0);
+        if (!STRCMPI(argv[u], "wtime"))
+        {
+            uClock[WHITE] = (ULONG)x;
+            fClock = TRUE;
+        }
+        else if (!STRCMPI(argv[u], "btime"))
+        {
+            uClock[BLACK] = (ULONG)x;
+            fClock = TRUE;
+        }
+        else if (!STRCMPI(argv[u], "winc"))
+        {
+            uIncrement[WHITE] = (ULONG)x;
+        }
+        else if (!STRCMPI(argv[u], "binc"))
+        {
+            uIncrement[BLACK] = (ULONG)x;
+        }
+        else if (!STRCMPI(argv[u], "movestogo"))
+        {
+            uMovesToGo = (ULONG)x;
+        }
+        else if (!STRCMPI(argv[u], "movetime"))
+        {
+            uMoveTime = (ULONG)x;
+        }
+        else if (!STRCMPI(argv[u], "depth"))
+        {
+            g_Options.uMaxDepth = MINU(MAXU((ULONG)x, 1),
+                                       MAX_PLY_PER_SEARCH - 1);
+        }
+        else if (!STRCMPI(argv[u], "nodes"))
+        {
+            g_Options.u64MaxNodeCount = strtoull(argv[u + 1], NULL, 10);
+        }
+        else
+        {
+            continue;
+        }
+        u++;
+    }
+
+    g_Options.uMovesToGo = 0;
+    if (uMoveTime != 0)
+    {
+        g_Options.eClock = CLOCK_FIXED;
+        g_Options.uMyIncrementMs = uMoveTime;
+    }
+    else if ((TRUE == fClock) && (FALSE == g_UciSearch.fInfinite))
+    {
+        g_Options.uMyClockMs = uClock[uColor];
+        g_Options.uOpponentsClockMs = uClock[FLIP(uColor)];
+        g_Options.uMyIncrementMs = uIncrement[uColor];
+        g_Options.uMovesToGo = uMovesToGo;
+        g_Options.uMovesPerTimePeriod = 0;
+        g_Options.eClock = CLOCK_NORMAL;
+        if (uIncrement[uColor] != 0)
+        {
+            g_Options.eClock = CLOCK_INCREMENT;
+        }
+    }
+    else
+    {
+        g_Options.eClock = CLOCK_NONE;
+    }
+
+    //
+    // Ponder without a time limit until ponderhit says which clock
+    // to use.
+    //
+    if (TRUE == g_UciSearch.fPondering)
+    {
+        g_UciSearch.eClock = g_Options.eClock;
+        g_Options.eClock = CLOCK_NONE;
+    }
+    g_UciSearch.fWaitForStop = (g_UciSearch.fInfinite ||
+                                g_UciSearch.fPondering);
+    g_Options.ePlayMode = (uColor == WHITE) ? I_PLAY_WHITE : I_PLAY_BLACK;
+}
+
+
+void
+UciPostPV(SEARCHER_THREAD_CONTEXT *ctx,
+          SCORE iAlpha,
+          SCORE iBeta,
+          SCORE iScore,
+          ULONG uLine,
+          double dElapsed)
+/**
+
+Routine description:
+
+    Post a root PV (or fail high / fail low) as a UCI info line.
+    UtilPrintPV calls this under UCI.
+
+Parameters:
+
+    SEARCHER_THREAD_CONTEXT *ctx,
+    SCORE iAlpha,
+    SCORE iBeta,
+    SCORE iScore,
+    ULONG uLine : which of the MultiPV lines this is (1 = best)
+    double dElapsed : seconds since the search started
+
+Return value:
+
+    void
+
+**/
+{
+    CHAR szScore[SMALL_STRING_LEN_CHAR];
+    CHAR szPV[SMALL_STRING_LEN_CHAR];
+    CHAR szLine[SMALL_STRING_LEN_CHAR];
+    UINT64 u64Nodes = ctx->sCounters.tree.u64TotalNodeCount;
+    ULONG uMs = (ULONG)(dElapsed * 1000.0);
+    ULONG u = ctx->uPly;
+    MOVE mv;
+
+    if (abs(iScore) < NMATE)
+    {
+        snprintf(szScore, ARRAY_LENGTH(szScore), "cp %d", iScore);
+    }
+    else if (iScore > 0)
+    {
+        snprintf(szScore, ARRAY_LENGTH(szScore), "mate %d",
+                 (+INFINITY - iScore + 1) / 2);
+    }
+    else
+    {
+        snprintf(szScore, ARRAY_LENGTH(szScore), "mate -%d",
+                 (+INFINITY + iScore + 1) / 2);
+    }
+    if (iScore <= iAlpha)
+    {
+        strcat(szScore, " upperbound");
+    }
+    else if (iScore >= iBeta)
+    {
+        strcat(szScore, " lowerbound");
+    }
+
+    //
+    // Walk the PV; the root move is all we have on a fail high/low.
+    // There's no need to make the moves, the notation doesn't depend
+    // on the position.
+    //
+    szPV[0] = '\0';
+    if ((iAlpha < iScore) && (iScore < iBeta))
+    {
+        while((u < MAX_PLY_PER_SEARCH) &&
+              ((mv.uMove = ctx->sPlyInfo[ctx->uPly].PV[u].uMove) != 0))
+        {
+            if ((mv.uMove == HASHMOVE.uMove) ||
+                (mv.uMove == RECOGNMOVE.uMove) ||
+                (mv.uMove == DRAWMOVE.uMove) ||
+                (strlen(szPV) > ARRAY_LENGTH(szPV) - 10))
+            {
+                break;
+            }
+            strcat(szPV, " ");
+            strcat(szPV, MoveToUci(mv));
+            u++;
+        }
+    }
+    else
+    {
+        strcat(szPV, " ");
+        strcat(szPV, MoveToUci(ctx->mvRootMove));
+    }
+
+    szLine[0] = '\0';
+    if (g_Options.uMultiPv > 1)
+    {
+        snprintf(szLine, ARRAY_LENGTH(szLine), " multipv %u", uLine);
+    }
+
+    Trace("info depth %u%s score %s time %u nodes %"
+          COMPILER_LONGLONG_UNSIGNED_FORMAT " nps %"
+          COMPILER_LONGLONG_UNSIGNED_FORMAT " pv%s\n",
+          g_uIterateDepth,
+          szLine,
+          szScore,
+          uMs,
+          u64Nodes,
+          (UINT64)((double)u64Nodes / MAX(dElapsed, 0.001)),
+          szPV);
+}
+
+
+void
+UciPostBestMove(SEARCHER_THREAD_CONTEXT *ctx)
+/**
+
+Routine description:
+
+    The search is over, post its result as "bestmove <move> [ponder
+    <move>]".  MakeTheMove calls us under UCI instead of making the
+    move.  After an infinite or ponder search hold the result until
+    the GUI says stop (or ponderhit).  Go back to force mode when
+    done; the GUI will send the position again.
+
+Parameters:
+
+    SEARCHER_THREAD_CONTEXT *ctx : the searcher context, at the root;
+        ctx->mvRootMove is zero if there is no legal move
+
+Return value:
+
+    void
+
+**/
+{
+    CHAR szBest[SMALL_STRING_LEN_CHAR];
+    MOVE mv = ctx->mvRootMove;
+    MOVE mvPonder;
+
+    while((TRUE == g_UciSearch.fWaitForStop) &&
+          (FALSE == g_fExitProgram))
+    {
+        ParseUserInput(FALSE);
+    }
+
+    //
+    // Stopped while still pondering: the GUI's opponent didn't play
+    // the move we pondered on.
+    //
+    if (TRUE == g_UciSearch.fPondering)
+    {
+        PonderMiss(ctx->sPosition.uToMove);
+    }
+    memset(&g_UciSearch, 0, sizeof(g_UciSearch));
+    g_Options.ePlayMode = FORCE_MODE;
+
+    strcpy(szBest, MoveToUci(mv));
+    if (0 == mv.uMove)
+    {
+        Trace("bestmove %s\n", szBest);
+        return;
+    }
+
+    //
+    // Suggest the second move of the PV as a move to ponder on, or
+    // failing that whatever the hash table says.
+    //
+    ASSERT(ctx->uPly == 0);
+    mvPonder.uMove = 0;
+    if (TRUE == MakeMove(ctx, mv))
+    {
+        if (IS_SAME_MOVE(ctx->sPlyInfo[0].PV[0], mv))
+        {
+            mvPonder = ctx->sPlyInfo[0].PV[1];
+        }
+        if ((mvPonder.uMove == 0) ||
+            (mvPonder.uMove == HASHMOVE.uMove) ||
+            (mvPonder.uMove == RECOGNMOVE.uMove) ||
+            (mvPonder.uMove == DRAWMOVE.uMove))
+        {
+            mvPonder = GetPonderMove(&(ctx->sPosition));
+        }
+        if ((mvPonder.uMove != 0) &&
+            (TRUE == SanityCheckMove(&(ctx->sPosition), mvPonder)) &&
+            (TRUE == MakeMove(ctx, mvPonder)))
+        {
+            UnmakeMove(ctx, mvPonder);
+        }
+        else
+        {
+            mvPonder.uMove = 0;
+        }
+        UnmakeMove(ctx, mv);
+    }
+
+    if (mvPonder.uMove != 0)
+    {
+        Trace("bestmove %s ponder %s\n", szBest, MoveToUci(mvPonder));
+    }
+    else
+    {
+        Trace("bestmove %s\n", szBest);
+    }
+}
@@ -29,11 +29,19 @@ Revision History:
 #include <sys/select.h>
 #include <sys/ipc.h>
 #include <sys/sem.h>
+#include <sys/socket.h>
+#include <sys/un.h>
 #include <pthread.h>
 #include <signal.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
 
 #define SYS_MAX_HEAP_ALLOC_SIZE_BYTES 0xfff
+#define SYS_ALLOC_ALIGNMENT_BYTES 64
 #define HEAP 0x48656170
 #define MMAP 0x4d6d6170
 
@@ -53,7 +61,8 @@ typedef struct _ALLOC_RECORD
 } ALLOC_RECORD;
 ALLOC_RECORD g_AllocHash[ALLOC_HASH_SIZE];
 
-#define PTR_TO_ALLOC_HASH(x) ((((ULONG)(x)) >> 3) & (ALLOC_HASH_SIZE - 1))
+#define PTR_TO_ALLOC_HASH(x) \
+    ((ULONG)(((uintptr_t)(x)) >> 3) & (ALLOC_HASH_SIZE - 1))
 
 ULONG
 GetHeapMemoryUsage(void)
@@ -73,7 +82,14 @@ ReleaseAllocHashEntry(void *p)
     {
         u++;
         u &= (ALLOC_HASH_SIZE - 1);
-        if (v == u) return;
+        if (v == u)
+        {
+            //
+            // Not tracked (see MarkAllocHashEntry's size limit).
+            //
+            UNLOCK_SYSTEM;
+            return;
+        }
     }
     g_AllocHash[u].p = NULL;
     g_uTotalAlloced -= g_AllocHash[u].uSize;
@@ -247,7 +263,7 @@ Return value:
 
     uParam = p->uThreadParam;
     i = (int)(*(p->pEntry))(uParam);          // call thread's user-supplied entry
-    return((void *)i);
+    return((void *)(intptr_t)i);
 }
 
 FLAG 
@@ -346,7 +362,7 @@ Return value:
     void *p;
 
     pthread_join(q->thread, &p);
-    *puCode = ((ULONG)p);
+    *puCode = (ULONG)(uintptr_t)p;
     return(TRUE);
 }
 
@@ -403,7 +419,11 @@ Return value:
 
 **/
 {
+#if defined(__i386__) || defined(__x86_64__)
     __asm__("int3\n");
+#else
+    __builtin_trap();
+#endif
 }
 
 UINT64 FASTCALL 
@@ -424,10 +444,15 @@ Return value:
 
 **/
 {
-    __asm__("rdtsc;"
-        :
-        :
-        : "%eax", "%edx");
+#if defined(__i386__) || defined(__x86_64__)
+    return(__builtin_ia32_rdtsc());
+#elif defined(__aarch64__)
+    UINT64 u64;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(u64));
+    return(u64);
+#else
+    return((UINT64)clock());
+#endif
 }
 
 
@@ -457,7 +482,7 @@ Return value:
     if (0 != gettimeofday(&tv, NULL))
     {
         UtilPanic(UNEXPECTED_SYSTEM_CALL_FAILURE,
-                  NULL, "gettimeofday", (void *)errno, NULL,
+                  NULL, "gettimeofday", (void *)(uintptr_t)errno, NULL,
                   __FILE__, __LINE__);
     }
     return((double)tv.tv_sec + (double)tv.tv_usec * 1.0e-6);
@@ -573,7 +598,7 @@ Return value:
     if (MAP_FAILED == pMem)
     {
         UtilPanic(UNEXPECTED_SYSTEM_CALL_FAILURE,
-                  NULL, "mmap", (void *)errno, (void *)dwSizeBytes,
+                  NULL, "mmap", (void *)(uintptr_t)errno, (void *)(uintptr_t)dwSizeBytes,
                   __FILE__, __LINE__);
     }
     (void)madvise(pMem, dwSizeBytes, MADV_RANDOM | MADV_WILLNEED);
@@ -602,7 +627,7 @@ Return value:
     if (0 != munmap(pMem, (size_t)-1))
     {
         UtilPanic(UNEXPECTED_SYSTEM_CALL_FAILURE,
-                  NULL, "munmap", (void *)errno, pMem,
+                  NULL, "munmap", (void *)(uintptr_t)errno, pMem,
                   __FILE__, __LINE__);
     }
 }
@@ -613,7 +638,8 @@ static void *_SystemCallMalloc(ULONG dwSizeBytes)
 
 Routine description:
 
-    Wrapper around malloc.
+    Wrapper around malloc.  Returns a cacheline aligned, zeroed
+    buffer.
 
 Parameters:
 
@@ -625,11 +651,15 @@ Return value:
 
 **/
 {
-    void *p = malloc(dwSizeBytes);
+    void *p = NULL;
+    if (0 != posix_memalign(&p, SYS_ALLOC_ALIGNMENT_BYTES, dwSizeBytes))
+    {
+        p = NULL;
+    }
     if (NULL == p)
     {
         UtilPanic(UNEXPECTED_SYSTEM_CALL_FAILURE,
-                  NULL, "malloc", (void *)errno, (void *)dwSizeBytes,
+                  NULL, "malloc", (void *)(uintptr_t)errno, (void *)(uintptr_t)dwSizeBytes,
                   __FILE__, __LINE__);
     }
     memset(p, 0, dwSizeBytes);
@@ -699,31 +729,36 @@ Return value:
 
 **/
 {
-    DWORD *p;
+    BYTE *p;
 
+    //
+    // The HEAP/MMAP tag lives in the DWORD just before the buffer we
+    // return; a whole cacheline of header keeps the buffer itself
+    // cacheline aligned (searcher contexts and hash tables care).
+    //
     if (0) // (dwSizeBytes > SYS_MAX_HEAP_ALLOC_SIZE_BYTES)
     {
-        p = _SystemCallMmap(dwSizeBytes + sizeof(DWORD));
+        p = _SystemCallMmap(dwSizeBytes + SYS_ALLOC_ALIGNMENT_BYTES);
         if (NULL == p)
         {
             UtilPanic(UNEXPECTED_SYSTEM_CALL_FAILURE,
-                      NULL, "mmap", (void *)errno, NULL,
+                      NULL, "mmap", (void *)(uintptr_t)errno, NULL,
                       __FILE__, __LINE__);
         }
-        *p = MMAP;
-        p += 1;
+        p += SYS_ALLOC_ALIGNMENT_BYTES;
+        ((DWORD *)p)[-1] = MMAP;
     }
     else
     {
-        p = _SystemCallMalloc(dwSizeBytes + sizeof(DWORD));
+        p = _SystemCallMalloc(dwSizeBytes + SYS_ALLOC_ALIGNMENT_BYTES);
         if (NULL == p)
         {
             UtilPanic(UNEXPECTED_SYSTEM_CALL_FAILURE,
-                      NULL, "malloc", (void *)errno, NULL,
+                      NULL, "malloc", (void *)(uintptr_t)errno, NULL,
                       __FILE__, __LINE__);
         }
-        *p = HEAP;
-        p += 1;
+        p += SYS_ALLOC_ALIGNMENT_BYTES;
+        ((DWORD *)p)[-1] = HEAP;
     }
 #ifdef DEBUG
     MarkAllocHashEntry(p, dwSizeBytes);
@@ -750,17 +785,17 @@ Return value:
 
 **/
 {
-    DWORD *p = pMemory;
+    DWORD dwTag = ((DWORD *)pMemory)[-1];
+    BYTE *p = (BYTE *)pMemory - SYS_ALLOC_ALIGNMENT_BYTES;
     
-    p -= 1;
 #ifdef DEBUG
     ReleaseAllocHashEntry(pMemory);
 #endif
-    if (*p == HEAP)
+    if (dwTag == HEAP)
     {
         _SystemCallFree(p);
     }
-    else if (*p == MMAP)
+    else if (dwTag == MMAP)
     {
         _SystemCallMunmap(p);
     }
@@ -833,7 +868,7 @@ Return value:
     if (0 != mprotect(pMemory, dwSizeBytes, PROT_READ))
     {
         UtilPanic(UNEXPECTED_SYSTEM_CALL_FAILURE,
-                  NULL, "mprotect", (void *)errno, (void *)PROT_READ,
+                  NULL, "mprotect", (void *)(uintptr_t)errno, (void *)PROT_READ,
                   __FILE__, __LINE__);
     }
     return(TRUE);
@@ -865,7 +900,7 @@ Return value:
         UtilPanic(UNEXPECTED_SYSTEM_CALL_FAILURE,
                   NULL, 
                   "mprotect", 
-                  (void *)errno,
+                  (void *)(uintptr_t)errno,
                   (void *)(PROT_READ | PROT_WRITE),
                   __FILE__, __LINE__);
     }
@@ -936,6 +971,147 @@ Return value:
 }
 
 
+ULONG
+SystemCreateServerSocket(CHAR *szPath)
+/**
+
+Routine description:
+
+    Create a Unix domain stream socket listening at szPath, replacing
+    any stale socket file left there.  Clients that hang up on us
+    must not kill the process so SIGPIPE is ignored from here on.
+
+Parameters:
+
+    CHAR *szPath
+
+Return value:
+
+    ULONG : a socket handle or (ULONG)-1 on error
+
+**/
+{
+    struct sockaddr_un sAddr;
+    int fd;
+
+    if (strlen(szPath) >= sizeof(sAddr.sun_path))
+    {
+        return((ULONG)-1);
+    }
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        return((ULONG)-1);
+    }
+    memset(&sAddr, 0, sizeof(sAddr));
+    sAddr.sun_family = AF_UNIX;
+    strcpy(sAddr.sun_path, szPath);
+    (void)unlink(szPath);
+    if ((0 != bind(fd, (struct sockaddr *)&sAddr, sizeof(sAddr))) ||
+        (0 != listen(fd, 8)))
+    {
+        close(fd);
+        return((ULONG)-1);
+    }
+    (void)signal(SIGPIPE, SIG_IGN);
+    return((ULONG)fd);
+}
+
+
+FLAG
+SystemAcceptServerConnection(ULONG uSocket,
+                             ULONG uTimeoutMs,
+                             FILE **ppIn,
+                             FILE **ppOut)
+/**
+
+Routine description:
+
+    Wait up to uTimeoutMs for a client to connect to a socket made by
+    SystemCreateServerSocket and, if one does, return a stream to
+    read from it and another to write to it.  The caller must fclose
+    both.
+
+Parameters:
+
+    ULONG uSocket,
+    ULONG uTimeoutMs,
+    FILE **ppIn,
+    FILE **ppOut
+
+Return value:
+
+    FLAG : TRUE if a client connected
+
+**/
+{
+    struct timeval tv;
+    fd_set fds;
+    int fd, fd2;
+
+    *ppIn = *ppOut = NULL;
+    FD_ZERO(&fds);
+    FD_SET((int)uSocket, &fds);
+    tv.tv_sec = uTimeoutMs / 1000;
+    tv.tv_usec = (uTimeoutMs % 1000) * 1000;
+    if (select((int)uSocket + 1, &fds, NULL, NULL, &tv) <= 0)
+    {
+        return(FALSE);
+    }
+    fd = accept((int)uSocket, NULL, NULL);
+    if (fd < 0)
+    {
+        return(FALSE);
+    }
+    fd2 = dup(fd);
+    if ((fd2 < 0) ||
+        (NULL == (*ppIn = fdopen(fd, "r"))) ||
+        (NULL == (*ppOut = fdopen(fd2, "w"))))
+    {
+        if (NULL != *ppIn)
+        {
+            fclose(*ppIn);
+            *ppIn = NULL;
+        }
+        else
+        {
+            close(fd);
+        }
+        if (fd2 >= 0)
+        {
+            close(fd2);
+        }
+        return(FALSE);
+    }
+    return(TRUE);
+}
+
+
+void
+SystemDeleteServerSocket(ULONG uSocket, CHAR *szPath)
+/**
+
+Routine description:
+
+    Close a socket made by SystemCreateServerSocket and remove its
+    file.
+
+Parameters:
+
+    ULONG uSocket,
+    CHAR *szPath
+
+Return value:
+
+    void
+
+**/
+{
+    close((int)uSocket);
+    (void)unlink(szPath);
+}
+
+
 #define MAX_LOCKS (8)
 typedef struct _UNIX_LOCK_ENTRY
 {
@@ -1103,7 +1279,7 @@ SystemReleaseSemaphoreResource(ULONG u)
         if (semop(g_rgSemaphores[u], &operation, 1) < 0) 
         {
             UtilPanic(UNEXPECTED_SYSTEM_CALL_FAILURE,
-                      NULL, "semop", (void *)errno, (void *)0,
+                      NULL, "semop", (void *)(uintptr_t)errno, (void *)0,
                       __FILE__, __LINE__);
         }
 #ifdef DEBUG
@@ -1130,7 +1306,7 @@ SystemObtainSemaphoreResource(ULONG u)
         if (semop(g_rgSemaphores[u], &operation, 1) < 0) 
         {
             UtilPanic(UNEXPECTED_SYSTEM_CALL_FAILURE,
-                      NULL, "semop", (void *)errno, (void *)1,
+                      NULL, "semop", (void *)(uintptr_t)errno, (void *)1,
                       __FILE__, __LINE__);
         }
 #ifdef DEBUG
@@ -1147,6 +1323,153 @@ SystemObtainSemaphoreResource(ULONG u)
 }
 
 
+#define MAX_EVENTS (4)
+typedef struct _UNIX_EVENT_ENTRY
+{
+    int fdRead;
+    int fdWrite;
+    FLAG fInUse;
+} UNIX_EVENT_ENTRY;
+UNIX_EVENT_ENTRY g_rgEventTable[MAX_EVENTS];
+
+ULONG
+SystemCreateEvent(void)
+/**
+
+Routine description:
+
+    Create an auto-reset event: SystemSignalEvent sets it and the
+    next SystemWaitForEvent consumes the signal.  Signals are sticky
+    so one raised before the waiter gets there is never lost.  On
+    Linux this is an eventfd; elsewhere it's a non-blocking pipe.
+
+Parameters:
+
+    void
+
+Return value:
+
+    ULONG : an event handle or (ULONG)-1 on error
+
+**/
+{
+    int fd[2];
+    ULONG u;
+
+    LOCK_SYSTEM;
+    for (u = 0; u < MAX_EVENTS; u++)
+    {
+        if (FALSE == g_rgEventTable[u].fInUse)
+        {
+#ifdef __linux__
+            fd[0] = fd[1] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (fd[0] < 0)
+            {
+                u = (ULONG)-1;
+                goto end;
+            }
+#else
+            if (pipe(fd) < 0)
+            {
+                u = (ULONG)-1;
+                goto end;
+            }
+            (void)fcntl(fd[0], F_SETFL, O_NONBLOCK);
+            (void)fcntl(fd[1], F_SETFL, O_NONBLOCK);
+#endif
+            g_rgEventTable[u].fdRead = fd[0];
+            g_rgEventTable[u].fdWrite = fd[1];
+            g_rgEventTable[u].fInUse = TRUE;
+            goto end;
+        }
+    }
+    u = (ULONG)-1;                            // no free slot
+
+ end:
+    UNLOCK_SYSTEM;
+    return(u);
+}
+
+FLAG
+SystemDeleteEvent(ULONG u)
+{
+    LOCK_SYSTEM;
+    if ((u < MAX_EVENTS) && (g_rgEventTable[u].fInUse == TRUE))
+    {
+        close(g_rgEventTable[u].fdRead);
+        if (g_rgEventTable[u].fdWrite != g_rgEventTable[u].fdRead)
+        {
+            close(g_rgEventTable[u].fdWrite);
+        }
+        g_rgEventTable[u].fInUse = FALSE;
+        UNLOCK_SYSTEM;
+        return(TRUE);
+    }
+    UNLOCK_SYSTEM;
+    return(FALSE);
+}
+
+void
+SystemSignalEvent(ULONG u)
+{
+    UINT64 u64One = 1;
+
+    //
+    // No lock here: this is called once per line of input and the
+    // event is never deleted while the input system is running.  If
+    // the write fails because the pipe is full the event is already
+    // signalled.
+    //
+    if ((u < MAX_EVENTS) && (g_rgEventTable[u].fInUse == TRUE))
+    {
+        if (write(g_rgEventTable[u].fdWrite, &u64One, sizeof(u64One)) < 0)
+        {
+            ASSERT(errno == EAGAIN);
+        }
+    }
+}
+
+FLAG
+SystemWaitForEvent(ULONG u, ULONG uTimeoutMs)
+/**
+
+Routine description:
+
+    Wait up to uTimeoutMs for an event to be signalled and reset it.
+
+Parameters:
+
+    ULONG u,
+    ULONG uTimeoutMs
+
+Return value:
+
+    FLAG : TRUE if the event was signalled, FALSE on timeout
+
+**/
+{
+    struct pollfd sPoll;
+    UINT64 u64Buf[8];
+
+    if ((u >= MAX_EVENTS) || (g_rgEventTable[u].fInUse == FALSE))
+    {
+        return(FALSE);
+    }
+    sPoll.fd = g_rgEventTable[u].fdRead;
+    sPoll.events = POLLIN;
+    sPoll.revents = 0;
+    if (poll(&sPoll, 1, (int)uTimeoutMs) <= 0)
+    {
+        return(FALSE);
+    }
+    while (read(sPoll.fd, u64Buf, sizeof(u64Buf)) > 0)
+    {
+        ;
+    }
+    return(TRUE);
+}
+
+
 FLAG
 SystemDependentInitialization(void)
 /**
@@ -1107,7 +1107,7 @@ UtilPanic(ULONG uPanicCode,
         case GOT_ILLEGAL_MOVE_WHILE_PONDERING:
         case CANNOT_OFFICIALLY_MAKE_MOVE:
             DumpPosition(pos);
-            DumpMove((ULONG)arg1);
+            DumpMove((ULONG)(uintptr_t)arg1);
             break;
         case INITIALIZATION_FAILURE:
             Bug("%s\n", (char *)arg1);
@@ -1126,7 +1126,8 @@ UtilPrintPV(SEARCHER_THREAD_CONTEXT *ctx,
             SCORE iAlpha,
             SCORE iBeta,
             SCORE iScore,
-            MOVE mv)
+            MOVE mv,
+            ULONG uLine)
 /**
 
 Routine description:
@@ -1139,7 +1140,9 @@ Parameters:
     SCORE iAlpha,
     SCORE iBeta,
     SCORE iScore,
-    MOVE mv
+    MOVE mv,
+    ULONG uLine : which MultiPV line this is; only line 1 (the best
+                  one) becomes the context's last PV
 
 Return value:
 
@@ -1148,6 +1151,7 @@ Return value:
 **/
 {
     double dNow = SystemTimeStamp();
+    CHAR szPV[SMALL_STRING_LEN_CHAR];
 
     ASSERT(ctx->uThreadNumber == 0);
     ASSERT(IS_VALID_SCORE(iAlpha));
@@ -1159,20 +1163,38 @@ Return value:
 
     //
     // Set the last PV in the context if we have a root PV or a root
-    // fail high.
+    // fail high.  The other lines of a MultiPV search are just
+    // printed.
     //
-    if ((iAlpha < iScore) && (iScore < iBeta))
+    if (uLine > 1)
+    {
+        strncpy(szPV, WalkPV(ctx), ARRAY_LENGTH(szPV) - 1);
+        szPV[ARRAY_LENGTH(szPV) - 1] = '\0';
+    }
+    else if ((iAlpha < iScore) && (iScore < iBeta))
     {
         strncpy(ctx->szLastPV, WalkPV(ctx), SMALL_STRING_LEN_CHAR);
+        strcpy(szPV, ctx->szLastPV);
     }
     else if (iScore > iBeta)
     {
         strncpy(ctx->szLastPV, MoveToSan(mv, &(ctx->sPosition)),
                 SMALL_STRING_LEN_CHAR);
+        strcpy(szPV, ctx->szLastPV);
+    }
+    else
+    {
+        strcpy(szPV, ctx->szLastPV);
     }
 
     if ((TRUE == g_Options.fThinking) && (TRUE == g_Options.fShouldPost))
     {
+        if (TRUE == g_Options.fRunningUnderUci)
+        {
+            UciPostPV(ctx, iAlpha, iBeta, iScore, uLine, dNow);
+            return;
+        }
+
         //
         // Maybe output the PV.  Note: xboard gets confused by PV
         // lines that don't match its requirements exactly; if we are
@@ -1191,7 +1213,7 @@ Return value:
                           iScore,
                           (ULONG)(dNow * 100),
                           ctx->sCounters.tree.u64TotalNodeCount,
-                          ctx->szLastPV);
+                          szPV);
                 }
                 else if (iScore <= iAlpha)
                 {
@@ -1211,7 +1233,7 @@ Return value:
                           iScore,
                           (ULONG)(dNow * 100),
                           ctx->sCounters.tree.u64TotalNodeCount,
-                          ctx->szLastPV);
+                          szPV);
                 }
             }
             else // !running under xboard
@@ -1224,7 +1246,7 @@ Return value:
                           ScoreToString(iScore),
                           TimeToString(dNow),
                           ctx->sCounters.tree.u64TotalNodeCount,
-                          ctx->szLastPV);
+                          szPV);
                 }
                 else if (iScore <= iAlpha)
                 {
@@ -1244,7 +1266,7 @@ Return value:
                           ScoreToString(iScore),
                           TimeToString(dNow),
                           ctx->sCounters.tree.u64TotalNodeCount,
-                          ctx->szLastPV);
+                          szPV);
                 }
             }
         }
@@ -55,6 +55,30 @@ USER_VARIABLE g_UserVarList[] =
       "B",
       (void *)&(g_Options.fShouldAnnounceOpening),
       NULL },
+    { "AspirationFailHighGrowth",
+      "D",
+      (void *)&(g_AspirationPolicy.dFailHighGrowth),
+      NULL },
+    { "AspirationFailLowGrowth",
+      "D",
+      (void *)&(g_AspirationPolicy.dFailLowGrowth),
+      NULL },
+    { "AspirationMaxDelta",
+      "I",
+      (void *)&(g_AspirationPolicy.iMaxDelta),
+      NULL },
+    { "AspirationMinDelta",
+      "I",
+      (void *)&(g_AspirationPolicy.iMinDelta),
+      NULL },
+    { "AspirationScoreJump",
+      "I",
+      (void *)&(g_AspirationPolicy.iScoreJump),
+      NULL },
+    { "AspirationVolatilityWeight",
+      "D",
+      (void *)&(g_AspirationPolicy.dVolatilityWeight),
+      NULL },
     { "BatchMode",
       "b",
       (void *)&(g_Options.fNoInputThread),
@@ -83,14 +107,26 @@ USER_VARIABLE g_UserVarList[] =
       "u",
       (void *)&(g_uBookProbeFailures),
       NULL },
-    { "ComputerTimeRemainingSec",
+    { "ComputerTimeRemainingMs",
       "U",
-      (void *)&(g_Options.uOpponentsClock),
+      (void *)&(g_Options.uOpponentsClockMs),
       NULL }, //&DoVerifyClocks },
+    { "EGTBCacheSize",
+      "U",
+      (void *)&(g_Options.uEGTBCacheSize),
+      ResizeEGTBCache },
     { "EGTBPath",
       "S",
       (void *)&(g_Options.szEGTBPath),
       InitializeEGTB },
+    { "EGTBProbeDepth",
+      "U",
+      (void *)&(g_Options.uEGTBProbeDepth),
+      NULL },
+    { "EvalType",
+      "S",
+      (void *)&(g_Options.szEvalType),
+      SelectEvalType },
     { "FastScript",
       "B",
       (void *)&(g_Options.fFastScript),
@@ -119,6 +155,10 @@ USER_VARIABLE g_UserVarList[] =
       "S",
       (void *)&(g_Options.szLogfile),
       NULL },
+    { "MoveOverheadMs",
+      "U",
+      (void *)&(g_Options.uMoveOverhead),
+      NULL },
     { "MoveToPonder",
       "m",
       (void *)&(g_Options.mvPonder),
@@ -127,9 +167,17 @@ USER_VARIABLE g_UserVarList[] =
       "U",
       (void *)&(g_Options.uMovesPerTimePeriod),
       NULL },
-    { "OpponentTimeRemainingSec",
+    { "MultiPV",
+      "U",
+      (void *)&(g_Options.uMultiPv),
+      NULL },
+    { "NNUEFile",
+      "S",
+      (void *)&(g_Options.szNnueFile),
+      InitializeNnue },
+    { "OpponentTimeRemainingMs",
       "U",
-      (void *)&(g_Options.uMyClock),
+      (void *)&(g_Options.uMyClockMs),
       NULL }, //&DoVerifyClocks },
     { "PendingInputEvents",
       "u",
@@ -151,9 +199,9 @@ USER_VARIABLE g_UserVarList[] =
       "U",
       (void *)&(g_Options.uMaxDepth),
       NULL }, //&DoVerifySearchDepth },
-    { "SearchTimeLimit",
+    { "SearchTimeLimitMs",
       "U",
-      (void *)&(g_Options.uMyIncrement),
+      (void *)&(g_Options.uMyIncrementMs),
       NULL }, //&DoVerifySearchTime },
     { "SearchStartedTime",
       "d",
@@ -442,6 +490,10 @@ Return value:
                         y = atoi(argv[2]);
                         *((int *)g_UserVarList[x].pValue) = y;
                         break;
+
+                    case 'D':
+                        *((double *)g_UserVarList[x].pValue) = atof(argv[2]);
+                        break;
                         
                     case 'B':
                         if (toupper(*(argv[2])) == 'T')
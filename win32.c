@@ -107,7 +107,14 @@ ReleaseAllocHashEntry(void *p)
     {
         u++;
         u &= (ALLOC_HASH_SIZE - 1);
-        if (v == u) return;
+        if (v == u)
+        {
+            //
+            // Not tracked (see MarkAllocHashEntry's size limit).
+            //
+            UNLOCK_SYSTEM;
+            return;
+        }
     }
     g_AllocHash[u].p = NULL;
     g_uTotalAlloced -= g_AllocHash[u].uSize;
@@ -1125,6 +1132,77 @@ Return value:
 }
 
 
+ULONG
+SystemCreateServerSocket(CHAR *szPath)
+/**
+
+Routine description:
+
+    Unix domain sockets are not supported on this platform; the
+    analysis server can only read requests from stdin here.
+
+Parameters:
+
+    CHAR *szPath
+
+Return value:
+
+    ULONG : (ULONG)-1
+
+**/
+{
+    return((ULONG)-1);
+}
+
+
+FLAG
+SystemAcceptServerConnection(ULONG uSocket,
+                             ULONG uTimeoutMs,
+                             FILE **ppIn,
+                             FILE **ppOut)
+/**
+
+Routine description:
+
+Parameters:
+
+    ULONG uSocket,
+    ULONG uTimeoutMs,
+    FILE **ppIn,
+    FILE **ppOut
+
+Return value:
+
+    FLAG
+
+**/
+{
+    *ppIn = *ppOut = NULL;
+    Sleep(uTimeoutMs);
+    return(FALSE);
+}
+
+
+void
+SystemDeleteServerSocket(ULONG uSocket, CHAR *szPath)
+/**
+
+Routine description:
+
+Parameters:
+
+    ULONG uSocket,
+    CHAR *szPath
+
+Return value:
+
+    void
+
+**/
+{
+}
+
+
 FLAG 
 SystemMakeMemoryReadWrite(void *pMemory, ULONG dwSizeBytes)
 /**
@@ -1345,6 +1423,69 @@ SystemObtainSemaphoreResource(ULONG u)
     UNLOCK_SYSTEM;
 }
 
+
+
+#define MAX_EVENTS (4)
+HANDLE g_rgEventHandles[MAX_EVENTS];
+
+ULONG
+SystemCreateEvent(void)
+{
+    ULONG u;
+    LOCK_SYSTEM;
+    for (u = 0; u < MAX_EVENTS; u++) 
+    {
+        if (g_rgEventHandles[u] == (HANDLE)NULL) 
+        {
+            g_rgEventHandles[u] = CreateEvent(NULL, FALSE, FALSE, NULL);
+            if (NULL == g_rgEventHandles[u]) 
+            {
+                u = (ULONG)-1;
+            }
+            goto end;
+        }
+    }
+    u = (ULONG)-1;
+
+ end:
+    UNLOCK_SYSTEM;
+    return(u);
+}
+
+FLAG
+SystemDeleteEvent(ULONG u) 
+{
+    LOCK_SYSTEM;
+    if ((u < MAX_EVENTS) && (g_rgEventHandles[u] != (HANDLE)NULL)) 
+    {
+        (void)CloseHandle(g_rgEventHandles[u]);
+        g_rgEventHandles[u] = (HANDLE)NULL;
+        UNLOCK_SYSTEM;
+        return(TRUE);
+    }
+    UNLOCK_SYSTEM;
+    return(FALSE);
+}
+
+void
+SystemSignalEvent(ULONG u) 
+{
+    if ((u < MAX_EVENTS) && (g_rgEventHandles[u] != (HANDLE)NULL)) 
+    {
+        (void)SetEvent(g_rgEventHandles[u]);
+    }
+}
+
+FLAG
+SystemWaitForEvent(ULONG u, ULONG uTimeoutMs) 
+{
+    if ((u < MAX_EVENTS) && (g_rgEventHandles[u] != (HANDLE)NULL)) 
+    {
+        return(WAIT_OBJECT_0 == 
+               WaitForSingleObject(g_rgEventHandles[u], uTimeoutMs));
+    }
+    return(FALSE);
+}
       
 
 FLAG 
@@ -1399,6 +1540,7 @@ Return value:
     //
     memset(g_rgLockTable, 0, sizeof(g_rgLockTable));
     memset(g_rgSemHandles, 0, sizeof(g_rgSemHandles));
+    memset(g_rgEventHandles, 0, sizeof(g_rgEventHandles));
 
     //
     // Populate global system info buffer